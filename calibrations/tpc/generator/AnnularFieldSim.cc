@@ -18,14 +18,201 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>  // for assert
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #define ALMOST_ZERO 0.00001
 
+namespace
+{
+  //! runs func(i) for every i in [0,n), spread over nthreads threads
+  template <class F>
+  void parallel_for(int n, unsigned int nthreads, const F &func)
+  {
+    if (nthreads == 0)
+    {
+      nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    nthreads = std::min<unsigned int>(nthreads, std::max(1, n));
+    if (nthreads == 1)
+    {
+      for (int i = 0; i < n; i++)
+      {
+        func(i);
+      }
+      return;
+    }
+    std::atomic<int> next{0};
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < nthreads; t++)
+    {
+      threads.emplace_back([&next, n, &func]()
+                           {
+        for (int i = next++; i < n; i = next++)
+        {
+          func(i);
+        } });
+    }
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  //! solves lap(V)=f on the cell centers of an annulus, V=0 on the r and z walls (the cell edges), periodic in phi.
+  //! f is indexed (ir*nphi+iphi)*nz+iz and is replaced by V.
+  //! phi and z are expanded in the eigenvectors of their second differences (real fourier modes and sines),
+  //! which leaves one tridiagonal system in r per (phi mode, z mode).
+  void solve_annular_poisson(int nr, int nphi, int nz, double rmin, double dr, double dphi, double dz, std::vector<double> &f, unsigned int nthreads)
+  {
+    // orthonormal phi modes: constant, then cos and sin pairs, then the alternating mode if nphi is even
+    std::vector<double> phibasis(nphi * nphi);
+    std::vector<double> phieigen(nphi);
+    for (int m = 0; m < nphi; m++)
+    {
+      const int freq = (m + 1) / 2;
+      const bool sine = (m > 0 && m % 2 == 0);
+      const double norm = (freq == 0 || 2 * freq == nphi) ? std::sqrt(1. / nphi) : std::sqrt(2. / nphi);
+      for (int j = 0; j < nphi; j++)
+      {
+        const double arg = 2 * M_PI * freq * j / nphi;
+        phibasis[m * nphi + j] = norm * (sine ? std::sin(arg) : std::cos(arg));
+      }
+      phieigen[m] = std::pow(2 * std::sin(M_PI * freq / nphi) / dphi, 2);
+    }
+    // orthonormal z modes sin(pi*k*(l+1/2)/nz), k=1..nz, which vanish on the cell edges at both ends
+    std::vector<double> zbasis(nz * nz);
+    std::vector<double> zeigen(nz);
+    for (int k = 0; k < nz; k++)
+    {
+      const double norm = (k + 1 == nz) ? std::sqrt(1. / nz) : std::sqrt(2. / nz);
+      for (int l = 0; l < nz; l++)
+      {
+        zbasis[k * nz + l] = norm * std::sin(M_PI * (k + 1) * (l + 0.5) / nz);
+      }
+      zeigen[k] = std::pow(2 * std::sin(M_PI * (k + 1) / (2. * nz)) / dz, 2);
+    }
+
+    const int slice = nphi * nz;
+    // forward or backward transform of one r slice
+    auto transform = [&](int ir, bool forward)
+    {
+      double *data = &f[static_cast<long>(ir) * slice];
+      std::vector<double> tmp(slice, 0.);
+      if (forward)
+      {
+        // z first, then phi
+        for (int j = 0; j < nphi; j++)
+        {
+          for (int k = 0; k < nz; k++)
+          {
+            double sum = 0;
+            for (int l = 0; l < nz; l++)
+            {
+              sum += zbasis[k * nz + l] * data[j * nz + l];
+            }
+            tmp[j * nz + k] = sum;
+          }
+        }
+        std::fill(data, data + slice, 0.);
+        for (int m = 0; m < nphi; m++)
+        {
+          for (int j = 0; j < nphi; j++)
+          {
+            const double w = phibasis[m * nphi + j];
+            for (int k = 0; k < nz; k++)
+            {
+              data[m * nz + k] += w * tmp[j * nz + k];
+            }
+          }
+        }
+      }
+      else
+      {
+        for (int m = 0; m < nphi; m++)
+        {
+          for (int j = 0; j < nphi; j++)
+          {
+            const double w = phibasis[m * nphi + j];
+            for (int k = 0; k < nz; k++)
+            {
+              tmp[j * nz + k] += w * data[m * nz + k];
+            }
+          }
+        }
+        for (int j = 0; j < nphi; j++)
+        {
+          for (int l = 0; l < nz; l++)
+          {
+            double sum = 0;
+            for (int k = 0; k < nz; k++)
+            {
+              sum += zbasis[k * nz + l] * tmp[j * nz + k];
+            }
+            data[j * nz + l] = sum;
+          }
+        }
+      }
+    };
+
+    parallel_for(nr, nthreads, [&transform](int ir)
+                 { transform(ir, true); });
+
+    // (1/r) d/dr(r dV/dr) with V=0 on the inner and outer wall, thomas algorithm per mode
+    std::vector<double> rlow(nr);
+    std::vector<double> rhigh(nr);
+    std::vector<double> rinv2(nr);
+    for (int ir = 0; ir < nr; ir++)
+    {
+      const double r = rmin + (ir + 0.5) * dr;
+      rlow[ir] = (ir > 0) ? (r - 0.5 * dr) / (r * dr * dr) : 0;
+      rhigh[ir] = (ir < nr - 1) ? (r + 0.5 * dr) / (r * dr * dr) : 0;
+      rinv2[ir] = 1. / (r * r);
+    }
+    // the wall is half a cell away, the mirrored value is -V
+    const double rwall_low = (rmin) / ((rmin + 0.5 * dr) * dr * dr);
+    const double rwall_high = (rmin + nr * dr) / ((rmin + (nr - 0.5) * dr) * dr * dr);
+    parallel_for(nphi, nthreads, [&](int m)
+                 {
+      std::vector<double> cprime(nr);
+      std::vector<double> dprime(nr);
+      for (int k = 0; k < nz; k++)
+      {
+        for (int ir = 0; ir < nr; ir++)
+        {
+          double &rhs = f[static_cast<long>(ir) * slice + m * nz + k];
+          double diag = -rlow[ir] - rhigh[ir] - phieigen[m] * rinv2[ir] - zeigen[k];
+          if (ir == 0)
+          {
+            diag -= 2 * rwall_low;
+          }
+          if (ir == nr - 1)
+          {
+            diag -= 2 * rwall_high;
+          }
+          const double denom = diag - ((ir > 0) ? rlow[ir] * cprime[ir - 1] : 0);
+          cprime[ir] = rhigh[ir] / denom;
+          dprime[ir] = (rhs - ((ir > 0) ? rlow[ir] * dprime[ir - 1] : 0)) / denom;
+        }
+        for (int ir = nr - 1; ir >= 0; ir--)
+        {
+          double &v = f[static_cast<long>(ir) * slice + m * nz + k];
+          v = dprime[ir] - ((ir < nr - 1) ? cprime[ir] * f[static_cast<long>(ir + 1) * slice + m * nz + k] : 0);
+        }
+      } });
+
+    parallel_for(nr, nthreads, [&transform](int ir)
+                 { transform(ir, false); });
+  }
+}  // namespace
+
 AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, float in_outerZ,
                                  int r, int roi_r0, int roi_r1, int /*in_rLowSpacing*/, int /*in_rHighSize*/,
                                  int phi, int roi_phi0, int roi_phi1, int /*in_phiLowSpacing*/, int /*in_phiHighSize*/,
@@ -218,9 +405,9 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
     q_local = new MultiArray<double>(1);
     *(q_local->GetFlat(0)) = 0;
   }
-  else if (lookupCase == Analytic || lookupCase == NoLookup)
+  else if (lookupCase == Analytic || lookupCase == NoLookup || lookupCase == Spectral)
   {
-    std::cout << "lookupCase==Analytic (or NoLookup)" << std::endl;
+    std::cout << "lookupCase==Analytic (or NoLookup or Spectral)" << std::endl;
 
     // zero them all out:
     Epartial_phislice = new MultiArray<TVector3>(1);
@@ -1314,6 +1501,11 @@ void AnnularFieldSim::populate_analytic_fieldmap(){
 
 void AnnularFieldSim::populate_fieldmap()
 {
+  if (lookupCase == Spectral)
+  {
+    populate_spectral_fieldmap();
+    return;
+  }
   // sum the E field at every point in the region of interest
   //  remember that Efield uses relative indices
   std::cout << boost::str(boost::format("in pop_fieldmap, n=(%d,%d,%d)") % nr % nphi % nz) << std::endl;
@@ -1355,6 +1547,64 @@ void AnnularFieldSim::populate_fieldmap()
   return;
 }
 
+void AnnularFieldSim::populate_spectral_fieldmap()
+{
+  // solve lap(V)=-rho/eps0 on the whole grid, the charge of a bin is spread over the bin volume.
+  // this replaces the (roi x volume) sum over the greens functions, the cost is O(n (nphi + nz)) for n bins
+  std::cout << boost::str(boost::format("populating fieldmap for (%dx%dx%d) grid with spectral poisson solve on (%dx%dx%d) grid") % nr_roi % nphi_roi % nz_roi % nr % nphi % nz) << std::endl;
+  const double dr = step.Perp();
+  const double dphi = step.Phi();
+  const double dz = step.Z();
+  auto cell = [this](int ir, int iphi, int iz)
+  { return (static_cast<long>(ir) * nphi + iphi) * nz + iz; };
+
+  std::vector<double> potential(static_cast<long>(nr) * nphi * nz);
+  for (int ir = 0; ir < nr; ir++)
+  {
+    const double volume = (rmin + (ir + 0.5) * dr) * dr * dphi * dz;
+    for (int iphi = 0; iphi < nphi; iphi++)
+    {
+      for (int iz = 0; iz < nz; iz++)
+      {
+        potential[cell(ir, iphi, iz)] = -q->GetChargeInBin(ir, iphi, iz) / volume * epsinv;
+      }
+    }
+  }
+  solve_annular_poisson(nr, nphi, nz, rmin, dr, dphi, dz, potential, m_nthreads);
+
+  // E=-grad(V) at the cell centers, the grounded walls are half a cell outside the outer cells
+  auto potentialAt = [&](int ir, int iphi, int iz)
+  {
+    if (ir < 0 || ir >= nr)
+    {
+      return -potential[cell(std::clamp(ir, 0, nr - 1), iphi, iz)];
+    }
+    if (iz < 0 || iz >= nz)
+    {
+      return -potential[cell(ir, iphi, std::clamp(iz, 0, nz - 1))];
+    }
+    return potential[cell(ir, FilterPhiIndex(iphi), iz)];
+  };
+  for (int ir = rmin_roi; ir < rmax_roi; ir++)
+  {
+    const double r = rmin + (ir + 0.5) * dr;
+    for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+    {
+      const double phi = (iphi + 0.5) * dphi;
+      for (int iz = zmin_roi; iz < zmax_roi; iz++)
+      {
+        const double Er = -(potentialAt(ir + 1, iphi, iz) - potentialAt(ir - 1, iphi, iz)) / (2 * dr);
+        const double Ephi = -(potentialAt(ir, iphi + 1, iz) - potentialAt(ir, iphi - 1, iz)) / (2 * r * dphi);
+        const double Ez = -(potentialAt(ir, iphi, iz + 1) - potentialAt(ir, iphi, iz - 1)) / (2 * dz);
+        TVector3 localF(Er * cos(phi) - Ephi * sin(phi), Er * sin(phi) + Ephi * cos(phi), Ez);
+        localF += Eexternal->Get(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi);
+        Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
+      }
+    }
+  }
+  return;
+}
+
 void AnnularFieldSim::populate_lookup()
 {
   // with 'f' being the position the field is being measured at, and 'o' being the position of the charge generating the field.
@@ -1387,6 +1637,10 @@ void AnnularFieldSim::populate_lookup()
   {
     std::cout << "Populating lookup:  lookupCase==NoLookup ===> skipping!" << std::endl;
   }
+  else if (lookupCase == Spectral)
+  {
+    std::cout << "Populating lookup:  lookupCase==Spectral ===> skipping!" << std::endl;
+  }
   else
   {
     exit(1);
@@ -3001,6 +3255,63 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
   unsigned long long waypoint = percent * debug_npercent;
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
 
+  // drift all electrons first, in parallel over the start positions.
+  // the start positions are built exactly as in the fill loop below, which picks up the results in the same order
+  std::vector<DriftJob> jobs;
+  jobs.reserve(totalelements);
+  inpart.SetXYZ(1, 0, 0);
+  for (ir = 0; ir < nrh; ir++)
+  {
+    partR = (ir + 0.5) * deltar + rih;
+    if (ir == 0)
+    {
+      inpart.SetPerp(partR + deltar);
+    }
+    else if (ir == nrh - 1)
+    {
+      inpart.SetPerp(partR - deltar);
+    }
+    else
+    {
+      inpart.SetPerp(partR);
+    }
+    for (ip = 0; ip < nph; ip++)
+    {
+      partP = (ip + 0.5) * deltap + pih;
+      inpart.SetPhi(partP);
+      for (iz = 0; iz < nzh; iz++)
+      {
+        partZ = (iz) *deltaz + zih;
+        if (iz == 0)
+        {
+          inpart.SetZ(partZ + deltaz);
+        }
+        else if (iz == nzh - 1)
+        {
+          inpart.SetZ(partZ - deltaz);
+        }
+        else
+        {
+          inpart.SetZ(partZ);
+        }
+        DriftJob job;
+        job.sim = this;
+        job.zdest = z_readout;
+        job.start = inpart;
+        jobs.push_back(job);
+        if (hasTwin)
+        {
+          job.sim = twin;
+          job.zdest = -z_readout;
+          job.start.SetZ(-1 * inpart.Z());
+          jobs.push_back(job);
+        }
+      }
+    }
+  }
+  DriftAll(jobs, nSteps);
+  unsigned long ijob = 0;
+
   int el = 0;
 
   // we want to loop over the entire region to be mapped, but we also need to include
@@ -3052,7 +3363,6 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
           if (localside == 0)
           {
             diffdistort = zero_vector;  // GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
           }
           else
           {
@@ -3061,8 +3371,12 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
             partZ *= -1;                   // position to place in histogram
             inpart.SetZ(-1 * inpart.Z());  // position to seek in sim
             diffdistort = zero_vector;     // twin->GetTotalDistortion(inpart.Z() - deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = twin->GetTotalDistortion(-z_readout, inpart, nSteps, true, &validToStep, &successCheck);
           }
+          // GetTotalDistortion(z_readout, inpart) on this side, or on the twin with flipped z
+          distort = jobs[ijob].distortion;
+          validToStep = jobs[ijob].goodToStep;
+          successCheck = jobs[ijob].success;
+          ijob++;
 
           diffdistort.RotateZ(-inpart.Phi());  // rotate so that distortion components are wrt the x axis
           diffdistP = diffdistort.Y();         // the phi component is now the y component.
@@ -3398,7 +3712,6 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
   int nph = nphi * p_subsamples + 2;  // nuber of phibins in the histogram
   int nrh = nr * r_subsamples + 2;    // number of r bins in the histogram
   int nzh = nz * z_subsamples + 2;    // number of z you get the idea.
-  int successCheck;
 
   if (hasTwin && makeUnifiedMap)
   {  // double the z range if we have a twin.  r and phi are the same, unless we had a phi roi...
@@ -3507,7 +3820,6 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
 
   TVector3 inpart, outpart;
   TVector3 distort;
-  int validToStep;
 
   // TTree version:
   float partR, partP, partZ;
@@ -3533,6 +3845,80 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
 
+  // drift all electrons first, in parallel over the start positions, two drifts per position.
+  // the start positions are built exactly as in the fill loop below, which picks up the results in the same order
+  std::vector<DriftJob> jobs;
+  jobs.reserve(2 * totalelements);
+  inpart.SetXYZ(1, 0, 0);
+  for (ir = 0; ir < nrh; ir++)
+  {
+    partR = (ir + 0.5) * deltar + rih;
+    if (ir == 0)
+    {
+      inpart.SetPerp(partR + deltar);
+    }
+    else if (ir == nrh - 1)
+    {
+      inpart.SetPerp(partR - deltar);
+    }
+    else
+    {
+      inpart.SetPerp(partR);
+    }
+    for (ip = 0; ip < nph; ip++)
+    {
+      partP = (ip + 0.5) * deltap + pih;
+      inpart.SetPhi(partP);
+      for (iz = 0; iz < nzh; iz++)
+      {
+        partZ = (iz) *deltaz + zih;
+        if (iz == 0)
+        {
+          inpart.SetZ(partZ + deltaz);
+        }
+        else if (iz == nzh - 1)
+        {
+          inpart.SetZ(partZ - deltaz);
+        }
+        else
+        {
+          inpart.SetZ(partZ);
+        }
+        DriftJob job;
+        // differential distortion
+        if (hasTwin && inpart.Z() < 0)
+        {
+          job.sim = twin;
+          job.zdest = inpart.Z();
+          job.start = inpart + stepzvec;
+        }
+        else
+        {
+          job.sim = this;
+          job.zdest = inpart.Z() + deltaz;
+          job.start = inpart;
+        }
+        jobs.push_back(job);
+        // integral distortion
+        if (hasTwin && makeUnifiedMap && inpart.Z() < 0)
+        {
+          job.sim = twin;
+          job.zdest = -z_readout;
+          job.start = inpart + stepzvec;
+        }
+        else
+        {
+          job.sim = this;
+          job.zdest = z_readout;
+          job.start = inpart;
+        }
+        jobs.push_back(job);
+      }
+    }
+  }
+  DriftAll(jobs, nSteps);
+  unsigned long ijob = 0;
+
   int el = 0;
 
   // we want to loop over the entire region to be mapped, but we also need to include
@@ -3584,14 +3970,9 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
 
         // differential distortion:
         // be careful with the math of a distortion.  The R distortion is NOT the perp() component of outpart-inpart -- that's the transverse magnitude of the distortion!
-        if (hasTwin && inpart.Z() < 0)
-        {
-          distort = twin->GetTotalDistortion(inpart.Z(), inpart + stepzvec, nSteps, true, &validToStep, &successCheck);  // step across the cell in the opposite direction, starting at the high side and going to the low side..
-        }
-        else
-        {
-          distort = GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-        }
+        // if the start is in the twin, step across the cell in the opposite direction, starting at the high side and going to the low side..
+        distort = jobs[ijob].distortion;
+        ijob++;
         distort.RotateZ(-inpart.Phi());  // rotate so that that is on the x axis
         diffdistP = distort.Y();         // the phi component is now the y component.
         diffdistR = distort.X();         // and the r component is the x component
@@ -3602,14 +3983,8 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
         dTree->Fill();
 
         // integral distortion:
-        if (hasTwin && makeUnifiedMap && inpart.Z() < 0)
-        {
-          distort = twin->GetTotalDistortion(-z_readout, inpart + stepzvec, nSteps, true, &validToStep, &successCheck);
-        }
-        else
-        {
-          distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
-        }
+        distort = jobs[ijob].distortion;
+        ijob++;
         distortX = distort.X();
         distortY = distort.Y();
         distort.RotateZ(-inpart.Phi());  // rotate so that that is on the x axis
@@ -3871,6 +4246,17 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
   return;
 }
 
+void AnnularFieldSim::DriftAll(std::vector<DriftJob> &jobs, int nSteps)
+{
+  // GetTotalDistortion only reads the field maps, except for filling the optional r-deltaR histogram
+  bool fillsHistogram = RdeltaRswitch || (hasTwin && twin->RdeltaRswitch);
+  parallel_for(static_cast<int>(jobs.size()), fillsHistogram ? 1 : m_nthreads, [&jobs, nSteps](int i)
+               {
+    DriftJob &job = jobs[i];
+    job.distortion = job.sim->GetTotalDistortion(job.zdest, job.start, nSteps, true, &job.goodToStep, &job.success); });
+  return;
+}
+
 TVector3 AnnularFieldSim::swimTo(float zdest, const TVector3 &start, bool interpolate, bool useAnalytic)
 {
   int defaultsteps = 100;
@@ -4052,6 +4438,11 @@ const std::string AnnularFieldSim::GetLookupString()
     return boost::str(boost::format("PhiSlice (%d x %d x %d) with (%d x 1 x %d) roi") % nr % nphi % nz % nr_roi % nz_roi);
   }
 
+  if (lookupCase == LookupCase::Spectral)
+  {
+    return boost::str(boost::format("Spectral (%d x %d x %d) with (%d x %d x %d) roi") % nr % nphi % nz % nr_roi % nphi_roi % nz_roi);
+  }
+
   return "broken";
 }
 const std::string AnnularFieldSim::GetGasString()
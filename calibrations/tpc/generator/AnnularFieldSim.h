@@ -4,6 +4,7 @@
 
 #include <cmath>   // for NAN, abs
 #include <string>  // for string
+#include <vector>
 
 class AnalyticFieldModel;
 class ChargeMapReader;
@@ -30,7 +31,8 @@ class AnnularFieldSim
     HybridRes,
     PhiSlice,
     Analytic,
-    NoLookup
+    NoLookup,
+    Spectral
   };
   // Full3D = uses (nr x nphi x nz)^2 lookup table
   // Hybrid = uses (nr x nphi x nz) x (nr_local x nphi_local x nz_local) + (nr_low x nphi_low x nz_low)^2 set of tables
@@ -38,6 +40,7 @@ class AnnularFieldSim
   // Analytic = doesn't use lookup tables -- no memory footprint, uses analytic E field at center of each bin.
   //     Note that this is not the same as analytic propagation, which checks the analytic field integrals in each step.
   // NoLookup = Don't build any structures -- effectively ignores any calculated spacecharge field
+  // Spectral = no lookup table, solves the poisson equation for the whole (nr x nphi x nz) grid in populate_fieldmap, with the r and z walls grounded as in the Rossegger greens functions.
   enum ChargeCase
   {
     FromFile,
@@ -93,6 +96,13 @@ class AnnularFieldSim
     truncation_length = x;
     return;
   }
+  //! threads used by the spectral solver and to drift the start positions of the distortion maps. 0 uses all available cores, 1 (default) runs sequentially.
+  //! the results do not depend on the number of threads
+  void SetNumThreads(unsigned int n)
+  {
+    m_nthreads = n;
+    return;
+  }
 
   // getters for internal states:
   const std::string GetLookupString();
@@ -188,6 +198,7 @@ class AnnularFieldSim
   TVector3 GetWeightedCellCenter(int r, int phi, int z);
   TVector3 fieldIntegral(float zdest, const TVector3 &start, MultiArray<TVector3> *field);
   void populate_fieldmap();
+  void populate_spectral_fieldmap();
   // now handled by setting 'analytic' lookup:  void populate_analytic_fieldmap();
   void populate_lookup();
   void populate_full3d_lookup();
@@ -215,6 +226,18 @@ class AnnularFieldSim
   TVector3 GetTotalDistortion(float zdest, const TVector3 &start, int nsteps, bool interpolate = true, int *goodToStep = 0, int *success = 0);
 
  private:
+  // one electron to drift for the distortion maps
+  struct DriftJob
+  {
+    AnnularFieldSim *sim = nullptr;
+    float zdest = 0;
+    TVector3 start;
+    TVector3 distortion;
+    int goodToStep = 0;
+    int success = 0;
+  };
+  void DriftAll(std::vector<DriftJob> &jobs, int nSteps);
+
   BoundsCase GetRindexAndCheckBounds(float pos, int *r);
   BoundsCase GetPhiIndexAndCheckBounds(float pos, int *phi);
   BoundsCase GetZindexAndCheckBounds(float pos, int *z);
@@ -345,4 +368,6 @@ class AnnularFieldSim
   MultiArray<double> *q_local;   // temporary holder of space charge in each f-bin and summed bin of the high-res region.
   MultiArray<double> *q_lowres;  // space charge in each l-bin. = sums over sets of f-bins.
   TH2 *hRdeltaRComponent{nullptr};
+
+  unsigned int m_nthreads = 1;
 };
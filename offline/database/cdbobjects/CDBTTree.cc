@@ -20,6 +20,40 @@
 #include <set>      // for set
 #include <utility>  // for pair, make_pair
 
+namespace
+{
+  // look up one field for a list of channels, each channel map is searched once
+  template <class T>
+  std::vector<T> fill_column(const std::map<int, std::map<std::string, T>> &entrymap, const std::vector<int> &channels, const std::string &fieldname, const std::string &name, const T missing, int verbose)
+  {
+    std::vector<T> column(channels.size(), missing);
+    for (size_t i = 0; i < channels.size(); ++i)
+    {
+      auto channelmapiter = entrymap.find(channels[i]);
+      if (channelmapiter == entrymap.end())
+      {
+        if (verbose > 0)
+        {
+          std::cout << PHWHERE << " Could not find channel " << channels[i]
+                    << " for " << name << std::endl;
+        }
+        continue;
+      }
+      auto calibiter = channelmapiter->second.find(fieldname);
+      if (calibiter == channelmapiter->second.end())
+      {
+        if (verbose > 0)
+        {
+          std::cout << "Could not find " << name << " for channel " << channels[i] << std::endl;
+        }
+        continue;
+      }
+      column[i] = calibiter->second;
+    }
+    return column;
+  }
+}  // namespace
+
 CDBTTree::CDBTTree(const std::string &fname)
   : m_Filename(fname)
 {
@@ -873,3 +907,39 @@ uint64_t CDBTTree::GetUInt64Value(int channel, const std::string &name, int verb
   }
   return calibiter->second;
 }
+
+std::vector<float> CDBTTree::GetFloatColumn(const std::vector<int> &channels, const std::string &name, int verbose)
+{
+  if (m_FloatEntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  return fill_column(m_FloatEntryMap, channels, "F" + name, name, std::numeric_limits<float>::quiet_NaN(), verbose);
+}
+
+std::vector<double> CDBTTree::GetDoubleColumn(const std::vector<int> &channels, const std::string &name, int verbose)
+{
+  if (m_DoubleEntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  return fill_column(m_DoubleEntryMap, channels, "D" + name, name, std::numeric_limits<double>::quiet_NaN(), verbose);
+}
+
+std::vector<int> CDBTTree::GetIntColumn(const std::vector<int> &channels, const std::string &name, int verbose)
+{
+  if (m_IntEntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  return fill_column(m_IntEntryMap, channels, "I" + name, name, std::numeric_limits<int>::min(), verbose);
+}
+
+std::vector<uint64_t> CDBTTree::GetUInt64Column(const std::vector<int> &channels, const std::string &name, int verbose)
+{
+  if (m_UInt64EntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  return fill_column(m_UInt64EntryMap, channels, "g" + name, name, std::numeric_limits<uint64_t>::max(), verbose);
+}
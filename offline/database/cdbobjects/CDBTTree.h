@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 class TTree;
 
@@ -38,6 +39,14 @@ class CDBTTree
   uint64_t GetSingleUInt64Value(const std::string &name, int verbose = 1);
   uint64_t GetUInt64Value(int channel, const std::string &name, int verbose = 1);
 
+  //! dense copies of one field, entry i holds the value of channel channels[i]
+  //! (e.g. the tower keys of all channels of a TowerInfoContainer).
+  //! Missing entries are set to the same values the Get...Value methods return
+  std::vector<float> GetFloatColumn(const std::vector<int> &channels, const std::string &name, int verbose = 1);
+  std::vector<double> GetDoubleColumn(const std::vector<int> &channels, const std::string &name, int verbose = 1);
+  std::vector<int> GetIntColumn(const std::vector<int> &channels, const std::string &name, int verbose = 1);
+  std::vector<uint64_t> GetUInt64Column(const std::vector<int> &channels, const std::string &name, int verbose = 1);
+
  private:
   enum
   {
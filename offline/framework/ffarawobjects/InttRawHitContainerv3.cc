@@ -0,0 +1,49 @@
+#include "InttRawHitContainerv3.h"
+
+static const int NINTTHITS = 100;
+
+InttRawHitContainerv3::InttRawHitContainerv3()
+{
+  m_hits.reserve(NINTTHITS);
+}
+
+void InttRawHitContainerv3::Reset()
+{
+  // keep the capacity for the next event
+  m_hits.clear();
+}
+
+void InttRawHitContainerv3::identify(std::ostream &os) const
+{
+  os << "InttRawHitContainerv3" << std::endl;
+  os << "containing " << m_hits.size() << " Intt hits" << std::endl;
+  if (!m_hits.empty())
+  {
+    os << "for beam clock: " << std::hex << m_hits.front().get_bco() << std::dec << std::endl;
+  }
+}
+
+int InttRawHitContainerv3::isValid() const
+{
+  return m_hits.capacity();
+}
+
+unsigned int InttRawHitContainerv3::get_nhits()
+{
+  return m_hits.size();
+}
+
+InttRawHit *InttRawHitContainerv3::AddHit()
+{
+  return &m_hits.emplace_back();
+}
+
+InttRawHit *InttRawHitContainerv3::AddHit(InttRawHit *intthit)
+{
+  return &m_hits.emplace_back(intthit);
+}
+
+InttRawHit *InttRawHitContainerv3::get_hit(unsigned int index)
+{
+  return index < m_hits.size() ? &m_hits[index] : nullptr;
+}
@@ -0,0 +1,46 @@
+#ifndef FUN4ALLRAW_INTTRAWHITCONTAINERV3_H
+#define FUN4ALLRAW_INTTRAWHITCONTAINERV3_H
+
+#include "InttRawHitContainer.h"
+#include "InttRawHitv2.h"
+
+#include <vector>
+
+class InttRawHit;
+
+/*!
+ * intt raw hit container storing its hits by value in a vector.
+ * Reset keeps the capacity, so filling it does not allocate once it has
+ * grown to the typical event size.
+ *
+ * Pointers returned by AddHit and get_hit are invalidated by the next AddHit
+ */
+class InttRawHitContainerv3 : public InttRawHitContainer
+{
+ public:
+  InttRawHitContainerv3();
+  ~InttRawHitContainerv3() override = default;
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override;
+
+  InttRawHit *AddHit() override;
+  InttRawHit *AddHit(InttRawHit *intthit) override;
+  unsigned int get_nhits() override;
+  InttRawHit *get_hit(unsigned int index) override;
+
+ private:
+  std::vector<InttRawHitv2> m_hits;
+
+  ClassDefOverride(InttRawHitContainerv3, 1)
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "MicromegasRawHitContainerv3.h"
 #include "MicromegasRawHitv3.h"
+#include "MicromegasRawHitv4.h"
 
 #include <TClonesArray.h>
 
@@ -59,6 +60,22 @@ MicromegasRawHit *MicromegasRawHitContainerv3::AddHit(MicromegasRawHit *rawhit)
     return new ((*MicromegasRawHitsTCArray)[MicromegasRawHitsTCArray->GetLast() + 1])
         MicromegasRawHitv3(std::move(*static_cast<MicromegasRawHitv3*>(rawhit)));
   }
+  else if (rawhit->IsA()==MicromegasRawHitv4::Class())
+  {
+    // hit in the arena of a MicromegasRawHitContainerv4, e.g. from the pool inputs, one vector per waveform
+    const auto arenahit = static_cast<MicromegasRawHitv4*>(rawhit);
+    auto newhit = new ((*MicromegasRawHitsTCArray)[MicromegasRawHitsTCArray->GetLast() + 1]) MicromegasRawHitv3();
+    newhit->set_bco(arenahit->get_bco());
+    newhit->set_packetid(arenahit->get_packetid());
+    newhit->set_fee(arenahit->get_fee());
+    newhit->set_channel(arenahit->get_channel());
+    for (uint32_t iwf = 0; iwf < arenahit->get_nwaveforms(); ++iwf)
+    {
+      const uint16_t* adc = arenahit->get_waveform_adc(iwf);
+      newhit->move_adc_waveform(arenahit->get_waveform_start(iwf), MicromegasRawHitv3::adc_list_t(adc, adc + arenahit->get_waveform_size(iwf)));
+    }
+    return newhit;
+  }
   else
   {
     // slow
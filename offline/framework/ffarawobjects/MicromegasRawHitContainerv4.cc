@@ -0,0 +1,130 @@
+#include "MicromegasRawHitContainerv4.h"
+#include "MicromegasRawHitv3.h"
+
+#include <iostream>
+
+static constexpr int NHITS = 100;
+
+MicromegasRawHitContainerv4::MicromegasRawHitContainerv4()
+  : MicromegasRawHitContainerv4(NHITS)
+{
+}
+
+MicromegasRawHitContainerv4::MicromegasRawHitContainerv4(unsigned int nhits)
+{
+  m_hits.reserve(nhits);
+}
+
+void MicromegasRawHitContainerv4::Reset()
+{
+  // keep the capacity for the next event
+  m_hits.clear();
+  m_waveform_start.clear();
+  m_waveform_offset.resize(1);
+  m_adc.clear();
+}
+
+void MicromegasRawHitContainerv4::identify(std::ostream &os) const
+{
+  os << "MicromegasRawHitContainerv4" << std::endl;
+  os << "containing " << m_hits.size() << " Micromegas hits" << std::endl;
+  if (!m_hits.empty())
+  {
+    os << "for beam clock: " << std::hex << m_hits.front().get_bco() << std::dec << std::endl;
+  }
+}
+
+int MicromegasRawHitContainerv4::isValid() const
+{
+  return m_hits.capacity();
+}
+
+unsigned int MicromegasRawHitContainerv4::get_nhits()
+{
+  return m_hits.size();
+}
+
+MicromegasRawHit *MicromegasRawHitContainerv4::AddHit()
+{
+  auto &newhit = m_hits.emplace_back();
+  newhit.first_waveform = m_waveform_start.size();
+  newhit.m_container = this;
+  return &newhit;
+}
+
+MicromegasRawHit *MicromegasRawHitContainerv4::AddHit(MicromegasRawHit *rawhit)
+{
+  auto newhit = static_cast<MicromegasRawHitv4 *>(AddHit());
+  newhit->bco = rawhit->get_bco();
+  newhit->packetid = rawhit->get_packetid();
+  newhit->fee = rawhit->get_fee();
+  newhit->channel = rawhit->get_channel();
+
+  if (rawhit->IsA() == MicromegasRawHitv3::Class())
+  {
+    // fast add, waveforms are copied to the arena in one go
+    for (const auto &waveform : static_cast<MicromegasRawHitv3 *>(rawhit)->get_adc_waveforms())
+    {
+      add_adc_waveform(waveform.first, waveform.second.data(), waveform.second.size());
+    }
+    return newhit;
+  }
+
+  if (rawhit->IsA() == MicromegasRawHitv4::Class())
+  {
+    // hit in the arena of another container, e.g. from the micromegas pool inputs
+    const auto arenahit = static_cast<MicromegasRawHitv4 *>(rawhit);
+    for (uint32_t iwf = 0; iwf < arenahit->get_nwaveforms(); ++iwf)
+    {
+      add_adc_waveform(arenahit->get_waveform_start(iwf), arenahit->get_waveform_adc(iwf), arenahit->get_waveform_size(iwf));
+    }
+    return newhit;
+  }
+
+  // any other version, a single waveform from sample begin to sample end
+  const uint16_t sample_begin = rawhit->get_sample_begin();
+  const uint16_t sample_end = rawhit->get_sample_end();
+  if (sample_end > sample_begin)
+  {
+    m_waveform_start.push_back(sample_begin);
+    for (uint16_t sample = sample_begin; sample < sample_end; ++sample)
+    {
+      m_adc.push_back(rawhit->get_adc(sample));
+    }
+    m_waveform_offset.push_back(m_adc.size());
+    ++newhit->nwaveforms;
+  }
+  return newhit;
+}
+
+MicromegasRawHit *MicromegasRawHitContainerv4::get_hit(unsigned int index)
+{
+  if (index >= m_hits.size())
+  {
+    return nullptr;
+  }
+
+  // hits read back from file do not know their container yet
+  auto &hit = m_hits[index];
+  hit.m_container = this;
+  return &hit;
+}
+
+void MicromegasRawHitContainerv4::add_adc_waveform(uint16_t start_time, const uint16_t *adc, uint32_t size)
+{
+  if (m_hits.empty())
+  {
+    std::cout << __PRETTY_FUNCTION__ << " - no hit to add the waveform to" << std::endl;
+    return;
+  }
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  m_waveform_start.push_back(start_time);
+  m_adc.insert(m_adc.end(), adc, adc + size);
+  m_waveform_offset.push_back(m_adc.size());
+  ++m_hits.back().nwaveforms;
+}
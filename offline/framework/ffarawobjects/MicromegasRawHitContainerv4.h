@@ -0,0 +1,84 @@
+#ifndef FUN4ALLRAW_MICROMEGASRAWHITCONTAINERv4_H
+#define FUN4ALLRAW_MICROMEGASRAWHITCONTAINERv4_H
+
+#include "MicromegasRawHitContainer.h"
+#include "MicromegasRawHitv4.h"
+
+#include <cstdint>
+#include <vector>
+
+class MicromegasRawHit;
+
+/*!
+ * micromegas raw hit container with contiguous storage.
+ * Hits are kept by value and the adc samples of all their waveforms are
+ * appended to a single per event arena, which Reset clears without releasing
+ * the memory. Same layout as TpcRawHitContainerv4.
+ *
+ * Pointers returned by AddHit and get_hit are invalidated by the next AddHit
+ * once the container is full, see is_full
+ */
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+class MicromegasRawHitContainerv4 : public MicromegasRawHitContainer
+{
+ public:
+
+  /// constructor
+  explicit MicromegasRawHitContainerv4();
+
+  /// constructor, reserving room for nhits hits
+  explicit MicromegasRawHitContainerv4(unsigned int nhits);
+
+  /// destructor
+  ~MicromegasRawHitContainerv4() override = default;
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override;
+
+  //! new hit without waveforms
+  MicromegasRawHit *AddHit() override;
+
+  //! copy hit and its waveforms to the arena
+  MicromegasRawHit *AddHit(MicromegasRawHit*) override;
+
+  unsigned int get_nhits() override;
+  MicromegasRawHit *get_hit(unsigned int) override;
+
+  //! append a waveform to the last added hit
+  void add_adc_waveform(uint16_t start_time, const uint16_t *adc, uint32_t size);
+
+  //! true if the next AddHit has to move the hits already added
+  bool is_full() const { return m_hits.size() >= m_hits.capacity(); }
+
+  //! waveform access, used by MicromegasRawHitv4
+  uint16_t get_waveform_start(uint32_t iwf) const { return m_waveform_start[iwf]; }
+  uint32_t get_waveform_offset(uint32_t iwf) const { return m_waveform_offset[iwf]; }
+  uint32_t get_waveform_size(uint32_t iwf) const { return m_waveform_offset[iwf + 1] - m_waveform_offset[iwf]; }
+  uint16_t get_arena_adc(uint32_t index) const { return m_adc[index]; }
+  const uint16_t *get_arena_data(uint32_t index) const { return m_adc.data() + index; }
+
+ private:
+  //! hits
+  std::vector<MicromegasRawHitv4> m_hits;
+
+  //! start sample of each waveform
+  std::vector<uint16_t> m_waveform_start;
+
+  //! position of each waveform's first sample in m_adc, followed by the total number of samples
+  std::vector<uint32_t> m_waveform_offset{0};
+
+  //! adc samples of all waveforms
+  std::vector<uint16_t> m_adc;
+
+  ClassDefOverride(MicromegasRawHitContainerv4, 1)
+};
+
+#endif
@@ -1,5 +1,5 @@
-#ifndef FUN4ALLRAW_TPCRAWTHITv3_H
-#define FUN4ALLRAW_TPCRAWTHITv3_H
+#ifndef FUN4ALLRAW_MICROMEGASRAWHITv3_H
+#define FUN4ALLRAW_MICROMEGASRAWHITv3_H
 
 #include "MicromegasRawHit.h"
 
@@ -63,6 +63,11 @@ class MicromegasRawHitv3 : public MicromegasRawHit
   // set adc values
   void move_adc_waveform(const uint16_t start_time, adc_list_t &&adc);
 
+  //! list of waveforms
+  /** each pair contains the start sample of the waveform and the constituting adc values */
+  using waveform_pair_t = std::pair<uint16_t,adc_list_t>;
+  const std::vector<waveform_pair_t>& get_adc_waveforms() const { return m_adcData; }
+
  private:
   uint64_t bco{std::numeric_limits<uint64_t>::max()};
   int32_t packetid{std::numeric_limits<int32_t>::max()};
@@ -76,8 +81,6 @@ class MicromegasRawHitv3 : public MicromegasRawHit
   bool parityerror{true};
 
   //! list of waveforms
-  /** each pair contains the start sample of the waveform and the constituting adc values */
-  using waveform_pair_t = std::pair<uint16_t,adc_list_t>;
   std::vector<waveform_pair_t> m_adcData;
 
   ClassDefOverride(MicromegasRawHitv3, 1)
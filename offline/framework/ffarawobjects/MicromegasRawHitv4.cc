@@ -0,0 +1,59 @@
+#include "MicromegasRawHitv4.h"
+#include "MicromegasRawHitContainerv4.h"
+
+#include <iostream>
+
+void MicromegasRawHitv4::identify(std::ostream &os) const
+{
+  os << "BCO: 0x" << std::hex << bco << std::dec << std::endl;
+  os << "packet id: " << packetid << std::endl;
+}
+
+uint16_t MicromegasRawHitv4::get_sample_begin() const
+{
+  return (m_container && nwaveforms > 0) ? m_container->get_waveform_start(first_waveform) : 0;
+}
+
+uint16_t MicromegasRawHitv4::get_sample_end() const
+{
+  if (!m_container || nwaveforms == 0)
+  {
+    return 0;
+  }
+
+  const uint32_t last = first_waveform + nwaveforms - 1;
+  return m_container->get_waveform_start(last) + m_container->get_waveform_size(last);
+}
+
+uint16_t MicromegasRawHitv4::get_adc(const uint16_t sample) const
+{
+  if (!m_container)
+  {
+    return 0;
+  }
+
+  for (uint32_t iwf = first_waveform; iwf < first_waveform + nwaveforms; ++iwf)
+  {
+    const uint16_t start = m_container->get_waveform_start(iwf);
+    if (sample >= start && static_cast<uint32_t>(sample - start) < m_container->get_waveform_size(iwf))
+    {
+      return m_container->get_arena_adc(m_container->get_waveform_offset(iwf) + sample - start);
+    }
+  }
+  return 0;
+}
+
+uint16_t MicromegasRawHitv4::get_waveform_start(uint32_t iwf) const
+{
+  return m_container->get_waveform_start(first_waveform + iwf);
+}
+
+uint32_t MicromegasRawHitv4::get_waveform_size(uint32_t iwf) const
+{
+  return m_container->get_waveform_size(first_waveform + iwf);
+}
+
+const uint16_t *MicromegasRawHitv4::get_waveform_adc(uint32_t iwf) const
+{
+  return m_container->get_arena_data(m_container->get_waveform_offset(first_waveform + iwf));
+}
@@ -0,0 +1,86 @@
+#ifndef FUN4ALLRAW_MICROMEGASRAWHITv4_H
+#define FUN4ALLRAW_MICROMEGASRAWHITv4_H
+
+#include "MicromegasRawHit.h"
+
+#include <phool/PHObject.h>
+
+#include <cstdint>
+#include <limits>
+
+class MicromegasRawHitContainerv4;
+
+/*!
+ * micromegas raw hit whose waveforms live in the sample arena of its MicromegasRawHitContainerv4.
+ * The hit only stores the range of its waveforms in that arena, so it is only
+ * meaningful as an element of the container and is filled by MicromegasRawHitContainerv4::AddHit
+ */
+class MicromegasRawHitv4 : public MicromegasRawHit
+{
+ public:
+  MicromegasRawHitv4() = default;
+  ~MicromegasRawHitv4() override = default;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  uint64_t get_bco() const override { return bco; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_bco(const uint64_t val) override { bco = val; }
+
+  int32_t get_packetid() const override { return packetid; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_packetid(const int32_t val) override { packetid = val; }
+
+  uint16_t get_fee() const override { return fee; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_fee(const uint16_t val) override { fee = val; }
+
+  uint16_t get_channel() const override { return channel; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_channel(const uint16_t val) override { channel = val; }
+
+  uint16_t get_sampaaddress() const override
+  { return static_cast<uint16_t>(channel >> 5U) & 0xfU; }
+
+  uint16_t get_sampachannel() const override { return channel & 0x1fU; }
+
+  // index of the first sample with data
+  uint16_t get_sample_begin() const override;
+
+  // index of the next to last sample with data
+  uint16_t get_sample_end() const override;
+
+  // get adc value
+  uint16_t get_adc(const uint16_t sample) const override;
+
+  //! waveforms of this hit in the container arena
+  uint32_t get_first_waveform() const { return first_waveform; }
+  uint32_t get_nwaveforms() const { return nwaveforms; }
+
+  //! start sample, number of samples and samples of the waveform iwf < get_nwaveforms() of this hit
+  uint16_t get_waveform_start(uint32_t iwf) const;
+  uint32_t get_waveform_size(uint32_t iwf) const;
+  const uint16_t *get_waveform_adc(uint32_t iwf) const;
+
+ private:
+  friend class MicromegasRawHitContainerv4;
+
+  uint64_t bco{std::numeric_limits<uint64_t>::max()};
+  int32_t packetid{std::numeric_limits<int32_t>::max()};
+  uint16_t fee{std::numeric_limits<uint16_t>::max()};
+  uint16_t channel{std::numeric_limits<uint16_t>::max()};
+
+  //! range of this hit's waveforms in the container
+  uint32_t first_waveform{0};
+  uint32_t nwaveforms{0};
+
+  //! owning container, set when the hit is added or accessed
+  const MicromegasRawHitContainerv4 *m_container{nullptr};  //!
+
+  ClassDefOverride(MicromegasRawHitv4, 1)
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "MvtxRawHitContainerv2.h"
+
+static const int NMVTXHITS = 100;
+
+MvtxRawHitContainerv2::MvtxRawHitContainerv2()
+{
+  m_hits.reserve(NMVTXHITS);
+}
+
+void MvtxRawHitContainerv2::Reset()
+{
+  // keep the capacity for the next event
+  m_hits.clear();
+}
+
+void MvtxRawHitContainerv2::identify(std::ostream &os) const
+{
+  os << "MvtxRawHitContainerv2" << std::endl;
+  os << "containing " << m_hits.size() << " Mvtx hits" << std::endl;
+  if (!m_hits.empty())
+  {
+    os << "for beam clock: " << std::hex << m_hits.front().get_bco() << std::dec << std::endl;
+  }
+}
+
+int MvtxRawHitContainerv2::isValid() const
+{
+  return m_hits.capacity();
+}
+
+unsigned int MvtxRawHitContainerv2::get_nhits()
+{
+  return m_hits.size();
+}
+
+MvtxRawHit *MvtxRawHitContainerv2::AddHit()
+{
+  return &m_hits.emplace_back();
+}
+
+MvtxRawHit *MvtxRawHitContainerv2::AddHit(MvtxRawHit *mvtxhit)
+{
+  return &m_hits.emplace_back(mvtxhit);
+}
+
+MvtxRawHit *MvtxRawHitContainerv2::get_hit(unsigned int index)
+{
+  return index < m_hits.size() ? &m_hits[index] : nullptr;
+}
@@ -0,0 +1,46 @@
+#ifndef FUN4ALLRAW_MVTXHITRAWCONTAINERV2_H
+#define FUN4ALLRAW_MVTXHITRAWCONTAINERV2_H
+
+#include "MvtxRawHitContainer.h"
+#include "MvtxRawHitv1.h"
+
+#include <vector>
+
+class MvtxRawHit;
+
+/*!
+ * mvtx raw hit container storing its hits by value in a vector.
+ * Reset keeps the capacity, so filling it does not allocate once it has
+ * grown to the typical event size.
+ *
+ * Pointers returned by AddHit and get_hit are invalidated by the next AddHit
+ */
+class MvtxRawHitContainerv2 : public MvtxRawHitContainer
+{
+ public:
+  MvtxRawHitContainerv2();
+  ~MvtxRawHitContainerv2() override = default;
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override;
+
+  MvtxRawHit *AddHit() override;
+  MvtxRawHit *AddHit(MvtxRawHit *mvtxhit) override;
+  unsigned int get_nhits() override;
+  MvtxRawHit *get_hit(unsigned int index) override;
+
+ private:
+  std::vector<MvtxRawHitv1> m_hits;
+
+  ClassDefOverride(MvtxRawHitContainerv2, 1)
+};
+
+#endif
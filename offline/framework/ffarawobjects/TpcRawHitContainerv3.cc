@@ -1,5 +1,6 @@
 #include "TpcRawHitContainerv3.h"
 #include "TpcRawHitv3.h"
+#include "TpcRawHitv4.h"
 
 #include <TClonesArray.h>
 
@@ -61,6 +62,25 @@ TpcRawHit *TpcRawHitContainerv3::AddHit(TpcRawHit *tpchit)
         TpcRawHitv3(std::move(*(static_cast<TpcRawHitv3 *>(tpchit))));
     return newhit;
   }
+  else if (tpchit->IsA() == TpcRawHitv4::Class())
+  {
+    // hit in the arena of a TpcRawHitContainerv4, e.g. from TpcTimeFrameBuilder, one vector per waveform
+    const TpcRawHitv4 *arenahit = static_cast<TpcRawHitv4 *>(tpchit);
+    TpcRawHitv3 *newhit = new ((*TpcRawHitsTCArray)[TpcRawHitsTCArray->GetLast() + 1]) TpcRawHitv3();
+    newhit->set_bco(arenahit->get_bco());
+    newhit->set_packetid(arenahit->get_packetid());
+    newhit->set_fee(arenahit->get_fee());
+    newhit->set_channel(arenahit->get_channel());
+    newhit->set_type(arenahit->get_type());
+    newhit->set_checksumerror(arenahit->get_checksumerror());
+    newhit->set_parityerror(arenahit->get_parityerror());
+    for (uint32_t iwf = 0; iwf < arenahit->get_nwaveforms(); ++iwf)
+    {
+      const uint16_t *adc = arenahit->get_waveform_adc(iwf);
+      newhit->move_adc_waveform(arenahit->get_waveform_start(iwf), std::vector<uint16_t>(adc, adc + arenahit->get_waveform_size(iwf)));
+    }
+    return newhit;
+  }
   else
   {
     std::cout << __PRETTY_FUNCTION__ << "WARNING: input hit is not of type TpcRawHitv3. This is slow, please avoid." << std::endl;
@@ -0,0 +1,140 @@
+#include "TpcRawHitContainerv4.h"
+#include "TpcRawHitv3.h"
+
+#include <iostream>
+#include <limits>
+#include <memory>
+
+static const int NTPCHITS = 10000;
+
+TpcRawHitContainerv4::TpcRawHitContainerv4()
+  : TpcRawHitContainerv4(NTPCHITS)
+{
+}
+
+TpcRawHitContainerv4::TpcRawHitContainerv4(unsigned int nhits)
+{
+  m_hits.reserve(nhits);
+}
+
+void TpcRawHitContainerv4::Reset()
+{
+  // keep the capacity for the next event
+  m_hits.clear();
+  m_waveform_start.clear();
+  m_waveform_offset.resize(1);
+  m_adc.clear();
+}
+
+void TpcRawHitContainerv4::identify(std::ostream &os) const
+{
+  os << "TpcRawHitContainerv4" << std::endl;
+  os << "containing " << m_hits.size() << " Tpc hits with "
+     << m_waveform_start.size() << " waveforms and " << m_adc.size() << " adc samples" << std::endl;
+  if (!m_hits.empty())
+  {
+    os << "for beam clock: " << std::hex << m_hits.front().get_bco() << std::dec << std::endl;
+  }
+}
+
+int TpcRawHitContainerv4::isValid() const
+{
+  return m_hits.capacity();
+}
+
+unsigned int TpcRawHitContainerv4::get_nhits()
+{
+  return m_hits.size();
+}
+
+TpcRawHit *TpcRawHitContainerv4::AddHit()
+{
+  TpcRawHitv4 &newhit = m_hits.emplace_back();
+  newhit.first_waveform = m_waveform_start.size();
+  newhit.m_container = this;
+  return &newhit;
+}
+
+TpcRawHit *TpcRawHitContainerv4::AddHit(TpcRawHit *tpchit)
+{
+  TpcRawHitv4 *newhit = static_cast<TpcRawHitv4 *>(AddHit());
+  newhit->bco = tpchit->get_bco();
+  newhit->packetid = tpchit->get_packetid();
+  newhit->fee = tpchit->get_fee();
+  newhit->channel = tpchit->get_channel();
+  newhit->type = tpchit->get_type();
+  newhit->samples = tpchit->get_samples();
+  newhit->checksumerror = tpchit->get_checksumerror();
+  newhit->parityerror = tpchit->get_parityerror();
+
+  if (tpchit->IsA() == TpcRawHitv3::Class())
+  {
+    // fast add, waveforms are copied to the arena in one go
+    for (const auto &waveform : static_cast<TpcRawHitv3 *>(tpchit)->get_adc_waveforms())
+    {
+      add_adc_waveform(waveform.first, waveform.second.data(), waveform.second.size());
+    }
+    return newhit;
+  }
+
+  if (tpchit->IsA() == TpcRawHitv4::Class())
+  {
+    // hit in the arena of another container, e.g. from TpcTimeFrameBuilder
+    const TpcRawHitv4 *arenahit = static_cast<TpcRawHitv4 *>(tpchit);
+    for (uint32_t iwf = 0; iwf < arenahit->get_nwaveforms(); ++iwf)
+    {
+      add_adc_waveform(arenahit->get_waveform_start(iwf), arenahit->get_waveform_adc(iwf), arenahit->get_waveform_size(iwf));
+    }
+    return newhit;
+  }
+
+  // any other version, the iterator output is split into waveforms of consecutive time bins
+  std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
+  uint32_t next_time_bin = std::numeric_limits<uint32_t>::max();
+  for (adc_iterator->First(); !adc_iterator->IsDone(); adc_iterator->Next())
+  {
+    const uint16_t time_bin = adc_iterator->CurrentTimeBin();
+    if (time_bin != next_time_bin)
+    {
+      m_waveform_start.push_back(time_bin);
+      m_waveform_offset.push_back(m_adc.size());
+      ++newhit->nwaveforms;
+    }
+    m_adc.push_back(adc_iterator->CurrentAdc());
+    m_waveform_offset.back() = m_adc.size();
+    next_time_bin = time_bin + 1U;
+  }
+  return newhit;
+}
+
+TpcRawHit *TpcRawHitContainerv4::get_hit(unsigned int index)
+{
+  if (index >= m_hits.size())
+  {
+    return nullptr;
+  }
+
+  // hits read back from file do not know their container yet
+  TpcRawHitv4 &hit = m_hits[index];
+  hit.m_container = this;
+  return &hit;
+}
+
+void TpcRawHitContainerv4::add_adc_waveform(uint16_t start_time, const uint16_t *adc, uint32_t size)
+{
+  if (m_hits.empty())
+  {
+    std::cout << __PRETTY_FUNCTION__ << " - no hit to add the waveform to" << std::endl;
+    return;
+  }
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  m_waveform_start.push_back(start_time);
+  m_adc.insert(m_adc.end(), adc, adc + size);
+  m_waveform_offset.push_back(m_adc.size());
+  ++m_hits.back().nwaveforms;
+}
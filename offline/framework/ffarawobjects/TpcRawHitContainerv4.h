@@ -0,0 +1,89 @@
+#ifndef FUN4ALLRAW_TPCHITRAWCONTAINERv4_H
+#define FUN4ALLRAW_TPCHITRAWCONTAINERv4_H
+
+#include "TpcRawHitContainer.h"
+#include "TpcRawHitv4.h"
+
+#include <cstdint>
+#include <vector>
+
+class TpcRawHit;
+
+/*!
+ * tpc raw hit container with contiguous storage.
+ * Hits are kept by value and the adc samples of all their waveforms are
+ * appended to a single per event arena. Reset clears the vectors but keeps
+ * their capacity, so after the first few events filling the container does
+ * not allocate, and reading it back from a DST creates a handful of vectors
+ * instead of one object and one vector per waveform for every hit.
+ *
+ * Pointers returned by AddHit and get_hit are invalidated by the next AddHit
+ * once the container is full, see is_full
+ */
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+class TpcRawHitContainerv4 : public TpcRawHitContainer
+{
+ public:
+  TpcRawHitContainerv4();
+
+  //! reserve room for nhits hits
+  explicit TpcRawHitContainerv4(unsigned int nhits);
+  ~TpcRawHitContainerv4() override = default;
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override;
+
+  //! new hit without waveforms
+  TpcRawHit *AddHit() override;
+
+  //! copy hit and its waveforms to the arena
+  TpcRawHit *AddHit(TpcRawHit *tpchit) override;
+
+  unsigned int get_nhits() override;
+  TpcRawHit *get_hit(unsigned int index) override;
+  void setStatus(const unsigned int i) override { status = i; }
+  unsigned int getStatus() const override { return status; }
+  void setBco(const uint64_t i) override { bco = i; }
+  uint64_t getBco() const override { return bco; }
+
+  //! append a waveform to the last added hit
+  void add_adc_waveform(uint16_t start_time, const uint16_t *adc, uint32_t size);
+
+  //! true if the next AddHit has to move the hits already added
+  bool is_full() const { return m_hits.size() >= m_hits.capacity(); }
+
+  //! waveform access, used by TpcRawHitv4
+  uint16_t get_waveform_start(uint32_t iwf) const { return m_waveform_start[iwf]; }
+  uint32_t get_waveform_offset(uint32_t iwf) const { return m_waveform_offset[iwf]; }
+  uint32_t get_waveform_size(uint32_t iwf) const { return m_waveform_offset[iwf + 1] - m_waveform_offset[iwf]; }
+  uint16_t get_arena_adc(uint32_t index) const { return m_adc[index]; }
+  const uint16_t *get_arena_data(uint32_t index) const { return m_adc.data() + index; }
+
+ private:
+  //! hits
+  std::vector<TpcRawHitv4> m_hits;
+
+  //! start time bin of each waveform
+  std::vector<uint16_t> m_waveform_start;
+
+  //! position of each waveform's first sample in m_adc, followed by the total number of samples
+  std::vector<uint32_t> m_waveform_offset{0};
+
+  //! adc samples of all waveforms
+  std::vector<uint16_t> m_adc;
+
+  uint64_t bco{0};
+  unsigned int status{0};
+
+  ClassDefOverride(TpcRawHitContainerv4, 1)
+};
+
+#endif
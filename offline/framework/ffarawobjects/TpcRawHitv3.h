@@ -75,6 +75,9 @@ class TpcRawHitv3 : public TpcRawHit
   //   }
   void move_adc_waveform(const uint16_t start_time, std::vector<uint16_t> &&adc);
 
+  //! waveforms, as start time and adc values
+  const std::vector<std::pair<uint16_t, std::vector<uint16_t> > > &get_adc_waveforms() const { return m_adcData; }
+
   uint16_t get_type() const override { return type; }
   void set_type(const uint16_t i) override { type = i; }
 
@@ -0,0 +1,117 @@
+#include "TpcRawHitv4.h"
+#include "TpcRawHitContainerv4.h"
+
+#include <iostream>
+
+void TpcRawHitv4::identify(std::ostream &os) const
+{
+  os << "BCO: 0x" << std::hex << bco << std::dec << std::endl;
+  os << " packet id: " << packetid << std::endl;
+
+  if (!m_container)
+  {
+    return;
+  }
+
+  for (uint32_t iwf = first_waveform; iwf < first_waveform + nwaveforms; ++iwf)
+  {
+    os << " start time: " << m_container->get_waveform_start(iwf) << " | ADCs: ";
+    const uint32_t offset = m_container->get_waveform_offset(iwf);
+    const uint32_t size = m_container->get_waveform_size(iwf);
+    for (uint32_t i = offset; i < offset + size; ++i)
+    {
+      os << m_container->get_arena_adc(i) << " ";
+    }
+    os << std::endl;
+  }
+}
+
+uint16_t TpcRawHitv4::get_adc(const uint16_t sample) const
+{
+  if (!m_container)
+  {
+    return 0;
+  }
+
+  for (uint32_t iwf = first_waveform; iwf < first_waveform + nwaveforms; ++iwf)
+  {
+    const uint16_t start = m_container->get_waveform_start(iwf);
+    if (sample >= start && static_cast<uint32_t>(sample - start) < m_container->get_waveform_size(iwf))
+    {
+      return m_container->get_arena_adc(m_container->get_waveform_offset(iwf) + sample - start);
+    }
+  }
+  return 0;
+}
+
+uint16_t TpcRawHitv4::get_waveform_start(uint32_t iwf) const
+{
+  return m_container->get_waveform_start(first_waveform + iwf);
+}
+
+uint32_t TpcRawHitv4::get_waveform_size(uint32_t iwf) const
+{
+  return m_container->get_waveform_size(first_waveform + iwf);
+}
+
+const uint16_t *TpcRawHitv4::get_waveform_adc(uint32_t iwf) const
+{
+  return m_container->get_arena_data(m_container->get_waveform_offset(first_waveform + iwf));
+}
+
+TpcRawHitv4::AdcIteratorv4::AdcIteratorv4(const TpcRawHitv4 &hit)
+  : m_container(hit.m_container)
+  , m_waveform_first(hit.first_waveform)
+  , m_waveform_end(hit.m_container ? hit.first_waveform + hit.nwaveforms : hit.first_waveform)
+{
+  First();
+}
+
+void TpcRawHitv4::AdcIteratorv4::SetWaveform()
+{
+  for (; m_waveform_index < m_waveform_end; ++m_waveform_index)
+  {
+    const uint32_t size = m_container->get_waveform_size(m_waveform_index);
+    if (size > 0)
+    {
+      m_adc_index = m_container->get_waveform_offset(m_waveform_index);
+      m_adc_end = m_adc_index + size;
+      m_time_bin = m_container->get_waveform_start(m_waveform_index);
+      return;
+    }
+  }
+}
+
+void TpcRawHitv4::AdcIteratorv4::First()
+{
+  m_waveform_index = m_waveform_first;
+  SetWaveform();
+}
+
+void TpcRawHitv4::AdcIteratorv4::Next()
+{
+  if (IsDone())
+  {
+    return;
+  }
+
+  if (++m_adc_index < m_adc_end)
+  {
+    ++m_time_bin;
+    return;
+  }
+
+  // advance to the next non empty waveform
+  ++m_waveform_index;
+  SetWaveform();
+}
+
+uint16_t TpcRawHitv4::AdcIteratorv4::CurrentTimeBin() const
+{
+  return IsDone() ? std::numeric_limits<uint16_t>::max() : m_time_bin;
+}
+
+uint16_t TpcRawHitv4::AdcIteratorv4::CurrentAdc() const
+{
+  return IsDone() ? std::numeric_limits<uint16_t>::max() : m_container->get_arena_adc(m_adc_index);
+}
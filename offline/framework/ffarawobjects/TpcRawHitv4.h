@@ -0,0 +1,127 @@
+#ifndef FUN4ALLRAW_TPCRAWTHITv4_H
+#define FUN4ALLRAW_TPCRAWTHITv4_H
+
+#include "TpcRawHit.h"
+
+#include <phool/PHObject.h>
+
+#include <cstdint>
+#include <limits>
+
+class TpcRawHitContainerv4;
+
+/*!
+ * tpc raw hit whose waveforms live in the sample arena of its TpcRawHitContainerv4.
+ * The hit only stores the range of its waveforms in that arena, so it is only
+ * meaningful as an element of the container and is filled by TpcRawHitContainerv4::AddHit
+ */
+class TpcRawHitv4 : public TpcRawHit
+{
+ public:
+  TpcRawHitv4() = default;
+  ~TpcRawHitv4() override = default;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  uint64_t get_bco() const override { return bco; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_bco(const uint64_t val) override { bco = val; }
+
+  int32_t get_packetid() const override { return packetid; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_packetid(const int32_t val) override { packetid = val; }
+
+  uint16_t get_fee() const override { return fee; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_fee(const uint16_t val) override { fee = val; }
+
+  uint16_t get_channel() const override { return channel; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_channel(const uint16_t val) override { channel = val; }
+
+  uint16_t get_sampaaddress() const override
+  {
+    return static_cast<uint16_t>(channel >> 5U) & 0xfU;
+  }
+
+  uint16_t get_sampachannel() const override { return channel & 0x1fU; }
+
+  uint16_t get_samples() const override { return samples; }
+  // cppcheck-suppress virtualCallInConstructor
+  void set_samples(const uint16_t val) override { samples = val; }
+
+  //! adc value of a given sample, 0 if it is not part of any waveform
+  uint16_t get_adc(const uint16_t sample) const override;
+
+  uint16_t get_type() const override { return type; }
+  void set_type(const uint16_t i) override { type = i; }
+
+  bool get_checksumerror() const override { return checksumerror; }
+  void set_checksumerror(const bool b) override { checksumerror = b; }
+
+  bool get_parityerror() const override { return parityerror; }
+  void set_parityerror(const bool b) override { parityerror = b; }
+
+  //! waveforms of this hit in the container arena
+  uint32_t get_first_waveform() const { return first_waveform; }
+  uint32_t get_nwaveforms() const { return nwaveforms; }
+
+  //! start time bin, number of samples and samples of the waveform iwf < get_nwaveforms() of this hit
+  uint16_t get_waveform_start(uint32_t iwf) const;
+  uint32_t get_waveform_size(uint32_t iwf) const;
+  const uint16_t *get_waveform_adc(uint32_t iwf) const;
+
+  class AdcIteratorv4 : public AdcIterator
+  {
+   private:
+    const TpcRawHitContainerv4 *m_container{nullptr};
+    uint32_t m_waveform_first{0};
+    uint32_t m_waveform_index{0};
+    uint32_t m_waveform_end{0};
+    uint32_t m_adc_index{0};
+    uint32_t m_adc_end{0};
+    uint16_t m_time_bin{0};
+
+    // first sample of the current waveform, skipping empty ones
+    void SetWaveform();
+
+   public:
+    explicit AdcIteratorv4(const TpcRawHitv4 &hit);
+
+    void First() override;
+    void Next() override;
+    bool IsDone() const override { return m_waveform_index >= m_waveform_end; }
+
+    uint16_t CurrentTimeBin() const override;
+    uint16_t CurrentAdc() const override;
+  };
+
+  AdcIterator *CreateAdcIterator() const override { return new AdcIteratorv4(*this); }
+
+ private:
+  friend class TpcRawHitContainerv4;
+
+  uint64_t bco{std::numeric_limits<uint64_t>::max()};
+  int32_t packetid{std::numeric_limits<int32_t>::max()};
+  uint16_t fee{std::numeric_limits<uint16_t>::max()};
+  uint16_t channel{std::numeric_limits<uint16_t>::max()};
+  uint16_t type{std::numeric_limits<uint16_t>::max()};
+  uint16_t samples{std::numeric_limits<uint16_t>::max()};
+
+  bool checksumerror{true};
+  bool parityerror{true};
+
+  //! range of this hit's waveforms in the container
+  uint32_t first_waveform{0};
+  uint32_t nwaveforms{0};
+
+  //! owning container, set when the hit is added or accessed
+  const TpcRawHitContainerv4 *m_container{nullptr};  //!
+
+  ClassDefOverride(TpcRawHitv4, 1)
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 #include <phool/phooldefs.h>
 
+#include <TROOT.h>
 #include <TSystem.h>
 
 #pragma GCC diagnostic push
@@ -41,6 +42,7 @@ Fun4AllDstInputManager::Fun4AllDstInputManager(const std::string &name, const st
 
 Fun4AllDstInputManager::~Fun4AllDstInputManager()
 {
+  StopPrefetch();
   delete m_IManager;
   delete m_RunNodeSum;
   return;
@@ -57,11 +59,29 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     fileclose();
   }
   FileName(filenam);
-  FROG frog;
-  fullfilename = frog.location(FileName());
+  // use the file opened by the prefetch thread if it is the one we want
+  PHNodeIOManager *prefetched = nullptr;
+  if (m_Prefetch.valid())
+  {
+    PrefetchedFile next = m_Prefetch.get();
+    if (next.IManager && next.FileName == filenam)
+    {
+      prefetched = next.IManager;
+      fullfilename = next.FullFileName;
+    }
+    else
+    {
+      delete next.IManager;
+    }
+  }
+  if (!prefetched)
+  {
+    FROG frog;
+    fullfilename = frog.location(FileName());
+  }
   if (Verbosity() > 0)
   {
-    std::cout << Name() << ": opening file " << fullfilename << std::endl;
+    std::cout << Name() << ": opening " << (prefetched ? "prefetched " : "") << "file " << fullfilename << std::endl;
   }
   // sanity check - the IManager must be nullptr when this method is executed
   // if not something is very very wrong and we must not continue
@@ -128,7 +148,8 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
   }
   // now open the dst node
   dstNode = se->getNode(InputNode(), TopNodeName());
-  m_IManager = new PHNodeIOManager(fullfilename, PHReadOnly);
+  m_IManager = (prefetched ? prefetched : new PHNodeIOManager(fullfilename, PHReadOnly));
+  m_IManager->SetReadCache(m_ReadCacheSize, m_ParallelUnzip);
   if (m_IManager->isFunctional())
   {
     IsOpen(1);
@@ -144,7 +165,7 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     {
       m_HaveSyncObject = -1;
     }
-
+    StartPrefetch();
     return 0;
   }
 
@@ -228,6 +249,69 @@ int Fun4AllDstInputManager::fileclose()
   return 0;
 }
 
+void Fun4AllDstInputManager::EnableReadAhead(const long cachesize, const bool parallelunzip)
+{
+  m_ReadCacheSize = cachesize;
+  m_ParallelUnzip = parallelunzip;
+  if (m_ParallelUnzip && !ROOT::IsImplicitMTEnabled())
+  {
+    std::cout << Name() << ": parallel unzip needs ROOT::EnableImplicitMT(), without it baskets are unzipped when they are read" << std::endl;
+  }
+  if (IsOpen())
+  {
+    std::cout << Name() << ": read ahead settings are used from the next file on" << std::endl;
+  }
+}
+
+void Fun4AllDstInputManager::StartPrefetch()
+{
+  if (!m_PrefetchNextFile || m_Prefetch.valid())
+  {
+    return;
+  }
+  std::string nextfile = NextFileName();
+  if (nextfile.empty())
+  {
+    return;
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": prefetching next file " << nextfile << std::endl;
+  }
+  // the next file is opened while the current one is being read
+  ROOT::EnableThreadSafety();
+  // the thread only works on its own copies and its own file,
+  // the result is picked up by fileopen()
+  m_Prefetch = std::async(std::launch::async, [nextfile, selection = branchread]()
+                          {
+    PrefetchedFile next;
+    next.FileName = nextfile;
+    FROG frog;
+    next.FullFileName = frog.location(nextfile);
+    PHNodeIOManager *iman = new PHNodeIOManager(next.FullFileName, PHReadOnly);
+    if (!iman->isFunctional())
+    {
+      // fileopen() tries again and reports the error
+      delete iman;
+      return next;
+    }
+    for (const auto &branch : selection)
+    {
+      iman->selectObjectToRead(branch.first, branch.second);
+    }
+    iman->PrefetchFirstBaskets();
+    next.IManager = iman;
+    return next; });
+}
+
+void Fun4AllDstInputManager::StopPrefetch()
+{
+  if (m_Prefetch.valid())
+  {
+    delete m_Prefetch.get().IManager;
+  }
+}
+
 int Fun4AllDstInputManager::GetSyncObject(SyncObject **mastersync)
 {
   // here we copy the sync object from the current file to the
@@ -5,6 +5,7 @@
 
 #include "Fun4AllInputManager.h"
 
+#include <future>
 #include <map>
 #include <string>
 
@@ -29,8 +30,19 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int PushBackEvents(const int i) override;
   int HasSyncObject() const override;
 
+  //! TTree read cache for the selected branches (size in bytes). With parallel unzip the
+  //! baskets for the next events are decompressed in the background while the current
+  //! event is processed, this needs ROOT::EnableImplicitMT()
+  void EnableReadAhead(const long cachesize = 100000000, const bool parallelunzip = true);
+
+  //! open the next file of the list and read its first baskets on a background thread
+  //! while the current file is processed (includes the FROG lookup)
+  void EnablePrefetchNextFile(const bool b = true) { m_PrefetchNextFile = b; }
+
  protected:
   int ReadNextEventSyncObject();
+  void StartPrefetch();
+  void StopPrefetch();
   void ReadRunTTree(const int i) { m_ReadRunTTree = i; }
   void IManager(PHNodeIOManager *iman) { m_IManager = iman; }
   PHNodeIOManager *IManager() { return m_IManager; }
@@ -58,6 +70,19 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   PHNodeIOManager *m_IManager = nullptr;
   SyncObject *syncobject = nullptr;
   std::string RunNode = "RUN";
+
+  long m_ReadCacheSize = 0;
+  bool m_ParallelUnzip = false;
+  bool m_PrefetchNextFile = false;
+
+  // next input file, opened by the prefetch thread
+  struct PrefetchedFile
+  {
+    std::string FileName;
+    std::string FullFileName;
+    PHNodeIOManager *IManager = nullptr;
+  };
+  std::future<PrefetchedFile> m_Prefetch;
 };
 
 #endif /* __FUN4ALLDSTINPUTMANAGER_H__ */
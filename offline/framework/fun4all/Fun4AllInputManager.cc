@@ -10,6 +10,7 @@
 #include <cstdint>  // for uintmax_t
 #include <fstream>
 #include <iostream>
+#include <iterator>  // for next
 
 Fun4AllInputManager::Fun4AllInputManager(const std::string &name, const std::string &nodename, const std::string &topnodename)
   : Fun4AllBase(name)
@@ -210,6 +211,20 @@ void Fun4AllInputManager::UpdateFileList()
   return;
 }
 
+std::string Fun4AllInputManager::NextFileName() const
+{
+  // the current file is at the front of the list until it is closed
+  if (m_FileList.size() > 1)
+  {
+    return *std::next(m_FileList.begin());
+  }
+  if (!m_FileList.empty() && m_Repeat)
+  {
+    return m_FileList.front();
+  }
+  return "";
+}
+
 int Fun4AllInputManager::OpenNextFile()
 {
   while (!m_FileList.empty())
@@ -64,6 +64,8 @@ class Fun4AllInputManager : public Fun4AllBase
   Fun4AllInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
   void UpdateFileList();
   int OpenNextFile();
+  // file which will be opened after the current one, empty if there is none
+  std::string NextFileName() const;
   void IsOpen(const int i) { m_IsOpen = i; }
   Fun4AllSyncManager *MySyncManager() { return m_MySyncManager; }
 
@@ -8,6 +8,7 @@
 #include "Fun4AllOutputManager.h"
 #include "Fun4AllReturnCodes.h"
 #include "Fun4AllSyncManager.h"
+#include "Fun4AllTimingReport.h"
 #include "SubsysReco.h"
 
 #include <phool/PHCompositeNode.h>
@@ -56,6 +57,7 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
 #ifdef FFAMEMTRACKER
   , ffamemtracker(Fun4AllMemoryTracker::instance())
 #endif
+  , timingreport(new Fun4AllTimingReport())
 {
   InitAll();
   return;
@@ -115,6 +117,7 @@ Fun4AllServer::~Fun4AllServer()
   recoConsts *rc = recoConsts::instance();
   delete rc;
   delete ffamemtracker;
+  delete timingreport;
   __instance = nullptr;
   return;
 }
@@ -267,10 +270,17 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
   std::string timer_name;
   timer_name = subsystem->Name() + "_" + topnodename;
   PHTimer timer(timer_name);
-  if (timer_map.find(timer_name) == timer_map.end())
+  auto titer = timer_map.find(timer_name);
+  if (titer == timer_map.end())
   {
-    timer_map.insert(make_pair(timer_name, timer));
+    titer = timer_map.insert(make_pair(timer_name, timer)).first;
   }
+  // map entries do not move, the timer is looked up only once
+  SubsystemTimer subsystimer;
+  subsystimer.timer = &titer->second;
+  subsystimer.slot = timingreport->RegisterSlot(timer_name);
+  subsystimer.name = timer_name;
+  SubsystemTimers.push_back(subsystimer);
   RetCodes.push_back(iret);  // vector with return codes
   return 0;
 }
@@ -317,8 +327,9 @@ int Fun4AllServer::unregisterSubsystemsNow()
     }
     Subsystems.erase(Subsystems.begin() + index);
     delete (*removeiter).first;
-    // also update the vector with return codes
+    // also update the vector with return codes and the timers
     RetCodes.erase(RetCodes.begin() + index);
+    SubsystemTimers.erase(SubsystemTimers.begin() + index);
     std::vector<Fun4AllOutputManager *>::iterator outiter;
     for (outiter = OutputManager.begin(); outiter != OutputManager.end(); ++outiter)
     {
@@ -506,6 +517,15 @@ TNamed *Fun4AllServer::getHisto(const std::string &hname) const
 
 int Fun4AllServer::process_event()
 {
+  PHTimer event_timer("EventTimer");
+  event_timer.restart();
+  timingreport->StartEvent(runnumber, eventnumber);
+  // close the event in the timing report on every exit path, aborted events included
+  auto end_event_timing = [this, &event_timer]()
+  {
+    event_timer.stop();
+    timingreport->EndEvent(event_timer.elapsed());
+  };
   eventcounter++;
   unsigned icnt = 0;
   int eventbad = 0;
@@ -559,20 +579,11 @@ int Fun4AllServer::process_event()
 
     try
     {
-      std::string timer_name;
-      timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
-      {
-        timer_found = true;
-        titer->second.restart();
-      }
-      else
-      {
-        std::cout << "could not find timer for " << timer_name << std::endl;
-      }
+      SubsystemTimer &subsystimer = SubsystemTimers.at(icnt);
+      subsystimer.timer->restart();
+      timingreport->StartSlot(subsystimer.slot);
 #ifdef FFAMEMTRACKER
+      const std::string &timer_name = subsystimer.name;
       ffamemtracker->Start(timer_name, "SubsysReco");
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
@@ -595,10 +606,8 @@ int Fun4AllServer::process_event()
         std::cout << "error: " << e.what() << std::endl;
         gSystem->Exit(1);
       }
-      if (timer_found)
-      {
-        titer->second.stop();
-      }
+      subsystimer.timer->stop();
+      timingreport->StopSlot(subsystimer.slot, subsystimer.timer->elapsed());
 #ifdef FFAMEMTRACKER
       ffamemtracker->Stop(timer_name, "SubsysReco");
 #endif
@@ -639,6 +648,7 @@ int Fun4AllServer::process_event()
       {
         retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
         std::cout << "Fun4AllServer::Abort Run by " << Subsystem.first->Name() << std::endl;
+        end_event_timing();
         return Fun4AllReturnCodes::ABORTRUN;
       }
       else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTPROCESSING)
@@ -646,6 +656,7 @@ int Fun4AllServer::process_event()
         eventbad = 1;
         retcodesmap[Fun4AllReturnCodes::ABORTPROCESSING]++;
         std::cout << "Fun4AllServer::Abort Processing by " << Subsystem.first->Name() << std::endl;
+        end_event_timing();
         return Fun4AllReturnCodes::ABORTPROCESSING;
       }
       else
@@ -657,6 +668,7 @@ int Fun4AllServer::process_event()
         std::cout << "it is too dangerous to continue, this Run will be aborted" << std::endl;
         std::cout << "If you do not know how to fix this please send mail to" << std::endl;
         std::cout << "phenix-off-l with this message" << std::endl;
+        end_event_timing();
         return Fun4AllReturnCodes::ABORTRUN;
       }
     }
@@ -786,6 +798,7 @@ int Fun4AllServer::process_event()
   }
   Fun4AllMonitoring::instance()->Snapshot("Event");
   ResetNodeTree();
+  end_event_timing();
   return 0;
 }
 
@@ -1152,6 +1165,7 @@ int Fun4AllServer::End()
   // close output files (check for existing output managers is
   // done inside outfileclose())
   outfileclose();
+  timingreport->End();
 
   if (ScreamEveryEvent)
   {
@@ -1766,6 +1780,13 @@ void Fun4AllServer::PrintTimer(const std::string &name)
   return;
 }
 
+void Fun4AllServer::EnableTimingReport(const std::string &filename, const bool trackmemory)
+{
+  timingreport->OutFileName(filename);
+  timingreport->TrackMemory(trackmemory);
+  timingreport->Enable();
+}
+
 void Fun4AllServer::PrintMemoryTracker(const std::string &name)
 {
 #ifdef FFAMEMTRACKER
@@ -20,6 +20,7 @@ class Fun4AllInputManager;
 class Fun4AllMemoryTracker;
 class Fun4AllSyncManager;
 class Fun4AllOutputManager;
+class Fun4AllTimingReport;
 class PHCompositeNode;
 class PHTimeStamp;
 class SubsysReco;
@@ -116,6 +117,10 @@ class Fun4AllServer : public Fun4AllBase
   int EventCounter() const { return eventcounter; }
   std::map<const std::string, PHTimer>::const_iterator timer_begin() { return timer_map.begin(); }
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
+  //! per module latency quantiles, RSS differences (if trackmemory is set) and event wall time,
+  //! written at End() as JSON or, for a .root file name, as TTrees with one entry per event
+  void EnableTimingReport(const std::string &filename = "fun4all_timing.json", const bool trackmemory = false);
+  Fun4AllTimingReport *getTimingReport() { return timingreport; }
 
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
@@ -128,6 +133,7 @@ class Fun4AllServer : public Fun4AllBase
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars{nullptr};
   Fun4AllMemoryTracker *ffamemtracker{nullptr};
+  Fun4AllTimingReport *timingreport{nullptr};
   Fun4AllHistoManager *ServerHistoManager{nullptr};
   PHTimeStamp *beginruntimestamp{nullptr};
   PHCompositeNode *TopNode{nullptr};
@@ -155,6 +161,15 @@ class Fun4AllServer : public Fun4AllBase
   std::vector<Fun4AllSyncManager *> SyncManagers;
   std::map<int, int> retcodesmap;
   std::map<const std::string, PHTimer> timer_map;
+
+  // timer and timing report slot of each entry in Subsystems, resolved at registration
+  struct SubsystemTimer
+  {
+    PHTimer *timer{nullptr};
+    unsigned int slot{0};
+    std::string name;
+  };
+  std::vector<SubsystemTimer> SubsystemTimers;
 };
 
 #endif
@@ -0,0 +1,385 @@
+#include "Fun4AllTimingReport.h"
+
+#include "Fun4AllMemoryTracker.h"
+
+#include <phool/phool.h>
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+void Fun4AllTimingReport::LatencyHistogram::Fill(const double ms)
+{
+  if (mEntries == 0)
+  {
+    mMin = ms;
+    mMax = ms;
+  }
+  else
+  {
+    mMin = std::min(mMin, ms);
+    mMax = std::max(mMax, ms);
+  }
+  mEntries++;
+  int bin = 0;  // underflow, also catches nan
+  if (ms >= MINTIME)
+  {
+    double fbin = std::log10(ms / MINTIME) * NBINSPERDECADE;
+    bin = (fbin < NBINS) ? 1 + static_cast<int>(fbin) : NBINS + 1;
+  }
+  mCounts[bin]++;
+}
+
+void Fun4AllTimingReport::LatencyHistogram::Reset()
+{
+  mCounts.fill(0);
+  mEntries = 0;
+  mMin = 0;
+  mMax = 0;
+}
+
+double Fun4AllTimingReport::LatencyHistogram::Quantile(const double q) const
+{
+  if (mEntries == 0)
+  {
+    return 0;
+  }
+  double target = std::clamp(q, 0., 1.) * mEntries;
+  unsigned long sum = 0;
+  for (int bin = 0; bin < NBINS + 2; bin++)
+  {
+    if (mCounts[bin] == 0 || sum + mCounts[bin] < target)
+    {
+      sum += mCounts[bin];
+      continue;
+    }
+    if (bin == 0)
+    {
+      return mMin;
+    }
+    if (bin == NBINS + 1)
+    {
+      return mMax;
+    }
+    // geometric interpolation inside the bin
+    double fraction = (target - sum) / mCounts[bin];
+    double value = MINTIME * std::pow(10., (bin - 1 + fraction) / NBINSPERDECADE);
+    return std::clamp(value, mMin, mMax);
+  }
+  return mMax;
+}
+
+Fun4AllTimingReport::Fun4AllTimingReport(const std::string &name)
+  : Fun4AllBase(name)
+{
+}
+
+Fun4AllTimingReport::~Fun4AllTimingReport()
+{
+  delete mFile;
+}
+
+unsigned int Fun4AllTimingReport::RegisterSlot(const std::string &name)
+{
+  auto iter = std::find_if(mSlots.begin(), mSlots.end(), [&name](const Slot &slot)
+                           { return slot.Name == name; });
+  if (iter != mSlots.end())
+  {
+    return iter - mSlots.begin();
+  }
+  Slot newslot;
+  newslot.Name = name;
+  mSlots.push_back(newslot);
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllTimingReport: slot " << mSlots.size() - 1 << " for " << name << std::endl;
+  }
+  return mSlots.size() - 1;
+}
+
+void Fun4AllTimingReport::StartEvent(const int runnumber, const int eventnumber)
+{
+  if (!mEnabled)
+  {
+    return;
+  }
+  if (!mFile && IsRootFile())
+  {
+    OpenTree();
+  }
+  mRunNumber = runnumber;
+  mEventNumber = eventnumber;
+  // -1 for modules which did not run in this event
+  mEventTimes.assign(mSlots.size(), -1);
+  mEventRSS.assign(mSlots.size(), 0);
+}
+
+void Fun4AllTimingReport::StartSlot(const unsigned int slot)
+{
+  if (mEnabled && mTrackMemory)
+  {
+    mSlots[slot].StartRSS = Fun4AllMemoryTracker::GetRSSMemory();
+  }
+}
+
+void Fun4AllTimingReport::StopSlot(const unsigned int slot, const double ms)
+{
+  if (!mEnabled)
+  {
+    return;
+  }
+  Slot &thisslot = mSlots[slot];
+  thisslot.Latency.Fill(ms);
+  thisslot.TotalTime += ms;
+  if (ms >= thisslot.Latency.Max())
+  {
+    thisslot.MaxEvent = mEventNumber;
+  }
+  // modules registered during this event
+  if (slot >= mEventTimes.size())
+  {
+    mEventTimes.resize(slot + 1, -1);
+    mEventRSS.resize(slot + 1, 0);
+  }
+  mEventTimes[slot] = ms;
+  if (mTrackMemory)
+  {
+    int diff = Fun4AllMemoryTracker::GetRSSMemory() - thisslot.StartRSS;
+    thisslot.TotalRSS += diff;
+    thisslot.MaxRSS = std::max(thisslot.MaxRSS, diff);
+    mEventRSS[slot] = diff;
+  }
+}
+
+void Fun4AllTimingReport::EndEvent(const double ms)
+{
+  if (!mEnabled)
+  {
+    return;
+  }
+  mEventLatency.Fill(ms);
+  mEventTotalTime += ms;
+  if (ms >= mEventLatency.Max())
+  {
+    mEventMaxEvent = mEventNumber;
+  }
+  if (mTree)
+  {
+    mEventTime = ms;
+    mRSS = (mTrackMemory ? Fun4AllMemoryTracker::GetRSSMemory() : 0);
+    mTree->Fill();
+  }
+}
+
+bool Fun4AllTimingReport::IsRootFile() const
+{
+  const std::string extension = ".root";
+  return mOutFileName.size() >= extension.size() &&
+         mOutFileName.compare(mOutFileName.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+void Fun4AllTimingReport::OpenTree()
+{
+  std::string currdir = gDirectory->GetPath();
+  mFile = TFile::Open(mOutFileName.c_str(), "RECREATE");
+  if (!mFile || mFile->IsZombie())
+  {
+    std::cout << PHWHERE << " could not open " << mOutFileName
+              << ", no per event timing tree will be written" << std::endl;
+    delete mFile;
+    mFile = nullptr;
+    mOutFileName.clear();
+    gROOT->cd(currdir.c_str());
+    return;
+  }
+  mTree = new TTree("Fun4AllTimingEvents", "Fun4All event and module times (ms) and RSS differences (kB)");
+  mTree->Branch("run", &mRunNumber);
+  mTree->Branch("event", &mEventNumber);
+  mTree->Branch("time", &mEventTime);
+  mTree->Branch("rss", &mRSS);
+  mTree->Branch("module_time", &mEventTimes);
+  mTree->Branch("module_rss", &mEventRSS);
+  gROOT->cd(currdir.c_str());
+}
+
+void Fun4AllTimingReport::Print(const std::string & /*what*/) const
+{
+  std::cout << "Fun4AllTimingReport: " << mEventLatency.Entries() << " events, times in ms, RSS in kB" << std::endl;
+  std::cout << std::setw(40) << std::left << "module" << std::right
+            << std::setw(10) << "calls"
+            << std::setw(12) << "mean"
+            << std::setw(12) << "p50"
+            << std::setw(12) << "p95"
+            << std::setw(12) << "p99"
+            << std::setw(12) << "max"
+            << std::setw(10) << "maxevt";
+  if (mTrackMemory)
+  {
+    std::cout << std::setw(12) << "rss total" << std::setw(12) << "rss max";
+  }
+  std::cout << std::endl;
+  auto printline = [](const std::string &name, const LatencyHistogram &latency, const double total, const int maxevent)
+  {
+    std::cout << std::setw(40) << std::left << name << std::right
+              << std::setw(10) << latency.Entries()
+              << std::setw(12) << (latency.Entries() ? total / latency.Entries() : 0.)
+              << std::setw(12) << latency.Quantile(0.5)
+              << std::setw(12) << latency.Quantile(0.95)
+              << std::setw(12) << latency.Quantile(0.99)
+              << std::setw(12) << latency.Max()
+              << std::setw(10) << maxevent;
+  };
+  for (const auto &slot : mSlots)
+  {
+    printline(slot.Name, slot.Latency, slot.TotalTime, slot.MaxEvent);
+    if (mTrackMemory)
+    {
+      std::cout << std::setw(12) << slot.TotalRSS << std::setw(12) << slot.MaxRSS;
+    }
+    std::cout << std::endl;
+  }
+  printline("Event", mEventLatency, mEventTotalTime, mEventMaxEvent);
+  std::cout << std::endl;
+}
+
+int Fun4AllTimingReport::WriteJson(const std::string &fname) const
+{
+  std::ofstream outfile(fname, std::ios_base::trunc);
+  if (!outfile.is_open())
+  {
+    std::cout << PHWHERE << " could not open " << fname << std::endl;
+    return -1;
+  }
+  auto escape = [](const std::string &name)
+  {
+    std::string escaped;
+    for (char c : name)
+    {
+      if (c == '"' || c == '\\')
+      {
+        escaped += '\\';
+      }
+      escaped += c;
+    }
+    return escaped;
+  };
+  auto latency_json = [&outfile](const LatencyHistogram &latency, const double total, const int maxevent)
+  {
+    outfile << "\"calls\": " << latency.Entries()
+            << ", \"total_ms\": " << total
+            << ", \"mean_ms\": " << (latency.Entries() ? total / latency.Entries() : 0.)
+            << ", \"p50_ms\": " << latency.Quantile(0.5)
+            << ", \"p95_ms\": " << latency.Quantile(0.95)
+            << ", \"p99_ms\": " << latency.Quantile(0.99)
+            << ", \"max_ms\": " << latency.Max()
+            << ", \"max_event\": " << maxevent;
+  };
+  outfile << std::setprecision(6);
+  outfile << "{" << std::endl;
+  outfile << "  \"event\": {";
+  latency_json(mEventLatency, mEventTotalTime, mEventMaxEvent);
+  outfile << "}," << std::endl;
+  outfile << "  \"track_memory\": " << (mTrackMemory ? "true" : "false") << "," << std::endl;
+  outfile << "  \"modules\": [";
+  for (auto iter = mSlots.begin(); iter != mSlots.end(); ++iter)
+  {
+    outfile << (iter == mSlots.begin() ? "" : ",") << std::endl;
+    outfile << "    {\"name\": \"" << escape(iter->Name) << "\", ";
+    latency_json(iter->Latency, iter->TotalTime, iter->MaxEvent);
+    if (mTrackMemory)
+    {
+      outfile << ", \"rss_total_kb\": " << iter->TotalRSS
+              << ", \"rss_max_kb\": " << iter->MaxRSS;
+    }
+    outfile << "}";
+  }
+  outfile << std::endl
+          << "  ]" << std::endl;
+  outfile << "}" << std::endl;
+  outfile.close();
+  return 0;
+}
+
+int Fun4AllTimingReport::WriteTree()
+{
+  if (!mFile)
+  {
+    OpenTree();
+    if (!mFile)
+    {
+      return -1;
+    }
+  }
+  std::string currdir = gDirectory->GetPath();
+  mFile->cd();
+  std::string name;
+  unsigned long calls = 0;
+  double total = 0;
+  double p50 = 0;
+  double p95 = 0;
+  double p99 = 0;
+  double max = 0;
+  int maxevent = 0;
+  long long rsstotal = 0;
+  int rssmax = 0;
+  TTree *summary = new TTree("Fun4AllTimingModules", "Fun4All module latencies (ms) and RSS differences (kB), slot = index in module_time");
+  summary->Branch("name", &name);
+  summary->Branch("calls", &calls);
+  summary->Branch("total", &total);
+  summary->Branch("p50", &p50);
+  summary->Branch("p95", &p95);
+  summary->Branch("p99", &p99);
+  summary->Branch("max", &max);
+  summary->Branch("maxevent", &maxevent);
+  summary->Branch("rsstotal", &rsstotal);
+  summary->Branch("rssmax", &rssmax);
+  for (const auto &slot : mSlots)
+  {
+    name = slot.Name;
+    calls = slot.Latency.Entries();
+    total = slot.TotalTime;
+    p50 = slot.Latency.Quantile(0.5);
+    p95 = slot.Latency.Quantile(0.95);
+    p99 = slot.Latency.Quantile(0.99);
+    max = slot.Latency.Max();
+    maxevent = slot.MaxEvent;
+    rsstotal = slot.TotalRSS;
+    rssmax = slot.MaxRSS;
+    summary->Fill();
+  }
+  mFile->Write();
+  mFile->Close();
+  delete mFile;  // also deletes the trees
+  mFile = nullptr;
+  mTree = nullptr;
+  gROOT->cd(currdir.c_str());
+  return 0;
+}
+
+int Fun4AllTimingReport::End()
+{
+  if (!mEnabled)
+  {
+    return 0;
+  }
+  if (Verbosity() > 0)
+  {
+    Print();
+  }
+  if (mOutFileName.empty())
+  {
+    return 0;
+  }
+  if (IsRootFile())
+  {
+    return WriteTree();
+  }
+  return WriteJson(mOutFileName);
+}
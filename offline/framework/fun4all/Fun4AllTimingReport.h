@@ -0,0 +1,115 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLTIMINGREPORT_H
+#define FUN4ALL_FUN4ALLTIMINGREPORT_H
+
+#include "Fun4AllBase.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+class TFile;
+class TTree;
+
+//! Per module latency distributions, RSS differences and event wall time
+//! collected by the Fun4AllServer. Slots are resolved once when a module is
+//! registered, the per event cost is a histogram fill per module (plus one
+//! RSS read per module call if memory tracking is enabled)
+class Fun4AllTimingReport : public Fun4AllBase
+{
+ public:
+  //! fixed log binned latency histogram, quantiles are interpolated within a bin
+  class LatencyHistogram
+  {
+   public:
+    static constexpr double MINTIME = 1e-3;  // ms
+    static constexpr int NDECADES = 10;
+    static constexpr int NBINSPERDECADE = 50;  // 4.7% relative bin width
+    static constexpr int NBINS = NDECADES * NBINSPERDECADE;
+
+    void Fill(const double ms);
+    void Reset();
+    //! q in [0,1]
+    double Quantile(const double q) const;
+    unsigned long Entries() const { return mEntries; }
+    double Max() const { return mMax; }
+    double Min() const { return mMin; }
+
+   private:
+    // first bin is underflow, last bin is overflow
+    std::array<unsigned long, NBINS + 2> mCounts{};
+    unsigned long mEntries{0};
+    double mMin{0};
+    double mMax{0};
+  };
+
+  struct Slot
+  {
+    std::string Name;
+    LatencyHistogram Latency;
+    double TotalTime{0};
+    int MaxEvent{-1};
+    long long TotalRSS{0};
+    int MaxRSS{0};
+    int StartRSS{0};
+  };
+
+  explicit Fun4AllTimingReport(const std::string &name = "Fun4AllTimingReport");
+  ~Fun4AllTimingReport() override;
+
+  //! a file name ending in .root gets a TTree with one entry per event
+  //! and a TTree with the module summaries, anything else a JSON summary
+  void OutFileName(const std::string &fname) { mOutFileName = fname; }
+  const std::string &OutFileName() const { return mOutFileName; }
+
+  void Enable(const bool b = true) { mEnabled = b; }
+  bool Enabled() const { return mEnabled; }
+
+  //! record the RSS difference of every module call (reads /proc)
+  void TrackMemory(const bool b = true) { mTrackMemory = b; }
+
+  //! returns the slot for name, an existing slot is reused
+  unsigned int RegisterSlot(const std::string &name);
+
+  void StartEvent(const int runnumber, const int eventnumber);
+  void StartSlot(const unsigned int slot);
+  void StopSlot(const unsigned int slot, const double ms);
+  void EndEvent(const double ms);
+
+  const Slot &GetSlot(const unsigned int slot) const { return mSlots.at(slot); }
+  unsigned int NSlots() const { return mSlots.size(); }
+  const LatencyHistogram &EventLatency() const { return mEventLatency; }
+
+  void Print(const std::string &what = "ALL") const override;
+  int WriteJson(const std::string &fname) const;
+  //! writes the module summary tree next to the event tree and closes the file
+  int WriteTree();
+  //! writes the output file if a name is set
+  int End();
+
+ private:
+  void OpenTree();
+  bool IsRootFile() const;
+
+  std::vector<Slot> mSlots;
+  LatencyHistogram mEventLatency;
+  int mEventMaxEvent{-1};
+  double mEventTotalTime{0};
+
+  // per event values written to the tree
+  std::vector<float> mEventTimes;
+  std::vector<int> mEventRSS;
+  int mRunNumber{0};
+  int mEventNumber{0};
+  float mEventTime{0};
+  int mRSS{0};
+  TFile *mFile{nullptr};
+  TTree *mTree{nullptr};
+
+  std::string mOutFileName;
+  bool mEnabled{false};
+  bool mTrackMemory{false};
+};
+
+#endif
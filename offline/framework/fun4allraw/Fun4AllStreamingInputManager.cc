@@ -38,14 +38,17 @@
 #include <boost/format.hpp>
 
 #include <TH1.h>
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <algorithm>  // for max
+#include <atomic>
 #include <cassert>
 #include <cstdint>  // for uint64_t, uint16_t
 #include <cstdlib>
 #include <iostream>  // for operator<<, basic_ostream, endl
-#include <utility>   // for pair
+#include <thread>
+#include <utility>  // for pair
 
 Fun4AllStreamingInputManager::Fun4AllStreamingInputManager(const std::string &name, const std::string &dstnodename, const std::string &topnodename)
   : Fun4AllInputManager(name, dstnodename, topnodename)
@@ -151,6 +154,12 @@ int Fun4AllStreamingInputManager::run(const int /*nevents*/)
   {
     iret += FillGl1();
   }
+  // with a reference bco from the gl1 the pools of all subsystems can be filled
+  // at the same time, the Fill*() calls below then use these pools
+  if (m_nthreads != 1 && m_RefBCO != 0)
+  {
+    PrefillPools();
+  }
   if (m_intt_registered_flag)
   {
     iret += FillIntt();
@@ -494,6 +503,11 @@ void Fun4AllStreamingInputManager::AddGl1RawHit(uint64_t bclk, Gl1Packet *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 {
+  if (std::vector<StagedHit> *staging = StagingBuffer())
+  {
+    staging->push_back({StagedHit::MVTXHIT, bclk, hit, 0});
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx hit to bclk 0x"
@@ -504,6 +518,11 @@ void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feeid, uint32_t detField)
 {
+  if (std::vector<StagedHit> *staging = StagingBuffer())
+  {
+    staging->push_back({StagedHit::MVTXFEEID, bclk, nullptr, (static_cast<uint64_t>(feeid) << 32U) | detField});
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx feeid info to bclk 0x"
@@ -518,6 +537,11 @@ void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feei
 
 void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bco)
 {
+  if (std::vector<StagedHit> *staging = StagingBuffer())
+  {
+    staging->push_back({StagedHit::MVTXL1TRG, bclk, nullptr, lv1Bco});
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx L1Trg to bclk 0x"
@@ -528,6 +552,11 @@ void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bc
 
 void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
 {
+  if (std::vector<StagedHit> *staging = StagingBuffer())
+  {
+    staging->push_back({StagedHit::INTTHIT, bclk, hit, 0});
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding intt hit to bclk 0x"
@@ -539,6 +568,11 @@ void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
 
 void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, MicromegasRawHit *hit)
 {
+  if (std::vector<StagedHit> *staging = StagingBuffer())
+  {
+    staging->push_back({StagedHit::MICROMEGASHIT, bclk, hit, 0});
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding micromegas hit to bclk 0x"
@@ -549,6 +583,11 @@ void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, Micromegas
 
 void Fun4AllStreamingInputManager::AddTpcRawHit(uint64_t bclk, TpcRawHit *hit)
 {
+  if (std::vector<StagedHit> *staging = StagingBuffer())
+  {
+    staging->push_back({StagedHit::TPCHIT, bclk, hit, 0});
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding tpc hit to bclk 0x"
@@ -1320,37 +1359,10 @@ void Fun4AllStreamingInputManager::SetMvtxBcoRange(const unsigned int i)
 
 int Fun4AllStreamingInputManager::FillInttPool()
 {
-  uint64_t ref_bco_minus_range = 0;
-  if (m_RefBCO > m_intt_negative_bco)
+  if (m_PrefilledPools.erase(InputManagerType::INTT) == 0)
   {
-    ref_bco_minus_range = m_RefBCO - m_intt_negative_bco;
-  }
-  for (auto iter : m_InttInputVector)
-  {
-    if (Verbosity() > 0)
-    {
-      std::cout << "Fun4AllStreamingInputManager::FillInttPool - fill pool for " << iter->Name() << std::endl;
-    }
-    iter->FillPool(ref_bco_minus_range);
-    // iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    QueueInttPool();
+    RunPoolFills();
   }
   if (m_InttRawHitMap.empty())
   {
@@ -1362,37 +1374,10 @@ int Fun4AllStreamingInputManager::FillInttPool()
 
 int Fun4AllStreamingInputManager::FillTpcPool()
 {
-  uint64_t ref_bco_minus_range = 0;
-  if(m_RefBCO > m_tpc_negative_bco)
+  if (m_PrefilledPools.erase(InputManagerType::TPC) == 0)
   {
-    ref_bco_minus_range = m_RefBCO - m_tpc_negative_bco;
-  }
-
-  for (auto iter : m_TpcInputVector)
-  {
-    if (Verbosity() > 0)
-    {
-      std::cout << "Fun4AllStreamingInputManager::FillTpcPool - fill pool for " << iter->Name() << std::endl;
-    }
-    iter->FillPool(ref_bco_minus_range);
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    QueueTpcPool();
+    RunPoolFills();
   }
   // if (m_TpcRawHitMap.empty())
   // {
@@ -1404,31 +1389,10 @@ int Fun4AllStreamingInputManager::FillTpcPool()
 
 int Fun4AllStreamingInputManager::FillMicromegasPool()
 {
-  for (auto iter : m_MicromegasInputVector)
+  if (m_PrefilledPools.erase(InputManagerType::MICROMEGAS) == 0)
   {
-    if (Verbosity() > 0)
-    {
-      std::cout << "Fun4AllStreamingInputManager::FillMicromegasPool - fill pool for " << iter->Name() << std::endl;
-    }
-    iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    QueueMicromegasPool();
+    RunPoolFills();
   }
   if (m_MicromegasRawHitMap.empty())
   {
@@ -1439,42 +1403,227 @@ int Fun4AllStreamingInputManager::FillMicromegasPool()
 }
 
 int Fun4AllStreamingInputManager::FillMvtxPool()
+{
+  if (m_PrefilledPools.erase(InputManagerType::MVTX) == 0)
+  {
+    QueueMvtxPool();
+    RunPoolFills();
+  }
+  if (m_MvtxRawHitMap.empty())
+  {
+    
+    std::cout << "MvtxRawHitMap is empty - we are done" << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+void Fun4AllStreamingInputManager::QueueInttPool()
+{
+  uint64_t ref_bco_minus_range = 0;
+  if (m_RefBCO > m_intt_negative_bco)
+  {
+    ref_bco_minus_range = m_RefBCO - m_intt_negative_bco;
+  }
+  for (auto iter : m_InttInputVector)
+  {
+    m_PoolFills.push_back({iter, ref_bco_minus_range, true, "FillInttPool", 0});
+  }
+}
+
+void Fun4AllStreamingInputManager::QueueTpcPool()
+{
+  uint64_t ref_bco_minus_range = 0;
+  if(m_RefBCO > m_tpc_negative_bco)
+  {
+    ref_bco_minus_range = m_RefBCO - m_tpc_negative_bco;
+  }
+  for (auto iter : m_TpcInputVector)
+  {
+    m_PoolFills.push_back({iter, ref_bco_minus_range, true, "FillTpcPool", 0});
+  }
+}
+
+void Fun4AllStreamingInputManager::QueueMicromegasPool()
+{
+  for (auto iter : m_MicromegasInputVector)
+  {
+    m_PoolFills.push_back({iter, 0, false, "FillMicromegasPool", 0});
+  }
+}
+
+void Fun4AllStreamingInputManager::QueueMvtxPool()
 {
   uint64_t ref_bco_minus_range = m_RefBCO < m_mvtx_bco_range ? 0 : m_RefBCO - m_mvtx_bco_range;
   for (auto iter : m_MvtxInputVector)
   {
-    if (Verbosity() > 3)
+    m_PoolFills.push_back({iter, ref_bco_minus_range, true, "FillMvtxPool", 3});
+  }
+}
+
+void Fun4AllStreamingInputManager::PrefillPools()
+{
+  // same order as the Fill*() calls in run()
+  m_PrefilledPools.clear();
+  if (m_intt_registered_flag)
+  {
+    QueueInttPool();
+    m_PrefilledPools.insert(InputManagerType::INTT);
+  }
+  if (m_mvtx_registered_flag)
+  {
+    QueueMvtxPool();
+    m_PrefilledPools.insert(InputManagerType::MVTX);
+  }
+  if (m_tpc_registered_flag)
+  {
+    QueueTpcPool();
+    m_PrefilledPools.insert(InputManagerType::TPC);
+  }
+  if (m_micromegas_registered_flag)
+  {
+    QueueMicromegasPool();
+    m_PrefilledPools.insert(InputManagerType::MICROMEGAS);
+  }
+  RunPoolFills();
+}
+
+void Fun4AllStreamingInputManager::RunPoolFills()
+{
+  auto fill = [](const PoolFill &poolfill)
+  {
+    if (poolfill.bybco)
     {
-      std::cout << "Fun4AllStreamingInputManager::FillMvtxPool - fill pool for " << iter->Name() << std::endl;
+      poolfill.input->FillPool(poolfill.minbco);
     }
-    iter->FillPool(ref_bco_minus_range);
-    if (m_RunNumber == 0)
+    else
     {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
+      poolfill.input->FillPool();
     }
-    else
+  };
+  auto print = [this](const PoolFill &poolfill)
+  {
+    if (Verbosity() > poolfill.verbosity)
     {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
+      std::cout << "Fun4AllStreamingInputManager::" << poolfill.caller << " - fill pool for " << poolfill.input->Name() << std::endl;
+    }
+  };
+
+  const unsigned int nfills = m_PoolFills.size();
+  unsigned int nthreads = m_nthreads > 0 ? m_nthreads : std::max(1U, std::thread::hardware_concurrency());
+  nthreads = std::min(nthreads, nfills);
+  if (nthreads <= 1)
+  {
+    for (const auto &poolfill : m_PoolFills)
+    {
+      print(poolfill);
+      fill(poolfill);
+      CheckRunNumber(poolfill.input);
     }
+    m_PoolFills.clear();
+    return;
   }
-  if (m_MvtxRawHitMap.empty())
+
+  for (const auto &poolfill : m_PoolFills)
   {
-    
-    std::cout << "MvtxRawHitMap is empty - we are done" << std::endl;
-    return -1;
+    print(poolfill);
   }
-  return 0;
+  // the tpc time frame builders book their histograms inside FillPool()
+  ROOT::EnableThreadSafety();
+  if (m_StagedHits.size() < nfills)
+  {
+    m_StagedHits.resize(nfills);
+  }
+  // each thread takes the next input, the inputs only touch their own pools
+  // and their Add*() calls go to the staging buffer of this input
+  std::atomic<unsigned int> next(0);
+  auto worker = [this, &next, &fill, nfills]()
+  {
+    for (unsigned int ifill = next++; ifill < nfills; ifill = next++)
+    {
+      StagingBuffer() = &m_StagedHits[ifill];
+      fill(m_PoolFills[ifill]);
+      StagingBuffer() = nullptr;
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  // merge in input order, this gives the same raw hit maps as filling one input after the other
+  for (unsigned int ifill = 0; ifill < nfills; ++ifill)
+  {
+    ReplayStagedHits(m_StagedHits[ifill]);
+    m_StagedHits[ifill].clear();
+    CheckRunNumber(m_PoolFills[ifill].input);
+  }
+  m_PoolFills.clear();
+}
+
+void Fun4AllStreamingInputManager::ReplayStagedHits(const std::vector<StagedHit> &staged)
+{
+  for (const auto &stagedhit : staged)
+  {
+    switch (stagedhit.type)
+    {
+    case StagedHit::INTTHIT:
+      AddInttRawHit(stagedhit.bclk, static_cast<InttRawHit *>(stagedhit.hit));
+      break;
+    case StagedHit::MICROMEGASHIT:
+      AddMicromegasRawHit(stagedhit.bclk, static_cast<MicromegasRawHit *>(stagedhit.hit));
+      break;
+    case StagedHit::MVTXFEEID:
+      AddMvtxFeeIdInfo(stagedhit.bclk, static_cast<uint16_t>(stagedhit.value >> 32U), static_cast<uint32_t>(stagedhit.value));
+      break;
+    case StagedHit::MVTXHIT:
+      AddMvtxRawHit(stagedhit.bclk, static_cast<MvtxRawHit *>(stagedhit.hit));
+      break;
+    case StagedHit::MVTXL1TRG:
+      AddMvtxL1TrgBco(stagedhit.bclk, stagedhit.value);
+      break;
+    case StagedHit::TPCHIT:
+      AddTpcRawHit(stagedhit.bclk, static_cast<TpcRawHit *>(stagedhit.hit));
+      break;
+    }
+  }
+}
+
+std::vector<Fun4AllStreamingInputManager::StagedHit> *&Fun4AllStreamingInputManager::StagingBuffer()
+{
+  // only set on the worker threads of RunPoolFills()
+  static thread_local std::vector<StagedHit> *staging = nullptr;
+  return staging;
 }
+
+void Fun4AllStreamingInputManager::CheckRunNumber(SingleStreamingInput *input)
+{
+  if (m_RunNumber == 0)
+  {
+    m_RunNumber = input->RunNumber();
+    SetRunNumber(m_RunNumber);
+  }
+  else
+  {
+    if (m_RunNumber != input->RunNumber())
+    {
+      std::cout << PHWHERE << " Run Number mismatch, run is "
+                << m_RunNumber << ", " << input->Name() << " reads "
+                << input->RunNumber() << std::endl;
+      std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
+      Print("INPUTFILES");
+      gSystem->Exit(1);
+      exit(1);
+    }
+  }
+}
+
 void Fun4AllStreamingInputManager::createQAHistos()
 {
   auto hm = QAHistManagerDef::getHistoManager();
@@ -7,9 +7,11 @@
 
 #include <fun4all/Fun4AllInputManager.h>
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 class SingleStreamingInput;
 class Gl1Packet;
@@ -64,6 +66,8 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   int FillMvtxPool();
   int FillTpcPool();
   void Streaming(bool b = true) { m_StreamingFlag = b; }
+  //! number of threads filling the input pools, 0 = one per core
+  void SetNumThreads(const unsigned int nthreads) { m_nthreads = nthreads; }
 
   void runMvtxTriggered(bool b = true) { m_mvtx_is_triggered = b; }
 
@@ -100,7 +104,43 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
     unsigned int EventFoundCounter{0};
   };
 
+  //! Add*() call of an input which fills its pool on a worker thread
+  struct StagedHit
+  {
+    enum Type : unsigned char
+    {
+      INTTHIT,
+      MICROMEGASHIT,
+      MVTXFEEID,
+      MVTXHIT,
+      MVTXL1TRG,
+      TPCHIT
+    };
+    Type type;
+    uint64_t bclk;
+    void *hit;       // nullptr for MVTXFEEID and MVTXL1TRG
+    uint64_t value;  // feeid << 32 | detField for MVTXFEEID, lv1 bco for MVTXL1TRG
+  };
+
+  struct PoolFill
+  {
+    SingleStreamingInput *input{nullptr};
+    uint64_t minbco{0};
+    bool bybco{true};  // false: FillPool() by number of events (micromegas)
+    const char *caller{nullptr};
+    int verbosity{0};  // print "fill pool for" above this verbosity
+  };
+
   void createQAHistos();
+  void CheckRunNumber(SingleStreamingInput *input);
+  void PrefillPools();
+  void QueueInttPool();
+  void QueueMicromegasPool();
+  void QueueMvtxPool();
+  void QueueTpcPool();
+  void ReplayStagedHits(const std::vector<StagedHit> &staged);
+  void RunPoolFills();
+  static std::vector<StagedHit> *&StagingBuffer();
 
   SyncObject *m_SyncObject{nullptr};
   PHCompositeNode *m_topNode{nullptr};
@@ -116,6 +156,7 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   unsigned int m_mvtx_negative_bco{0};
   unsigned int m_tpc_bco_range{0};
   unsigned int m_tpc_negative_bco{0};
+  unsigned int m_nthreads{1};
 
   bool m_gl1_registered_flag{false};
   bool m_intt_registered_flag{false};
@@ -137,6 +178,13 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   std::map<uint64_t, TpcRawHitInfo> m_TpcRawHitMap;
   std::map<int, std::map<int, uint64_t>> m_InttPacketFeeBcoMap;
 
+  // pool fills of the current call, run by RunPoolFills()
+  std::vector<PoolFill> m_PoolFills;
+  // Add*() calls per pool fill when filling on worker threads, merged in pool fill order
+  std::vector<std::vector<StagedHit>> m_StagedHits;
+  // subsystems whose pools were filled by PrefillPools() for this event
+  std::set<InputManagerType::enu_subsystem> m_PrefilledPools;
+
   // QA histos
   TH1 *h_refbco_mvtx{nullptr};
   TH1 *h_taggedAllFelixes_mvtx{nullptr};
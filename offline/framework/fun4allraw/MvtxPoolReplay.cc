@@ -0,0 +1,194 @@
+// Replay benchmark of mvtx_pool on a recorded MVTX (FELIX) packet file.
+//
+// usage: mvtx_pool_replay file.prdf [nevents] [nthreads,...]
+//
+// The packets of the first nevents events (0: all) are loaded into memory and
+// replayed through one mvtx_pool per packet id, once for every thread count
+// of the comma separated list (default 1). After each packet all strobes and
+// hits are read back as SingleMvtxPoolInput does. The decoding throughput is
+// reported per number of GBT links in the packet, and a digest of all
+// strobes and hits per thread count, which must not depend on it.
+
+#include "mvtx_pool.h"
+
+#include <Event/Event.h>
+#include <Event/EventTypes.h>
+#include <Event/fileEventiterator.h>
+#include <Event/packet.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr int MAXPACKETS = 10;
+
+  // FNV-1a
+  class Digest
+  {
+   public:
+    template <class T>
+    void add(T value)
+    {
+      for (size_t i = 0; i < sizeof(T); ++i)
+      {
+        m_hash ^= (static_cast<uint64_t>(value) >> (8 * i)) & 0xffU;
+        m_hash *= 0x100000001b3ULL;
+      }
+    }
+    uint64_t value() const { return m_hash; }
+
+   private:
+    uint64_t m_hash = 0xcbf29ce484222325ULL;
+  };
+
+  struct LinkCountStat
+  {
+    uint64_t npackets = 0;
+    uint64_t nbytes = 0;
+    uint64_t nhits = 0;
+    double seconds = 0;
+  };
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cout << "usage: " << argv[0] << " file.prdf [nevents] [nthreads,...]" << std::endl;
+    return 1;
+  }
+  const int nevents = (argc > 2) ? std::atoi(argv[2]) : 0;
+  std::vector<unsigned int> thread_counts;
+  {
+    std::istringstream list((argc > 3) ? argv[3] : "1");
+    std::string item;
+    while (std::getline(list, item, ','))
+    {
+      thread_counts.push_back(std::atoi(item.c_str()));
+    }
+  }
+
+  // load the packets
+  int status = 0;
+  fileEventiterator eventiterator(argv[1], status);
+  if (status)
+  {
+    std::cout << "cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+  std::vector<Event*> events;
+  std::vector<Packet*> packets;
+  Packet* plist[MAXPACKETS];
+  while (Event* evt = eventiterator.getNextEvent())
+  {
+    if (evt->getEvtType() != DATAEVENT)
+    {
+      delete evt;
+      continue;
+    }
+    events.push_back(evt);
+    const int npackets = evt->getPacketList(plist, MAXPACKETS);
+    for (int i = 0; i < npackets; ++i)
+    {
+      packets.push_back(plist[i]);
+    }
+    if (nevents > 0 && (int) events.size() >= nevents)
+    {
+      break;
+    }
+  }
+  std::cout << "loaded " << events.size() << " events, " << packets.size() << " packets" << std::endl;
+
+  for (const unsigned int nthreads : thread_counts)
+  {
+    std::map<int, std::unique_ptr<mvtx_pool>> pools;
+    std::map<size_t, LinkCountStat> stats;
+    Digest digest;
+    for (Packet* packet : packets)
+    {
+      auto& pool = pools[packet->getIdentifier()];
+      if (!pool)
+      {
+        pool = std::make_unique<mvtx_pool>();
+        pool->set_nthreads(nthreads);
+      }
+
+      uint64_t nhits = 0;
+      const auto start = std::chrono::steady_clock::now();
+      pool->addPacket(packet);
+      const size_t num_feeId = pool->get_feeidSet_size();
+      for (size_t i_fee = 0; i_fee < num_feeId; ++i_fee)
+      {
+        const auto feeId = pool->get_feeid(i_fee);
+        const auto num_strobes = pool->get_strbSet_size(feeId);
+        const auto num_L1Trgs = pool->get_trgSet_size(feeId);
+        digest.add(feeId);
+        digest.add(num_strobes);
+        digest.add(num_L1Trgs);
+        for (int iL1 = 0; iL1 < num_L1Trgs; ++iL1)
+        {
+          digest.add(pool->get_L1_IR_BCO(feeId, iL1));
+        }
+        for (int i_strb = 0; i_strb < num_strobes; ++i_strb)
+        {
+          digest.add(pool->get_TRG_IR_BCO(feeId, i_strb));
+          digest.add(pool->get_TRG_IR_BC(feeId, i_strb));
+          digest.add(pool->get_TRG_DET_FIELD(feeId, i_strb));
+          for (const auto& hit : pool->get_hits(feeId, i_strb))
+          {
+            digest.add(hit.chip_id);
+            digest.add(hit.bunchcounter);
+            digest.add(hit.row_pos);
+            digest.add(hit.col_pos);
+            ++nhits;
+          }
+        }
+      }
+      const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      auto& stat = stats[num_feeId];
+      ++stat.npackets;
+      stat.nbytes += static_cast<uint64_t>(packet->getDataLength()) * 4;
+      stat.nhits += nhits;
+      stat.seconds += seconds;
+    }
+
+    LinkCountStat total;
+    std::cout << "threads: " << nthreads << std::endl;
+    std::cout << "  links   packets        hits     MB/s  Mhits/s" << std::endl;
+    for (const auto& [nlinks, stat] : stats)
+    {
+      std::cout << std::setw(7) << nlinks << std::setw(10) << stat.npackets << std::setw(12) << stat.nhits
+                << std::fixed << std::setprecision(1) << std::setw(9) << stat.nbytes / stat.seconds / 1e6
+                << std::setprecision(2) << std::setw(9) << stat.nhits / stat.seconds / 1e6 << std::endl;
+      total.npackets += stat.npackets;
+      total.nbytes += stat.nbytes;
+      total.nhits += stat.nhits;
+      total.seconds += stat.seconds;
+    }
+    std::cout << "    all" << std::setw(10) << total.npackets << std::setw(12) << total.nhits
+              << std::setprecision(1) << std::setw(9) << total.nbytes / total.seconds / 1e6
+              << std::setprecision(2) << std::setw(9) << total.nhits / total.seconds / 1e6 << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << "  digest: " << std::hex << digest.value() << std::dec << std::endl;
+  }
+
+  for (Packet* packet : packets)
+  {
+    delete packet;
+  }
+  for (Event* evt : events)
+  {
+    delete evt;
+  }
+  return 0;
+}
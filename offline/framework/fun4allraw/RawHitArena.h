@@ -0,0 +1,77 @@
+#ifndef FUN4ALLRAW_RAWHITARENA_H
+#define FUN4ALLRAW_RAWHITARENA_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*!
+ * raw hits of a streaming input, kept per beam clock in the arenas of v4 raw
+ * hit containers (TpcRawHitContainerv4, MicromegasRawHitContainerv4) until
+ * the input manager has copied them to the event container.
+ *
+ * Hits are created with AddHit() and add_adc_waveform() on the container
+ * returned by get_container(). A container is never filled past the number of
+ * hits it reserved, so the hits do not move and the pointers handed to the
+ * input manager stay valid until their beam clock is released. Released
+ * containers are reset and reused for the next beam clocks.
+ */
+template <class Container>
+class RawHitArena
+{
+ public:
+  //! nhits is the number of hits reserved by each container
+  explicit RawHitArena(const unsigned int nhits)
+    : m_nhits(nhits)
+  {
+  }
+
+  //! container with room for one more hit of beam clock bco
+  Container *get_container(const uint64_t bco)
+  {
+    auto &containers = m_containers[bco];
+    if (containers.empty() || containers.back()->is_full())
+    {
+      if (m_free.empty())
+      {
+        containers.push_back(std::make_unique<Container>(m_nhits));
+      }
+      else
+      {
+        containers.push_back(std::move(m_free.back()));
+        m_free.pop_back();
+      }
+    }
+    return containers.back().get();
+  }
+
+  //! drop all hits of beam clock bco, their containers are kept for reuse
+  void release(const uint64_t bco)
+  {
+    const auto iter = m_containers.find(bco);
+    if (iter == m_containers.end())
+    {
+      return;
+    }
+
+    for (auto &container : iter->second)
+    {
+      container->Reset();
+      m_free.push_back(std::move(container));
+    }
+    m_containers.erase(iter);
+  }
+
+ private:
+  unsigned int m_nhits = 0;
+
+  //! containers in use, per beam clock
+  std::map<uint64_t, std::vector<std::unique_ptr<Container>>> m_containers;
+
+  //! released containers
+  std::vector<std::unique_ptr<Container>> m_free;
+};
+
+#endif
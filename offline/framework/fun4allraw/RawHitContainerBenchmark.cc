@@ -0,0 +1,277 @@
+// Benchmark of the TPC raw hit containers as filled by the streaming input.
+//
+// usage: raw_hit_container_benchmark [nevents] [nhits] [nwaveforms] [nsamples]
+//
+// Each event has nhits synthetic hits with nwaveforms waveforms of nsamples
+// ADC values. Three ways to get them from the decoder to the event container
+// are compared:
+//  - v3 hits: one TpcRawHitv3 and one vector per waveform, copied to a
+//    TpcRawHitContainerv3, as done before RawHitArena
+//  - arena -> v3: hits created in a RawHitArena<TpcRawHitContainerv4>, as
+//    TpcTimeFrameBuilder does, copied to a TpcRawHitContainerv3 (DST default)
+//  - arena -> v4: the same, copied to a TpcRawHitContainerv4
+// For each, the heap allocations per event are counted and the time per
+// event is reported for filling (decode and copy to the event container) and
+// unpacking (reading all hits back through the AdcIterator, as
+// TpcCombinedRawDataUnpacker does, and resetting the containers). The
+// Micromegas containers share the same code paths.
+//
+// A digest of all unpacked hits is printed, which must be identical for the
+// three. Returns 1 if it is not.
+
+#include "RawHitArena.h"
+
+#include <ffarawobjects/TpcRawHitContainerv3.h>
+#include <ffarawobjects/TpcRawHitContainerv4.h>
+#include <ffarawobjects/TpcRawHitv3.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+  uint64_t allocations = 0;
+
+  // FNV-1a
+  class Digest
+  {
+   public:
+    template <class T>
+    void add(T value)
+    {
+      for (size_t i = 0; i < sizeof(T); ++i)
+      {
+        m_hash ^= (static_cast<uint64_t>(value) >> (8 * i)) & 0xffU;
+        m_hash *= 0x100000001b3ULL;
+      }
+    }
+    uint64_t value() const { return m_hash; }
+
+   private:
+    uint64_t m_hash = 0xcbf29ce484222325ULL;
+  };
+
+  // raw data of one event, as found in the DAM packets
+  struct Waveform
+  {
+    uint16_t start_t = 0;
+    std::vector<uint16_t> adc;
+  };
+
+  struct RawHit
+  {
+    uint64_t bco = 0;
+    uint16_t fee = 0;
+    uint16_t channel = 0;
+    std::vector<Waveform> waveforms;
+  };
+
+  std::vector<RawHit> make_event(int ievent, int nhits, int nwaveforms, int nsamples)
+  {
+    std::vector<RawHit> hits(nhits);
+    uint32_t seed = 12345U + ievent;
+    for (int ihit = 0; ihit < nhits; ++ihit)
+    {
+      auto& hit = hits[ihit];
+      hit.bco = ievent * 1000 + ihit % 7;
+      hit.fee = ihit % 26;
+      hit.channel = ihit % 256;
+      hit.waveforms.resize(nwaveforms);
+      for (int iwf = 0; iwf < nwaveforms; ++iwf)
+      {
+        hit.waveforms[iwf].start_t = iwf * (nsamples + 10);
+        hit.waveforms[iwf].adc.resize(nsamples);
+        for (auto& adc : hit.waveforms[iwf].adc)
+        {
+          seed = seed * 1664525U + 1013904223U;
+          adc = (seed >> 16U) & 0x3ffU;
+        }
+      }
+    }
+    return hits;
+  }
+
+  void set_hit(TpcRawHit* hit, const RawHit& raw)
+  {
+    hit->set_bco(raw.bco);
+    hit->set_packetid(4001);
+    hit->set_fee(raw.fee);
+    hit->set_channel(raw.channel);
+    hit->set_type(0);
+    hit->set_samples(1024);
+  }
+
+  // producer: one TpcRawHitv3 and one vector per waveform
+  class V3Producer
+  {
+   public:
+    void fill(const std::vector<RawHit>& event, TpcRawHitContainer* container)
+    {
+      for (const auto& raw : event)
+      {
+        auto hit = std::make_unique<TpcRawHitv3>();
+        set_hit(hit.get(), raw);
+        for (const auto& waveform : raw.waveforms)
+        {
+          std::vector<uint16_t> adc(waveform.adc.begin(), waveform.adc.end());
+          hit->move_adc_waveform(waveform.start_t, std::move(adc));
+        }
+        container->AddHit(hit.get());
+      }
+    }
+  };
+
+  // producer: hits and waveforms in a RawHitArena, released once copied
+  class ArenaProducer
+  {
+   public:
+    void fill(const std::vector<RawHit>& event, TpcRawHitContainer* container)
+    {
+      std::vector<TpcRawHit*> hits;
+      hits.reserve(event.size());
+      for (const auto& raw : event)
+      {
+        auto* hits_container = m_arena.get_container(0);
+        TpcRawHit* hit = hits_container->AddHit();
+        set_hit(hit, raw);
+        for (const auto& waveform : raw.waveforms)
+        {
+          hits_container->add_adc_waveform(waveform.start_t, waveform.adc.data(), waveform.adc.size());
+        }
+        hits.push_back(hit);
+      }
+      for (auto* hit : hits)
+      {
+        container->AddHit(hit);
+      }
+      m_arena.release(0);
+    }
+
+   private:
+    RawHitArena<TpcRawHitContainerv4> m_arena{1024};
+  };
+
+  void unpack(TpcRawHitContainer* container, Digest& digest)
+  {
+    const unsigned int nhits = container->get_nhits();
+    for (unsigned int ihit = 0; ihit < nhits; ++ihit)
+    {
+      const TpcRawHit* hit = container->get_hit(ihit);
+      digest.add(hit->get_bco());
+      digest.add(hit->get_fee());
+      digest.add(hit->get_channel());
+      std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(hit->CreateAdcIterator());
+      for (adc_iterator->First(); !adc_iterator->IsDone(); adc_iterator->Next())
+      {
+        digest.add(adc_iterator->CurrentTimeBin());
+        digest.add(adc_iterator->CurrentAdc());
+      }
+    }
+  }
+
+  struct Result
+  {
+    double fill_us = 0;
+    double unpack_us = 0;
+    double allocations = 0;
+    uint64_t digest = 0;
+  };
+
+  template <class Producer>
+  Result run(const std::vector<std::vector<RawHit>>& events, TpcRawHitContainer* container)
+  {
+    Producer producer;
+    Digest digest;
+    double fill_seconds = 0;
+    double unpack_seconds = 0;
+    uint64_t nallocations = 0;
+
+    // the first event is not counted, it sizes the reused buffers
+    for (size_t ievent = 0; ievent < events.size(); ++ievent)
+    {
+      const uint64_t allocations_start = allocations;
+      const auto start = std::chrono::steady_clock::now();
+      producer.fill(events[ievent], container);
+      const auto filled = std::chrono::steady_clock::now();
+      unpack(container, digest);
+      container->Reset();
+      const auto stop = std::chrono::steady_clock::now();
+      if (ievent > 0)
+      {
+        fill_seconds += std::chrono::duration<double>(filled - start).count();
+        unpack_seconds += std::chrono::duration<double>(stop - filled).count();
+        nallocations += allocations - allocations_start;
+      }
+    }
+
+    const double nevents = (events.size() > 1) ? events.size() - 1 : 1;
+    return {fill_seconds / nevents * 1e6, unpack_seconds / nevents * 1e6, nallocations / nevents, digest.value()};
+  }
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  if (void* pointer = std::malloc(size ? size : 1))
+  {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept
+{
+  std::free(pointer);
+}
+
+int main(int argc, char* argv[])
+{
+  const int nevents = (argc > 1) ? std::atoi(argv[1]) : 100;
+  const int nhits = (argc > 2) ? std::atoi(argv[2]) : 5000;
+  const int nwaveforms = (argc > 3) ? std::atoi(argv[3]) : 2;
+  const int nsamples = (argc > 4) ? std::atoi(argv[4]) : 20;
+
+  std::vector<std::vector<RawHit>> events;
+  for (int ievent = 0; ievent < nevents + 1; ++ievent)
+  {
+    events.push_back(make_event(ievent, nhits, nwaveforms, nsamples));
+  }
+  std::cout << nevents << " events, " << nhits << " hits, " << nwaveforms << " waveforms of "
+            << nsamples << " samples per hit" << std::endl;
+
+  TpcRawHitContainerv3 container_v3;
+  TpcRawHitContainerv3 container_arena_v3;
+  TpcRawHitContainerv4 container_arena_v4;
+  const std::vector<std::pair<std::string, Result>> results = {
+      {"v3 hits -> v3", run<V3Producer>(events, &container_v3)},
+      {"arena -> v3", run<ArenaProducer>(events, &container_arena_v3)},
+      {"arena -> v4", run<ArenaProducer>(events, &container_arena_v4)}};
+
+  std::cout << "                 allocs/event  fill us/event  unpack us/event  digest" << std::endl;
+  bool same = true;
+  for (const auto& [name, result] : results)
+  {
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << result.allocations << std::setw(15) << result.fill_us
+              << std::setw(17) << result.unpack_us << "  " << std::hex << result.digest << std::dec << std::endl;
+    same = same && (result.digest == results.front().second.digest);
+  }
+  if (!same)
+  {
+    std::cout << "digests differ" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -4,7 +4,6 @@
 #include "InputManagerType.h"
 
 #include <ffarawobjects/MicromegasRawHitContainerv3.h>
-#include <ffarawobjects/MicromegasRawHitv3.h>
 
 #include <fun4all/Fun4AllHistoManager.h>
 #include <qautils/QAHistManagerDef.h>
@@ -291,8 +290,9 @@ void SingleMicromegasPoolInput_v1::FillPool(const unsigned int /*nbclks*/)
           continue;
         }
 
-        // create new hit
-        auto newhit = std::make_unique<MicromegasRawHitv3>();
+        // create new hit, in the arena of its beam clock
+        auto container = m_hitArena.get_container(gtm_bco);
+        auto newhit = container->AddHit();
         newhit->set_bco(fee_bco);
         newhit->set_gtm_bco(gtm_bco);
 
@@ -313,10 +313,10 @@ void SingleMicromegasPoolInput_v1::FillPool(const unsigned int /*nbclks*/)
           }
 
           uint16_t first = is;
-          MicromegasRawHitv3::adc_list_t values;
+          m_adc_values.clear();
           for( ;is<samples && (adc = packet->iValue(wf, is)) != m_adc_invalid; ++is )
-          { values.push_back(adc); }
-          newhit->move_adc_waveform( first, std::move(values));
+          { m_adc_values.push_back(adc); }
+          container->add_adc_waveform( first, m_adc_values.data(), m_adc_values.size());
 
         }
 
@@ -333,10 +333,10 @@ void SingleMicromegasPoolInput_v1::FillPool(const unsigned int /*nbclks*/)
 
         if (StreamingInputManager())
         {
-          StreamingInputManager()->AddMicromegasRawHit(gtm_bco, newhit.get());
+          StreamingInputManager()->AddMicromegasRawHit(gtm_bco, newhit);
         }
 
-        m_MicromegasRawHitMap[gtm_bco].push_back(newhit.release());
+        m_MicromegasRawHitMap[gtm_bco].push_back(newhit);
       }
     }
   }
@@ -405,8 +405,8 @@ void SingleMicromegasPoolInput_v1::CleanupUsedPackets(const uint64_t bclk, bool
         ++m_waveform_count_dropped_pool[rawhit->get_packetid()];
         h_waveform_count_dropped_pool->Fill( std::to_string(rawhit->get_packetid()).c_str(), 1 );
       }
-      delete rawhit;
     }
+    m_hitArena.release(iter->first);
   }
 
   // cleanup bco stacks
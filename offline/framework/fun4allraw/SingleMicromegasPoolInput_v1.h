@@ -2,8 +2,11 @@
 #define FUN4ALLRAW_SINGLEMICROMEGASPOOLINPUT_V1_H
 
 #include "MicromegasBcoMatchingInformation.h"
+#include "RawHitArena.h"
 #include "SingleStreamingInput.h"
 
+#include <ffarawobjects/MicromegasRawHitContainerv4.h>
+
 #include <phool/PHTimer.h>
 
 #include <array>
@@ -51,6 +54,9 @@ class SingleMicromegasPoolInput_v1 : public SingleStreamingInput
   void createQAHistos() override;
 
  private:
+  /// number of raw hits reserved per arena container
+  static constexpr unsigned int kBclkArenaHits = 256;
+
   std::array<Packet *, 10> plist{};
   unsigned int m_NumSpecialEvents{0};
   unsigned int m_BcoRange{0};
@@ -73,6 +79,12 @@ class SingleMicromegasPoolInput_v1 : public SingleStreamingInput
   //! store list of raw hits matching a given bco
   std::map<uint64_t, std::vector<MicromegasRawHit *>> m_MicromegasRawHitMap;
 
+  //! raw hits of the beam clocks in m_MicromegasRawHitMap, released in CleanupUsedPackets
+  RawHitArena<MicromegasRawHitContainerv4> m_hitArena{kBclkArenaHits};
+
+  //! adc values of the current waveform, reused between waveforms
+  std::vector<uint16_t> m_adc_values;
+
   //! store current list of BCO on a per fee basis.
   /** only packets for which a given FEE have data are stored */
   std::map<int, uint64_t> m_FEEBclkMap;
@@ -4,7 +4,6 @@
 #include "InputManagerType.h"
 
 #include <ffarawobjects/MicromegasRawHitContainerv3.h>
-#include <ffarawobjects/MicromegasRawHitv3.h>
 
 #include <fun4all/Fun4AllHistoManager.h>
 #include <qautils/QAHistManagerDef.h>
@@ -328,8 +327,8 @@ void SingleMicromegasPoolInput_v2::CleanupUsedPackets(const uint64_t bclk, bool
         ++m_waveform_count_dropped_pool[rawhit->get_packetid()];
         h_waveform_count_dropped_pool->Fill( std::to_string(rawhit->get_packetid()).c_str(), 1 );
       }
-      delete rawhit;
     }
+    m_hitArena.release(iter->first);
   }
 
   // cleanup bco stacks
@@ -766,6 +765,19 @@ void SingleMicromegasPoolInput_v2::process_fee_data( int packet_id, unsigned int
     if( payload.type == HEARTBEAT_T )
     { continue; }
 
+    // create new hit, in the arena of its beam clock
+    auto container = m_hitArena.get_container(gtm_bco);
+    auto newhit = container->AddHit();
+    newhit->set_bco(fee_bco);
+    newhit->set_gtm_bco(gtm_bco);
+
+    // packet id, fee id, channel, etc.
+    newhit->set_packetid(packet_id);
+    newhit->set_fee(fee_id);
+    newhit->set_channel(payload.channel);
+    newhit->set_sampaaddress(payload.sampa_address);
+    newhit->set_sampachannel(payload.sampa_channel);
+
     // store data from string
     // Format is (N sample) (start time), (1st sample)... (Nth sample)
     size_t pos = HEADER_LENGTH;
@@ -789,38 +801,22 @@ void SingleMicromegasPoolInput_v2::process_fee_data( int packet_id, unsigned int
         break;
       }
 
-      std::vector<uint16_t> adc(samples);
+      m_adc_values.resize(samples);
       for (int i = 0; i < samples; ++i)
-      { adc[i] = data_buffer[pos++]; }
+      { m_adc_values[i] = data_buffer[pos++]; }
 
       // add
-      payload.waveforms.emplace_back(start_t,std::move(adc));
+      container->add_adc_waveform(start_t, m_adc_values.data(), samples);
     }
 
-    // create new hit
-    auto newhit = std::make_unique<MicromegasRawHitv3>();
-    newhit->set_bco(fee_bco);
-    newhit->set_gtm_bco(gtm_bco);
-
-    // packet id, fee id, channel, etc.
-    newhit->set_packetid(packet_id);
-    newhit->set_fee(fee_id);
-    newhit->set_channel(payload.channel);
-    newhit->set_sampaaddress(payload.sampa_address);
-    newhit->set_sampachannel(payload.sampa_channel);
-
-    // adc values
-    for( auto&& [start_t, adc]:payload.waveforms )
-    { newhit->move_adc_waveform(start_t,std::move(adc)); }
-
     m_BeamClockFEE[gtm_bco].insert(fee_id);
     m_FEEBclkMap[fee_id] = gtm_bco;
 
     if (StreamingInputManager())
     {
-      StreamingInputManager()->AddMicromegasRawHit(gtm_bco, newhit.get());
+      StreamingInputManager()->AddMicromegasRawHit(gtm_bco, newhit);
     }
 
-    m_MicromegasRawHitMap[gtm_bco].push_back(newhit.release());
+    m_MicromegasRawHitMap[gtm_bco].push_back(newhit);
   }
 }
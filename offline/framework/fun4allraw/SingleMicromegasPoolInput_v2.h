@@ -2,8 +2,11 @@
 #define FUN4ALLRAW_SINGLEMICROMEGASPOOLINPUT_V2_H
 
 #include "MicromegasBcoMatchingInformation_v2.h"
+#include "RawHitArena.h"
 #include "SingleStreamingInput.h"
 
+#include <ffarawobjects/MicromegasRawHitContainerv4.h>
+
 #include <phool/PHTimer.h>
 
 #include <array>
@@ -61,6 +64,9 @@ class SingleMicromegasPoolInput_v2 : public SingleStreamingInput
 
   // Length for the 256-bit wide Round Robin Multiplexer for the data stream
   static constexpr size_t DAM_DMA_WORD_LENGTH = 16;
+
+  /// number of raw hits reserved per arena container
+  static constexpr unsigned int kBclkArenaHits = 256;
   //@}
 
   //! DMA word structure
@@ -106,6 +112,12 @@ class SingleMicromegasPoolInput_v2 : public SingleStreamingInput
   //! store list of raw hits matching a given bco
   std::map<uint64_t, std::vector<MicromegasRawHit *>> m_MicromegasRawHitMap;
 
+  //! raw hits of the beam clocks in m_MicromegasRawHitMap, released in CleanupUsedPackets
+  RawHitArena<MicromegasRawHitContainerv4> m_hitArena{kBclkArenaHits};
+
+  //! adc values of the current waveform, reused between waveforms
+  std::vector<uint16_t> m_adc_values;
+
   //! store current list of BCO on a per fee basis.
   /** only packets for which a given FEE have data are stored */
   std::map<int, uint64_t> m_FEEBclkMap;
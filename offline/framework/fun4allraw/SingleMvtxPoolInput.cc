@@ -110,6 +110,7 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
           std::cout << "starting new mvtx pool for packet " << plist[i]->getIdentifier() << std::endl;
         }
         poolmap[plist[i]->getIdentifier()] = new mvtx_pool();
+        poolmap[plist[i]->getIdentifier()]->set_nthreads(m_nthreads);
       }
       poolmap[plist[i]->getIdentifier()]->addPacket(plist[i]);
       delete plist[i];
@@ -170,19 +171,19 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
               std::cout << " GBT: " << link.gbtid << ", bco: 0x" << std::hex << strb_bco << std::dec;
               std::cout << ", n_hits: " << num_hits << std::endl;
             }
-            auto hits = pool->get_hits(feeId, i_strb);
-            for (auto &&hit : hits)
+            const auto hits = pool->get_hits(feeId, i_strb);
+            for (const auto &hit : hits)
             {
               auto newhit = std::make_unique<MvtxRawHitv1>();
               newhit->set_bco(strb_bco);
               newhit->set_strobe_bc(strb_bc);
-              newhit->set_chip_bc(hit->bunchcounter);
+              newhit->set_chip_bc(hit.bunchcounter);
               newhit->set_layer_id(link.layer);
               newhit->set_stave_id(link.stave);
               newhit->set_chip_id(
-                  MvtxRawDefs::gbtChipId_to_staveChipId[link.gbtid][hit->chip_id]);
-              newhit->set_row(hit->row_pos);
-              newhit->set_col(hit->col_pos);
+                  MvtxRawDefs::gbtChipId_to_staveChipId[link.gbtid][hit.chip_id]);
+              newhit->set_row(hit.row_pos);
+              newhit->set_col(hit.col_pos);
               if (StreamingInputManager())
               {
                 StreamingInputManager()->AddMvtxRawHit(strb_bco, newhit.get());
@@ -34,6 +34,8 @@ class SingleMvtxPoolInput : public SingleStreamingInput
   bool  GetReadStrWidthFromDB(){ return m_readStrWidthFromDB; }
   void  SetStrobeWidth(const float val) { m_strobeWidth = val; }
   float GetStrobeWidth() { return m_strobeWidth; }
+  //! number of threads decoding the GBT links of a packet, 0 = one per core
+  void  SetNumThreads(const unsigned int nthreads) { m_nthreads = nthreads; }
 
  protected:
  private:
@@ -52,6 +54,7 @@ class SingleMvtxPoolInput : public SingleStreamingInput
 
   bool m_readStrWidthFromDB = true;
   float m_strobeWidth = 0;
+  unsigned int m_nthreads = 1;
 };
 
 #endif
@@ -15,6 +15,7 @@
 #include <Event/EventTypes.h>
 #include <Event/Eventiterator.h>
 
+#include <atomic>
 #include <memory>
 #include <set>
 
@@ -167,16 +168,15 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
       else
       {
         int m_nWaveFormInFrame = packet->iValue(0, "NR_WF");
-        static int once = 0;
+        static std::atomic<int> once(0);
         for (int wf = 0; wf < m_nWaveFormInFrame; wf++)
         {
           if (m_TpcRawHitMap[gtm_bco].size() > 20000)
           {
-            if (!once)
+            if (once++ == 0)
             {
               std::cout << "too many hits" << std::endl;
             }
-            once++;
             continue;
           }
           else
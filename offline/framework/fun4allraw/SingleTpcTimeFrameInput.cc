@@ -28,7 +28,9 @@
 #include <Event/Eventiterator.h>
 #include <Event/fileEventiterator.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 
 SingleTpcTimeFrameInput::SingleTpcTimeFrameInput(const std::string &name)
@@ -113,11 +115,9 @@ SingleTpcTimeFrameInput::TimeTracker::~TimeTracker()
 void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
 {
   {
-    static bool first = true;
-    if (first)
+    static std::atomic<bool> first(true);
+    if (first.exchange(false))
     {
-      first = false;
-
       if (m_SelectedPacketIDs.size())
       {
         std::cout << "SingleTpcTimeFrameInput::" << Name() << " : note, only processing packets with ID: ";
@@ -290,7 +290,12 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
           std::cout << __PRETTY_FUNCTION__ << ": Creating TpcTimeFrameBuilder for packet id: " << packet_id << std::endl;
         }
 
-        m_TpcTimeFrameBuilderMap[packet_id] = new TpcTimeFrameBuilder(packet_id);
+        {
+          // the builder registers its histograms, pools can be filled on several threads
+          static std::mutex builder_mutex;
+          std::lock_guard<std::mutex> lock(builder_mutex);
+          m_TpcTimeFrameBuilderMap[packet_id] = new TpcTimeFrameBuilder(packet_id);
+        }
         m_TpcTimeFrameBuilderMap[packet_id]->setVerbosity(Verbosity());
       }
 
@@ -4,7 +4,6 @@
 #include <Event/packet.h>
 
 #include <ffarawobjects/TpcRawHitv2.h>
-#include <ffarawobjects/TpcRawHitv3.h>
 #include <phool/PHTimer.h>  // for PHTimer
 
 #include <fun4all/Fun4AllHistoManager.h>
@@ -18,14 +17,43 @@
 #include <TString.h>
 #include <TVector3.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
 
 using namespace std;
 
+namespace
+{
+  // CRC16 of the FEE packets: polynomial 0x8005, initial value 0xffff. The FEE
+  // computes it LSB first on bit reversed words and reverses the result, which is
+  // the same as the MSB first CRC on the words as they are, one byte per table lookup
+  constexpr uint16_t crc16_poly = 0x8005U;
+
+  constexpr std::array<uint16_t, 256> make_crc16_table()
+  {
+    std::array<uint16_t, 256> table{};
+    for (unsigned int byte = 0; byte < 256; ++byte)
+    {
+      uint16_t crc = static_cast<uint16_t>(byte << 8U);
+      for (int bit = 0; bit < 8; ++bit)
+      {
+        crc = (crc & 0x8000U) ? static_cast<uint16_t>(static_cast<uint16_t>(crc << 1U) ^ crc16_poly) : static_cast<uint16_t>(crc << 1U);
+      }
+      table[byte] = crc;
+    }
+    return table;
+  }
+
+  constexpr std::array<uint16_t, 256> crc16_table = make_crc16_table();
+}  // namespace
+
 TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
   : m_packet_id(packet_id)
   , m_HistoPrefix("TpcTimeFrameBuilder_Packet" + to_string(packet_id))
@@ -162,15 +190,6 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
 
 TpcTimeFrameBuilder::~TpcTimeFrameBuilder()
 {
-  for (auto& timeFrameEntry : m_timeFrameMap)
-  {
-    while (!timeFrameEntry.second.empty())
-    {
-      delete timeFrameEntry.second.back();
-      timeFrameEntry.second.pop_back();
-    }
-  }
-
   if (m_packetTimer)
   {
     delete m_packetTimer;
@@ -230,7 +249,7 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
               << std::endl;
   }
 
-  for (auto it = m_timeFrameMap.begin(); it != m_timeFrameMap.end();)
+  for (auto it = m_timeFrames.begin(); it != m_timeFrames.end();)
   {
     if (it->first + GL1_BCO_MATCH_WINDOW < bclk_rollover_corrected)
     {
@@ -240,11 +259,11 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
                   << ":DROPPED: BCO " << std::hex << it->first << std::dec
                   << " dropped for gtm_bco: 0x" << std::hex << gtm_bco << std::dec
                   << " and bclk_rollover_corrected 0x" << std::hex
-                  << bclk_rollover_corrected << std::dec << ". m_timeFrameMap:" << std::endl;
+                  << bclk_rollover_corrected << std::dec << ". m_timeFrames:" << std::endl;
 
         // if (m_verbosity >= 3)
         {
-          for (const auto& timeframe : m_timeFrameMap)
+          for (const auto& timeframe : m_timeFrames)
           {
             std::cout << "- BCO in map: 0x" << std::hex << timeframe.first << std::dec
                       << "(Diff:" << int64_t(timeframe.first) - int64_t(bclk_rollover_corrected)
@@ -258,11 +277,8 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
       m_hNorm->Fill("GTM_TimeFrame_Dropped_Hit_Sum", it->second.size());
       assert(h_GTMClockDiff_Dropped);
       h_GTMClockDiff_Dropped->Fill(int64_t(it->first) - int64_t(bclk_rollover_corrected));
-      for (const auto& hit : it->second)
-      {
-        delete hit;
-      }
-      it = m_timeFrameMap.erase(it);
+      m_hitArena.release(it->first);
+      it = m_timeFrames.erase(it);
     }
     else if (it->first < bclk_rollover_corrected + GL1_BCO_MATCH_WINDOW)
     {
@@ -272,9 +288,9 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
                   << ":PASS: BCO " << std::hex << it->first << std::dec
                   << " matched for gtm_bco: 0x" << std::hex << gtm_bco << std::dec
                   << " and bclk_rollover_corrected 0x" << std::hex
-                  << bclk_rollover_corrected << std::dec << ". m_timeFrameMap:" << std::endl;
+                  << bclk_rollover_corrected << std::dec << ". m_timeFrames:" << std::endl;
 
-        for (const auto& timeframe : m_timeFrameMap)
+        for (const auto& timeframe : m_timeFrames)
         {
           std::cout << "- BCO in map: 0x" << std::hex << timeframe.first << std::dec
                     << "(Diff:" << int64_t(timeframe.first) - int64_t(bclk_rollover_corrected)
@@ -304,11 +320,11 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
     std::cout << __PRETTY_FUNCTION__ << "\t- packet " << m_packet_id
               << ":WARNING: BCO no match for gtm_bco: 0x" << std::hex << gtm_bco << std::dec
               << "and bclk_rollover_corrected 0x" << std::hex
-              << bclk_rollover_corrected << std::dec << ". m_timeFrameMap:" << std::endl;
+              << bclk_rollover_corrected << std::dec << ". m_timeFrames:" << std::endl;
 
     if (m_verbosity >= 2)
     {
-      for (const auto& timeframe : m_timeFrameMap)
+      for (const auto& timeframe : m_timeFrames)
       {
         std::cout << "- BCO in map: 0x" << std::hex << timeframe.first << std::dec
                   << "(Diff:" << int64_t(timeframe.first) - int64_t(bclk_rollover_corrected) << ")" << std::endl;
@@ -318,7 +334,7 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
 
   m_hNorm->Fill("GTM_TimeFrame_Unmatched", 1);
   assert(h_GTMClockDiff_Unmatched);
-  for (const auto& timeframe : m_timeFrameMap)
+  for (const auto& timeframe : m_timeFrames)
   {
     h_GTMClockDiff_Unmatched->Fill(int64_t(timeframe.first) - int64_t(bclk_rollover_corrected));
   }
@@ -342,7 +358,7 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
     if (m_verbosity > 1)
     {
       std::cout << __PRETTY_FUNCTION__ << "\t- packet " << m_packet_id
-                << ": cleaning up previous processed packet in m_timeFrameMap at clock 0x"
+                << ": cleaning up previous processed packet in m_timeFrames at clock 0x"
                 << std::hex
                 << bco_completed << std::dec
                 << " for CleanupUsedPackets(const uint64_t& bclk) call at bclk 0x" << std::hex
@@ -350,19 +366,17 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
                 << " Diff:" << int64_t(bco_completed) - int64_t(bclk) << std::endl;
     }
 
-    auto it = m_timeFrameMap.find(bco_completed);
+    auto it = std::lower_bound(m_timeFrames.begin(), m_timeFrames.end(), bco_completed,
+                               [](const TimeFrame& timeframe, const uint64_t& bco)
+                               { return timeframe.first < bco; });
 
-    // assert(it != m_timeFrameMap.end());  // strong workflow check disabled
+    // assert(it != m_timeFrames.end());  // strong workflow check disabled
     // this can happen if TPC GL1 tagger is shifted slight ahead of the GTM BCO, but within GL1_BCO_MATCH_WINDOW
 
-    if (it != m_timeFrameMap.end())
+    if (it != m_timeFrames.end() && it->first == bco_completed)
     {
-      while (!it->second.empty())
-      {
-        delete it->second.back();
-        it->second.pop_back();
-      }
-      m_timeFrameMap.erase(it);
+      m_hitArena.release(it->first);
+      m_timeFrames.erase(it);
     }
   }
 
@@ -370,7 +384,7 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
 
   assert(m_hFEEDataStream);
 
-  for (auto it = m_timeFrameMap.begin(); it != m_timeFrameMap.end();)
+  for (auto it = m_timeFrames.begin(); it != m_timeFrames.end();)
   {
     if (it->first <= bclk_rollover_corrected)
     {
@@ -378,34 +392,49 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
       while (!it->second.empty())
       {
         m_hFEEDataStream->Fill(it->second.back()->get_fee(), "HitUnusedBeforeCleanup", 1);
-        delete it->second.back();
         it->second.pop_back();
         ++count;
       }
+      m_hitArena.release(it->first);
 
       if (m_verbosity >= 1)
       {
         std::cout << __PRETTY_FUNCTION__ << "\t- packet " << m_packet_id
-                  << ": cleaning up " << count << " TPC hits in m_timeFrameMap at clock 0x"
+                  << ": cleaning up " << count << " TPC hits in m_timeFrames at clock 0x"
                   << std::hex
                   << it->first << std::dec
                   << " for <= bclk_rollover_corrected 0x" << std::hex
                   << bclk_rollover_corrected << std::dec
                   << " Diff:" << int64_t(it->first) - int64_t(bclk_rollover_corrected) << std::endl;
       }
-      m_timeFrameMap.erase(it++);
+      it = m_timeFrames.erase(it);
     }
     else
     {
       break;
     }
-  }  //   for (auto it = m_timeFrameMap.begin(); it != m_timeFrameMap.end();)
+  }  //   for (auto it = m_timeFrames.begin(); it != m_timeFrames.end();)
+}
+
+std::vector<TpcRawHit*>& TpcTimeFrameBuilder::insertTimeFrame(const uint64_t& gtm_bco)
+{
+  // search from the back, the hits of a packet belong to the latest few time frames
+  auto it = m_timeFrames.end();
+  while (it != m_timeFrames.begin() && std::prev(it)->first > gtm_bco)
+  {
+    --it;
+  }
+  if (it != m_timeFrames.begin() && std::prev(it)->first == gtm_bco)
+  {
+    return std::prev(it)->second;
+  }
+  return m_timeFrames.emplace(it, gtm_bco, std::vector<TpcRawHit*>())->second;
 }
 
 int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 {
-  static size_t call_count = 0;
-  ++call_count;
+  static std::atomic<size_t> call_counter(0);
+  const size_t call_count = ++call_counter;
 
   if (m_verbosity > 1)
   {
@@ -528,10 +557,7 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 
       if (fee_id < MAX_FEECOUNT)
       {
-        for (const uint16_t& i : dma_word_data.data)
-        {
-          m_feeData[fee_id].push_back(i);
-        }
+        m_feeData[fee_id].append(dma_word_data.data, DAM_DMA_WORD_LENGTH - 1);
         m_hNorm->Fill("DMA_WORD_FEE", 1);
 
         // immediate fee buffer processing to reduce memory consuption
@@ -560,7 +586,7 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
   }
 
   // sanity check for the timeframe size
-  for (auto& timeframe : m_timeFrameMap)
+  for (auto& timeframe : m_timeFrames)
   {
     if (timeframe.second.size() > kMaxRawHitLimit)
     {
@@ -570,11 +596,8 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
            << endl;
       m_hNorm->Fill("TimeFrameSizeLimitError", 1);
 
-      while (!timeframe.second.empty())
-      {
-        delete timeframe.second.back();
-        timeframe.second.pop_back();
-      }
+      timeframe.second.clear();
+      m_hitArena.release(timeframe.first);
     }
   }
 
@@ -595,7 +618,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   }
 
   assert(fee < m_feeData.size());
-  std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  FeeDataBuffer& data_buffer = m_feeData[fee];
 
   while (HEADER_LENGTH <= data_buffer.size())
   {
@@ -607,7 +630,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE magic key at position 1 0x" << hex << data_buffer[1] << dec << endl;
       }
       m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
-      data_buffer.pop_front();
+      data_buffer.consume(1);
       continue;
     }
     assert(data_buffer[1] == FEE_PACKET_MAGIC_KEY_1);
@@ -619,7 +642,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE magic key at position 2 0x" << hex << data_buffer[2] << dec << endl;
       }
       m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
-      data_buffer.pop_front();
+      data_buffer.consume(1);
       continue;
     }
     assert(data_buffer[2] == FEE_PACKET_MAGIC_KEY_2);
@@ -633,7 +656,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE pkt_length " << pkt_length << endl;
       }
       m_hFEEDataStream->Fill(fee, "InvalidLength", 1);
-      data_buffer.pop_front();
+      data_buffer.consume(1);
       continue;
     }
 
@@ -650,6 +673,9 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
       break;
     }
 
+    // the whole packet is in the buffer, parse it in place
+    const uint16_t* packet_words = data_buffer.data();
+
     fee_payload payload;
     // continue the decoding
     payload.fee_id = fee;
@@ -665,7 +691,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
 
     if (not m_fastBCOSkip)
     {
-      auto crc_parity = crc16_parity(fee, pkt_length);
+      auto crc_parity = crc16_parity(packet_words, pkt_length);
       payload.calc_crc = crc_parity.first;
       payload.calc_parity = crc_parity.second;
 
@@ -805,18 +831,35 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
     {
       m_hFEEDataStream->Fill(fee, "RawHit", 1);
 
+      // valid packet in the buffer, create a new hit in the arena of its time frame
+      // the waveforms are appended to it while decoding
+      TpcRawHitContainerv4* timeframe_hits = nullptr;
+      if (payload.type != m_bcoMatchingInformation.HEARTBEAT_T)
+      {
+        timeframe_hits = m_hitArena.get_container(payload.gtm_bco);
+        TpcRawHit* hit = timeframe_hits->AddHit();
+        insertTimeFrame(payload.gtm_bco).push_back(hit);
+
+        hit->set_bco(payload.bx_timestamp);
+        hit->set_packetid(m_packet_id);
+        hit->set_fee(fee);
+        hit->set_channel(payload.channel);
+        hit->set_type(payload.type);
+        hit->set_samples(MAX_SAMPLES);
+        // hit->set_checksum(payload.data_crc);
+        hit->set_checksumerror(payload.data_crc != payload.calc_crc);
+        // hit->set_parity(payload.data_parity);
+        hit->set_parityerror(payload.data_parity != payload.calc_parity);
+      }
+
       // Format is (N sample) (start time), (1st sample)... (Nth sample)
       size_t pos = HEADER_LENGTH;
-      std::deque<uint16_t>::const_iterator data_buffer_iterator = data_buffer.cbegin();
-      std::advance(data_buffer_iterator, pos);
       while (pos + 2 < pkt_length)
       {
-        const uint16_t& nsamp = *data_buffer_iterator;
+        const uint16_t& nsamp = packet_words[pos];
         ++pos;
-        ++data_buffer_iterator;
-        const uint16_t& start_t = *data_buffer_iterator;
+        const uint16_t& start_t = packet_words[pos];
         ++pos;
-        ++data_buffer_iterator;
         if (m_verbosity > 3)
         {
           cout << __PRETTY_FUNCTION__ << ": nsamp: " << nsamp
@@ -844,18 +887,16 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         }
 
         const unsigned int fee_sampa_address = fee * MAX_SAMPA + payload.sampa_address;
-        std::vector<uint16_t> adc(nsamp);
+        const uint16_t* adc = packet_words + pos;
         for (int j = 0; j < nsamp; j++)
         {
-          const uint16_t& adc_value = *data_buffer_iterator;
-
-          adc[j] = adc_value;
-          m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc_value);
-
-          ++pos;
-          ++data_buffer_iterator;  //data_buffer[pos++];
+          m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc[j]);
+        }
+        pos += nsamp;
+        if (timeframe_hits)
+        {
+          timeframe_hits->add_adc_waveform(start_t, adc, nsamp);
         }
-        payload.waveforms.emplace_back(start_t, std::move(adc));
 
         //   // an exception to deal with the last sample that is missing in the current hit format
         //   if (pos + 1 == pkt_length) break;
@@ -871,31 +912,9 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         }
         m_hFEEDataStream->Fill(fee, "HitFormatErrorMismatchedLength", 1);
       }
-
-      // valid packet in the buffer, create a new hit
-      if (payload.type != m_bcoMatchingInformation.HEARTBEAT_T)
-      {
-        TpcRawHitv3* hit = new TpcRawHitv3();
-        m_timeFrameMap[payload.gtm_bco].push_back(hit);
-
-        hit->set_bco(payload.bx_timestamp);
-        hit->set_packetid(m_packet_id);
-        hit->set_fee(fee);
-        hit->set_channel(payload.channel);
-        hit->set_type(payload.type);
-        // hit->set_checksum(payload.data_crc);
-        hit->set_checksumerror(payload.data_crc != payload.calc_crc);
-        // hit->set_parity(payload.data_parity);
-        hit->set_parityerror(payload.data_parity != payload.calc_parity);
-
-        for (pair<uint16_t, std::vector<uint16_t>>& waveform : payload.waveforms)
-        {
-          hit->move_adc_waveform(waveform.first, std::move(waveform.second));
-        }
-      }
     }  //     if (not m_fastBCOSkip)
 
-    data_buffer.erase(data_buffer.begin(), data_buffer.begin() + pkt_length + 1);
+    data_buffer.consume(pkt_length + 1);
     m_hFEEDataStream->Fill(fee, "WordValid", pkt_length + 1);
 
   }  //     while (HEADER_LENGTH < data_buffer.size())
@@ -984,51 +1003,52 @@ int TpcTimeFrameBuilder::decode_gtm_data(const TpcTimeFrameBuilder::dma_word& gt
   return 0;
 }
 
-uint16_t TpcTimeFrameBuilder::reverseBits(const uint16_t x) const
-{
-  uint16_t n = x;
-  n = (static_cast<uint16_t>(n >> 1U) & 0x55555555U) | (static_cast<uint16_t>(n << 1U) & 0xaaaaaaaaU);
-  n = (static_cast<uint16_t>(n >> 2U) & 0x33333333U) | (static_cast<uint16_t>(n << 2U) & 0xccccccccU);
-  n = (static_cast<uint16_t>(n >> 4U) & 0x0f0f0f0fU) | (static_cast<uint16_t>(n << 4U) & 0xf0f0f0f0U);
-  n = (static_cast<uint16_t>(n >> 8U) & 0x00ff00ffU) | (static_cast<uint16_t>(n << 8U) & 0xff00ff00U);
-  // n = (n >> 16U) & 0x0000ffffU | (n << 16U) & 0xffff0000U;
-  return n;
-}
-
-std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint32_t fee, const uint16_t l) const
+std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint16_t* data, const uint16_t l)
 {
-  const std::deque<uint16_t>& data_buffer = m_feeData[fee];
-  assert(l < data_buffer.size());
-
-  std::deque<uint16_t>::const_iterator it = data_buffer.begin();
-
   uint16_t crc = 0xffffU;
-  uint16_t data_parity = 0U;
+  for (int i = 0; i < l; ++i)
+  {
+    crc ^= data[i];
+    crc = static_cast<uint16_t>(crc << 8U) ^ crc16_table[crc >> 8U];
+    crc = static_cast<uint16_t>(crc << 8U) ^ crc16_table[crc >> 8U];
+  }
 
-  for (int i = 0; i < l; ++i, ++it)
+  // parity on data payload only: the parity of all payload bits is the parity of their xor
+  uint16_t payload_xor = 0U;
+  for (int i = HEADER_LENGTH; i < l; ++i)
   {
-    const uint16_t& x = *it;
+    payload_xor ^= data[i];
+  }
+  uint16_t word = payload_xor & uint16_t((1U << 10U) - 1U);
+  word = word ^ static_cast<uint16_t>(word >> 1U);
+  word = word ^ static_cast<uint16_t>(word >> 2U);
+  word = word ^ static_cast<uint16_t>(word >> 4U);
+  word = word ^ static_cast<uint16_t>(word >> 8U);
+  const uint16_t data_parity = word & 1U;
 
-    crc ^= reverseBits(x);
-    for (uint16_t k = 0; k < 16U; k++)
-    {
-      crc = crc & 1U ? static_cast<uint16_t>(crc >> 1U) ^ 0xa001U : crc >> 1U;
-    }
+  return make_pair(crc, data_parity);
+}
 
-    // parity on data payload only
-    if (i >= HEADER_LENGTH)
-    {
-      // fast parity
-      uint16_t word = x & uint16_t((1U << 10U) - 1U);
-      word = word ^ static_cast<uint16_t>(word >> 1U);
-      word = word ^ static_cast<uint16_t>(word >> 2U);
-      word = word ^ static_cast<uint16_t>(word >> 4U);
-      word = word ^ static_cast<uint16_t>(word >> 8U);
-      data_parity ^= word & 1U;
-    }
+void TpcTimeFrameBuilder::FeeDataBuffer::append(const uint16_t* words, const size_t n)
+{
+  // move the unread words to the front before the buffer has to grow
+  if (m_begin > 0 && 2 * m_begin >= m_words.size())
+  {
+    m_words.erase(m_words.begin(), m_words.begin() + m_begin);
+    m_begin = 0;
+  }
+  m_words.insert(m_words.end(), words, words + n);
+}
+
+void TpcTimeFrameBuilder::FeeDataBuffer::consume(const size_t n)
+{
+  assert(n <= size());
+  m_begin += n;
+  if (m_begin == m_words.size())
+  {
+    m_words.clear();
+    m_begin = 0;
   }
-  crc = reverseBits(crc);
-  return make_pair(crc, data_parity);
 }
 
 namespace
@@ -1,6 +1,10 @@
 #ifndef Fun4All_TpcTimeFrameBuilder_H
 #define Fun4All_TpcTimeFrameBuilder_H
 
+#include "RawHitArena.h"
+
+#include <ffarawobjects/TpcRawHitContainerv4.h>
+
 #include <algorithm>
 #include <cstdint>
 #include <deque>
@@ -56,14 +60,15 @@ class TpcTimeFrameBuilder
   static const uint16_t MAX_FEECOUNT = 26;              // that many FEEs
   static const uint16_t MAX_SAMPA = 8;                  // that many FEEs
   static const uint16_t MAX_CHANNELS = MAX_SAMPA * 32;  // that many channels per FEE
+  static const uint16_t MAX_SAMPLES = 1024;              // time bins per hit, as reported by TpcRawHitv3
                                                         //  static const uint16_t  HEADER_LENGTH  = 5;
   static const uint16_t HEADER_LENGTH = 7;
   static const uint16_t MAX_PACKET_LENGTH = 1025;
 
   static const uint16_t GL1_BCO_MATCH_WINDOW = 256;  // BCOs
 
-  uint16_t reverseBits(const uint16_t x) const;
-  std::pair<uint16_t, uint16_t> crc16_parity(const uint32_t fee, const uint16_t l) const;
+  //! CRC16 of the first l words and parity of the payload words after the header
+  static std::pair<uint16_t, uint16_t> crc16_parity(const uint16_t *data, const uint16_t l);
 
   //! DMA word structure
   struct dma_word
@@ -106,8 +111,32 @@ class TpcTimeFrameBuilder
     
     uint16_t data_parity = 0;
     uint16_t calc_parity = 0;
+  };
+
+  //! FIFO of the 16-bit words of one FEE
+  /**
+   * The words are kept contiguous, so that a FEE packet is always one span
+   * that can be parsed in place. Consumed words only move the read position,
+   * the buffer is compacted once more than half of it is consumed.
+   */
+  class FeeDataBuffer
+  {
+   public:
+    size_t size() const { return m_words.size() - m_begin; }
+    bool empty() const { return size() == 0; }
 
-    std::vector<std::pair<uint16_t, std::vector<uint16_t>>> waveforms;
+    //! words from the read position on, valid until the next append()
+    const uint16_t *data() const { return m_words.data() + m_begin; }
+    const uint16_t &operator[](const size_t i) const { return m_words[m_begin + i]; }
+
+    void append(const uint16_t *words, const size_t n);
+
+    //! drop n words from the front
+    void consume(const size_t n);
+
+   private:
+    std::vector<uint16_t> m_words;
+    size_t m_begin = 0;
   };
 
   // -------------------------
@@ -317,7 +346,11 @@ class TpcTimeFrameBuilder
   };  //   class BcoMatchingInformation
 
  private:
-  std::vector<std::deque<uint16_t>> m_feeData;
+  //! BCO ordered queue of time frames, new hits mostly go to the latest time frames
+  using TimeFrame = std::pair<uint64_t, std::vector<TpcRawHit *>>;
+  std::vector<TpcRawHit *> &insertTimeFrame(const uint64_t &gtm_bco);
+
+  std::vector<FeeDataBuffer> m_feeData;
 
   int m_verbosity = 0;
   int m_packet_id = 0;
@@ -326,10 +359,14 @@ class TpcTimeFrameBuilder
   std::string m_HistoPrefix;
 
   //! GTM BCO -> TpcRawHit
-  //! Map to store TpcRawHit pointers indexed by GTM BCO values
+  //! Time frames of TpcRawHit pointers sorted by GTM BCO values
   //! This is used to organize hits into time frames based on their BCO values
-  std::map<uint64_t, std::vector<TpcRawHit *>> m_timeFrameMap;
+  std::deque<TimeFrame> m_timeFrames;
   static const size_t kMaxRawHitLimit = 10000;  // 10k hits per event > 256ch/fee * 26fee
+
+  //! storage of the hits of the time frames, released with their time frame
+  static const unsigned int kTimeFrameArenaHits = 1024;  // hits per arena container
+  RawHitArena<TpcRawHitContainerv4> m_hitArena{kTimeFrameArenaHits};
   std::queue<uint64_t> m_UsedTimeFrameSet;
 
   //! fast skip mode when searching for particular GL1 BCO over long segment of files
@@ -0,0 +1,236 @@
+// Replay micro-benchmark of TpcTimeFrameBuilder on a captured DAM packet stream.
+//
+// usage: tpc_timeframe_builder_replay file.prdf [nevents] [lag] [hits.txt]
+//
+// All TPC packets (ids 4000 to 4999) of the first nevents events (0: all) are
+// loaded into memory first, then replayed through one TpcTimeFrameBuilder per
+// packet id, in file order. The time frames are requested with the level-1
+// BCOs of the GTM taggers found in each packet, lag triggers behind the
+// latest one, as the GL1 would request them in the streaming input.
+//
+// The program reports the decoding speed in 16-bit words per second and a
+// digest of all hits handed out. Building it before and after a change of
+// TpcTimeFrameBuilder and running both on the same file compares the speed;
+// the digests (and the optional hit dump) must be identical.
+
+#include "TpcTimeFrameBuilder.h"
+
+#include <ffarawobjects/TpcRawHit.h>
+
+#include <Event/Event.h>
+#include <Event/EventTypes.h>
+#include <Event/fileEventiterator.h>
+#include <Event/packet.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr int MAXPACKETS = 100;
+
+  // 16 bit words of a DAM DMA transfer, header included
+  constexpr size_t DAM_DMA_WORD_LENGTH = 16;
+  constexpr uint16_t GTM_LVL1_ACCEPT_MAGIC_KEY = 0xbbf0;
+
+  // level-1 BCOs of the GTM taggers in a packet, decoded as in TpcTimeFrameBuilder::decode_gtm_data
+  std::vector<uint64_t> lvl1_bcos(Packet* packet)
+  {
+    std::vector<uint64_t> bcos;
+    const int data_length = packet->getDataLength();
+    std::vector<uint16_t> words((static_cast<size_t>(data_length) * 2 / DAM_DMA_WORD_LENGTH + 1) * DAM_DMA_WORD_LENGTH);
+    int l2 = 0;
+    packet->fillIntArray(reinterpret_cast<int*>(words.data()), data_length + DAM_DMA_WORD_LENGTH / 2, &l2, "DATA");
+    l2 -= packet->getPadding();
+    const size_t dma_words = (l2 > 0) ? static_cast<size_t>(l2) * 2 / DAM_DMA_WORD_LENGTH : 0;
+    for (size_t index = 0; index < dma_words; ++index)
+    {
+      const uint16_t* dma = &words[index * DAM_DMA_WORD_LENGTH];
+      if (dma[0] != GTM_LVL1_ACCEPT_MAGIC_KEY)
+      {
+        continue;
+      }
+      const uint64_t bco = uint64_t(dma[1]) | (uint64_t(dma[2]) << 16U) | (uint64_t(dma[3]) << 32U);
+      // 40 bit BCO, as provided by the GL1
+      bcos.push_back(bco & 0xFFFFFFFFFFU);
+    }
+    return bcos;
+  }
+
+  // FNV-1a
+  class Digest
+  {
+   public:
+    template <class T>
+    void add(T value)
+    {
+      for (size_t i = 0; i < sizeof(T); ++i)
+      {
+        m_hash ^= (static_cast<uint64_t>(value) >> (8 * i)) & 0xffU;
+        m_hash *= 0x100000001b3ULL;
+      }
+    }
+    uint64_t value() const { return m_hash; }
+
+   private:
+    uint64_t m_hash = 0xcbf29ce484222325ULL;
+  };
+
+  struct ReplayPacket
+  {
+    int id = 0;
+    Packet* packet = nullptr;
+    std::vector<uint64_t> bcos;
+  };
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cout << "usage: " << argv[0] << " file.prdf [nevents] [lag] [hits.txt]" << std::endl;
+    return 1;
+  }
+  const int nevents = (argc > 2) ? std::atoi(argv[2]) : 0;
+  const size_t lag = (argc > 3) ? std::atoi(argv[3]) : 12;
+  std::unique_ptr<std::ofstream> dump;
+  if (argc > 4)
+  {
+    dump = std::make_unique<std::ofstream>(argv[4]);
+  }
+
+  // load the stream
+  int status = 0;
+  fileEventiterator eventiterator(argv[1], status);
+  if (status)
+  {
+    std::cout << "cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+  std::vector<Event*> events;
+  std::vector<ReplayPacket> packets;
+  uint64_t nwords = 0;
+  Packet* plist[MAXPACKETS];
+  while (Event* evt = eventiterator.getNextEvent())
+  {
+    if (evt->getEvtType() != DATAEVENT)
+    {
+      delete evt;
+      continue;
+    }
+    events.push_back(evt);
+    const int npackets = evt->getPacketList(plist, MAXPACKETS);
+    for (int i = 0; i < npackets; ++i)
+    {
+      const int id = plist[i]->getIdentifier();
+      if (id < 4000 || id >= 5000)
+      {
+        delete plist[i];
+        continue;
+      }
+      nwords += static_cast<uint64_t>(plist[i]->getDataLength()) * 2;
+      packets.push_back({id, plist[i], lvl1_bcos(plist[i])});
+    }
+    if (nevents > 0 && (int) events.size() >= nevents)
+    {
+      break;
+    }
+  }
+  std::cout << "loaded " << events.size() << " events, " << packets.size() << " TPC packets, "
+            << nwords << " words" << std::endl;
+
+  // replay
+  std::map<int, std::unique_ptr<TpcTimeFrameBuilder>> builders;
+  std::map<int, std::deque<uint64_t>> pending;
+  Digest digest;
+  uint64_t nhits = 0;
+  uint64_t ntimeframes = 0;
+  auto get_time_frame = [&](int id, uint64_t bco)
+  {
+    auto& builder = builders[id];
+    const auto& hits = builder->getTimeFrame(bco);
+    ++ntimeframes;
+    for (const TpcRawHit* hit : hits)
+    {
+      ++nhits;
+      digest.add(hit->get_bco());
+      digest.add(hit->get_gtm_bco());
+      digest.add(hit->get_packetid());
+      digest.add(hit->get_fee());
+      digest.add(hit->get_channel());
+      digest.add(hit->get_sampaaddress());
+      digest.add(hit->get_sampachannel());
+      digest.add(hit->get_type());
+      digest.add(hit->get_userword());
+      digest.add(hit->get_checksumerror());
+      digest.add(hit->get_parityerror());
+      digest.add(hit->get_samples());
+      if (dump)
+      {
+        *dump << id << " " << std::hex << bco << " " << hit->get_gtm_bco() << " " << hit->get_bco() << std::dec
+              << " fee " << hit->get_fee() << " ch " << hit->get_channel() << " type " << hit->get_type()
+              << " err " << hit->get_checksumerror() << hit->get_parityerror() << " :";
+      }
+      // get_adc is not implemented by all hit versions, the waveforms are read through the iterator
+      std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(hit->CreateAdcIterator());
+      for (adc_iterator->First(); !adc_iterator->IsDone(); adc_iterator->Next())
+      {
+        digest.add(adc_iterator->CurrentTimeBin());
+        digest.add(adc_iterator->CurrentAdc());
+        if (dump)
+        {
+          *dump << " " << adc_iterator->CurrentTimeBin() << ":" << adc_iterator->CurrentAdc();
+        }
+      }
+      if (dump)
+      {
+        *dump << "\n";
+      }
+    }
+    builder->CleanupUsedPackets(bco);
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  for (auto& replay : packets)
+  {
+    auto& builder = builders[replay.id];
+    if (!builder)
+    {
+      builder = std::make_unique<TpcTimeFrameBuilder>(replay.id);
+    }
+    builder->ProcessPacket(replay.packet);
+
+    auto& bcos = pending[replay.id];
+    bcos.insert(bcos.end(), replay.bcos.begin(), replay.bcos.end());
+    while (bcos.size() > lag)
+    {
+      get_time_frame(replay.id, bcos.front());
+      bcos.pop_front();
+    }
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "replayed " << packets.size() << " packets in " << seconds << " s: "
+            << nwords / seconds / 1e6 << " Mwords/s" << std::endl;
+  std::cout << "time frames: " << ntimeframes << " hits: " << nhits
+            << " digest: " << std::hex << digest.value() << std::dec << std::endl;
+
+  builders.clear();
+  for (auto& replay : packets)
+  {
+    delete replay.packet;
+  }
+  for (auto* evt : events)
+  {
+    delete evt;
+  }
+  return 0;
+}
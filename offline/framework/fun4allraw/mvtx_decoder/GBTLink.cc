@@ -61,6 +61,7 @@ void GBTLink::clear(bool resetStat, bool resetTFRaw)
       trg.clear();
     }
     mTrgData.clear();
+    mHits.clear();
     dataOffset = 0;
     hbf_count = 0;
   }
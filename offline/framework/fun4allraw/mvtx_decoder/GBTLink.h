@@ -20,6 +20,7 @@
 #include <iostream>
 #include <memory>
 #include <iomanip>
+#include <vector>
 
 #define GBTLINK_DECODE_ERRORCHECK(errRes, errEval)                            \
   errRes = errEval;                                                           \
@@ -84,6 +85,7 @@ struct GBTLink
   size_t dataOffset = 0;     //
   std::vector<InteractionRecord> mL1TrgTime;
   std::vector<StrobeData> mTrgData;
+  std::vector<mvtx_hit> mHits; // packed hits of all strobes, in decoding order
 
   //------------------------------------------------------------------------
   GBTLink() = default;
@@ -116,13 +118,19 @@ struct GBTLink
 
   void addHit(const uint8_t laneId, const uint8_t bc, uint8_t reg, const uint16_t addr)
   {
-    auto* hit = new mvtx_hit();
+    auto& hit = mHits.emplace_back();
 
-    hit->chip_id = laneId;
-    hit->bunchcounter = bc;
-    getRowCol(reg, addr, hit->row_pos, hit->col_pos);
+    hit.chip_id = laneId;
+    hit.bunchcounter = bc;
+    getRowCol(reg, addr, hit.row_pos, hit.col_pos);
 
-    mTrgData.back().hit_vector.push_back(hit);
+    ++mTrgData.back().n_hits;
+  }
+
+  mvtx_hit_range getHits(const StrobeData& strb) const
+  {
+    const mvtx_hit* first = mHits.data() + strb.first_hit;
+    return {first, first + strb.n_hits};
   }
 
   void check_APE(const uint8_t& chipId, const uint8_t& dataC)
@@ -362,6 +370,7 @@ inline GBTLink::CollectedDataStatus GBTLink::collectROFCableData(/*const Mapping
             n_no_continuation++;
             mTrgData.emplace_back(ir.orbit, ir.bc);
             mTrgData.back().detectorField = detectorField;
+            mTrgData.back().first_hit = mHits.size();
           } // end if not cont
         } // end TDH
         else if (gbtWord.isCDW()) // CALIBRATION DATA WORD
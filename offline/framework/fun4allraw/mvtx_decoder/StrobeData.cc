@@ -17,10 +17,7 @@ void StrobeData::clear()
   hasCDW = false;
   calWord = {};
 
-  for ( auto&& hit : hit_vector )
-  {
-    delete hit;
-  }
-  hit_vector.clear();
+  first_hit = 0;
+  n_hits = 0;
 }
 
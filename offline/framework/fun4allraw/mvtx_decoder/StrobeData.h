@@ -4,7 +4,7 @@
 #include "InteractionRecord.h"
 #include "GBTWord.h"
 
-#include <vector>
+#include <cstddef>
 
 namespace mvtx
 {
@@ -16,6 +16,18 @@ namespace mvtx
     uint16_t col_pos = 0xFFFF;
   } mvtx_hit;
 
+  /// hits of one strobe, a slice of the packed hit records of its link
+  struct mvtx_hit_range
+  {
+    const mvtx_hit* first = nullptr;
+    const mvtx_hit* last = nullptr;
+
+    const mvtx_hit* begin() const { return first; }
+    const mvtx_hit* end() const { return last; }
+    size_t size() const { return last - first; }
+    const mvtx_hit& operator[](size_t i) const { return first[i]; }
+  };
+
   struct StrobeData
   {
     StrobeData(uint64_t orb, uint16_t b) : ir(orb, b) {};
@@ -28,7 +40,8 @@ namespace mvtx
     GBTCalibDataWord calWord = {};
     uint32_t detectorField = 0;
 
-    std::vector<mvtx_hit *> hit_vector = {};
+    uint32_t first_hit = 0; // index of the first hit in GBTLink::mHits
+    uint32_t n_hits = 0;
   };
 
 } // namespace mvtx
@@ -1,13 +1,37 @@
 #include "mvtx_pool.h"
 
-#include <string>
-#include <cstdint>
-
 #include <Event/packet.h>
 #include "mvtx_decoder/RDH.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
 using namespace std;
 
+namespace
+{
+  const std::pair<const char *, mvtx_pool::Field> field_names[] = {
+      {"NR_LINKS", mvtx_pool::Field::NR_LINKS},
+      {"FEEID", mvtx_pool::Field::FEEID},
+      {"NR_HBF", mvtx_pool::Field::NR_HBF},
+      {"NR_PHYS_TRG", mvtx_pool::Field::NR_PHYS_TRG},
+      {"NR_STROBES", mvtx_pool::Field::NR_STROBES},
+      {"NR_HITS", mvtx_pool::Field::NR_HITS},
+      {"L1_IR_BC", mvtx_pool::Field::L1_IR_BC},
+      {"TRG_IR_BC", mvtx_pool::Field::TRG_IR_BC},
+      {"TRG_DET_FIELD", mvtx_pool::Field::TRG_DET_FIELD},
+      {"TRG_NR_HITS", mvtx_pool::Field::TRG_NR_HITS},
+      {"HIT_CHIP_ID", mvtx_pool::Field::HIT_CHIP_ID},
+      {"HIT_BC", mvtx_pool::Field::HIT_BC},
+      {"HIT_ROW", mvtx_pool::Field::HIT_ROW},
+      {"HIT_COL", mvtx_pool::Field::HIT_COL},
+      {"L1_IR_BCO", mvtx_pool::Field::L1_IR_BCO},
+      {"TRG_IR_BCO", mvtx_pool::Field::TRG_IR_BCO}};
+}  // namespace
+
 //_________________________________________________
 mvtx_pool::~mvtx_pool()
 {
@@ -16,6 +40,8 @@ mvtx_pool::~mvtx_pool()
     std::cout << "LOG mvtx_pool::~mvtx_pool() called." << std::endl;
   }
 
+  stop_workers();
+
   for (auto& link : mGBTLinks)
   {
     // clear data and the statistics
@@ -224,14 +250,89 @@ int mvtx_pool::mvtx_decode()
   }
   m_is_decoded = true;
 
-  for (auto& link : mGBTLinks)
+  const unsigned int nlinks = mGBTLinks.size();
+  unsigned int nthreads = m_nthreads > 0 ? m_nthreads : std::max(1U, std::thread::hardware_concurrency());
+  nthreads = std::min(nthreads, nlinks);
+  if (nthreads <= 1)
   {
-    link.collectROFCableData();
+    for (auto& link : mGBTLinks)
+    {
+      link.collectROFCableData();
+    }
+    return 0;
   }
 
+  // the workers persist between packets, only missing ones are started.
+  // Each thread takes the next link, a link only fills its own strobes and
+  // hits, so the result does not depend on the number of threads
+  while (m_workers.size() < nthreads - 1)
+  {
+    m_workers.emplace_back(&mvtx_pool::worker_loop, this, m_generation);
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_workers_mutex);
+    m_next_link = 0;
+    m_busy = m_workers.size();
+    ++m_generation;
+  }
+  m_work_cv.notify_all();
+  decode_links();
+  std::unique_lock<std::mutex> lock(m_workers_mutex);
+  m_done_cv.wait(lock, [this]() { return m_busy == 0; });
+
   return 0;
 }
 
+//_________________________________________________
+void mvtx_pool::decode_links()
+{
+  const unsigned int nlinks = mGBTLinks.size();
+  for (unsigned int ilink = m_next_link++; ilink < nlinks; ilink = m_next_link++)
+  {
+    mGBTLinks[ilink].collectROFCableData();
+  }
+}
+
+//_________________________________________________
+void mvtx_pool::worker_loop(uint64_t generation)
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_workers_mutex);
+      m_work_cv.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+      if (m_stop)
+      {
+        return;
+      }
+      generation = m_generation;
+    }
+    decode_links();
+    {
+      std::lock_guard<std::mutex> lock(m_workers_mutex);
+      if (--m_busy == 0)
+      {
+        m_done_cv.notify_one();
+      }
+    }
+  }
+}
+
+//_________________________________________________
+void mvtx_pool::stop_workers()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_workers_mutex);
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+  for (auto& worker : m_workers)
+  {
+    worker.join();
+  }
+  m_workers.clear();
+}
+
 //_________________________________________________
 uint32_t mvtx_pool::get_linkId(const uint16_t iLnk)
 {
@@ -326,7 +427,7 @@ int mvtx_pool::get_TRG_NR_HITS(const uint16_t iLnk, const uint32_t index)
   // auto lnkId = get_linkId(iLnk);
   // return (index < mGBTLinks[lnkId].mTrgData.size()) ?
   //         mGBTLinks[lnkId].mTrgData[index].hit_vector.size() : -1;
-  return mGBTLinks[mFeeId2LinkID[iLnk].entry].mTrgData[index].hit_vector.size();
+  return mGBTLinks[mFeeId2LinkID[iLnk].entry].mTrgData[index].n_hits;
 }
 
 //_________________________________________________
@@ -350,94 +451,148 @@ long long int mvtx_pool::get_TRG_IR_BCO(const uint16_t iLnk, const uint32_t inde
 }
 
 //_________________________________________________
-std::vector<mvtx::mvtx_hit *>& mvtx_pool::get_hits(const int feeId, const int i_strb)
+mvtx::mvtx_hit_range mvtx_pool::get_hits(const int feeId, const int i_strb)
 {
-  return mGBTLinks[mFeeId2LinkID[feeId].entry].mTrgData[i_strb].hit_vector;
+  const auto& link = mGBTLinks[mFeeId2LinkID[feeId].entry];
+  return link.getHits(link.mTrgData[i_strb]);
 }
 
 //_________________________________________________
-int mvtx_pool::iValue(const int n, const char *what)
+mvtx_pool::Field mvtx_pool::get_field(const char *what)
 {
-  mvtx_decode();
-  if (n == -1) // Global Information.
+  for (const auto &[name, field] : field_names)
   {
-    if (strcmp(what, "NR_LINKS") == 0)
+    if (strcmp(what, name) == 0)
     {
-      return get_feeidSet_size();
+      return field;
     }
-    else
+  }
+  return Field::UNKNOWN;
+}
+
+//_________________________________________________
+const char *mvtx_pool::get_field_name(const Field what)
+{
+  for (const auto &[name, field] : field_names)
+  {
+    if (field == what)
     {
-      std::cout << "Unknow option " << what << std::endl;
-      return -1;
+      return name;
     }
   }
+  return "UNKNOWN";
+}
 
-  unsigned int i = n;
-  if (strcmp(what, "FEEID") == 0)
+//_________________________________________________
+int mvtx_pool::iValue(const int n, const char *what)
+{
+  const Field field = get_field(what);
+  if (field == Field::UNKNOWN)
   {
-    return get_feeid(i);
+    mvtx_decode();
+    std::cout << "Unknow option " << what << std::endl;
+    return -1;
   }
-  else
+  return iValue(n, field);
+}
+
+//_________________________________________________
+int mvtx_pool::iValue(const int i_feeid, const int idx, const char *what)
+{
+  const Field field = get_field(what);
+  if (field == Field::UNKNOWN)
   {
-    if ( strcmp(what, "NR_HBF") == 0 )
-    {
-      return get_hbfSet_size(i);
-    }
-    else if ( strcmp(what, "NR_PHYS_TRG") == 0 )
+    mvtx_decode();
+    std::cout << "Unknow option " << what << std::endl;
+    return -1;
+  }
+  return iValue(i_feeid, idx, field);
+}
+
+//_________________________________________________
+int mvtx_pool::iValue(const int i_feeid, const int i_trg, const int i_hit, const char *what)
+{
+  const Field field = get_field(what);
+  if (field == Field::UNKNOWN)
+  {
+    mvtx_decode();
+    std::cout << "Unknow option " << what << std::endl;
+    return -1;
+  }
+  return iValue(i_feeid, i_trg, i_hit, field);
+}
+
+//_________________________________________________
+long long int mvtx_pool::lValue(const int i_feeid, const int idx, const char *what)
+{
+  const Field field = get_field(what);
+  if (field == Field::UNKNOWN)
+  {
+    mvtx_decode();
+    std::cout << "Unknow option " << what << std::endl;
+    return -1;
+  }
+  return lValue(i_feeid, idx, field);
+}
+
+//_________________________________________________
+int mvtx_pool::iValue(const int n, const Field what)
+{
+  mvtx_decode();
+  if (n == -1) // Global Information.
+  {
+    if (what == Field::NR_LINKS)
     {
-      return get_trgSet_size(i);
+      return get_feeidSet_size();
     }
-    else if ( strcmp(what, "NR_STROBES") == 0 )
-    {
+    std::cout << "Unknow option " << get_field_name(what) << std::endl;
+    return -1;
+  }
+
+  unsigned int i = n;
+  switch (what)
+  {
+  case Field::FEEID:
+    return get_feeid(i);
+  case Field::NR_HBF:
+    return get_hbfSet_size(i);
+  case Field::NR_PHYS_TRG:
+    return get_trgSet_size(i);
+  case Field::NR_STROBES:
     return get_strbSet_size(i);
-    }
-    else if ( strcmp(what, "NR_HITS") == 0 )  // the number of datasets
-    {
-      return -1;
-    }
-    else
-    {
-      std::cout << "Unknow option " << what << std::endl;
-      return -1;
-    }
+  case Field::NR_HITS:  // the number of datasets
+    return -1;
+  default:
+    std::cout << "Unknow option " << get_field_name(what) << std::endl;
+    return -1;
   }
-  return 0;
 }
 
 //_________________________________________________
-int mvtx_pool::iValue(const int i_feeid, const int idx, const char *what)
+int mvtx_pool::iValue(const int i_feeid, const int idx, const Field what)
 {
   mvtx_decode();
   uint32_t feeId = i_feeid;
   uint32_t index = idx;
 
-  if ( strcmp(what, "L1_IR_BC") == 0 )
+  switch (what)
   {
+  case Field::L1_IR_BC:
     return get_L1_IR_BC(feeId, index);
-  }
-  else if ( strcmp(what, "TRG_IR_BC") == 0 )
-  {
+  case Field::TRG_IR_BC:
     return get_TRG_IR_BC(feeId, index);
-  }
-  else if ( strcmp(what, "TRG_DET_FIELD") == 0 )
-  {
+  case Field::TRG_DET_FIELD:
     return get_TRG_DET_FIELD(feeId, index);
-  }
-  else if ( strcmp(what, "TRG_NR_HITS") == 0)
-  {
+  case Field::TRG_NR_HITS:
     return get_TRG_NR_HITS(feeId, index);
-  }
-  else
-  {
-    std::cout << "Unknow option " << what << std::endl;
+  default:
+    std::cout << "Unknow option " << get_field_name(what) << std::endl;
     return -1;
   }
-  return 0;
 }
 
-
 //_________________________________________________
-int mvtx_pool::iValue(const int i_feeid, const int i_trg, const int i_hit, const char *what)
+int mvtx_pool::iValue(const int i_feeid, const int i_trg, const int i_hit, const Field what)
 {
   mvtx_decode();
 
@@ -452,55 +607,46 @@ int mvtx_pool::iValue(const int i_feeid, const int i_trg, const int i_hit, const
   }
   uint32_t lnkId =  mFeeId2LinkID[feeId].entry;
 
-  if ( strcmp(what, "HIT_CHIP_ID") == 0 )
-  {
-    return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->chip_id : -1;
-  }
-  else if ( strcmp(what, "HIT_BC") == 0 )
-  {
-    return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->bunchcounter : -1;
-  }
-  else if ( strcmp(what, "HIT_ROW") == 0 )
+  if (what != Field::HIT_CHIP_ID && what != Field::HIT_BC && what != Field::HIT_ROW && what != Field::HIT_COL)
   {
-    return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->row_pos : -1;
+    std::cout << "Unknow option " << get_field_name(what) << std::endl;
+    return -1;
   }
-  else if ( strcmp(what, "HIT_COL") == 0 )
+
+  const auto hits = mGBTLinks[lnkId].getHits(mGBTLinks[lnkId].mTrgData[trg]);
+  if ((i_hit < 0) || (hit >= hits.size()))
   {
-    return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->col_pos : -1;
+    return -1;
   }
-  else
+  switch (what)
   {
-    std::cout << "Unknow option " << what << std::endl;
-    return -1;
+  case Field::HIT_CHIP_ID:
+    return hits[hit].chip_id;
+  case Field::HIT_BC:
+    return hits[hit].bunchcounter;
+  case Field::HIT_ROW:
+    return hits[hit].row_pos;
+  default:
+    return hits[hit].col_pos;
   }
-  return 0;
 }
 
 //_________________________________________________
-long long int mvtx_pool::lValue(const int i_feeid, const int idx, const char *what)
+long long int mvtx_pool::lValue(const int i_feeid, const int idx, const Field what)
 {
   mvtx_decode();
 
   uint32_t feeId = i_feeid;
   uint32_t index = idx;
 
-  if ( strcmp(what, "L1_IR_BCO") == 0 )
+  switch (what)
   {
+  case Field::L1_IR_BCO:
     return get_L1_IR_BCO(feeId, index);
-  }
-  else if ( strcmp(what, "TRG_IR_BCO") == 0 )
-  {
+  case Field::TRG_IR_BCO:
     return get_TRG_IR_BCO(feeId, index);
-  }
-  else
-  {
-    std::cout << "Unknow option " << what << std::endl;
+  default:
+    std::cout << "Unknow option " << get_field_name(what) << std::endl;
     return -1;
   }
-
-  return 0;
 }
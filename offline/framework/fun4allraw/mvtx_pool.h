@@ -5,7 +5,11 @@
 #include "mvtx_decoder/GBTLink.h"
 #include "mvtx_decoder/StrobeData.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +20,32 @@ class Packet;
 class mvtx_pool {
 
  public:
+  //! typed keys of iValue/lValue, named like the string keys
+  enum class Field : int
+  {
+    UNKNOWN = -1,
+    NR_LINKS,
+    FEEID,
+    NR_HBF,
+    NR_PHYS_TRG,
+    NR_STROBES,
+    NR_HITS,
+    L1_IR_BC,
+    TRG_IR_BC,
+    TRG_DET_FIELD,
+    TRG_NR_HITS,
+    HIT_CHIP_ID,
+    HIT_BC,
+    HIT_ROW,
+    HIT_COL,
+    L1_IR_BCO,
+    TRG_IR_BCO
+  };
+  //! Field for a string key, UNKNOWN if there is none
+  static Field get_field(const char* what);
+  //! string key of a Field
+  static const char* get_field_name(const Field what);
+
   mvtx_pool() = default;
   virtual ~mvtx_pool();
 
@@ -42,12 +72,20 @@ class mvtx_pool {
 
   long long int lValue(const int, const int, const char* what);
 
-  std::vector<mvtx::mvtx_hit*>& get_hits(const int feeId,
-                                         const int i_strb);
+  int iValue(const int, const Field what);
+  int iValue(const int, const int, const Field what);
+  int iValue(const int, const int, const int, const Field what);
+
+  long long int lValue(const int, const int, const Field what);
+
+  mvtx::mvtx_hit_range get_hits(const int feeId, const int i_strb);
 
   void set_verbosity(const int val) { verbosity = val; }
   int  get_verbosity() { return verbosity; }
 
+  //! number of threads decoding the GBT links of a packet, 0 = one per core
+  void set_nthreads(const unsigned int val) { m_nthreads = val; }
+
  protected:
    uint32_t get_linkId(const uint16_t i);
 
@@ -55,7 +93,24 @@ class mvtx_pool {
   int mvtx_decode();
   bool m_is_decoded = false;
 
+  //! decode the GBT links not taken by another thread yet
+  void decode_links();
+  //! body of the decoding threads, they wait for the next packet between decodes
+  void worker_loop(uint64_t generation);
+  void stop_workers();
+
   int verbosity = 0;
+  unsigned int m_nthreads = 1;
+
+  // decoding threads, started by the first multithreaded decode and reused for all packets
+  std::vector<std::thread> m_workers;
+  std::mutex m_workers_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  uint64_t m_generation = 0;  // incremented for each packet handed to the workers
+  unsigned int m_busy = 0;    // workers still decoding the current packet
+  bool m_stop = false;
+  std::atomic<unsigned int> m_next_link{0};
 
   struct dumpEntry
   {
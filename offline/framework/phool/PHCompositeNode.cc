@@ -51,6 +51,7 @@ bool PHCompositeNode::addNode(PHNode* newNode)
   // No conflict, so we can append the new node.
   //
   newNode->setParent(this);
+  treeChanged();
   return (subNodes.append(newNode));
 }
 
@@ -91,6 +92,62 @@ void PHCompositeNode::forgetMe(PHNode* child)
     {
       subNodes.removeAt(nodeIter.pos());
       child = nullptr;
+      treeChanged();
+    }
+  }
+}
+
+PHNode* PHCompositeNode::findFirst(const std::string& requiredName)
+{
+  updateNameIndex();
+  auto iter = nameIndex.find(requiredName);
+  if (iter == nameIndex.end())
+  {
+    return nullptr;
+  }
+  return iter->second.front();
+}
+
+PHNode* PHCompositeNode::findFirst(const std::string& requiredType, const std::string& requiredName)
+{
+  updateNameIndex();
+  auto iter = nameIndex.find(requiredName);
+  if (iter == nameIndex.end())
+  {
+    return nullptr;
+  }
+  for (auto* thisNode : iter->second)
+  {
+    if (thisNode->getType() == requiredType)
+    {
+      return thisNode;
+    }
+  }
+  return nullptr;
+}
+
+void PHCompositeNode::updateNameIndex()
+{
+  if (nameIndexVersion == getTreeVersion())
+  {
+    return;
+  }
+  nameIndex.clear();
+  fillNameIndex(this);
+  nameIndexVersion = getTreeVersion();
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void PHCompositeNode::fillNameIndex(PHCompositeNode* node)
+{
+  PHPointerListIterator<PHNode> nodeIter(node->subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter()))
+  {
+    nameIndex[thisNode->getName()].push_back(thisNode);
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      fillNameIndex(static_cast<PHCompositeNode*>(thisNode));
     }
   }
 }
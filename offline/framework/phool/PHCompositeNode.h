@@ -8,6 +8,8 @@
 #include "PHPointerList.h"
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class PHIOManager;
 
@@ -31,6 +33,17 @@ class PHCompositeNode : public PHNode
   //
   void prune() override;
 
+  //
+  // First node with the given name (and type) below this node, in the
+  // same depth first order as the recursive search of PHNodeIterator.
+  // Uses a name index of the sub tree, which is built lazily on the first
+  // search after the node tree changed. A search can therefore modify this
+  // node: concurrent searches (findFirst, findNode::getClass) on the same
+  // tree are not read-only anymore and have to be serialized.
+  //
+  PHNode *findFirst(const std::string &name);
+  PHNode *findFirst(const std::string &type, const std::string &name);
+
   //
   // I/O functions
   //
@@ -44,6 +57,12 @@ class PHCompositeNode : public PHNode
 
  private:
   PHCompositeNode() = delete;
+  void updateNameIndex();
+  void fillNameIndex(PHCompositeNode *node);
+
+  // all nodes of the sub tree by name, in depth first order
+  std::unordered_map<std::string, std::vector<PHNode *>> nameIndex;
+  unsigned long nameIndexVersion = 0;
 };
 
 #endif
@@ -14,6 +14,8 @@
 
 #include <iostream>
 
+unsigned long PHNode::lasttreeversion = 0;
+
 PHNode::PHNode(const std::string& n)
   : PHNode(n, "")
 {
@@ -21,6 +23,7 @@ PHNode::PHNode(const std::string& n)
 
 PHNode::PHNode(const std::string& n, const std::string& typ)
   : objecttype(typ)
+  , treeversion(++lasttreeversion)
 {
   int badnode = 0;
   if (n.find('.') != std::string::npos)
@@ -52,12 +55,33 @@ PHNode::PHNode(const std::string& n, const std::string& typ)
 
 PHNode::~PHNode()
 {
+  treeChanged();
   if (parent)
   {
     parent->forgetMe(this);
   }
 }
 
+unsigned long PHNode::getTreeVersion() const
+{
+  const PHNode* root = this;
+  while (root->parent)
+  {
+    root = root->parent;
+  }
+  return root->treeversion;
+}
+
+void PHNode::treeChanged()
+{
+  PHNode* root = this;
+  while (root->parent)
+  {
+    root = root->parent;
+  }
+  root->treeversion = ++lasttreeversion;
+}
+
 // Implementation of external functions.
 std::ostream&
 operator<<(std::ostream& stream, const PHNode& node)
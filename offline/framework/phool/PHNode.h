@@ -21,12 +21,16 @@ class PHNode
   PHNode *getParent() const { return parent; }
   bool isPersistent() const { return persistent; }
   void makePersistent() { persistent = true; }
-  const std::string getObjectType() const { return objecttype; }
-  const std::string getType() const { return type; }
-  const std::string getName() const { return name; }
-  const std::string getClass() const { return objectclass; }
+  const std::string &getObjectType() const { return objecttype; }
+  const std::string &getType() const { return type; }
+  const std::string &getName() const { return name; }
+  const std::string &getClass() const { return objectclass; }
   void setParent(PHNode *p) { parent = p; }
-  void setName(const std::string &n) { name = n; }
+  void setName(const std::string &n)
+  {
+    name = n;
+    treeChanged();
+  }
   void setObjectType(const std::string &n) { objecttype = n; }
   virtual void prune() = 0;
   virtual void print(const std::string &) = 0;
@@ -37,7 +41,16 @@ class PHNode
   virtual bool getResetFlag() const { return reset_able; }
   void makeTransient() { persistent = false; }
 
+  // Version of the node tree this node belongs to, kept by its root node.
+  // It changes whenever a node is added, deleted or renamed in that tree,
+  // changes in other trees do not affect it. The name index of
+  // PHCompositeNode and PHNodeHandle use it to detect that the tree changed
+  unsigned long getTreeVersion() const;
+
  protected:
+  // give the tree of this node a new version, unique across all trees
+  void treeChanged();
+
   PHNode *parent = nullptr;
   bool persistent = true;
   std::string type = "PHNode";
@@ -47,6 +60,9 @@ class PHNode
   std::string objectclass;
 
  private:
+  // only meaningful on the root node
+  unsigned long treeversion = 0;
+  static unsigned long lasttreeversion;
   PHNode() = delete;
   PHNode(const PHNode &) = delete;
   PHNode &operator=(const PHNode &) = delete;
@@ -0,0 +1,108 @@
+#ifndef PHOOL_PHNODEHANDLE_H
+#define PHOOL_PHNODEHANDLE_H
+
+//  Declaration of class PHNodeHandle
+//  Purpose: typed handle to the object of a data node. Resolve it once
+//  (e.g. in InitRun) and dereference it every event. The node is only
+//  searched again after the node tree of the top node changed and the
+//  object is only cast again if the node holds a different object (e.g.
+//  after the DST input replaced it). The top node has to outlive the handle.
+//
+//  PHNodeHandle<TrkrClusterContainer> m_clusters;
+//  InitRun:       m_clusters.resolve(topNode, "TRKR_CLUSTER");
+//  process_event: for (auto hsk : m_clusters->getHitSetKeys()) ...
+
+#include "PHCompositeNode.h"
+#include "PHDataNode.h"
+#include "PHIODataNode.h"
+#include "PHNode.h"
+
+#include <TObject.h>
+
+#include <string>
+
+template <class T>
+class PHNodeHandle
+{
+ public:
+  PHNodeHandle() = default;
+  PHNodeHandle(PHCompositeNode *top, const std::string &name) { resolve(top, name); }
+
+  // returns false if the node does not exist (yet), the handle keeps
+  // looking for it whenever the node tree changes
+  bool resolve(PHCompositeNode *top, const std::string &name)
+  {
+    topNode = top;
+    nodeName = name;
+    treeVersion = 0;
+    return get() != nullptr;
+  }
+
+  // same result as findNode::getClass<T>(top, name)
+  T *get()
+  {
+    if (!topNode)
+    {
+      return nullptr;
+    }
+    if (treeVersion != topNode->getTreeVersion())
+    {
+      lookup();
+    }
+    // the data of a PHDataNode is checked on every call, as in findNode::getClass,
+    // it can be set after the handle was resolved
+    if (dataNode)
+    {
+      return dataNode->getData();
+    }
+    if (!ioNode)
+    {
+      return nullptr;
+    }
+    TObject *tobject = ioNode->getData();
+    if (tobject != cachedTObject)
+    {
+      cachedTObject = tobject;
+      cachedObject = dynamic_cast<T *>(tobject);
+    }
+    return cachedObject;
+  }
+
+  T *operator->() { return get(); }
+  T &operator*() { return *get(); }
+  explicit operator bool() { return get() != nullptr; }
+
+  const std::string &getName() const { return nodeName; }
+
+ private:
+  void lookup()
+  {
+    treeVersion = topNode->getTreeVersion();
+    dataNode = nullptr;
+    ioNode = nullptr;
+    cachedTObject = nullptr;
+    cachedObject = nullptr;
+    PHNode *node = topNode->findFirst(nodeName);
+    if (!node)
+    {
+      return;
+    }
+    // same logic as findNode::getClass. A PHDataNode<T> stays one even if it
+    // holds no data yet, only other nodes are PHIODataNode<TObject>
+    dataNode = dynamic_cast<PHDataNode<T> *>(node);
+    if (!dataNode)
+    {
+      ioNode = static_cast<PHIODataNode<TObject> *>(node);
+    }
+  }
+
+  PHCompositeNode *topNode = nullptr;
+  std::string nodeName;
+  unsigned long treeVersion = 0;
+  PHDataNode<T> *dataNode = nullptr;
+  PHIODataNode<TObject> *ioNode = nullptr;
+  TObject *cachedTObject = nullptr;
+  T *cachedObject = nullptr;
+};
+
+#endif
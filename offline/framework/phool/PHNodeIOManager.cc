@@ -13,6 +13,7 @@
 #include <TClass.h>
 #include <TDirectory.h>  // for TDirectory
 #include <TFile.h>
+#include <TLeaf.h>
 #include <TLeafObject.h>
 #include <TObjArray.h>  // for TObjArray
 #include <TObject.h>
@@ -490,9 +491,61 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
       nodeIter.cd("..");
     }
   }
+  setupReadCache();
   return topNode;
 }
 
+void PHNodeIOManager::setupReadCache()
+{
+  if (m_ReadCacheSize <= 0 || !tree)
+  {
+    return;
+  }
+  // the cache type is decided when it is created
+  tree->SetParallelUnzip(m_ParallelUnzip);
+  tree->SetCacheSize(m_ReadCacheSize);
+  // only the branches we actually read, no learning phase needed
+  for (auto& branch : fBranches)
+  {
+    tree->AddBranchToCache(branch.second, true);
+  }
+  tree->StopCacheLearningPhase();
+}
+
+bool PHNodeIOManager::PrefetchFirstBaskets()
+{
+  if (!file || tree || accessMode != PHReadOnly)
+  {
+    return false;
+  }
+  std::string currdir = gDirectory->GetPath();
+  TFile* file_ptr = gFile;  // save current gFile
+  file->cd();
+  // the tree is kept in memory by the file, reconstructNodeTree() gets this
+  // instance back and the baskets read here are used for the first event
+  TTree* treetmp = static_cast<TTree*>(file->Get(TreeName.c_str()));
+  if (treetmp)
+  {
+    for (auto& it : objectToRead)
+    {
+      treetmp->SetBranchStatus(it.first.c_str(), it.second);
+    }
+    TObjArray* leafArray = treetmp->GetListOfLeaves();
+    for (int i = 0; i < leafArray->GetEntriesFast(); i++)
+    {
+      TBranch* thisBranch = static_cast<TLeaf*>(leafArray->At(i))->GetBranch();
+      if (thisBranch->TestBit(kDoNotProcess) || thisBranch->GetEntries() <= 0)
+      {
+        continue;
+      }
+      thisBranch->GetBasket(0);
+    }
+  }
+  gFile = file_ptr;  // recover gFile
+  gROOT->cd(currdir.c_str());
+  return treetmp != nullptr;
+}
+
 void PHNodeIOManager::selectObjectToRead(const std::string& objectName, bool readit)
 {
   objectToRead[objectName] = readit;
@@ -55,8 +55,20 @@ class PHNodeIOManager : public PHIOManager
   int SplitLevel() const { return splitlevel; }
   int BufferSize() const { return buffersize; }
 
+  // TTreeCache for the selected branches, set up when the tree is read (size in bytes, 0 uses the ROOT default)
+  // parallel unzip decompresses the baskets of the cache ahead of the current event, it needs ROOT::EnableImplicitMT()
+  void SetReadCache(const long size, const bool parallelunzip = false)
+  {
+    m_ReadCacheSize = size;
+    m_ParallelUnzip = parallelunzip;
+  }
+  // reads and unzips the first basket of every selected branch of a file opened for reading,
+  // used to warm up the next input file on a background thread. The baskets are used by the first read()
+  bool PrefetchFirstBaskets();
+
  private:
   int FillBranchMap();
+  void setupReadCache();
   PHCompositeNode *reconstructNodeTree(PHCompositeNode *);
   bool readEventFromFile(size_t requestedEvent);
   static std::string getBranchClassName(TBranch *);
@@ -69,6 +81,8 @@ class PHNodeIOManager : public PHIOManager
   int isFunctionalFlag{0};        // flag to tell if that object initialized properly
   int buffersize{std::numeric_limits<int>::min()};
   int splitlevel{std::numeric_limits<int>::min()};
+  long m_ReadCacheSize{0};
+  bool m_ParallelUnzip{false};
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
 };
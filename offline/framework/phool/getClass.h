@@ -14,6 +14,8 @@ class PHCompositeNode;
 
 namespace findNode
 {
+  // the search uses the lazily built name index of the node tree, it is not
+  // read-only (see PHCompositeNode::findFirst)
   template <class T>
   T *getClass(PHCompositeNode *top, const std::string &name)
   {
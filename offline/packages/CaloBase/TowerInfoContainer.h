@@ -7,8 +7,10 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <memory>
 
 class TowerInfo;
+class TowerInfoGeometry;
 
 class TowerInfoContainer : public PHObject
 {
@@ -56,7 +58,13 @@ class TowerInfoContainer : public PHObject
 
   virtual DETECTOR get_detectorid() const { return DETECTOR_INVALID; }
 
+  //! per channel tower geometry, see TowerInfoGeometry::attach(). Transient, not written out
+  void set_geometry(const std::shared_ptr<const TowerInfoGeometry> &geometry) { m_geometry = geometry; }
+  const TowerInfoGeometry *get_geometry() const { return m_geometry.get(); }
+
  private:
+  std::shared_ptr<const TowerInfoGeometry> m_geometry;  //!
+
   ClassDefOverride(TowerInfoContainer, 1);
 };
 
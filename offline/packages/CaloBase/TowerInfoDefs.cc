@@ -1,12 +1,13 @@
 #include "TowerInfoDefs.h"
 #include "RawTowerDefs.h"
 
+#include <array>
 #include <cstdlib>
 #include <iostream>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
-static const int emcadc[8][8] = {
+static constexpr int emcadc[8][8] = {
     {62, 60, 46, 44, 30, 28, 14, 12},
     {63, 61, 47, 45, 31, 29, 15, 13},
     {58, 56, 42, 40, 26, 24, 10, 8},
@@ -16,7 +17,7 @@ static const int emcadc[8][8] = {
     {50, 48, 34, 32, 18, 16, 2, 0},
     {51, 49, 35, 33, 19, 17, 3, 1}};
 
-static const int hcaladc[8][2] = {
+static constexpr int hcaladc[8][2] = {
     {0, 1},
     {2, 3},
     {4, 5},
@@ -43,60 +44,275 @@ static const int epdchnlmap[16][2] = {
     {27, 28},
     {29, 30}};
 
-static const int epd_phimap[31] = {0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1};
-static const int epd_rmap[31] = {0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15};
+static constexpr int epd_phimap[31] = {0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1};
+static constexpr int epd_rmap[31] = {0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15};
 
-unsigned int TowerInfoDefs::encode_emcal(const unsigned int towerIndex)
+namespace
 {
-  static int phimap[64];
-  static int etamap[64];
-  static int etabinoffset[4];
-  static int ifirst = 1;
-  if (ifirst == 1)
+  // channel <-> key tables, generated at compile time from the adc maps above. The key
+  // tables are indexed by etabin * nphibins + phibin. Channels and keys outside the
+  // detector fall back to the arithmetic.
+  constexpr unsigned int emcal_etabins = 96;
+  constexpr unsigned int emcal_phibins = 256;
+  constexpr unsigned int emcal_channels = emcal_etabins * emcal_phibins;
+  constexpr unsigned int hcal_etabins = 24;
+  constexpr unsigned int hcal_phibins = 64;
+  constexpr unsigned int hcal_channels = hcal_etabins * hcal_phibins;
+  constexpr unsigned int epd_channels = 31 * 12 * 2;
+  constexpr unsigned int epd_keys = 1U << 10U;
+
+  struct AdcMap
+  {
+    std::array<int, 64> etamap{};
+    std::array<int, 64> phimap{};
+  };
+
+  constexpr AdcMap make_emcal_adcmap()
   {
+    AdcMap map;
     for (int j = 0; j < 8; j++)
     {
       for (int k = 0; k < 8; k++)
       {
-        etamap[emcadc[j][k]] = j;
-        phimap[emcadc[j][k]] = k;
+        map.etamap[emcadc[j][k]] = j;
+        map.phimap[emcadc[j][k]] = k;
       }
     }
-    etabinoffset[0] = 24;
-    etabinoffset[1] = 0;
-    etabinoffset[2] = 48;
-    etabinoffset[3] = 72;
-    ifirst = 0;
-  }
-  const int channels_per_sector = 64;
-  const int supersector = 64 * 12;
-  const int nchannelsperpacket = 64 * 3;
-  const int maxphibin = 7;
-  const int maxetabin = 23;
-  int supersectornumber = towerIndex / supersector;
-  int packet = (towerIndex % supersector) / nchannelsperpacket;  // 0 = S small |eta|, 1 == S big |eta|, 2 == N small |eta|, 3 == N big |eta|
-  if (packet < 0 || packet > 3)
-  {
-    std::cout << "Attempting to access channel with invalid value in EMCal " << packet << std::endl;
-    exit(1);
+    return map;
+  }
+
+  constexpr AdcMap make_hcal_adcmap()
+  {
+    AdcMap map;
+    for (int j = 0; j < 8; j++)
+    {
+      for (int k = 0; k < 2; k++)
+      {
+        map.etamap[hcaladc[j][k]] = j;
+        map.phimap[hcaladc[j][k]] = k;
+      }
+    }
+    return map;
   }
-  int interfaceboard = ((towerIndex % supersector) % nchannelsperpacket) / channels_per_sector;
-  int interfaceboard_channel = ((towerIndex % supersector) % nchannelsperpacket) % channels_per_sector;
-  int localphibin = phimap[interfaceboard_channel];
-  if (packet == 0 || packet == 1)
+
+  constexpr AdcMap emcal_adcmap = make_emcal_adcmap();
+  constexpr AdcMap hcal_adcmap = make_hcal_adcmap();
+
+  constexpr unsigned int compute_emcal_key(const unsigned int towerIndex)
   {
-    localphibin = maxphibin - localphibin;
+    const int etabinoffset[4] = {24, 0, 48, 72};
+    const int channels_per_sector = 64;
+    const int supersector = 64 * 12;
+    const int nchannelsperpacket = 64 * 3;
+    const int maxphibin = 7;
+    const int maxetabin = 23;
+    int supersectornumber = towerIndex / supersector;
+    int packet = (towerIndex % supersector) / nchannelsperpacket;  // 0 = S small |eta|, 1 == S big |eta|, 2 == N small |eta|, 3 == N big |eta|
+    int interfaceboard = ((towerIndex % supersector) % nchannelsperpacket) / channels_per_sector;
+    int interfaceboard_channel = ((towerIndex % supersector) % nchannelsperpacket) % channels_per_sector;
+    int localphibin = emcal_adcmap.phimap[interfaceboard_channel];
+    if (packet == 0 || packet == 1)
+    {
+      localphibin = maxphibin - localphibin;
+    }
+    int localetabin = emcal_adcmap.etamap[interfaceboard_channel];
+    int packet_etabin = localetabin + 8 * interfaceboard;
+    if (packet == 0 || packet == 1)
+    {
+      packet_etabin = maxetabin - packet_etabin;
+    }
+    unsigned int globaletabin = packet_etabin + etabinoffset[packet];
+    unsigned int globalphibin = localphibin + supersectornumber * 8;
+    unsigned int key = globalphibin + (globaletabin << 16U);
+    return key;
   }
-  int localetabin = etamap[interfaceboard_channel];
-  int packet_etabin = localetabin + 8 * interfaceboard;
-  if (packet == 0 || packet == 1)
+
+  constexpr unsigned int compute_emcal_index(const unsigned int tower_key)
   {
-    packet_etabin = maxetabin - packet_etabin;
+    const int etabinoffset[4] = {24, 0, 48, 72};
+    const int etabinmap[4] = {1, 0, 2, 3};
+    const int channels_per_sector = 64;
+    const int supersector = 64 * 12;
+    const int nchannelsperpacket = 64 * 3;
+    const int maxphibin = 7;
+    const int maxetabin = 23;
+
+    unsigned int etabin = tower_key >> 16U;
+    unsigned int phibin = tower_key - (etabin << 16U);
+    int packet = etabinmap[(int) etabin / 24];
+    int localetabin = etabin - etabinoffset[packet];
+    int localphibin = phibin % 8;
+    int supersectornumber = phibin / 8;
+    int ib = 0;
+    if (packet == 0 || packet == 1)
+    {
+      localetabin = maxetabin - localetabin;
+    }
+    ib = localetabin / 8;
+    unsigned int index = 0;
+    if (packet == 0 || packet == 1)
+    {
+      localphibin = maxphibin - localphibin;
+    }
+    localetabin = localetabin % 8;
+    unsigned int localindex = emcadc[localetabin][localphibin];
+    index = localindex + channels_per_sector * ib + packet * nchannelsperpacket + supersector * supersectornumber;
+    return index;
   }
-  unsigned int globaletabin = packet_etabin + etabinoffset[packet];
-  unsigned int globalphibin = localphibin + supersectornumber * 8;
-  unsigned int key = globalphibin + (globaletabin << 16U);
-  return key;
+
+  constexpr unsigned int compute_hcal_key(const unsigned int towerIndex)
+  {
+    const int etabinoffset[4] = {0, 8, 16, 0};
+    const int phibinoffset[4] = {0, 2, 4, 6};
+    const int channels_per_sector = 16;
+    const int supersector = 16 * 4 * 3;
+    const int nchannelsperpacket = channels_per_sector * 4;
+    int supersectornumber = towerIndex / supersector;
+    int packet = (towerIndex % supersector) / nchannelsperpacket;  // 0 = S small |eta|, 1 == S big |eta|, 2 == N small |eta|, 3 == N big |eta|
+    int interfaceboard = ((towerIndex % supersector) % nchannelsperpacket) / channels_per_sector;
+    int interfaceboard_channel = ((towerIndex % supersector) % nchannelsperpacket) % channels_per_sector;
+    int localphibin = hcal_adcmap.phimap[interfaceboard_channel] + phibinoffset[interfaceboard];
+    int localetabin = hcal_adcmap.etamap[interfaceboard_channel];
+    int packet_etabin = localetabin;
+    unsigned int globaletabin = packet_etabin + etabinoffset[packet];
+    unsigned int globalphibin = localphibin + supersectornumber * 8;
+    unsigned int key = globalphibin + (globaletabin << 16U);
+    return key;
+  }
+
+  constexpr unsigned int compute_hcal_index(const unsigned int tower_key)
+  {
+    const int channels_per_sector = 16;
+    const int supersector = 16 * 4 * 3;
+    const int nchannelsperpacket = channels_per_sector * 4;
+    const int etabinoffset[3] = {0, 8, 16};
+    const int phibinoffset[4] = {0, 2, 4, 6};
+    unsigned int etabin = tower_key >> 16U;
+    unsigned int phibin = tower_key - (etabin << 16U);
+    int packet = etabin / 8;
+    int localetabin = etabin - etabinoffset[packet];
+    int localphibin = phibin % 8;
+    int supersectornumber = phibin / 8;
+    int ib = localphibin / 2;
+    unsigned int index = 0;
+    localphibin = localphibin - phibinoffset[ib];
+    unsigned int localindex = hcaladc[localetabin][localphibin];
+    index = localindex + channels_per_sector * ib + packet * nchannelsperpacket + supersector * supersectornumber;
+    return index;
+  }
+
+  constexpr unsigned int compute_epd_key(const unsigned int towerIndex)
+  {
+    constexpr unsigned int channels_per_sector = 31;
+    constexpr unsigned int supersector = channels_per_sector * 12;
+    unsigned int supersectornumber = towerIndex / supersector;
+    unsigned int sector = ((towerIndex % supersector)) / channels_per_sector;
+    unsigned int channel = ((towerIndex % supersector)) % channels_per_sector;
+    unsigned int key = channel + (sector << 5U) + (supersectornumber << 9U);
+    return key;
+  }
+
+  // rbin and phibin of an epd key, only valid for channel < 31 and sector < 12
+  constexpr unsigned int compute_epd_rbin(const unsigned int key)
+  {
+    return epd_rmap[key & 0x1fU];
+  }
+
+  constexpr unsigned int compute_epd_phibin(const unsigned int key)
+  {
+    const int flip[24] = {1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1};
+    unsigned int arm = key >> 9U;
+    unsigned int sector = (key >> 5U) & 0xfU;
+    unsigned int channel = key & 0x1fU;
+    unsigned int phibin = epd_phimap[channel] + 2 * sector;
+    if (arm == 1)
+    {
+      phibin = phibin + flip[phibin];
+    }
+    if (epd_rmap[channel] == 0)
+    {
+      phibin = sector;
+    }
+    return phibin;
+  }
+
+  constexpr bool is_valid_epd_key(const unsigned int key)
+  {
+    return key < epd_keys && (key & 0x1fU) < 31 && ((key >> 5U) & 0xfU) < 12;
+  }
+
+  struct CaloTables
+  {
+    std::array<unsigned int, emcal_channels> emcal_key{};
+    std::array<unsigned int, emcal_channels> emcal_index{};
+    std::array<unsigned int, hcal_channels> hcal_key{};
+    std::array<unsigned int, hcal_channels> hcal_index{};
+    std::array<unsigned int, epd_channels> epd_key{};
+    std::array<unsigned char, epd_keys> epd_rbin{};
+    std::array<unsigned char, epd_keys> epd_phibin{};
+  };
+
+  constexpr CaloTables make_calo_tables()
+  {
+    CaloTables tables;
+    for (unsigned int towerIndex = 0; towerIndex < emcal_channels; towerIndex++)
+    {
+      unsigned int key = compute_emcal_key(towerIndex);
+      tables.emcal_key[towerIndex] = key;
+      tables.emcal_index[(key >> 16U) * emcal_phibins + (key & 0xffffU)] = towerIndex;
+    }
+    for (unsigned int towerIndex = 0; towerIndex < hcal_channels; towerIndex++)
+    {
+      unsigned int key = compute_hcal_key(towerIndex);
+      tables.hcal_key[towerIndex] = key;
+      tables.hcal_index[(key >> 16U) * hcal_phibins + (key & 0xffffU)] = towerIndex;
+    }
+    for (unsigned int towerIndex = 0; towerIndex < epd_channels; towerIndex++)
+    {
+      tables.epd_key[towerIndex] = compute_epd_key(towerIndex);
+    }
+    for (unsigned int key = 0; key < epd_keys; key++)
+    {
+      if (is_valid_epd_key(key))
+      {
+        tables.epd_rbin[key] = compute_epd_rbin(key);
+        tables.epd_phibin[key] = compute_epd_phibin(key);
+      }
+    }
+    return tables;
+  }
+
+  constexpr CaloTables calo_tables = make_calo_tables();
+
+  // the key tables are only complete if channel <-> key is a bijection
+  constexpr bool check_calo_tables()
+  {
+    for (unsigned int towerIndex = 0; towerIndex < emcal_channels; towerIndex++)
+    {
+      if (compute_emcal_index(calo_tables.emcal_key[towerIndex]) != towerIndex)
+      {
+        return false;
+      }
+    }
+    for (unsigned int towerIndex = 0; towerIndex < hcal_channels; towerIndex++)
+    {
+      if (compute_hcal_index(calo_tables.hcal_key[towerIndex]) != towerIndex)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  static_assert(check_calo_tables(), "calorimeter channel <-> key tables are not a bijection");
+}  // namespace
+
+unsigned int TowerInfoDefs::encode_emcal(const unsigned int towerIndex)
+{
+  if (towerIndex < emcal_channels)
+  {
+    return calo_tables.emcal_key[towerIndex];
+  }
+  return compute_emcal_key(towerIndex);
 }
 
 unsigned int TowerInfoDefs::encode_emcal(const unsigned int etabin, const unsigned int phibin)
@@ -107,87 +323,22 @@ unsigned int TowerInfoDefs::encode_emcal(const unsigned int etabin, const unsign
 
 unsigned int TowerInfoDefs::decode_emcal(const unsigned int tower_key)
 {
-  const int etabinoffset[4] = {24, 0, 48, 72};
-  const int etabinmap[4] = {1, 0, 2, 3};
-  const int channels_per_sector = 64;
-  const int supersector = 64 * 12;
-  const int nchannelsperpacket = 64 * 3;
-  const int maxphibin = 7;
-  const int maxetabin = 23;
-
   unsigned int etabin = tower_key >> 16U;
-  unsigned int phibin = tower_key - (etabin << 16U);
-  int packet = etabinmap[(int) etabin / 24];
-  int localetabin = etabin - etabinoffset[packet];
-  int localphibin = phibin % 8;
-  int supersectornumber = phibin / 8;
-  int ib = 0;
-  if (packet == 0 || packet == 1)
+  unsigned int phibin = tower_key & 0xffffU;
+  if (etabin < emcal_etabins && phibin < emcal_phibins)
   {
-    localetabin = maxetabin - localetabin;
+    return calo_tables.emcal_index[etabin * emcal_phibins + phibin];
   }
-  ib = localetabin / 8;
-  unsigned int index = 0;
-  if (packet == 0 || packet == 1)
-  {
-    localphibin = maxphibin - localphibin;
-  }
-  localetabin = localetabin % 8;
-  unsigned int localindex = emcadc[localetabin][localphibin];
-  index = localindex + channels_per_sector * ib + packet * nchannelsperpacket + supersector * supersectornumber;
-  return index;
+  return compute_emcal_index(tower_key);
 }
 
 unsigned int TowerInfoDefs::encode_hcal(const unsigned int towerIndex)
 {
-  static int phimap[64];
-  static int etamap[64];
-  static int etabinoffset[4];
-  static int phibinoffset[4];
-  static int ifirst = 1;
-  if (ifirst == 1)
+  if (towerIndex < hcal_channels)
   {
-    for (int j = 0; j < 8; j++)
-    {
-      for (int k = 0; k < 2; k++)
-      {
-        etamap[hcaladc[j][k]] = j;
-        phimap[hcaladc[j][k]] = k;
-      }
-    }
-    etabinoffset[0] = 0;
-    etabinoffset[1] = 8;
-    etabinoffset[2] = 16;
-    etabinoffset[3] = 0;
-
-    phibinoffset[0] = 0;
-    phibinoffset[1] = 2;
-    phibinoffset[2] = 4;
-    phibinoffset[3] = 6;
-    ifirst = 0;
-  }
-
-  const int channels_per_sector = 16;
-  const int supersector = 16 * 4 * 3;
-  const int nchannelsperpacket = channels_per_sector * 4;
-  // const int etabinoffset[4] = {0,8,16,0};
-  // const int phibinoffset[4] = {0,2,4,6};
-  int supersectornumber = towerIndex / supersector;
-  int packet = (towerIndex % supersector) / nchannelsperpacket;  // 0 = S small |eta|, 1 == S big |eta|, 2 == N small |eta|, 3 == N big |eta|
-  if (packet < 0 || packet > 3)
-  {
-    std::cout << "Attempting to access channel with invalid value ih HCAL " << packet << std::endl;
-    exit(1);
+    return calo_tables.hcal_key[towerIndex];
   }
-  int interfaceboard = ((towerIndex % supersector) % nchannelsperpacket) / channels_per_sector;
-  int interfaceboard_channel = ((towerIndex % supersector) % nchannelsperpacket) % channels_per_sector;
-  int localphibin = phimap[interfaceboard_channel] + phibinoffset[interfaceboard];
-  int localetabin = etamap[interfaceboard_channel];
-  int packet_etabin = localetabin;
-  unsigned int globaletabin = packet_etabin + etabinoffset[packet];
-  unsigned int globalphibin = localphibin + supersectornumber * 8;
-  unsigned int key = globalphibin + (globaletabin << 16U);
-  return key;
+  return compute_hcal_key(towerIndex);
 }
 
 // convert from etabin-phibin to key
@@ -199,23 +350,13 @@ unsigned int TowerInfoDefs::encode_hcal(const unsigned int etabin, const unsigne
 
 unsigned int TowerInfoDefs::decode_hcal(const unsigned int tower_key)
 {
-  int channels_per_sector = 16;
-  int supersector = 16 * 4 * 3;
-  int nchannelsperpacket = channels_per_sector * 4;
-  int etabinoffset[3] = {0, 8, 16};
-  int phibinoffset[4] = {0, 2, 4, 6};
   unsigned int etabin = tower_key >> 16U;
-  unsigned int phibin = tower_key - (etabin << 16U);
-  int packet = etabin / 8;
-  int localetabin = etabin - etabinoffset[packet];
-  int localphibin = phibin % 8;
-  int supersectornumber = phibin / 8;
-  int ib = localphibin / 2;
-  unsigned int index = 0;
-  localphibin = localphibin - phibinoffset[ib];
-  unsigned int localindex = hcaladc[localetabin][localphibin];
-  index = localindex + channels_per_sector * ib + packet * nchannelsperpacket + supersector * supersectornumber;
-  return index;
+  unsigned int phibin = tower_key & 0xffffU;
+  if (etabin < hcal_etabins && phibin < hcal_phibins)
+  {
+    return calo_tables.hcal_index[etabin * hcal_phibins + phibin];
+  }
+  return compute_hcal_index(tower_key);
 }
 
 // convert from calorimeter key to phi bin
@@ -235,13 +376,11 @@ unsigned int TowerInfoDefs::getCaloTowerEtaBin(const unsigned int key)
 
 unsigned int TowerInfoDefs::encode_epd(const unsigned int towerIndex)  // convert from tower index to key
 {
-  constexpr unsigned int channels_per_sector = 31;
-  constexpr unsigned int supersector = channels_per_sector * 12;
-  unsigned int supersectornumber = towerIndex / supersector;
-  unsigned int sector = ((towerIndex % supersector)) / channels_per_sector;
-  unsigned int channel = ((towerIndex % supersector)) % channels_per_sector;
-  unsigned int key = channel + (sector << 5U) + (supersectornumber << 9U);
-  return key;
+  if (towerIndex < epd_channels)
+  {
+    return calo_tables.epd_key[towerIndex];
+  }
+  return compute_epd_key(towerIndex);
 }
 
 // convert from arm-rbin-phibin to key
@@ -296,6 +435,10 @@ unsigned int TowerInfoDefs::get_epd_sector(unsigned int key)
 // convert from epd key to r bin
 unsigned int TowerInfoDefs::get_epd_rbin(unsigned int key)
 {
+  if (is_valid_epd_key(key))
+  {
+    return calo_tables.epd_rbin[key];
+  }
   unsigned int arm = get_epd_arm(key);
   unsigned int sector = get_epd_sector(key);
   unsigned int channel = key - (sector << 5U) - (arm << 9U);
@@ -305,6 +448,10 @@ unsigned int TowerInfoDefs::get_epd_rbin(unsigned int key)
 // convert from epd key to phi bin
 unsigned int TowerInfoDefs::get_epd_phibin(unsigned int key)
 {
+  if (is_valid_epd_key(key))
+  {
+    return calo_tables.epd_phibin[key];
+  }
   int flip[24] = {1,-1,1,-1,1,-1,1,-1,1,-1,1,-1,1,-1,1,-1,1,-1,1,-1,1,-1,1,-1};
   unsigned int arm = get_epd_arm(key);
   unsigned int rbin = get_epd_rbin(key);
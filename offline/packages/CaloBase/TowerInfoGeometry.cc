@@ -0,0 +1,47 @@
+#include "TowerInfoGeometry.h"
+
+#include "RawTowerGeom.h"
+#include "RawTowerGeomContainer.h"
+#include "TowerInfoContainer.h"
+
+#include <memory>
+
+void TowerInfoGeometry::build(TowerInfoContainer *towers, RawTowerGeomContainer *geom, RawTowerDefs::CalorimeterId caloid)
+{
+  m_geom = geom;
+  m_caloid = caloid;
+  m_towers.assign(towers->size(), Tower());
+  for (unsigned int channel = 0; channel < m_towers.size(); channel++)
+  {
+    Tower &tower = m_towers[channel];
+    unsigned int calokey = towers->encode_key(channel);
+    int ieta = towers->getTowerEtaBin(calokey);
+    int iphi = towers->getTowerPhiBin(calokey);
+    tower.geokey = RawTowerDefs::encode_towerid(caloid, ieta, iphi);
+    RawTowerGeom *tower_geom = geom->get_tower_geometry(tower.geokey);
+    if (!tower_geom)
+    {
+      continue;
+    }
+    tower.valid = true;
+    tower.eta = tower_geom->get_eta();
+    tower.phi = tower_geom->get_phi();
+    tower.center_x = tower_geom->get_center_x();
+    tower.center_y = tower_geom->get_center_y();
+    tower.center_z = tower_geom->get_center_z();
+    tower.center_radius = tower_geom->get_center_radius();
+  }
+}
+
+const TowerInfoGeometry *TowerInfoGeometry::attach(TowerInfoContainer *towers, RawTowerGeomContainer *geom, RawTowerDefs::CalorimeterId caloid)
+{
+  const TowerInfoGeometry *attached = towers->get_geometry();
+  if (attached && attached->get_geometry_container() == geom && attached->get_calorimeter_id() == caloid && attached->size() == towers->size())
+  {
+    return attached;
+  }
+  auto table = std::make_shared<TowerInfoGeometry>();
+  table->build(towers, geom, caloid);
+  towers->set_geometry(table);
+  return table.get();
+}
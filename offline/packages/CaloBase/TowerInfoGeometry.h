@@ -0,0 +1,55 @@
+#ifndef CALOBASE_TOWERINFOGEOMETRY_H
+#define CALOBASE_TOWERINFOGEOMETRY_H
+
+#include "RawTowerDefs.h"
+
+#include <vector>
+
+class RawTowerGeomContainer;
+class TowerInfoContainer;
+
+/*! \class TowerInfoGeometry
+    \brief tower geometry of a TowerInfoContainer, indexed by channel
+
+    Copies the tower centers out of the RawTowerGeomContainer map once, so that
+    consumers can loop over the channels of a TowerInfoContainer with their
+    geometry without a map lookup per tower. Use attach() to share one table
+    between all modules reading the same container.
+*/
+class TowerInfoGeometry
+{
+ public:
+  struct Tower
+  {
+    RawTowerDefs::keytype geokey{0};
+    bool valid{false};  // false if the geometry container has no tower for this channel
+    double eta{0};
+    double phi{0};
+    double center_x{0};
+    double center_y{0};
+    double center_z{0};
+    double center_radius{0};
+  };
+
+  TowerInfoGeometry() = default;
+  ~TowerInfoGeometry() = default;
+
+  //! fill one entry per channel of towers, the geometry keys use calorimeter caloid
+  void build(TowerInfoContainer *towers, RawTowerGeomContainer *geom, RawTowerDefs::CalorimeterId caloid);
+
+  //! table attached to towers, built first if there is none for this geometry container and calorimeter id
+  static const TowerInfoGeometry *attach(TowerInfoContainer *towers, RawTowerGeomContainer *geom, RawTowerDefs::CalorimeterId caloid);
+
+  const Tower &get_tower_at_channel(unsigned int channel) const { return m_towers[channel]; }
+  unsigned int size() const { return m_towers.size(); }
+
+  const RawTowerGeomContainer *get_geometry_container() const { return m_geom; }
+  RawTowerDefs::CalorimeterId get_calorimeter_id() const { return m_caloid; }
+
+ private:
+  std::vector<Tower> m_towers;
+  const RawTowerGeomContainer *m_geom{nullptr};
+  RawTowerDefs::CalorimeterId m_caloid{RawTowerDefs::NONE};
+};
+
+#endif
@@ -300,28 +300,54 @@ int CaloTowerCalib::InitRun(PHCompositeNode *topNode)
   {
     topNode->print();
   }
+  // the calibration columns are filled with the first event of the run
+  m_calibconst.clear();
+  m_ZScrosscalibconst.clear();
+  m_meantime.clear();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void CaloTowerCalib::LoadCalibrationColumns(TowerInfoContainer *raw_towers)
+{
+  unsigned int ntowers = raw_towers->size();
+  std::vector<int> keys(ntowers);
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    keys[channel] = raw_towers->encode_key(channel);
+  }
+  m_calibconst = cdbttree->GetFloatColumn(keys, m_fieldname);
+  if (m_doZScrosscalib)
+  {
+    m_ZScrosscalibconst = cdbttree_ZScrosscalib->GetFloatColumn(keys, m_fieldname_ZScrosscalib);
+  }
+  if (m_dotimecalib)
+  {
+    m_meantime = cdbttree_time->GetFloatColumn(keys, m_fieldname_time);
+  }
+}
+
 //____________________________________________________________________________..
 int CaloTowerCalib::process_event(PHCompositeNode *topNode)
 {
   TowerInfoContainer *_raw_towers = findNode::getClass<TowerInfoContainer>(topNode, RawTowerNodeName);
   TowerInfoContainer *_calib_towers = findNode::getClass<TowerInfoContainer>(topNode, CalibTowerNodeName);
   unsigned int ntowers = _raw_towers->size();
+  if (m_calibconst.size() != ntowers)
+  {
+    LoadCalibrationColumns(_raw_towers);
+  }
 
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
-    unsigned int key = _raw_towers->encode_key(channel);
     TowerInfo *caloinfo_raw = _raw_towers->get_tower_at_channel(channel);
     _calib_towers->get_tower_at_channel(channel)->copy_tower(caloinfo_raw);
     float raw_amplitude = caloinfo_raw->get_energy();
-    float calibconst = cdbttree->GetFloatValue(key, m_fieldname);
+    float calibconst = m_calibconst[channel];
     bool isZS = caloinfo_raw->get_isZS();
 
     if (isZS && m_doZScrosscalib)
     {
-      float crosscalibconst = cdbttree_ZScrosscalib->GetFloatValue(key, m_fieldname_ZScrosscalib);
+      float crosscalibconst = m_ZScrosscalibconst[channel];
       if (crosscalibconst == 0) 
       { 
         crosscalibconst = 1; 
@@ -344,7 +370,7 @@ int CaloTowerCalib::process_event(PHCompositeNode *topNode)
       {
       //I realized that there is no point to do timing calibration for the towerinfov1 object since the resolution is not enough...
       float raw_time = caloinfo_raw->get_time_float();
-      float meantime = cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      float meantime = m_meantime[channel];
       _calib_towers->get_tower_at_channel(channel)->set_time_float(raw_time - meantime);
       }
     }
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
@@ -128,6 +129,13 @@ class CaloTowerCalib : public SubsysReco
   CDBTTree *cdbttree = nullptr;
   CDBTTree *cdbttree_time = nullptr;
   CDBTTree *cdbttree_ZScrosscalib = nullptr;
+
+  // calibration constants indexed by channel, filled from the CDBTTrees once per run
+  void LoadCalibrationColumns(TowerInfoContainer *raw_towers);
+  std::vector<float> m_calibconst;
+  std::vector<float> m_ZScrosscalibconst;
+  std::vector<float> m_meantime;
+
   int m_runNumber;
 };
 
@@ -212,19 +212,47 @@ int CaloTowerStatus::InitRun(PHCompositeNode *topNode)
   {
     topNode->print();
   }
+  // the status columns are filled with the first event of the run
+  m_columnsLoaded = false;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void CaloTowerStatus::LoadStatusColumns()
+{
+  unsigned int ntowers = m_raw_towers->size();
+  std::vector<int> keys(ntowers);
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    keys[channel] = m_raw_towers->encode_key(channel);
+  }
+  if (m_doHotChi2)
+  {
+    m_fraction_badChi2 = m_cdbttree_chi2->GetFloatColumn(keys, m_fieldname_chi2);
+  }
+  if (m_doTime)
+  {
+    m_mean_time = m_cdbttree_time->GetFloatColumn(keys, m_fieldname_time);
+  }
+  if (m_doHotMap)
+  {
+    m_hotMap_val = m_cdbttree_hotMap->GetIntColumn(keys, m_fieldname_hotMap);
+  }
+  m_columnsLoaded = true;
+}
+
 //____________________________________________________________________________..
 int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
 {
+  if (!m_columnsLoaded)
+  {
+    LoadStatusColumns();
+  }
   unsigned int ntowers = m_raw_towers->size();
   float fraction_badChi2 = 0;
   float mean_time = 0;
   int hotMap_val = 0;
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
-    unsigned int key = m_raw_towers->encode_key(channel);
     // only reset what we will set
     m_raw_towers->get_tower_at_channel(channel)->set_isHot(false);
     m_raw_towers->get_tower_at_channel(channel)->set_isBadTime(false);
@@ -232,15 +260,15 @@ int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
 
     if (m_doHotChi2)
     {
-      fraction_badChi2 = m_cdbttree_chi2->GetFloatValue(key, m_fieldname_chi2);
+      fraction_badChi2 = m_fraction_badChi2[channel];
     }
     if (m_doTime)
     {
-      mean_time = m_cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      mean_time = m_mean_time[channel];
     }
     if (m_doHotMap)
     {
-      hotMap_val = m_cdbttree_hotMap->GetIntValue(key, m_fieldname_hotMap);
+      hotMap_val = m_hotMap_val[channel];
     }
     float chi2 = m_raw_towers->get_tower_at_channel(channel)->get_chi2();
     float time = m_raw_towers->get_tower_at_channel(channel)->get_time_float();
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
@@ -93,6 +94,13 @@ class CaloTowerStatus : public SubsysReco
   CDBTTree *m_cdbttree_time{nullptr};
   CDBTTree *m_cdbttree_hotMap{nullptr};
 
+  // status constants indexed by channel, filled from the CDBTTrees once per run
+  void LoadStatusColumns();
+  std::vector<float> m_fraction_badChi2;
+  std::vector<float> m_mean_time;
+  std::vector<int> m_hotMap_val;
+  bool m_columnsLoaded{false};
+
   bool m_doHotChi2{true};
   bool m_doTime{true};
   bool m_doHotMap{true};
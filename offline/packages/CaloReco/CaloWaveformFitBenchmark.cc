@@ -0,0 +1,177 @@
+// Benchmark of the ROOT fit (CaloWaveformFitting) against the Gauss-Newton
+// template fit (CaloWaveformTemplateFitter) on the same waveforms.
+//
+// usage: calowaveform_fit_benchmark template.root [waveforms.root] [nthreads] [nchannels_per_event]
+//
+// waveforms.root holds a TTree "waveforms" with one entry per channel and a
+// std::vector<float> branch "waveform" (e.g. dumped from recorded EMCal
+// data), consecutive entries are grouped into events of nchannels_per_event.
+// Without an input file (or with "-") pulses are generated from the template.
+// The fit results of both paths are compared channel by channel.
+
+#include "CaloWaveformFitting.h"
+#include "CaloWaveformTemplateFitter.h"
+
+#include <TFile.h>
+#include <TProfile.h>
+#include <TRandom3.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using Event = std::vector<std::vector<float>>;
+
+  std::vector<Event> read_waveforms(const std::string& filename, std::size_t nchannels)
+  {
+    std::vector<Event> events;
+    std::unique_ptr<TFile> fin(TFile::Open(filename.c_str()));
+    if (!fin || !fin->IsOpen())
+    {
+      std::cout << "cannot open " << filename << std::endl;
+      return events;
+    }
+    auto* tree = dynamic_cast<TTree*>(fin->Get("waveforms"));
+    if (!tree)
+    {
+      std::cout << "no TTree waveforms in " << filename << std::endl;
+      return events;
+    }
+    std::vector<float>* waveform = nullptr;
+    tree->SetBranchAddress("waveform", &waveform);
+    Event event;
+    for (Long64_t ientry = 0; ientry < tree->GetEntries(); ++ientry)
+    {
+      tree->GetEntry(ientry);
+      event.push_back(*waveform);
+      if (event.size() == nchannels)
+      {
+        events.push_back(std::move(event));
+        event.clear();
+      }
+    }
+    if (!event.empty())
+    {
+      events.push_back(std::move(event));
+    }
+    return events;
+  }
+
+  // template pulses on a pedestal with gaussian noise, peaking around sample 6
+  std::vector<Event> generate_waveforms(const std::string& templatefile, std::size_t nchannels, int nevents)
+  {
+    std::vector<Event> events;
+    std::unique_ptr<TFile> fin(TFile::Open(templatefile.c_str()));
+    if (!fin || !fin->IsOpen())
+    {
+      std::cout << "cannot open " << templatefile << std::endl;
+      return events;
+    }
+    auto* h_template = dynamic_cast<TProfile*>(fin->Get("waveform_template"));
+    if (!h_template)
+    {
+      std::cout << "no waveform_template in " << templatefile << std::endl;
+      return events;
+    }
+    const double peak_time = h_template->GetBinCenter(h_template->GetMaximumBin());
+    constexpr int nsamples = 16;
+    TRandom3 random(12345);
+    events.resize(nevents);
+    for (auto& event : events)
+    {
+      event.resize(nchannels);
+      for (auto& waveform : event)
+      {
+        const double amplitude = random.Exp(200.);
+        const double t0 = 6. - peak_time + random.Uniform(-1., 1.);
+        const double pedestal = random.Gaus(1500., 20.);
+        waveform.resize(nsamples);
+        for (int is = 0; is < nsamples; ++is)
+        {
+          waveform[is] = std::round(amplitude * h_template->Interpolate(is - t0) + pedestal + random.Gaus(0., 3.));
+        }
+      }
+    }
+    return events;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cout << "usage: " << argv[0] << " template.root [waveforms.root] [nthreads] [nchannels_per_event]" << std::endl;
+    return 1;
+  }
+  const std::string templatefile = argv[1];
+  const std::string inputfile = (argc > 2) ? argv[2] : "-";
+  const int nthreads = (argc > 3) ? std::atoi(argv[3]) : 1;
+  const std::size_t nchannels = (argc > 4) ? std::atoi(argv[4]) : 24576;
+
+  const auto events = (inputfile == "-") ? generate_waveforms(templatefile, nchannels, 10) : read_waveforms(inputfile, nchannels);
+  if (events.empty())
+  {
+    return 1;
+  }
+
+  CaloWaveformFitting rootfitter;
+  rootfitter.set_nthreads(nthreads);
+  rootfitter.initialize_processing(templatefile);
+
+  CaloWaveformTemplateFitter gnfitter;
+  gnfitter.set_nthreads(nthreads);
+  gnfitter.initialize_processing(templatefile);
+
+  double root_ms = 0;
+  double gn_ms = 0;
+  std::size_t nfitted = 0;
+  std::size_t namplitude_diff = 0;
+  double max_time_diff = 0;
+  for (const auto& event : events)
+  {
+    auto start = std::chrono::steady_clock::now();
+    const auto root_results = rootfitter.process_waveform(event);
+    auto stop = std::chrono::steady_clock::now();
+    root_ms += std::chrono::duration<double, std::milli>(stop - start).count();
+
+    start = std::chrono::steady_clock::now();
+    const auto gn_results = gnfitter.process_waveform(event);
+    stop = std::chrono::steady_clock::now();
+    gn_ms += std::chrono::duration<double, std::milli>(stop - start).count();
+
+    for (std::size_t ich = 0; ich < event.size(); ++ich)
+    {
+      const auto& r = root_results[ich];
+      const auto& g = gn_results[ich];
+      // zero suppressed channels have no time, nothing was fitted
+      if (std::isnan(r[1]) || std::isnan(g[1]))
+      {
+        continue;
+      }
+      ++nfitted;
+      if (std::abs(r[0] - g[0]) > 1e-3 * std::max(1.f, std::abs(r[0])))
+      {
+        ++namplitude_diff;
+      }
+      max_time_diff = std::max<double>(max_time_diff, std::abs(r[1] - g[1]));
+    }
+  }
+
+  const double nevents = events.size();
+  std::cout << "events: " << events.size() << " channels per event: " << events.front().size() << " threads: " << nthreads << std::endl;
+  std::cout << "ROOT fit:          " << root_ms / nevents << " ms/event" << std::endl;
+  std::cout << "Gauss-Newton fit:  " << gn_ms / nevents << " ms/event" << std::endl;
+  std::cout << "speedup:           " << root_ms / std::max(gn_ms, 1e-9) << std::endl;
+  std::cout << "fitted channels:   " << nfitted
+            << ", amplitude differs by more than 1e-3: " << namplitude_diff
+            << ", max time difference: " << max_time_diff << " samples" << std::endl;
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include "CaloWaveformProcessing.h"
 #include "CaloWaveformFitting.h"
+#include "CaloWaveformTemplateFitter.h"
 
 #include <ffamodules/CDBInterface.h>
 
@@ -17,6 +18,7 @@ Ort::Session *onnxmodule;
 CaloWaveformProcessing::~CaloWaveformProcessing()
 {
   delete m_Fitter;
+  delete m_TemplateFitter;
 }
 
 void CaloWaveformProcessing::initialize_processing()
@@ -44,6 +46,26 @@ void CaloWaveformProcessing::initialize_processing()
         m_Fitter->set_bitFlipRecovery(_dobitfliprecovery);
       }
   }
+  else if (m_processingtype == CaloWaveformProcessing::TEMPLATE_GAUSSNEWTON)
+  {
+    std::string calibrations_repo_template = std::string(calibrationsroot) + "/WaveformProcessing/templates/" + m_template_input_file;
+    url_template = CDBInterface::instance()->getUrl(m_template_name, calibrations_repo_template);
+    m_TemplateFitter = new CaloWaveformTemplateFitter();
+    m_TemplateFitter->initialize_processing(url_template);
+    m_TemplateFitter->set_nthreads(_nthreads);
+    if (m_setTimeLim)
+    {
+      m_TemplateFitter->set_timeFitLim(m_timeLim_low, m_timeLim_high);
+    }
+    if (_bdosoftwarezerosuppression)
+    {
+      m_TemplateFitter->set_softwarezerosuppression(_bdosoftwarezerosuppression, _nsoftwarezerosuppression);
+    }
+    if (_dobitfliprecovery)
+    {
+      m_TemplateFitter->set_bitFlipRecovery(_dobitfliprecovery);
+    }
+  }
   else if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
     std::string calibrations_repo_model = std::string(calibrationsroot) + "/WaveformProcessing/models/" + m_model_name;
@@ -59,17 +81,22 @@ void CaloWaveformProcessing::initialize_processing()
   }
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::vector<std::vector<float>> waveformvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(const std::vector<std::vector<float>> &waveformvector)
 {
   int size1 = waveformvector.size();
   std::vector<std::vector<float>> fitresults;
   if (m_processingtype == CaloWaveformProcessing::TEMPLATE)
   {
+    std::vector<std::vector<float>> chnlvector = waveformvector;
     for (int i = 0; i < size1; i++)
     {
-      waveformvector.at(i).push_back(i);
+      chnlvector.at(i).push_back(i);
     }
-    fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
+    fitresults = m_Fitter->calo_processing_templatefit(chnlvector);
+  }
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE_GAUSSNEWTON)
+  {
+    fitresults = m_TemplateFitter->process_waveform(waveformvector);
   }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
@@ -86,7 +113,7 @@ std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::ve
   return fitresults;
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(std::vector<std::vector<float>> chnlvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector)
 {
   std::vector<std::vector<float>> fit_values;
   int nchnls = chnlvector.size();
@@ -121,6 +148,10 @@ int CaloWaveformProcessing::get_nthreads()
   {
     return m_Fitter->get_nthreads();
   }
+  if (m_TemplateFitter)
+  {
+    return m_TemplateFitter->get_nthreads();
+  }
   return _nthreads;
 }
 void CaloWaveformProcessing::set_nthreads(int nthreads)
@@ -130,5 +161,9 @@ void CaloWaveformProcessing::set_nthreads(int nthreads)
   {
     m_Fitter->set_nthreads(nthreads);
   }
+  if (m_TemplateFitter)
+  {
+    m_TemplateFitter->set_nthreads(nthreads);
+  }
   return;
 }
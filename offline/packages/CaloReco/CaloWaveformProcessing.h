@@ -7,6 +7,7 @@
 #include <vector>
 
 class CaloWaveformFitting;
+class CaloWaveformTemplateFitter;
 
 class CaloWaveformProcessing : public SubsysReco
 {
@@ -18,6 +19,7 @@ class CaloWaveformProcessing : public SubsysReco
     ONNX = 2,
     FAST = 3,
     NYQUIST = 4,
+    TEMPLATE_GAUSSNEWTON = 5,  // template fit without ROOT fitter objects
   };
 
   CaloWaveformProcessing() = default;
@@ -72,13 +74,14 @@ class CaloWaveformProcessing : public SubsysReco
     _dobitfliprecovery = dobitfliprecovery;
   }
 
-  std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
-  std::vector<std::vector<float>> calo_processing_ONNX(std::vector<std::vector<float>> chnlvector);
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
+  std::vector<std::vector<float>> calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector);
 
   void initialize_processing();
 
  private:
   CaloWaveformFitting *m_Fitter = nullptr;
+  CaloWaveformTemplateFitter *m_TemplateFitter = nullptr;
 
   CaloWaveformProcessing::process m_processingtype = CaloWaveformProcessing::TEMPLATE;
   int _nthreads = 1;
@@ -0,0 +1,389 @@
+#include "CaloWaveformTemplateFitter.h"
+
+#include <TFile.h>
+#include <TProfile.h>
+
+#include <ROOT/TThreadExecutor.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+  // solve the symmetric 3x3 system a * x = b with Cramer's rule
+  bool solve3(const double a[3][3], const double b[3], double *x)
+  {
+    const double det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+                       a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+                       a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    if (!std::isfinite(det) || det == 0)
+    {
+      return false;
+    }
+    x[0] = (b[0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+            a[0][1] * (b[1] * a[2][2] - a[1][2] * b[2]) +
+            a[0][2] * (b[1] * a[2][1] - a[1][1] * b[2])) /
+           det;
+    x[1] = (a[0][0] * (b[1] * a[2][2] - a[1][2] * b[2]) -
+            b[0] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+            a[0][2] * (a[1][0] * b[2] - b[1] * a[2][0])) /
+           det;
+    x[2] = (a[0][0] * (a[1][1] * b[2] - b[1] * a[2][1]) -
+            a[0][1] * (a[1][0] * b[2] - b[1] * a[2][0]) +
+            b[0] * (a[1][0] * a[2][1] - a[1][1] * a[2][0])) /
+           det;
+    return true;
+  }
+
+  // highest sample and pedestal estimate, same as in CaloWaveformFitting
+  template <class T>
+  void find_peak(const T *v, int size1, float &maxheight, int &maxbin, float &pedestal)
+  {
+    maxheight = 0;
+    maxbin = 0;
+    for (int i = 0; i < size1; i++)
+    {
+      if (v[i] > maxheight)
+      {
+        maxheight = v[i];
+        maxbin = i;
+      }
+    }
+    if (maxbin > 4)
+    {
+      pedestal = 0.5 * (v[maxbin - 4] + v[maxbin - 5]);
+    }
+    else if (maxbin > 3)
+    {
+      pedestal = v[maxbin - 4];
+    }
+    else
+    {
+      pedestal = 0.5 * (v[size1 - 3] + v[size1 - 2]);
+    }
+  }
+}  // namespace
+
+CaloWaveformTemplateFitter::CaloWaveformTemplateFitter() = default;
+
+CaloWaveformTemplateFitter::~CaloWaveformTemplateFitter() = default;
+
+void CaloWaveformTemplateFitter::initialize_processing(const std::string &templatefile)
+{
+  TFile *fin = TFile::Open(templatefile.c_str());
+  assert(fin);
+  assert(fin->IsOpen());
+  TProfile *h_template = static_cast<TProfile *>(fin->Get("waveform_template"));
+  assert(h_template);
+  h_template->SetDirectory(nullptr);
+  fin->Close();
+  delete fin;
+
+  // tabulate the bin means, the interpolation between bin centers is done by template_value
+  const int nbins = h_template->GetNbinsX();
+  m_template.resize(nbins);
+  for (int i = 0; i < nbins; i++)
+  {
+    m_template[i] = h_template->GetBinContent(i + 1);
+  }
+  m_templateFirstCenter = h_template->GetBinCenter(1);
+  m_templateBinWidth = h_template->GetBinWidth(1);
+  m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
+  delete h_template;
+}
+
+double CaloWaveformTemplateFitter::template_value(double t) const
+{
+  const double u = (t - m_templateFirstCenter) / m_templateBinWidth;
+  const int nbins = m_template.size();
+  if (u <= 0)
+  {
+    return m_template.front();
+  }
+  if (u >= nbins - 1)
+  {
+    return m_template.back();
+  }
+  const int i = static_cast<int>(u);
+  return m_template[i] + (u - i) * (m_template[i + 1] - m_template[i]);
+}
+
+double CaloWaveformTemplateFitter::template_derivative(double t) const
+{
+  const double u = (t - m_templateFirstCenter) / m_templateBinWidth;
+  const int nbins = m_template.size();
+  if (u <= 0 || u >= nbins - 1)
+  {
+    return 0;
+  }
+  const int i = static_cast<int>(u);
+  return (m_template[i + 1] - m_template[i]) / m_templateBinWidth;
+}
+
+double CaloWaveformTemplateFitter::chi2(const double *x, const double *y, int npoints, const double *par) const
+{
+  double sum = 0;
+  for (int k = 0; k < npoints; k++)
+  {
+    const double residual = y[k] - (par[0] * template_value(x[k] - par[1]) + par[2]);
+    sum += residual * residual;
+  }
+  return sum;
+}
+
+double CaloWaveformTemplateFitter::fit(const double *x, const double *y, int npoints, double tmin, double tmax, double *par) const
+{
+  par[1] = std::clamp(par[1], tmin, tmax);
+  double current = chi2(x, y, npoints, par);
+  double lambda = 1e-3;
+  for (int iter = 0; iter < _maxiterations; iter++)
+  {
+    // normal equations of the linearized problem, all sample errors are 1
+    double jtj[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+    double jtr[3] = {0, 0, 0};
+    for (int k = 0; k < npoints; k++)
+    {
+      const double t = x[k] - par[1];
+      const double value = template_value(t);
+      const double residual = y[k] - (par[0] * value + par[2]);
+      const double jac[3] = {value, -par[0] * template_derivative(t), 1};
+      for (int i = 0; i < 3; i++)
+      {
+        jtr[i] += jac[i] * residual;
+        for (int j = 0; j < 3; j++)
+        {
+          jtj[i][j] += jac[i] * jac[j];
+        }
+      }
+    }
+
+    double damped[3][3];
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        damped[i][j] = jtj[i][j];
+      }
+      damped[i][i] += lambda * std::max(jtj[i][i], 1e-12);
+    }
+    double step[3];
+    if (!solve3(damped, jtr, step))
+    {
+      lambda *= 10;
+      if (lambda > 1e12)
+      {
+        break;
+      }
+      continue;
+    }
+
+    double trial[3] = {par[0] + step[0], std::clamp(par[1] + step[1], tmin, tmax), par[2] + step[2]};
+    const double trialchi2 = chi2(x, y, npoints, trial);
+    if (trialchi2 < current)
+    {
+      const double improvement = current - trialchi2;
+      std::copy(trial, trial + 3, par);
+      current = trialchi2;
+      lambda = std::max(lambda * 0.1, 1e-12);
+      if (improvement < 1e-9 * (1. + current))
+      {
+        break;
+      }
+    }
+    else
+    {
+      lambda *= 10;
+      if (lambda > 1e12)
+      {
+        break;
+      }
+    }
+  }
+  return current;
+}
+
+void CaloWaveformTemplateFitter::process_channel(const float *v, int size1, Workspace &ws, float *result) const
+{
+  const float qnan = std::numeric_limits<float>::quiet_NaN();
+  if (size1 == _nzerosuppresssamples)
+  {
+    result[0] = v[1] - v[0];  // peak sample - pedestal sample
+    result[1] = qnan;         // time is qnan for ZS
+    result[2] = v[0];
+    result[3] = (v[0] != 0 && v[1] == 0) ? 1000000 : qnan;  // post-sample is 0, set high chi2
+    result[4] = 0;
+    return;
+  }
+
+  float maxheight = 0;
+  int maxbin = 0;
+  float pedestal = 1500;
+  find_peak(v, size1, maxheight, maxbin, pedestal);
+
+  if ((_bdosoftwarezerosuppression && v[6] - v[0] < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+  {
+    result[0] = v[6] - v[0];
+    result[1] = qnan;
+    result[2] = v[0];
+    result[3] = (v[0] != 0 && v[1] == 0) ? 1000000 : qnan;
+    result[4] = 0;
+    return;
+  }
+
+  // skip saturated samples, unless so many are saturated that the fit would lack ndf
+  double *x = ws.x.data();
+  double *y = ws.y.data();
+  int ndata = 0;
+  for (int i = 0; i < size1; ++i)
+  {
+    if (v[i] == 16383)
+    {
+      continue;
+    }
+    x[ndata] = i;
+    y[ndata] = v[i];
+    ndata++;
+  }
+  if (ndata > (size1 - 4))
+  {
+    ndata = size1;
+    for (int i = 0; i < size1; ++i)
+    {
+      x[i] = i;
+      y[i] = v[i];
+    }
+  }
+
+  double tmin = -1 * m_peakTimeTemp;
+  double tmax = size1 - m_peakTimeTemp;
+  if (m_setTimeLim)
+  {
+    tmin = m_timeLim_low;
+    tmax = m_timeLim_high;
+  }
+  double par[3] = {static_cast<double>(maxheight - pedestal), static_cast<double>(maxbin - m_peakTimeTemp), static_cast<double>(pedestal)};
+  double chi2min = fit(x, y, ndata, tmin, tmax, par);
+  chi2min /= ndata - 3;  // divide by the number of dof
+
+  if (chi2min > _chi2threshold && (par[2] < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (par[2] > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
+  {
+    double *rv = ws.recovered.data();  // temporary recovered waveform
+    std::copy(v, v + size1, rv);
+    unsigned int bits[3] = {8192, 4096, 2048};
+    for (auto bit : bits)
+    {
+      for (int i = 0; i < size1; i++)
+      {
+        if (((unsigned int) rv[i] & bit) && ((unsigned int) rv[i] % bit > _bfr_lowpedestalthreshold))
+        {
+          rv[i] = rv[i] - bit;
+        }
+      }
+    }
+    find_peak(rv, size1, maxheight, maxbin, pedestal);
+    for (int i = 0; i < size1; ++i)
+    {
+      x[i] = i;
+      y[i] = rv[i];
+    }
+
+    double recover_par[3] = {static_cast<double>(maxheight - pedestal), 0, static_cast<double>(pedestal)};
+    double recover_chi2min = fit(x, y, size1, -1 * m_peakTimeTemp, size1 - m_peakTimeTemp, recover_par);
+    recover_chi2min /= size1 - 3;  // divide by the number of dof
+    if (recover_chi2min < _chi2lowthreshold && recover_par[2] < _bfr_highpedestalthreshold && recover_par[2] > _bfr_lowpedestalthreshold)
+    {
+      std::copy(recover_par, recover_par + 3, result);
+      result[3] = recover_chi2min;
+      result[4] = 1;
+      return;
+    }
+  }
+  std::copy(par, par + 3, result);
+  result[3] = chi2min;
+  result[4] = 0;
+}
+
+void CaloWaveformTemplateFitter::process(const float *samples, const int *nsamples, std::size_t nchannels, std::size_t stride, float *results)
+{
+  if (m_template.empty())
+  {
+    std::cout << "CaloWaveformTemplateFitter::process - no template loaded, call initialize_processing first" << std::endl;
+    return;
+  }
+
+  // split the channels into one contiguous range per thread
+  const std::size_t nthreads = std::max(1, _nthreads);
+  m_workspaces.resize(nthreads);
+  for (auto &ws : m_workspaces)
+  {
+    if (ws.x.size() < stride)
+    {
+      ws.x.resize(stride);
+      ws.y.resize(stride);
+      ws.recovered.resize(stride);
+    }
+  }
+
+  auto process_chunk = [&](const Chunk &chunk)
+  {
+    for (std::size_t ich = chunk.begin; ich < chunk.end; ich++)
+    {
+      process_channel(samples + ich * stride, nsamples[ich], *chunk.ws, results + ich * NRESULTS);
+    }
+  };
+
+  if (nthreads == 1 || nchannels < nthreads)
+  {
+    process_chunk(Chunk{0, nchannels, &m_workspaces.front()});
+    return;
+  }
+
+  const std::size_t chunksize = (nchannels + nthreads - 1) / nthreads;
+  m_chunks.clear();
+  for (std::size_t i = 0; i < nthreads; i++)
+  {
+    const std::size_t begin = i * chunksize;
+    const std::size_t end = std::min(nchannels, begin + chunksize);
+    if (begin < end)
+    {
+      m_chunks.push_back({begin, end, &m_workspaces[i]});
+    }
+  }
+  if (!m_executor || m_executor->GetPoolSize() != nthreads)
+  {
+    m_executor = std::make_unique<ROOT::TThreadExecutor>(nthreads);
+  }
+  m_executor->Foreach(process_chunk, m_chunks);
+}
+
+std::vector<std::vector<float>> CaloWaveformTemplateFitter::process_waveform(const std::vector<std::vector<float>> &waveformvector)
+{
+  // copy into one channels x samples matrix
+  const std::size_t nchannels = waveformvector.size();
+  std::size_t stride = 0;
+  for (const auto &waveform : waveformvector)
+  {
+    stride = std::max(stride, waveform.size());
+  }
+  m_samples.resize(nchannels * stride);
+  m_nsamples.resize(nchannels);
+  m_results.resize(nchannels * NRESULTS);
+  for (std::size_t ich = 0; ich < nchannels; ich++)
+  {
+    const auto &waveform = waveformvector[ich];
+    std::copy(waveform.begin(), waveform.end(), m_samples.begin() + ich * stride);
+    m_nsamples[ich] = waveform.size();
+  }
+
+  process(m_samples.data(), m_nsamples.data(), nchannels, stride, m_results.data());
+
+  std::vector<std::vector<float>> fit_params(nchannels);
+  for (std::size_t ich = 0; ich < nchannels; ich++)
+  {
+    fit_params[ich].assign(m_results.begin() + ich * NRESULTS, m_results.begin() + (ich + 1) * NRESULTS);
+  }
+  return fit_params;
+}
@@ -0,0 +1,115 @@
+#ifndef CALORECO_CALOWAVEFORMTEMPLATEFITTER_H
+#define CALORECO_CALOWAVEFORMTEMPLATEFITTER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ROOT
+{
+  class TThreadExecutor;
+}
+
+//! Template fit of calorimeter waveforms without ROOT fitting objects
+//! The template is tabulated once, amplitude/time/pedestal are fitted with a
+//! damped Gauss-Newton (Levenberg-Marquardt) solver working on preallocated
+//! per thread buffers. The selection and bit flip recovery logic follows
+//! CaloWaveformFitting::calo_processing_templatefit
+class CaloWaveformTemplateFitter
+{
+ public:
+  //! number of values per channel in the result: amplitude, time, pedestal, chi2/ndf, recovered
+  static constexpr int NRESULTS = 5;
+
+  CaloWaveformTemplateFitter();
+  ~CaloWaveformTemplateFitter();
+
+  void initialize_processing(const std::string &templatefile);
+
+  void set_nthreads(int nthreads) { _nthreads = nthreads; }
+  int get_nthreads() const { return _nthreads; }
+
+  void set_softwarezerosuppression(bool usezerosuppression, int softwarezerosuppression)
+  {
+    _nsoftwarezerosuppression = softwarezerosuppression;
+    _bdosoftwarezerosuppression = usezerosuppression;
+  }
+  void set_maxsoftwarezerosuppression(bool usezerosuppression, int softwarezerosuppression)
+  {
+    _nsoftwarezerosuppression = softwarezerosuppression;
+    _maxsoftwarezerosuppression = usezerosuppression;
+  }
+  void set_timeFitLim(float low, float high)
+  {
+    m_setTimeLim = true;
+    m_timeLim_low = low;
+    m_timeLim_high = high;
+  }
+  void set_bitFlipRecovery(bool dobitfliprecovery) { _dobitfliprecovery = dobitfliprecovery; }
+
+  //! fit nchannels waveforms stored row-wise with a row length of stride
+  //! nsamples[i] is the number of samples in row i (2 for zero suppressed channels)
+  //! results has to hold nchannels * NRESULTS values
+  void process(const float *samples, const int *nsamples, std::size_t nchannels, std::size_t stride, float *results);
+
+  //! same interface as CaloWaveformFitting::process_waveform
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
+
+ private:
+  // preallocated fit buffers, one per thread
+  struct Workspace
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> recovered;
+  };
+
+  // range of channels processed with one workspace
+  struct Chunk
+  {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    Workspace *ws = nullptr;
+  };
+
+  void process_channel(const float *v, int size1, Workspace &ws, float *result) const;
+
+  //! fit amplitude, time and pedestal to the npoints in x, y. Returns the chi2
+  double fit(const double *x, const double *y, int npoints, double tmin, double tmax, double *par) const;
+  double chi2(const double *x, const double *y, int npoints, const double *par) const;
+
+  //! linear interpolation of the template, same as TH1::Interpolate
+  double template_value(double t) const;
+  double template_derivative(double t) const;
+
+  std::vector<double> m_template;
+  double m_templateFirstCenter{0};
+  double m_templateBinWidth{1};
+  double m_peakTimeTemp{0};
+
+  std::vector<Workspace> m_workspaces;
+  std::vector<Chunk> m_chunks;
+  std::unique_ptr<ROOT::TThreadExecutor> m_executor;
+
+  // contiguous copies used by process_waveform
+  std::vector<float> m_samples;
+  std::vector<int> m_nsamples;
+  std::vector<float> m_results;
+
+  int _nthreads{1};
+  int _nzerosuppresssamples{2};
+  int _nsoftwarezerosuppression{40};
+  int _maxiterations{100};
+  float m_timeLim_low{-3.0};
+  float m_timeLim_high{4.0};
+  float _chi2threshold{100000};
+  float _chi2lowthreshold{10000};
+  float _bfr_lowpedestalthreshold{1200};
+  float _bfr_highpedestalthreshold{4000};
+  bool _bdosoftwarezerosuppression{false};
+  bool _maxsoftwarezerosuppression{false};
+  bool m_setTimeLim{false};
+  bool _dobitfliprecovery{false};
+};
+#endif
@@ -8,6 +8,7 @@
 #include <calobase/RawTowerGeomContainer.h>
 #include <calobase/TowerInfo.h>           // for TowerInfo
 #include <calobase/TowerInfoContainer.h>  // for TowerInfoContainer
+#include <calobase/TowerInfoGeometry.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>
@@ -560,6 +561,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
   {
     TowerInfo *towerInfo = nullptr;
     unsigned int n_IH_towers = towerinfosIH->size();
+    const TowerInfoGeometry *towergeomIH = TowerInfoGeometry::attach(towerinfosIH, _geom_containers[0], RawTowerDefs::CalorimeterId::HCALIN);
     for (unsigned int iIH = 0; iIH < n_IH_towers; iIH++)
     {
       towerInfo = towerinfosIH->get_tower_at_channel(iIH);
@@ -567,15 +569,11 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         continue;
       }
-      unsigned int towerinfo_key = towerinfosIH->encode_key(iIH);
-      int ti_ieta = towerinfosIH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosIH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ti_ieta, ti_iphi);
+      const TowerInfoGeometry::Tower &tower_geom = towergeomIH->get_tower_at_channel(iIH);
+      const RawTowerDefs::keytype key = tower_geom.geokey;
 
-      RawTowerGeom *tower_geom = _geom_containers[0]->get_tower_geometry(key);
-
-      int ieta = _geom_containers[0]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[0]->get_phibin(tower_geom->get_phi());
+      int ieta = _geom_containers[0]->get_etabin(tower_geom.eta);
+      int iphi = _geom_containers[0]->get_phibin(tower_geom.phi);
       float this_E = towerInfo->get_energy();
 
       if (!_use_absE && this_E < 1.E-10)
@@ -599,6 +597,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       }
     }
     unsigned int n_OH_towers = towerinfosOH->size();
+    const TowerInfoGeometry *towergeomOH = TowerInfoGeometry::attach(towerinfosOH, _geom_containers[1], RawTowerDefs::CalorimeterId::HCALOUT);
     for (unsigned int iOH = 0; iOH < n_OH_towers; iOH++)
     {
       towerInfo = towerinfosOH->get_tower_at_channel(iOH);
@@ -606,15 +605,11 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         continue;
       }
-      unsigned int towerinfo_key = towerinfosOH->encode_key(iOH);
-      int ti_ieta = towerinfosOH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosOH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[1]->get_tower_geometry(key);
+      const TowerInfoGeometry::Tower &tower_geom = towergeomOH->get_tower_at_channel(iOH);
+      const RawTowerDefs::keytype key = tower_geom.geokey;
 
-      int ieta = _geom_containers[1]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[1]->get_phibin(tower_geom->get_phi());
+      int ieta = _geom_containers[1]->get_etabin(tower_geom.eta);
+      int iphi = _geom_containers[1]->get_phibin(tower_geom.phi);
       float this_E = towerInfo->get_energy();
 
 
@@ -83,23 +83,17 @@ int RawClusterPositionCorrection::InitRun(PHCompositeNode *topNode)
   /// north
   std::string m_fieldname = "cemc_PDC_NorthSector_8x8_clusE";
   std::string m_fieldname_ecore = "cemc_PDC_NorthSector_8x8_clusEcore";
-  float calib_constant = 0;
+  std::vector<int> keys(bins_eta);
 
   // Read in the calibration factors and store in the array
   for (int i = 0; i < bins_phi; ++i)
   {
-    std::vector<float> dumvec;
-    std::vector<float> dumvec2;
     for (int j = 0; j < bins_eta; ++j)
     {
-      int key = i * bins_eta + j;
-      calib_constant = cdbttree->GetFloatValue(key, m_fieldname);
-      dumvec.push_back(calib_constant);
-      calib_constant = cdbttree->GetFloatValue(key, m_fieldname_ecore);
-      dumvec2.push_back(calib_constant);
+      keys[j] = i * bins_eta + j;
     }
-    calib_constants_north.push_back(dumvec);
-    calib_constants_north_ecore.push_back(dumvec2);
+    calib_constants_north.push_back(cdbttree->GetFloatColumn(keys, m_fieldname));
+    calib_constants_north_ecore.push_back(cdbttree->GetFloatColumn(keys, m_fieldname_ecore));
   }
   /// south
   m_fieldname = "cemc_PDC_SouthSector_8x8_clusE";
@@ -108,18 +102,12 @@ int RawClusterPositionCorrection::InitRun(PHCompositeNode *topNode)
   // Read in the calibration factors and store in the array
   for (int i = 0; i < bins_phi; ++i)
   {
-    std::vector<float> dumvec;
-    std::vector<float> dumvec2;
     for (int j = 0; j < bins_eta; ++j)
     {
-      int key = i * bins_eta + j;
-      calib_constant = cdbttree->GetFloatValue(key, m_fieldname);
-      dumvec.push_back(calib_constant);
-      calib_constant = cdbttree->GetFloatValue(key, m_fieldname_ecore);
-      dumvec2.push_back(calib_constant);
+      keys[j] = i * bins_eta + j;
     }
-    calib_constants_south.push_back(dumvec);
-    calib_constants_south_ecore.push_back(dumvec2);
+    calib_constants_south.push_back(cdbttree->GetFloatColumn(keys, m_fieldname));
+    calib_constants_south_ecore.push_back(cdbttree->GetFloatColumn(keys, m_fieldname_ecore));
   }
 
   // Load PDC final stage correction
@@ -316,13 +316,22 @@ int RawTowerCalibration::process_event(PHCompositeNode * /*topNode*/)
           return Fun4AllReturnCodes::ABORTRUN;
         }
 
-        float gain_factor = -888;
-        const int eta = _raw_towerinfos->getTowerEtaBin(key);
-        const int phi = _raw_towerinfos->getTowerPhiBin(key);
-        unsigned int etaphikey = phi;
-        etaphikey = (etaphikey << 16U) + eta;
-
-        gain_factor = m_CDBTTree->GetFloatValue(etaphikey, "etaphi");
+        // gain factors indexed by channel, looked up once
+        if (m_GainFactor.size() != ntowers)
+        {
+          std::vector<int> etaphikeys(ntowers);
+          for (unsigned int ich = 0; ich < ntowers; ich++)
+          {
+            const unsigned int towerkey = _raw_towerinfos->encode_key(ich);
+            const int eta = _raw_towerinfos->getTowerEtaBin(towerkey);
+            const int phi = _raw_towerinfos->getTowerPhiBin(towerkey);
+            unsigned int etaphikey = phi;
+            etaphikey = (etaphikey << 16U) + eta;
+            etaphikeys[ich] = etaphikey;
+          }
+          m_GainFactor = m_CDBTTree->GetFloatColumn(etaphikeys, "etaphi");
+        }
+        float gain_factor = m_GainFactor[channel];
         const double raw_energy = raw_tower->get_energy();
         float corr_energy = raw_energy * gain_factor * _calib_const_GeV_ADC;
         calib_tower->set_energy(corr_energy);
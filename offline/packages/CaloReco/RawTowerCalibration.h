@@ -8,6 +8,7 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
@@ -196,6 +197,8 @@ class RawTowerCalibration : public SubsysReco
   bool m_UseTowerInfoV2{false};
 
   CDBTTree *m_CDBTTree{nullptr};
+  //! gain factors from m_CDBTTree indexed by TowerInfo channel
+  std::vector<float> m_GainFactor;
   RawTowerCalibration::ProcessTowerType m_UseTowerInfo{RawTowerCalibration::ProcessTowerType::kBothTowers};  // 0 just produce RawTowers, 1 just produce TowerInfo objects, and 2 produce both
 };
 
@@ -27,6 +27,8 @@
 
 #include "KFParticle_Tools.h"
 
+#include <fun4all/Fun4AllServer.h>
+
 #include <trackbase_historic/SvtxTrack.h>
 #include <trackbase_historic/SvtxTrackMap.h>
 
@@ -61,6 +63,23 @@
 
 KFParticle_truthAndDetTools toolSet;
 
+namespace
+{
+  /// Daughters of the current event, one entry per track map and track hit selection
+  struct SharedDaughters
+  {
+    SvtxTrackMap *trackmap {nullptr};
+    unsigned int ntracks {0};
+    int nMVTXHits {0};
+    int nTPCHits {0};
+    bool bunch_crossing_zero_only {false};
+    std::vector<KFParticle> particles;
+  };
+  int shared_daughters_run {-1};
+  int shared_daughters_event {-1};
+  std::vector<SharedDaughters> shared_daughters;
+}  // namespace
+
 /// KFParticle constructor
 KFParticle_Tools::KFParticle_Tools()
   : m_has_intermediates(false)
@@ -228,6 +247,45 @@ KFParticle KFParticle_Tools::makeParticle(PHCompositeNode * /*topNode*/)  /// Re
 }
 
 std::vector<KFParticle> KFParticle_Tools::makeAllDaughterParticles(PHCompositeNode *topNode)
+{
+  if (!m_share_daughters)
+  {
+    return buildAllDaughterParticles(topNode);
+  }
+
+  // the shared daughters are only valid for the event being processed by the server
+  Fun4AllServer *se = Fun4AllServer::instance();
+  if (se->RunNumber() != shared_daughters_run || se->EventCounter() != shared_daughters_event)
+  {
+    shared_daughters.clear();
+    shared_daughters_run = se->RunNumber();
+    shared_daughters_event = se->EventCounter();
+  }
+
+  m_dst_trackmap = findNode::getClass<SvtxTrackMap>(topNode, m_trk_map_node_name.c_str());
+  for (const auto &shared : shared_daughters)
+  {
+    if (shared.trackmap == m_dst_trackmap && shared.ntracks == m_dst_trackmap->size() &&
+        shared.nMVTXHits == m_nMVTXHits && shared.nTPCHits == m_nTPCHits &&
+        shared.bunch_crossing_zero_only == m_bunch_crossing_zero_only)
+    {
+      return shared.particles;
+    }
+  }
+
+  SharedDaughters shared;
+  shared.trackmap = m_dst_trackmap;
+  shared.ntracks = m_dst_trackmap->size();
+  shared.nMVTXHits = m_nMVTXHits;
+  shared.nTPCHits = m_nTPCHits;
+  shared.bunch_crossing_zero_only = m_bunch_crossing_zero_only;
+  shared.particles = buildAllDaughterParticles(topNode);
+  shared_daughters.push_back(shared);
+
+  return shared.particles;
+}
+
+std::vector<KFParticle> KFParticle_Tools::buildAllDaughterParticles(PHCompositeNode *topNode)
 {
   std::vector<KFParticle> daughterParticles;
   m_dst_trackmap = findNode::getClass<SvtxTrackMap>(topNode, m_trk_map_node_name.c_str());
@@ -374,7 +432,7 @@ int KFParticle_Tools::calcMinIP(const KFParticle &track, const std::vector<KFPar
   return 0;
 }
 
-std::vector<int> KFParticle_Tools::findAllGoodTracks(std::vector<KFParticle> daughterParticles, const std::vector<KFParticle> &primaryVertices)
+std::vector<int> KFParticle_Tools::findAllGoodTracks(const std::vector<KFParticle> &daughterParticles, const std::vector<KFParticle> &primaryVertices)
 {
   std::vector<int> goodTrackIndex;
 
@@ -391,51 +449,89 @@ std::vector<int> KFParticle_Tools::findAllGoodTracks(std::vector<KFParticle> dau
   return goodTrackIndex;
 }
 
-std::vector<std::vector<int>> KFParticle_Tools::findTwoProngs(std::vector<KFParticle> daughterParticles, std::vector<int> goodTrackIndex, int nTracks)
+std::vector<int> KFParticle_Tools::requiredTrackCharges(int start, int stop)
+{
+  std::vector<int> requiredCharges;
+  if (start < 0 || stop > (int) m_daughter_charge.size() || start >= stop)
+  {
+    return requiredCharges;
+  }
+  for (int i = start; i < stop; ++i)
+  {
+    if (std::abs(m_daughter_charge[i]) != 1)
+    {
+      requiredCharges.clear();
+      return requiredCharges;
+    }
+    requiredCharges.push_back(m_daughter_charge[i]);
+  }
+  return requiredCharges;
+}
+
+bool KFParticle_Tools::isChargeCompatible(int nPositive, int nNegative, const std::vector<int> &requiredCharges)
+{
+  if (requiredCharges.empty())
+  {
+    return true;
+  }
+  int requiredPositive = std::count(requiredCharges.begin(), requiredCharges.end(), 1);
+  int requiredNegative = requiredCharges.size() - requiredPositive;
+
+  // buildMother compares the sum of charge times mass hypothesis, which only matches if the charges match
+  bool compatible = nPositive <= requiredPositive && nNegative <= requiredNegative;
+  if (m_get_charge_conjugate)
+  {
+    compatible = compatible || (nPositive <= requiredNegative && nNegative <= requiredPositive);
+  }
+  return compatible;
+}
+
+std::vector<std::vector<int>> KFParticle_Tools::findTwoProngs(const std::vector<KFParticle> &daughterParticles, const std::vector<int> &goodTrackIndex, int nTracks,
+                                                              const std::vector<int> &requiredCharges)
 {
   std::vector<std::vector<int>> goodTracksThatMeet;
 
-  for (std::vector<int>::iterator i_it = goodTrackIndex.begin(); i_it != goodTrackIndex.end(); ++i_it)
+  for (auto i_it = goodTrackIndex.begin(); i_it != goodTrackIndex.end(); ++i_it)
   {
-    for (std::vector<int>::iterator j_it = goodTrackIndex.begin(); j_it != goodTrackIndex.end(); ++j_it)
+    for (auto j_it = i_it + 1; j_it != goodTrackIndex.end(); ++j_it)
     {
-      if (i_it < j_it)
+      // Charge first, it is free compared to the DCA and the vertex fit
+      int nPositive = (daughterParticles[*i_it].GetQ() > 0) + (daughterParticles[*j_it].GetQ() > 0);
+      if (!isChargeCompatible(nPositive, 2 - nPositive, requiredCharges))
       {
-        float dca = 0;
-        if (m_use_2D_matching_tools)
-        {
-          dca = daughterParticles[*i_it].GetDistanceFromParticleXY(daughterParticles[*j_it]);
-        }
-        else
-        {
-          dca = daughterParticles[*i_it].GetDistanceFromParticle(daughterParticles[*j_it]);
-        }
+        continue;
+      }
+
+      float dca = 0;
+      if (m_use_2D_matching_tools)
+      {
+        dca = daughterParticles[*i_it].GetDistanceFromParticleXY(daughterParticles[*j_it]);
+      }
+      else
+      {
+        dca = daughterParticles[*i_it].GetDistanceFromParticle(daughterParticles[*j_it]);
+      }
+
+      if (dca <= m_comb_DCA)
+      {
+        std::vector<int> combination = {*i_it, *j_it};
 
-        if (dca <= m_comb_DCA)
+        // The vertex is only needed for the final combination
+        if (nTracks == 2)
         {
           KFVertex twoParticleVertex;
           twoParticleVertex += daughterParticles[*i_it];
           twoParticleVertex += daughterParticles[*j_it];
           float vertexchi2ndof = twoParticleVertex.GetChi2() / twoParticleVertex.GetNDF();
           float sv_radial_position = sqrt(pow(twoParticleVertex.GetX(), 2) + pow(twoParticleVertex.GetY(), 2));
-          std::vector<int> combination = {*i_it, *j_it};
 
-          if (nTracks == 2 && vertexchi2ndof > m_vertex_chi2ndof)
+          if (vertexchi2ndof > m_vertex_chi2ndof || sv_radial_position < m_min_radial_SV)
           {
             continue;
           }
-          else
-          {
-            if (nTracks == 2 && sv_radial_position < m_min_radial_SV)
-            {
-              continue;
-            }
-            else
-            {
-              goodTracksThatMeet.push_back(combination);
-            }
-          }
         }
+
+        goodTracksThatMeet.push_back(combination);
       }
     }
   }
@@ -443,76 +539,94 @@ std::vector<std::vector<int>> KFParticle_Tools::findTwoProngs(std::vector<KFPart
   return goodTracksThatMeet;
 }
 
-std::vector<std::vector<int>> KFParticle_Tools::findNProngs(std::vector<KFParticle> daughterParticles,
+std::vector<std::vector<int>> KFParticle_Tools::findNProngs(const std::vector<KFParticle> &daughterParticles,
                                                             const std::vector<int> &goodTrackIndex,
                                                             std::vector<std::vector<int>> goodTracksThatMeet,
-                                                            int nRequiredTracks, unsigned int nProngs)
+                                                            int nRequiredTracks, unsigned int nProngs,
+                                                            const std::vector<int> &requiredCharges)
 {
   unsigned int nGoodProngs = goodTracksThatMeet.size();
 
+  // The same track pairs come up for many combinations, compute each DCA only once
+  // -1: not computed yet, 0: fails the DCA cut, 1: passes it
+  const unsigned int nParticles = daughterParticles.size();
+  std::vector<signed char> pairMeets(nParticles * nParticles, -1);
+  auto dcaMeets = [&](int i, int j)
+  {
+    signed char &meets = pairMeets[i * nParticles + j];
+    if (meets < 0)
+    {
+      float dca = 0;
+      if (m_use_2D_matching_tools)
+      {
+        dca = daughterParticles[i].GetDistanceFromParticleXY(daughterParticles[j]);
+      }
+      else
+      {
+        dca = daughterParticles[i].GetDistanceFromParticle(daughterParticles[j]);
+      }
+      meets = dca <= m_comb_DCA ? 1 : 0;
+    }
+    return meets == 1;
+  };
+
   for (auto &i_it : goodTrackIndex)
   {
     for (unsigned int i_prongs = 0; i_prongs < nGoodProngs; ++i_prongs)
     {
       bool trackNotUsedAlready = true;
+      int nPositive = daughterParticles[i_it].GetQ() > 0;
       for (unsigned int i_trackCheck = 0; i_trackCheck < nProngs - 1; ++i_trackCheck)
       {
         if (i_it == goodTracksThatMeet[i_prongs][i_trackCheck])
         {
           trackNotUsedAlready = false;
+          break;
         }
+        nPositive += daughterParticles[goodTracksThatMeet[i_prongs][i_trackCheck]].GetQ() > 0;
       }
-      if (trackNotUsedAlready)
+      if (!trackNotUsedAlready || !isChargeCompatible(nPositive, nProngs - nPositive, requiredCharges))
       {
-        bool dcaMet = true;
-        for (unsigned int i = 0; i < nProngs - 1; ++i)
+        continue;
+      }
+
+      bool dcaMet = true;
+      for (unsigned int i = 0; i < nProngs - 1; ++i)
+      {
+        if (!dcaMeets(i_it, goodTracksThatMeet[i_prongs][i]))
         {
-          float dca = 0;
-          if (m_use_2D_matching_tools)
-          {
-            dca = daughterParticles[i_it].GetDistanceFromParticleXY(daughterParticles[goodTracksThatMeet[i_prongs][i]]);
-          }
-          else
-          {
-            dca = daughterParticles[i_it].GetDistanceFromParticle(daughterParticles[goodTracksThatMeet[i_prongs][i]]);          
-          }
+          dcaMet = false;
+          break;
+        }
+      }
 
-          if (dca > m_comb_DCA)
-          {
-            dcaMet = false;
-          }
+      if (dcaMet)
+      {
+        std::vector<int> combination;
+        combination.push_back(i_it);
+        for (unsigned int i = 0; i < nProngs - 1; ++i)
+        {
+          combination.push_back(goodTracksThatMeet[i_prongs][i]);
         }
 
-        if (dcaMet)
+        // The vertex is only needed for the final combination
+        if ((unsigned int) nRequiredTracks == nProngs)
         {
           KFVertex particleVertex;
-          particleVertex += daughterParticles[i_it];
-          std::vector<int> combination;
-          combination.push_back(i_it);
-          for (unsigned int i = 0; i < nProngs - 1; ++i)
+          for (int i : combination)
           {
-            particleVertex += daughterParticles[goodTracksThatMeet[i_prongs][i]];
-            combination.push_back(goodTracksThatMeet[i_prongs][i]);
+            particleVertex += daughterParticles[i];
           }
           float vertexchi2ndof = particleVertex.GetChi2() / particleVertex.GetNDF();
           float sv_radial_position = sqrt(pow(particleVertex.GetX(), 2) + pow(particleVertex.GetY(), 2));
 
-          if ((unsigned int) nRequiredTracks == nProngs && vertexchi2ndof > m_vertex_chi2ndof)
+          if (vertexchi2ndof > m_vertex_chi2ndof || sv_radial_position < m_min_radial_SV)
           {
             continue;
           }
-          else
-          {
-            if ((unsigned int) nRequiredTracks == nProngs && sv_radial_position < m_min_radial_SV)
-            {
-              continue;
-            }
-            else
-            {
-              goodTracksThatMeet.push_back(combination);
-            }
-          }
         }
+
+        goodTracksThatMeet.push_back(combination);
       }
     }
   }
@@ -527,7 +641,7 @@ std::vector<std::vector<int>> KFParticle_Tools::findNProngs(std::vector<KFPartic
   return goodTracksThatMeet;
 }
 
-std::vector<std::vector<int>> KFParticle_Tools::appendTracksToIntermediates(KFParticle intermediateResonances[], std::vector<KFParticle> daughterParticles, const std::vector<int> &goodTrackIndex, int num_remaining_tracks)
+std::vector<std::vector<int>> KFParticle_Tools::appendTracksToIntermediates(KFParticle intermediateResonances[], const std::vector<KFParticle> &daughterParticles, const std::vector<int> &goodTrackIndex, int num_remaining_tracks)
 {
   std::vector<std::vector<int>> goodTracksThatMeet, goodTracksThatMeetIntermediates;  //, vectorOfGoodTracks;
   if (num_remaining_tracks == 1)
@@ -55,24 +55,35 @@ class KFParticle_Tools : protected KFParticle_MVA
 
   KFParticle makeParticle(PHCompositeNode *topNode);
 
+  /// Daughters of this event, shared with every other instance using the same track map and track hit selection
   std::vector<KFParticle> makeAllDaughterParticles(PHCompositeNode *topNode);
 
+  std::vector<KFParticle> buildAllDaughterParticles(PHCompositeNode *topNode);
+
   int getTracksFromVertex(PHCompositeNode *topNode, const KFParticle &vertex, const std::string &vertexMapName);
 
   /*const*/ bool isGoodTrack(const KFParticle &particle, const std::vector<KFParticle> &primaryVertices);
 
   int calcMinIP(const KFParticle &track, const std::vector<KFParticle> &PVs, float &minimumIP, float &minimumIPchi2);
 
-  std::vector<int> findAllGoodTracks(std::vector<KFParticle> daughterParticles, const std::vector<KFParticle> &primaryVertices);
+  std::vector<int> findAllGoodTracks(const std::vector<KFParticle> &daughterParticles, const std::vector<KFParticle> &primaryVertices);
+
+  /// Charges of the daughters [start, stop) of the decay descriptor, empty if they can not all be tracks
+  std::vector<int> requiredTrackCharges(int start, int stop);
 
-  std::vector<std::vector<int>> findTwoProngs(std::vector<KFParticle> daughterParticles, std::vector<int> goodTrackIndex, int nTracks);
+  /// True if a combination with these numbers of positive and negative tracks can still become the required charges
+  bool isChargeCompatible(int nPositive, int nNegative, const std::vector<int> &requiredCharges);
 
-  std::vector<std::vector<int>> findNProngs(std::vector<KFParticle> daughterParticles,
+  std::vector<std::vector<int>> findTwoProngs(const std::vector<KFParticle> &daughterParticles, const std::vector<int> &goodTrackIndex, int nTracks,
+                                              const std::vector<int> &requiredCharges = {});
+
+  std::vector<std::vector<int>> findNProngs(const std::vector<KFParticle> &daughterParticles,
                                             const std::vector<int> &goodTrackIndex,
                                             std::vector<std::vector<int>> goodTracksThatMeet,
-                                            int nRequiredTracks, unsigned int nProngs);
+                                            int nRequiredTracks, unsigned int nProngs,
+                                            const std::vector<int> &requiredCharges = {});
 
-  std::vector<std::vector<int>> appendTracksToIntermediates(KFParticle intermediateResonances[], std::vector<KFParticle> daughterParticles, const std::vector<int> &goodTrackIndex, int num_remaining_tracks);
+  std::vector<std::vector<int>> appendTracksToIntermediates(KFParticle intermediateResonances[], const std::vector<KFParticle> &daughterParticles, const std::vector<int> &goodTrackIndex, int num_remaining_tracks);
 
   /// Calculates the cosine of the angle betweent the flight direction and momentum
   float eventDIRA(const KFParticle &particle, const KFParticle &vertex, bool do3D = true);
@@ -186,6 +197,8 @@ class KFParticle_Tools : protected KFParticle_MVA
 
   bool m_use_mbd_vertex {false};
 
+  bool m_share_daughters {false};
+
   std::string m_vtx_map_node_name;
   std::string m_trk_map_node_name;
   MbdVertexMap *m_dst_mbdvertexmap {nullptr};
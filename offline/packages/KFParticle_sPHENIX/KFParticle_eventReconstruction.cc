@@ -96,10 +96,11 @@ void KFParticle_eventReconstruction::buildBasicChain(std::vector<KFParticle>& se
                                                      const std::vector<int>& goodTrackIndexBasic,
                                                      const std::vector<KFParticle>& primaryVerticesBasic)
 {
-  std::vector<std::vector<int>> goodTracksThatMeet = findTwoProngs(daughterParticlesBasic, goodTrackIndexBasic, m_num_tracks);
+  std::vector<int> requiredCharges = requiredTrackCharges(0, m_num_tracks);
+  std::vector<std::vector<int>> goodTracksThatMeet = findTwoProngs(daughterParticlesBasic, goodTrackIndexBasic, m_num_tracks, requiredCharges);
   for (int p = 3; p < m_num_tracks + 1; ++p)
   {
-    goodTracksThatMeet = findNProngs(daughterParticlesBasic, goodTrackIndexBasic, goodTracksThatMeet, m_num_tracks, p);
+    goodTracksThatMeet = findNProngs(daughterParticlesBasic, goodTrackIndexBasic, goodTracksThatMeet, m_num_tracks, p, requiredCharges);
   }
 
   getCandidateDecay(selectedMotherBasic, selectedVertexBasic, selectedDaughtersBasic, daughterParticlesBasic,
@@ -128,13 +129,19 @@ void KFParticle_eventReconstruction::buildChain(std::vector<KFParticle>& selecte
   for (int i = 0; i < m_num_intermediate_states; ++i)
   {
     std::vector<KFParticle> vertices;
-    std::vector<std::vector<int>> goodTracksThatMeet = findTwoProngs(daughterParticlesAdv, goodTrackIndexAdv, m_num_tracks_from_intermediate[i]);
+    // Same daughters as getCandidateDecay below uses for the charge check
+    std::vector<int> requiredCharges = requiredTrackCharges(track_start, track_stop);
+    if ((int) requiredCharges.size() != m_num_tracks_from_intermediate[i])
+    {
+      requiredCharges.clear();
+    }
+    std::vector<std::vector<int>> goodTracksThatMeet = findTwoProngs(daughterParticlesAdv, goodTrackIndexAdv, m_num_tracks_from_intermediate[i], requiredCharges);
     for (int p = 3; p <= m_num_tracks_from_intermediate[i]; ++p)
     {
       goodTracksThatMeet = findNProngs(daughterParticlesAdv,
                                        goodTrackIndexAdv,
                                        goodTracksThatMeet,
-                                       m_num_tracks_from_intermediate[i], p);
+                                       m_num_tracks_from_intermediate[i], p, requiredCharges);
     }
     getCandidateDecay(potentialIntermediates[i], vertices, potentialDaughters[i], daughterParticlesAdv,
                       goodTracksThatMeet, primaryVerticesAdv, track_start, track_stop, true, i, m_constrain_int_mass);
@@ -412,9 +419,9 @@ void KFParticle_eventReconstruction::buildChain(std::vector<KFParticle>& selecte
 void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>& selectedMotherCand,
                                                        std::vector<KFParticle>& selectedVertexCand,
                                                        std::vector<std::vector<KFParticle>>& selectedDaughtersCand,
-                                                       std::vector<KFParticle> daughterParticlesCand,
-                                                       std::vector<std::vector<int>> goodTracksThatMeetCand,
-                                                       std::vector<KFParticle> primaryVerticesCand,
+                                                       const std::vector<KFParticle>& daughterParticlesCand,
+                                                       const std::vector<std::vector<int>>& goodTracksThatMeetCand,
+                                                       const std::vector<KFParticle>& primaryVerticesCand,
                                                        int n_track_start, int n_track_stop,
                                                        bool isIntermediate, int intermediateNumber, bool constrainMass)
 {
@@ -432,7 +439,7 @@ void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>&
     required_unique_vertexID += m_daughter_charge[i] * kfp_Tools_evtReco.getParticleMass(m_daughter_name[i].c_str());
   }
 
-  for (auto& i_comb : goodTracksThatMeetCand)  // Loop over all good track combinations
+  for (const auto& i_comb : goodTracksThatMeetCand)  // Loop over all good track combinations
   {
     KFParticle *daughterTracks = new KFParticle[nTracks];
 
@@ -531,8 +538,8 @@ void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>&
 }
 
 int KFParticle_eventReconstruction::selectBestCombination(bool PVconstraint, bool isAnInterMother,
-                                                          std::vector<KFParticle> possibleCandidates,
-                                                          std::vector<KFParticle> possibleVertex)
+                                                          const std::vector<KFParticle>& possibleCandidates,
+                                                          const std::vector<KFParticle>& possibleVertex)
 {
   KFParticle smallestMassError = possibleCandidates[0];
   int bestCombinationIndex = 0;
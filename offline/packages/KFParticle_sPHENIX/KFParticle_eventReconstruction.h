@@ -71,16 +71,16 @@ class KFParticle_eventReconstruction : public KFParticle_Tools
   void getCandidateDecay(std::vector<KFParticle>& selectedMotherCand,
                          std::vector<KFParticle>& selectedVertexCand,
                          std::vector<std::vector<KFParticle>>& selectedDaughtersCand,
-                         std::vector<KFParticle> daughterParticlesCand,
-                         std::vector<std::vector<int>> goodTracksThatMeetCand,
-                         std::vector<KFParticle> primaryVerticesCand,
+                         const std::vector<KFParticle>& daughterParticlesCand,
+                         const std::vector<std::vector<int>>& goodTracksThatMeetCand,
+                         const std::vector<KFParticle>& primaryVerticesCand,
                          int n_track_start, int n_track_stop,
                          bool isIntermediate, int intermediateNumber, bool constrainMass);
 
   /// Method to chose best candidate from a selection of common SV's
   int selectBestCombination(bool PVconstraint, bool isAnInterMother,
-                            std::vector<KFParticle> possibleCandidates,
-                            std::vector<KFParticle> possibleVertex);
+                            const std::vector<KFParticle>& possibleCandidates,
+                            const std::vector<KFParticle>& possibleVertex);
 
   KFParticle createFakePV();
 
@@ -174,6 +174,9 @@ class KFParticle_sPHENIX : public SubsysReco, public KFParticle_nTuple, public K
 
   void setMinTPChits(int nHits) { m_nTPCHits = nHits; }
 
+  /// Reuse the daughter particles built by another KFParticle_sPHENIX module with the same track selection in the same event (default false)
+  void shareDaughterParticles(bool share) { m_share_daughters = share; }
+
   void setMaximumDaughterDCA(float dca) { m_comb_DCA = dca; }
  
   void setMinimumRadialSV(float min_rad_sv) { m_min_radial_SV = min_rad_sv; }
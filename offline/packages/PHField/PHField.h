@@ -1,6 +1,8 @@
 #ifndef PHFIELD_PHFIELD_H
 #define PHFIELD_PHFIELD_H
 
+#include <cstddef>
+
 // units of this class. To convert internal value to Geant4/CLHEP units for fast access
 
 //! \brief transient object for field storage and access
@@ -21,6 +23,22 @@ class PHField
       const double Point[4],
       double *Bfield) const = 0;
 
+  //! access field values for many points at once
+  //! @param[in]  Points  n consecutive x, y, z triplets in Geant4/CLHEP units
+  //! @param[in]  n       number of points
+  //! @param[out] Bfield  n consecutive Bx, By, Bz triplets in Geant4/CLHEP units
+  virtual void GetFieldValues(const double *Points, const size_t n, double *Bfield) const
+  {
+    double point[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < n; ++i)
+    {
+      point[0] = Points[3 * i];
+      point[1] = Points[3 * i + 1];
+      point[2] = Points[3 * i + 2];
+      GetFieldValue(point, Bfield + 3 * i);
+    }
+  }
+
   void Verbosity(const int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
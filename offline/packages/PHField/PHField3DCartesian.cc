@@ -15,6 +15,8 @@
 #include <boost/stacktrace.hpp>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -111,6 +113,21 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
 
   delete field_map;
   delete rootinput;
+
+  m_regular_grid = BuildRegularGrid();
+  if (m_regular_grid)
+  {
+    // the flat arrays hold everything, free the sparse map
+    fieldmap.clear();
+    xvals.clear();
+    yvals.clear();
+    zvals.clear();
+    std::cout << " ---> using regular grid with " << m_nx << " x " << m_ny << " x " << m_nz << " points" << std::endl;
+  }
+  else
+  {
+    std::cout << " ---> grid is not regular, using sparse field map lookup" << std::endl;
+  }
   std::cout << "\n================= End Construct Mag Field ======================\n"
             << std::endl;
 }
@@ -125,12 +142,56 @@ PHField3DCartesian::~PHField3DCartesian()
   }
 }
 
-void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) const
+bool PHField3DCartesian::BuildRegularGrid()
 {
-  static double xsav = -1000000.;
-  static double ysav = -1000000.;
-  static double zsav = -1000000.;
+  m_nx = xvals.size();
+  m_ny = yvals.size();
+  m_nz = zvals.size();
+  if (m_nx < 2 || m_ny < 2 || m_nz < 2)
+  {
+    return false;
+  }
+
+  // every grid value has to sit on a multiple of the step size
+  auto on_grid = [](const std::set<float> &vals, const double vmin, const double step)
+  {
+    int i = 0;
+    for (const auto &val : vals)
+    {
+      if (std::abs((val - vmin) / step - i) > 1e-3)
+      {
+        return false;
+      }
+      ++i;
+    }
+    return true;
+  };
+  if (!on_grid(xvals, xmin, xstepsize) ||
+      !on_grid(yvals, ymin, ystepsize) ||
+      !on_grid(zvals, zmin, zstepsize))
+  {
+    return false;
+  }
+
+  const size_t npoints = static_cast<size_t>(m_nx) * m_ny * m_nz;
+  m_bx.assign(npoints, NAN);
+  m_by.assign(npoints, NAN);
+  m_bz.assign(npoints, NAN);
+  for (const auto &[coord, field] : fieldmap)
+  {
+    const size_t ix = std::lround((std::get<0>(coord) - xmin) / xstepsize);
+    const size_t iy = std::lround((std::get<1>(coord) - ymin) / ystepsize);
+    const size_t iz = std::lround((std::get<2>(coord) - zmin) / zstepsize);
+    const size_t index = (ix * m_ny + iy) * m_nz + iz;
+    m_bx[index] = std::get<0>(field);
+    m_by[index] = std::get<1>(field);
+    m_bz[index] = std::get<2>(field);
+  }
+  return true;
+}
 
+void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) const
+{
   double x = point[0];
   double y = point[1];
   double z = point[2];
@@ -140,8 +201,8 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   Bfield[2] = 0.0;
   if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
   {
-    static int ifirst = 0;
-    if (ifirst < 10)
+    static std::atomic<int> ifirst = 0;
+    if (ifirst++ < 10)
     {
       std::cout << "PHField3DCartesian::GetFieldValue: "
                 << "Invalid coordinates: "
@@ -150,21 +211,12 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
                 << ", z: " << z / cm
                 << " bailing out returning zero bfield"
                 << std::endl;
-      std::cout << "previous point: "
-                << "x: " << xsav / cm
-                << ", y: " << ysav / cm
-                << ", z: " << zsav / cm
-                << std::endl;
       std::cout << "Here is the stacktrace: " << std::endl;
       std::cout << boost::stacktrace::stacktrace();
       std::cout << "This is not a segfault. Check the stacktrace for the guilty party (typically #2)" << std::endl;
-      ifirst++;
     }
     return;
   }
-  xsav = x;
-  ysav = y;
-  zsav = z;
 
   if (point[0] < xmin || point[0] > xmax ||
       point[1] < ymin || point[1] > ymax ||
@@ -172,6 +224,108 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   {
     return;
   }
+
+  if (m_regular_grid)
+  {
+    InterpolateRegularGrid(x, y, z, Bfield);
+    return;
+  }
+  GetFieldValueFromMap(x, y, z, Bfield);
+}
+
+void PHField3DCartesian::GetFieldValues(const double *points, const size_t n, double *Bfield) const
+{
+  if (!m_regular_grid)
+  {
+    PHField::GetFieldValues(points, n, Bfield);
+    return;
+  }
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double x = points[3 * i];
+    const double y = points[3 * i + 1];
+    const double z = points[3 * i + 2];
+    double *bfield = Bfield + 3 * i;
+    // this also rejects nan coordinates
+    if (!(x >= xmin && x <= xmax &&
+          y >= ymin && y <= ymax &&
+          z >= zmin && z <= zmax))
+    {
+      bfield[0] = 0.0;
+      bfield[1] = 0.0;
+      bfield[2] = 0.0;
+      continue;
+    }
+    InterpolateRegularGrid(x, y, z, bfield);
+  }
+}
+
+inline void PHField3DCartesian::InterpolateRegularGrid(const double x, const double y, const double z, double *Bfield) const
+{
+  // position in units of the step size. Coordinates are within the map, so the
+  // truncation is the lower grid point. Points on the upper edge use the last cell
+  const double posx = (x - xmin) / xstepsize;
+  const double posy = (y - ymin) / ystepsize;
+  const double posz = (z - zmin) / zstepsize;
+  const int ix = std::min(static_cast<int>(posx), m_nx - 2);
+  const int iy = std::min(static_cast<int>(posy), m_ny - 2);
+  const int iz = std::min(static_cast<int>(posz), m_nz - 2);
+  const double fx = posx - ix;
+  const double fy = posy - iy;
+  const double fz = posz - iz;
+
+  // corner weights and offsets, corner c has x/y/z bits (c >> 2) & 1, (c >> 1) & 1, c & 1
+  const size_t stridex = static_cast<size_t>(m_ny) * m_nz;
+  const size_t stridey = m_nz;
+  const size_t index = ix * stridex + iy * stridey + iz;
+  const size_t offset[8] = {0, 1, stridey, stridey + 1,
+                            stridex, stridex + 1, stridex + stridey, stridex + stridey + 1};
+  const double weight[8] = {
+      (1. - fx) * (1. - fy) * (1. - fz),
+      (1. - fx) * (1. - fy) * fz,
+      (1. - fx) * fy * (1. - fz),
+      (1. - fx) * fy * fz,
+      fx * (1. - fy) * (1. - fz),
+      fx * (1. - fy) * fz,
+      fx * fy * (1. - fz),
+      fx * fy * fz};
+
+  const float *bx = m_bx.data() + index;
+  const float *by = m_by.data() + index;
+  const float *bz = m_bz.data() + index;
+  double sumx = 0;
+  double sumy = 0;
+  double sumz = 0;
+  for (int c = 0; c < 8; ++c)
+  {
+    sumx += weight[c] * bx[offset[c]];
+    sumy += weight[c] * by[offset[c]];
+    sumz += weight[c] * bz[offset[c]];
+  }
+
+  // a corner which is not in the field map gives nan, same as the map lookup failing
+  if (!std::isfinite(sumx) || !std::isfinite(sumy) || !std::isfinite(sumz))
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << " field map point missing in " << filename
+                << " around x: " << x / cm
+                << ", y: " << y / cm
+                << ", z: " << z / cm << std::endl;
+    }
+    Bfield[0] = 0.0;
+    Bfield[1] = 0.0;
+    Bfield[2] = 0.0;
+    return;
+  }
+  Bfield[0] = sumx;
+  Bfield[1] = sumy;
+  Bfield[2] = sumz;
+}
+
+void PHField3DCartesian::GetFieldValueFromMap(const double x, const double y, const double z, double *Bfield) const
+{
   double xkey[2];
   std::set<float>::const_iterator it = xvals.lower_bound(x);
   xkey[0] = *it;
@@ -276,9 +430,9 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   }
 
   // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
+  double xinblock = x - xkey[1];
+  double yinblock = y - ykey[1];
+  double zinblock = z - zkey[1];
   // normalize distance to step size
   double fractionx = xinblock / xstepsize;
   double fractiony = yinblock / ystepsize;
@@ -4,10 +4,12 @@
 #include "PHField.h"
 
 #include <cmath>
+#include <cstddef>
 #include <map>
 #include <set>
 #include <string>
 #include <tuple>
+#include <vector>
 
 class PHField3DCartesian : public PHField
 {
@@ -21,7 +23,20 @@ class PHField3DCartesian : public PHField
   //! @param[out] Bfield  field value. In the case of magnetic field, the order is Bx, By, Bz in in Geant4/CLHEP units
   void GetFieldValue(const double Point[4], double *Bfield) const override;
 
+  //! access field values for n consecutive x, y, z triplets, see PHField::GetFieldValues
+  void GetFieldValues(const double *Points, const size_t n, double *Bfield) const override;
+
  private:
+  //! copy the field map into flat arrays if the points lie on a regular grid
+  bool BuildRegularGrid();
+
+  //! trilinear interpolation on the regular grid, reentrant
+  //! x, y, z must be within the map boundaries
+  inline void InterpolateRegularGrid(const double x, const double y, const double z, double *Bfield) const;
+
+  //! lookup in the sparse field map, used if the grid is not regular
+  void GetFieldValueFromMap(const double x, const double y, const double z, double *Bfield) const;
+
   std::string filename;
   double xmin = 1000000;
   double xmax = -1000000;
@@ -47,6 +62,16 @@ class PHField3DCartesian : public PHField
   std::set<float> xvals;
   std::set<float> yvals;
   std::set<float> zvals;
+
+  // regular grid representation, field components are stored as separate contiguous arrays
+  // indexed by (ix * ny + iy) * nz + iz. Points missing from the map are NaN
+  bool m_regular_grid = false;
+  int m_nx = 0;
+  int m_ny = 0;
+  int m_nz = 0;
+  std::vector<float> m_bx;
+  std::vector<float> m_by;
+  std::vector<float> m_bz;
 };
 
 #endif
@@ -9,6 +9,7 @@
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
+#include <trackbase/TrkrPixelClusterLabeler.h>
 
 #include <trackbase/ClusHitsVerbosev1.h>
 #include <trackbase/RawHit.h>
@@ -29,15 +30,15 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <iostream>
 #include <limits>
 #include <memory>  // for unique_ptr, make_...
 #include <set>
+#include <thread>
 #include <vector>  // for vector
 
 namespace
@@ -51,50 +52,65 @@ namespace
   }
 }  // namespace
 
-bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer)
+TrkrPixelClusterLabeler::Adjacency InttClusterizer::get_adjacency(const int layer, const bool raw) const
 {
-  if (get_z_clustering(layer))
+  TrkrPixelClusterLabeler::Adjacency adjacency;
+  if (!get_z_clustering(layer))
   {
-    if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) <= 1)
+    adjacency.diagonal = false;
+    adjacency.antidiagonal = false;
+    if (raw)
     {
-      if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-      {
-        return true;
-      }
+      // raw hits: neighbouring phi bins (col) in the same time bin (row)
+      adjacency.row = false;
     }
-  }
-  else if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) == 0)
-  {
-    if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
+    else
     {
-      return true;
+      // same column, neighbouring rows
+      adjacency.col = false;
     }
   }
-
-  return false;
+  return adjacency;
 }
 
-bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int layer)
+void InttClusterizer::label_hitsets(const unsigned int nhitsets, const std::function<void(unsigned int)>& fill)
 {
-  if (get_z_clustering(layer))
+  // one labeler per hitset, buffers are kept from one event to the next
+  if (m_labelers.size() < nhitsets)
   {
-    if (std::abs((int) (lhs->getPhiBin()) - (int) (rhs->getPhiBin())) <= 1)  // col
+    m_labelers.resize(nhitsets);
+  }
+
+  unsigned int nthreads = m_nthreads > 0 ? m_nthreads : std::max(1U, std::thread::hardware_concurrency());
+  nthreads = std::min(nthreads, nhitsets);
+  if (nthreads <= 1)
+  {
+    for (unsigned int ihitset = 0; ihitset < nhitsets; ++ihitset)
     {
-      if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) <= 1)  // Row
-      {
-        return true;
-      }
+      fill(ihitset);
     }
+    return;
   }
-  else if (std::abs((int) (lhs->getPhiBin()) - (int)(rhs->getPhiBin())) <= 1)
+
+  // each thread takes the next unlabeled hitset, labelers only touch their own hitset
+  std::atomic<unsigned int> next(0);
+  auto worker = [&next, &fill, nhitsets]()
   {
-    if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) == 0)
+    for (unsigned int ihitset = next++; ihitset < nhitsets; ihitset = next++)
     {
-      return true;
+      fill(ihitset);
     }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
   }
-
-  return false;
 }
 
 InttClusterizer::InttClusterizer(const std::string& name,
@@ -360,12 +376,36 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
   // loop over the InttHitSet objects
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::inttId);
+
+  // find the connected strips of all sensors first, possibly in parallel.
+  // Clusters are then filled in hitset order, so the output does not depend on the number of threads
+  std::vector<TrkrHitSet*> hitsets;
+  std::vector<TrkrPixelClusterLabeler::Adjacency> adjacencies;
+  for (auto hitsetitr = hitsetrange.first; hitsetitr != hitsetrange.second; ++hitsetitr)
+  {
+    hitsets.push_back(hitsetitr->second);
+    adjacencies.push_back(get_adjacency(TrkrDefs::getLayer(hitsetitr->first), false));
+  }
+  label_hitsets(hitsets.size(), [this, &hitsets, &adjacencies](unsigned int ihitset)
+                {
+    auto& labeler = m_labelers[ihitset];
+    labeler.clear();
+    labeler.reserve(hitsets[ihitset]->size());
+    TrkrHitSet::ConstRange hitrange = hitsets[ihitset]->getHits();
+    for (auto hitr = hitrange.first; hitr != hitrange.second; ++hitr)
+    {
+      labeler.addHit(InttDefs::getCol(hitr->first), InttDefs::getRow(hitr->first));
+    }
+    labeler.label(adjacencies[ihitset]); });
+
+  unsigned int ihitset = 0;
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second;
-       ++hitsetitr)
+       ++hitsetitr, ++ihitset)
   {
     // Each hitset contains only hits that are clusterizable - i.e. belong to a single sensor
     TrkrHitSet* hitset = hitsetitr->second;
+    const auto& labeler = m_labelers[ihitset];
 
     if (Verbosity() > 1)
     {
@@ -400,49 +440,15 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
-    }
+    // the clustering was done by the labeler, hit indices are the
+    // positions in hitvec and cluster ids are numbered from zero
 
     // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    for (unsigned int clusid = 0; clusid < labeler.nClusters(); ++clusid)
     {
       // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
       // get all hits for this cluster ID only
-      std::pair<std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator,
-                std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator>
-          clusrange = clusters.equal_range(clusid);
+      auto clusrange = labeler.getHits(clusid);
 
       // make the cluster directly in the node tree
       TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -467,17 +473,18 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       unsigned int clus_maxadc = 0.0;
       unsigned nhits = 0;
       // std::cout << PHWHERE << " ckey " << ckey << ":" << std::endl;
-      for (std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (auto hititer = clusrange.first; hititer != clusrange.second; ++hititer)
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        int col = InttDefs::getCol((mapiter->second).first);
-        int row = InttDefs::getRow((mapiter->second).first);
+        const auto& hit = hitvec[*hititer];
+        // hit.first  is the hit key
+        // std::cout << " adding hitkey " << hit.first << std::endl;
+        int col = InttDefs::getCol(hit.first);
+        int row = InttDefs::getRow(hit.first);
         zbins.insert(col);
         phibins.insert(row);
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second).second->getAdc();
+        // hit.second is the hit
+        unsigned int hit_adc = hit.second->getAdc();
 
         // Add clusterkey/bunch crossing to mmap
         m_clustercrossingassoc->addAssoc(ckey, crossing);
@@ -508,7 +515,7 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
         ++nhits;
 
         // add this cluster-hit association to the association map of (clusterkey,hitkey)
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
         if (Verbosity() > 2)
         {
@@ -625,12 +632,36 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
   // loop over the InttHitSet objects
   RawHitSetContainer::ConstRange hitsetrange =
       m_rawhits->getHitSets(TrkrDefs::TrkrId::inttId);
+
+  // find the connected strips of all sensors first, possibly in parallel.
+  // Clusters are then filled in hitset order, so the output does not depend on the number of threads
+  std::vector<RawHitSet*> hitsets;
+  std::vector<TrkrPixelClusterLabeler::Adjacency> adjacencies;
+  for (auto hitsetitr = hitsetrange.first; hitsetitr != hitsetrange.second; ++hitsetitr)
+  {
+    hitsets.push_back(hitsetitr->second);
+    adjacencies.push_back(get_adjacency(TrkrDefs::getLayer(hitsetitr->first), true));
+  }
+  label_hitsets(hitsets.size(), [this, &hitsets, &adjacencies](unsigned int ihitset)
+                {
+    auto& labeler = m_labelers[ihitset];
+    labeler.clear();
+    labeler.reserve(hitsets[ihitset]->size());
+    RawHitSet::ConstRange hitrange = hitsets[ihitset]->getHits();
+    for (auto hitr = hitrange.first; hitr != hitrange.second; ++hitr)
+    {
+      labeler.addHit((*hitr)->getPhiBin(), (*hitr)->getTBin());
+    }
+    labeler.label(adjacencies[ihitset]); });
+
+  unsigned int ihitset = 0;
   for (RawHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second;
-       ++hitsetitr)
+       ++hitsetitr, ++ihitset)
   {
     // Each hitset contains only hits that are clusterizable - i.e. belong to a single sensor
     RawHitSet* hitset = hitsetitr->second;
+    const auto& labeler = m_labelers[ihitset];
 
     if (Verbosity() > 1)
     {
@@ -671,47 +702,15 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, RawHit*> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
-    }
+    // the clustering was done by the labeler, hit indices are the
+    // positions in hitvec and cluster ids are numbered from zero
 
     // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    for (unsigned int clusid = 0; clusid < labeler.nClusters(); ++clusid)
     {
       // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
       // get all hits for this cluster ID only
-      auto clusrange = clusters.equal_range(clusid);
+      auto clusrange = labeler.getHits(clusid);
 
       // make the cluster directly in the node tree
       TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -738,13 +737,12 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       // std::cout << PHWHERE << " ckey " << ckey << ":" << std::endl;
 
       std::map<int, unsigned int> m_phi, m_z;  // hold data for
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (auto hititer = clusrange.first; hititer != clusrange.second; ++hititer)
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        const auto energy = (mapiter->second)->getAdc();
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
+        RawHit* hit = hitvec[*hititer];
+        const auto energy = hit->getAdc();
+        int col = hit->getPhiBin();
+        int row = hit->getTBin();
         //	    std::cout << " found Tbin(row) " << row << " Phibin(col) " << col << std::endl;
         zbins.insert(col);
         phibins.insert(row);
@@ -764,8 +762,7 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
           }
         }
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second)->getAdc();
+        unsigned int hit_adc = hit->getAdc();
 
         // Add clusterkey/bunch crossing to mmap
         m_clustercrossingassoc->addAssoc(ckey, crossing);
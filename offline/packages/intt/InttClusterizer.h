@@ -4,11 +4,14 @@
 #include <fun4all/SubsysReco.h>
 
 #include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrPixelClusterLabeler.h>
 
+#include <functional>
 #include <limits>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 class ClusHitsVerbosev1;
 class PHCompositeNode;
@@ -72,14 +75,21 @@ class InttClusterizer : public SubsysReco
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_read_raw(bool read_raw) { do_read_raw = read_raw; }
 
+  //! number of threads used to find the connected strips of the sensors. 0 uses all available cores, 1 (default) runs sequentially
+  //! clusters are always filled in hitset order, the output does not depend on the number of threads
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
+
   // for saving verbose clusters
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
   bool record_ClusHitsVerbose{false};
-  bool ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs, const int layer);
-  bool ladder_are_adjacent(RawHit *lhs, RawHit *rhs, const int layer);
+  //! which neighbouring strips are connected in this layer, for hits or raw hits
+  TrkrPixelClusterLabeler::Adjacency get_adjacency(const int layer, const bool raw) const;
+
+  //! runs fill(i) for all hitsets i, fill labels the strips of hitset i with m_labelers[i]
+  void label_hitsets(const unsigned int nhitsets, const std::function<void(unsigned int)> &fill);
 
   void CalculateLadderThresholds(PHCompositeNode *topNode);
   void ClusterLadderCells(PHCompositeNode *topNode);
@@ -100,6 +110,10 @@ class InttClusterizer : public SubsysReco
   std::map<int, bool> _make_e_weights;        // layer->energy_weighting_option
   bool do_hit_assoc = true;
   bool do_read_raw = false;
+  unsigned int m_nthreads = 1;
+
+  //! one labeler per hitset, reused between events
+  std::vector<TrkrPixelClusterLabeler> m_labelers;
 };
 
 #endif
@@ -10,6 +10,7 @@
 #include <calobase/RawTowerGeomContainer.h>
 #include <calobase/TowerInfo.h>
 #include <calobase/TowerInfoContainer.h>
+#include <calobase/TowerInfoGeometry.h>
 #include <globalvertex/GlobalVertex.h>
 #include <globalvertex/GlobalVertexMap.h>
 
@@ -468,16 +469,25 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       return std::vector<Jet *>();
     }
 
+    // tower geometry by channel, built once and kept with the container
+    const TowerInfoGeometry *towergeom = TowerInfoGeometry::attach(towerinfos, geom, geocaloid);
+
+    double EMCal_r = 0;
+    bool use_EMCal_r = m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS;
+    if (use_EMCal_r)
+    {
+      const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
+      RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
+      assert(EMCal_tower_geom);
+      EMCal_r = EMCal_tower_geom->get_center_radius();
+    }
+
     unsigned int nchannels = towerinfos->size();
     for (unsigned int channel = 0; channel < nchannels; channel++)
     {
       TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
       assert(tower);
 
-      unsigned int calokey = towerinfos->encode_key(channel);
-      int ieta = towerinfos->getTowerEtaBin(calokey);
-      int iphi = towerinfos->getTowerPhiBin(calokey);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
       // skip masked towers
       if (tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2())
       {
@@ -487,19 +497,12 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       {
         continue;
       }
-      RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
-      assert(tower_geom);
+      const TowerInfoGeometry::Tower &tower_geom = towergeom->get_tower_at_channel(channel);
+      assert(tower_geom.valid);
 
-      double r = tower_geom->get_center_radius();
-      if(m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input ==Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
-      {
-        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-        RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key );
-        assert(EMCal_tower_geom);
-        r = EMCal_tower_geom->get_center_radius();
-      }
-      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-      double towereta = tower_geom->get_eta();
+      double r = use_EMCal_r ? EMCal_r : tower_geom.center_radius;
+      double phi = atan2(tower_geom.center_y, tower_geom.center_x);
+      double towereta = tower_geom.eta;
       double z0 = sinh(towereta) * r;
       double z = z0 - vtxz;
       double eta = asinh(z / r);  // eta after shift from vertex
@@ -21,6 +21,7 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
 #include <trackbase/TrkrHitv2.h>
+#include <trackbase/TrkrPixelClusterLabeler.h>
 
 #include <trackbase/RawHit.h>
 #include <trackbase/RawHitSet.h>
@@ -42,23 +43,18 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>  // for exit
 #include <iostream>
 #include <map>  // for multimap<>::iterator
 #include <set>  // for set, set<>::iterator
 #include <string>
+#include <thread>
 #include <vector>  // for vector
 
-using namespace boost;
 using namespace std;
 
 namespace
@@ -72,62 +68,64 @@ namespace
   }
 }  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs)
+TrkrPixelClusterLabeler::Adjacency MvtxClusterizer::get_adjacency(const bool raw) const
 {
-  if (GetZClustering())
+  // column is first, row is second
+  TrkrPixelClusterLabeler::Adjacency adjacency;
+  if (!GetZClustering())
   {
-    // column is first, row is second
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) <= 1)
-    {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
-      {
-        return true;
-      }
-    }
+    // same column, neighbouring rows only
+    adjacency.col = false;
+    adjacency.diagonal = false;
+    adjacency.antidiagonal = false;
   }
-  else
+  else if (raw)
   {
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) == 0)
-    {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
-      {
-        return true;
-      }
-    }
+    // raw hit bins are unsigned, the difference of (col+1, row-1) and (col, row)
+    // wraps around and these pixels were never considered adjacent. Keep it that way.
+    adjacency.antidiagonal = false;
   }
-
-  return false;
+  return adjacency;
 }
 
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs)
+void MvtxClusterizer::label_hitsets(const unsigned int nhitsets, const std::function<void(unsigned int)> &fill)
 {
-  if (GetZClustering())
+  // one labeler per hitset, buffers are kept from one event to the next
+  if (m_labelers.size() < nhitsets)
   {
-    // column is first, row is second
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) <= 1)  // col
+    m_labelers.resize(nhitsets);
+  }
+
+  unsigned int nthreads = m_nthreads > 0 ? m_nthreads : std::max(1U, std::thread::hardware_concurrency());
+  nthreads = std::min(nthreads, nhitsets);
+  if (nthreads <= 1)
+  {
+    for (unsigned int ihitset = 0; ihitset < nhitsets; ++ihitset)
     {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)  // Row
-      {
-        return true;
-      }
+      fill(ihitset);
     }
+    return;
   }
-  else
+
+  // each thread takes the next unlabeled hitset, labelers only touch their own hitset
+  std::atomic<unsigned int> next(0);
+  auto worker = [&next, &fill, nhitsets]()
   {
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) == 0)
+    for (unsigned int ihitset = next++; ihitset < nhitsets; ihitset = next++)
     {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)
-      {
-        return true;
-      }
+      fill(ihitset);
     }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
   }
-
-  return false;
 }
 
 MvtxClusterizer::MvtxClusterizer(const string &name)
@@ -327,10 +325,33 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
   // loop over each MvtxHitSet object (chip)
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::mvtxId);
+
+  // find the connected pixels of all chips first, possibly in parallel.
+  // Clusters are then filled in hitset order, so the output does not depend on the number of threads
+  std::vector<TrkrHitSet *> hitsets;
+  for (auto hitsetitr = hitsetrange.first; hitsetitr != hitsetrange.second; ++hitsetitr)
+  {
+    hitsets.push_back(hitsetitr->second);
+  }
+  const auto adjacency = get_adjacency(false);
+  label_hitsets(hitsets.size(), [this, &hitsets, &adjacency](unsigned int ihitset)
+                {
+    auto &labeler = m_labelers[ihitset];
+    labeler.clear();
+    labeler.reserve(hitsets[ihitset]->size());
+    TrkrHitSet::ConstRange hitrange = hitsets[ihitset]->getHits();
+    for (auto hitr = hitrange.first; hitr != hitrange.second; ++hitr)
+    {
+      labeler.addHit(MvtxDefs::getCol(hitr->first), MvtxDefs::getRow(hitr->first));
+    }
+    labeler.label(adjacency); });
+
+  unsigned int ihitset = 0;
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
-       hitsetitr != hitsetrange.second; ++hitsetitr)
+       hitsetitr != hitsetrange.second; ++hitsetitr, ++ihitset)
   {
     TrkrHitSet *hitset = hitsetitr->second;
+    const auto &labeler = m_labelers[ihitset];
 
     if (Verbosity() > 0)
     {
@@ -374,51 +395,17 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       }
     }
 
-    // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    set<int> cluster_ids;  // unique components
-    // multimap<int, pixel> clusters;
-    multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit *> > clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
+    // the clustering was done by the labeler, hit indices are the
+    // positions in hitvec and cluster ids are numbered from zero
 //    int total_clusters = 0;
-    for (set<int>::iterator clusiter = cluster_ids.begin();
-         clusiter != cluster_ids.end(); ++clusiter)
+    for (unsigned int clusid = 0; clusid < labeler.nClusters(); ++clusid)
     {
-      int clusid = *clusiter;
-      auto clusrange = clusters.equal_range(clusid);
+      auto clusrange = labeler.getHits(clusid);
 
       if (Verbosity() > 2)
       {
         cout << "Filling cluster id " << clusid << " of "
-             << std::distance(cluster_ids.begin(), clusiter) << endl;
+             << labeler.nClusters() << endl;
       }
 //      ++total_clusters;
       auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -447,13 +434,15 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (auto hititer = clusrange.first; hititer != clusrange.second;
+           ++hititer)
       {
+        const auto &hit = hitvec[*hititer];
+
         // size
-        const auto energy = (mapiter->second).second->getAdc();
-        int col = MvtxDefs::getCol((mapiter->second).first);
-        int row = MvtxDefs::getRow((mapiter->second).first);
+        const auto energy = hit.second->getAdc();
+        int col = MvtxDefs::getCol(hit.first);
+        int row = MvtxDefs::getRow(hit.first);
         zbins.insert(col);
         phibins.insert(row);
 
@@ -488,9 +477,9 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         loczsum += local_coords.Z();
         // add the association between this cluster key and this hitkey to the
         // table
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
-      }  // mapiter
+      }  // hititer
 
       if (mClusHitsVerbose)
       {
@@ -653,10 +642,33 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
   // loop over each MvtxHitSet object (chip)
   RawHitSetContainer::ConstRange hitsetrange =
       m_rawhits->getHitSets(TrkrDefs::TrkrId::mvtxId);
+
+  // find the connected pixels of all chips first, possibly in parallel.
+  // Clusters are then filled in hitset order, so the output does not depend on the number of threads
+  std::vector<RawHitSet *> hitsets;
+  for (auto hitsetitr = hitsetrange.first; hitsetitr != hitsetrange.second; ++hitsetitr)
+  {
+    hitsets.push_back(hitsetitr->second);
+  }
+  const auto adjacency = get_adjacency(true);
+  label_hitsets(hitsets.size(), [this, &hitsets, &adjacency](unsigned int ihitset)
+                {
+    auto &labeler = m_labelers[ihitset];
+    labeler.clear();
+    labeler.reserve(hitsets[ihitset]->size());
+    RawHitSet::ConstRange hitrange = hitsets[ihitset]->getHits();
+    for (auto hitr = hitrange.first; hitr != hitrange.second; ++hitr)
+    {
+      labeler.addHit((*hitr)->getPhiBin(), (*hitr)->getTBin());
+    }
+    labeler.label(adjacency); });
+
+  unsigned int ihitset = 0;
   for (RawHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
-       hitsetitr != hitsetrange.second; ++hitsetitr)
+       hitsetitr != hitsetrange.second; ++hitsetitr, ++ihitset)
   {
     RawHitSet *hitset = hitsetitr->second;
+    const auto &labeler = m_labelers[ihitset];
 
     if (Verbosity() > 0)
     {
@@ -688,53 +700,17 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       cout << "hitvec.size(): " << hitvec.size() << endl;
     }
 
-    // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    set<int> cluster_ids;  // unique components
-    // multimap<int, pixel> clusters;
-
-    multimap<int, RawHit *> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
-    //    cout << "found cluster #: "<< clusters.size()<< endl;
+    // the clustering was done by the labeler, hit indices are the
+    // positions in hitvec and cluster ids are numbered from zero
     // loop over the componenets and make clusters
-    for (set<int>::iterator clusiter = cluster_ids.begin();
-         clusiter != cluster_ids.end(); ++clusiter)
+    for (unsigned int clusid = 0; clusid < labeler.nClusters(); ++clusid)
     {
-      int clusid = *clusiter;
-      auto clusrange = clusters.equal_range(clusid);
+      auto clusrange = labeler.getHits(clusid);
 
       if (Verbosity() > 2)
       {
         cout << "Filling cluster id " << clusid << " of "
-             << std::distance(cluster_ids.begin(), clusiter) << endl;
+             << labeler.nClusters() << endl;
       }
 
       // make the cluster directly in the node tree
@@ -762,12 +738,12 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (auto hititer = clusrange.first; hititer != clusrange.second;
+           ++hititer)
       {
         // size
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
+        int col = hitvec[*hititer]->getPhiBin();
+        int row = hitvec[*hititer]->getTBin();
         zbins.insert(col);
         phibins.insert(row);
 
@@ -789,7 +765,7 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         // table
         //	      m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
 
-      }  // mapiter
+      }  // hititer
 
       // This is the local position
       locclusx = locxsum / nhits;
@@ -10,9 +10,12 @@
 #include <fun4all/SubsysReco.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrPixelClusterLabeler.h>
 
+#include <functional>
 #include <string>  // for string
 #include <utility>
+#include <vector>
 
 class ClusHitsVerbose;
 class PHCompositeNode;
@@ -60,13 +63,20 @@ class MvtxClusterizer : public SubsysReco
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_read_raw(bool read_raw) { do_read_raw = read_raw; }
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
+
+  //! number of threads used to find the connected pixels of the chips. 0 uses all available cores, 1 (default) runs sequentially
+  //! clusters are always filled in hitset order, the output does not depend on the number of threads
+  void SetNumThreads(const unsigned int nthreads) { m_nthreads = nthreads; }
   ClusHitsVerbose *mClusHitsVerbose{nullptr};
 
  private:
   // bool are_adjacent(const pixel lhs, const pixel rhs);
   bool record_ClusHitsVerbose{false};
-  bool are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs);
-  bool are_adjacent(RawHit *lhs, RawHit *rhs);
+  //! which neighbouring pixels are connected, for hits or raw hits
+  TrkrPixelClusterLabeler::Adjacency get_adjacency(const bool raw) const;
+
+  //! runs fill(i) for all hitsets i, fill labels the pixels of hitset i with m_labelers[i]
+  void label_hitsets(const unsigned int nhitsets, const std::function<void(unsigned int)> &fill);
 
   void ClusterMvtx(PHCompositeNode *topNode);
   void ClusterMvtxRaw(PHCompositeNode *topNode);
@@ -83,6 +93,10 @@ class MvtxClusterizer : public SubsysReco
   bool m_makeZClustering;  // z_clustering_option
   bool do_hit_assoc = true;
   bool do_read_raw = false;
+  unsigned int m_nthreads = 1;
+
+  //! one labeler per hitset, reused between events
+  std::vector<TrkrPixelClusterLabeler> m_labelers;
 };
 
 #endif  // MVTX_MVTXCLUSTERIZER_H
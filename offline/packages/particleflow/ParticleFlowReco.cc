@@ -27,6 +27,7 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_uniform_pos
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -36,6 +37,134 @@ bool sort_by_pair_second_lowest(const std::pair<int, float> &a, const std::pair<
   return (a.second < b.second);
 }
 
+namespace
+{
+  // Objects binned in (eta, phi), with cells slightly larger than the matching radius so
+  // that everything within dR of a point is in the 3x3 cells around it. phi wraps around.
+  // Objects with a non-finite eta or phi (calculate_dR can not reject them) or far outside
+  // the acceptance are returned for every query.
+  class EtaPhiGrid
+  {
+   public:
+    EtaPhiGrid(const std::vector<float> &eta, const std::vector<float> &phi, float radius)
+      : m_size(eta.size())
+    {
+      m_cell = radius * 1.01;
+      m_nphibins = std::max(1, (int) std::floor(2 * M_PI / m_cell));
+      m_phicell = 2 * M_PI / m_nphibins;
+
+      float etamax = 0;
+      bool first = true;
+      for (unsigned int i = 0; i < m_size; i++)
+      {
+        if (!binned(eta[i], phi[i]))
+        {
+          continue;
+        }
+        m_etamin = first ? eta[i] : std::min(m_etamin, eta[i]);
+        etamax = first ? eta[i] : std::max(etamax, eta[i]);
+        first = false;
+      }
+      m_netabins = first ? 0 : (int) ((etamax - m_etamin) / m_cell) + 1;
+
+      // counting sort into cells, filled in index order so every cell is sorted
+      std::vector<int> cells(m_size, -1);
+      m_offsets.assign(m_netabins * m_nphibins + 1, 0);
+      for (unsigned int i = 0; i < m_size; i++)
+      {
+        if (!binned(eta[i], phi[i]))
+        {
+          m_always.push_back(i);
+          continue;
+        }
+        cells[i] = etabin(eta[i]) * m_nphibins + phibin(phi[i]);
+        m_offsets[cells[i] + 1]++;
+      }
+      for (unsigned int cell = 0; cell + 1 < m_offsets.size(); cell++)
+      {
+        m_offsets[cell + 1] += m_offsets[cell];
+      }
+      m_entries.resize(m_offsets.back());
+      std::vector<unsigned int> fill(m_offsets.begin(), m_offsets.end() - 1);
+      for (unsigned int i = 0; i < m_size; i++)
+      {
+        if (cells[i] >= 0)
+        {
+          m_entries[fill[cells[i]]++] = i;
+        }
+      }
+    }
+
+    // indices of all objects which can be within the radius of (eta, phi), in increasing order
+    void find(float eta, float phi, std::vector<unsigned int> &candidates) const
+    {
+      candidates.clear();
+      if (!std::isfinite(eta) || !std::isfinite(phi))
+      {
+        // calculate_dR is nan, nothing can be rejected
+        for (unsigned int i = 0; i < m_size; i++)
+        {
+          candidates.push_back(i);
+        }
+        return;
+      }
+      candidates = m_always;
+      if (m_netabins == 0)
+      {
+        return;
+      }
+      int ieta = (int) std::clamp(std::floor((eta - m_etamin) / m_cell), -2.F, m_netabins + 1.F);
+      int iphi = phibin(phi);
+      for (int jeta = std::max(ieta - 1, 0); jeta <= std::min(ieta + 1, m_netabins - 1); jeta++)
+      {
+        if (m_nphibins < 3)
+        {
+          add_cells(jeta * m_nphibins, (jeta + 1) * m_nphibins, candidates);
+          continue;
+        }
+        for (int dphi = -1; dphi <= 1; dphi++)
+        {
+          int jphi = (iphi + dphi + m_nphibins) % m_nphibins;
+          add_cells(jeta * m_nphibins + jphi, jeta * m_nphibins + jphi + 1, candidates);
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+    }
+
+   private:
+    static bool binned(float eta, float phi)
+    {
+      return std::isfinite(eta) && std::isfinite(phi) && std::fabs(eta) < 10;
+    }
+
+    int etabin(float eta) const
+    {
+      return std::min((int) ((eta - m_etamin) / m_cell), m_netabins - 1);
+    }
+
+    int phibin(float phi) const
+    {
+      double wrapped = phi - 2 * M_PI * std::floor(phi / (2 * M_PI));
+      return std::min((int) (wrapped / m_phicell), m_nphibins - 1);
+    }
+
+    void add_cells(int begin, int end, std::vector<unsigned int> &candidates) const
+    {
+      candidates.insert(candidates.end(), m_entries.begin() + m_offsets[begin], m_entries.begin() + m_offsets[end]);
+    }
+
+    unsigned int m_size{0};
+    float m_cell{0};
+    double m_phicell{0};
+    float m_etamin{0};
+    int m_netabins{0};
+    int m_nphibins{1};
+    std::vector<unsigned int> m_offsets;
+    std::vector<unsigned int> m_entries;
+    std::vector<unsigned int> m_always;
+  };
+}  // namespace
+
 float ParticleFlowReco::calculate_dR(float eta1, float eta2, float phi1, float phi2)
 {
   float deta = eta1 - eta2;
@@ -368,6 +497,11 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     std::cout << "ParticleFlowReco::process_event : TRK -> EM and TRK -> HAD linking " << std::endl;
   }
 
+  // clusters within the matching dR of a track or EM cluster can only be in the neighbouring grid cells
+  EtaPhiGrid gridEM(_pflow_EM_eta, _pflow_EM_phi, 0.2);
+  EtaPhiGrid gridHAD(_pflow_HAD_eta, _pflow_HAD_phi, 0.5);
+  std::vector<unsigned int> candidates;
+
   for (unsigned int trk = 0; trk < _pflow_TRK_p.size(); trk++)
   {
     if (Verbosity() > 10)
@@ -379,7 +513,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     float min_em_dR = 0.2;
     int min_em_index = -1;
 
-    for (unsigned int em = 0; em < _pflow_EM_E.size(); em++)
+    gridEM.find(_pflow_TRK_EMproj_eta[trk], _pflow_TRK_EMproj_phi[trk], candidates);
+    for (unsigned int em : candidates)
     {
       float dR = calculate_dR(_pflow_TRK_EMproj_eta[trk], _pflow_EM_eta[em], _pflow_TRK_EMproj_phi[trk], _pflow_EM_phi[em]);
 
@@ -475,7 +610,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     float max_had_pt = 0;
 
     // TODO: sequential linking should better happen here -- i.e. allow EM-matched HAD's into the possible pool
-    for (unsigned int had = 0; had < _pflow_HAD_E.size(); had++)
+    gridHAD.find(_pflow_TRK_HADproj_eta[trk], _pflow_TRK_HADproj_phi[trk], candidates);
+    for (unsigned int had : candidates)
     {
       float dR = calculate_dR(_pflow_TRK_HADproj_eta[trk], _pflow_HAD_eta[had], _pflow_TRK_HADproj_phi[trk], _pflow_HAD_phi[had]);
 
@@ -569,7 +705,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     int min_had_index = -1;
     float max_had_pt = 0;
 
-    for (unsigned int had = 0; had < _pflow_HAD_E.size(); had++)
+    gridHAD.find(_pflow_EM_eta[em], _pflow_EM_phi[em], candidates);
+    for (unsigned int had : candidates)
     {
       float dR = calculate_dR(_pflow_EM_eta[em], _pflow_HAD_eta[had], _pflow_EM_phi[em], _pflow_HAD_phi[had]);
       if (dR > 0.5)
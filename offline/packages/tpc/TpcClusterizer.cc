@@ -50,12 +50,14 @@
 
 #include <TFile.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>  // for sqrt, cos, sin
 #include <iostream>
 #include <limits>
 #include <map>  // for _Rb_tree_cons...
 #include <string>
+#include <thread>   // for hardware_concurrency
 #include <utility>  // for pair
 #include <vector>
 // Terra incognita....
@@ -128,21 +130,115 @@ namespace
     vec_dVerbose zvec_ClusHitsVerbose;    // only fill if fillClusHitsVerbose
   };
 
-  pthread_mutex_t mythreadlock;
+  // seed hits ordered by adc, replaces a per hitset std::multimap<adc, ihit>.
+  // Hits are appended unsorted, then stable sorted once, so that the order in which
+  // seeds are returned is the same as iterating the multimap from rbegin.
+  // Removed hits are only flagged, the storage is kept across hitsets and events
+  class seed_queue
+  {
+   public:
+    void clear()
+    {
+      m_hits.clear();
+      m_removed.clear();
+      m_top = 0;
+      m_nleft = 0;
+    }
+
+    void insert(const ihit &hit) { m_hits.push_back(hit); }
+
+    void finalize()
+    {
+      std::stable_sort(m_hits.begin(), m_hits.end(), [](const ihit &lhs, const ihit &rhs)
+                       { return lhs.adc < rhs.adc; });
+      m_removed.assign(m_hits.size(), 0);
+      m_top = m_hits.size();
+      m_nleft = m_hits.size();
+    }
+
+    bool empty() const { return m_nleft == 0; }
 
-  void remove_hit(double adc, int phibin, int tbin, int edge, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
+    // highest adc hit still in the queue, must not be called on an empty queue
+    const ihit &top()
+    {
+      while (m_removed[m_top - 1])
+      {
+        --m_top;
+      }
+      return m_hits[m_top - 1];
+    }
+
+    // remove the first hit with given adc at given position, if any
+    void erase(unsigned short adc, int phibin, int tbin)
+    {
+      auto range = std::equal_range(m_hits.begin(), m_hits.end(), ihit{0, 0, adc, 0}, [](const ihit &lhs, const ihit &rhs)
+                                    { return lhs.adc < rhs.adc; });
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        const size_t index = std::distance(m_hits.begin(), it);
+        if (!m_removed[index] && it->iphi == phibin && it->it == tbin)
+        {
+          m_removed[index] = 1;
+          --m_nleft;
+          break;
+        }
+      }
+    }
+
+   private:
+    std::vector<ihit> m_hits;
+    std::vector<char> m_removed;
+    size_t m_top = 0;
+    size_t m_nleft = 0;
+  };
+
+  // per worker scratch buffers, reused for every hitset the worker processes
+  struct sector_scratch
   {
-    using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
-    std::pair<hit_iterator, hit_iterator> iterpair = all_hit_map.equal_range(adc);
-    hit_iterator it = iterpair.first;
-    for (; it != iterpair.second; ++it)
+    // adc values, indexed as [phibin][tbin]. Only the cells listed in filled_cells
+    // can be non zero, they are reset once the hitset is done
+    std::vector<std::vector<unsigned short>> adcval;
+    std::vector<std::pair<unsigned short, unsigned short>> filled_cells;
+    seed_queue seeds;
+    std::vector<ihit> ihit_list;
+
+    void prepare(unsigned short phibins, unsigned short tbins)
     {
-      if (it->second.iphi == phibin && it->second.it == tbin)
+      if (adcval.size() < phibins)
       {
-        all_hit_map.erase(it);
-        break;
+        adcval.resize(phibins);
       }
+      for (unsigned short iphi = 0; iphi < phibins; ++iphi)
+      {
+        if (adcval[iphi].size() < tbins)
+        {
+          adcval[iphi].resize(tbins, 0);
+        }
+      }
+      seeds.clear();
+    }
+
+    void set_adc(unsigned short phibin, unsigned short tbin, unsigned short adc)
+    {
+      adcval[phibin][tbin] = adc;
+      filled_cells.emplace_back(phibin, tbin);
+    }
+
+    void reset()
+    {
+      for (const auto &[phibin, tbin] : filled_cells)
+      {
+        adcval[phibin][tbin] = 0;
+      }
+      filled_cells.clear();
+      seeds.clear();
+      ihit_list.clear();
     }
+  };
+
+  void remove_hit(double adc, int phibin, int tbin, int edge, seed_queue &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
+  {
+    all_hit_map.erase(static_cast<unsigned short>(adc), phibin, tbin);
     if (edge)
     {
       adcval[phibin][tbin] = USHRT_MAX;
@@ -153,7 +249,7 @@ namespace
     }
   }
 
-  void remove_hits(std::vector<ihit> &ihit_list, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
+  void remove_hits(std::vector<ihit> &ihit_list, seed_queue &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
   {
     for (auto &iter : ihit_list)
     {
@@ -780,7 +876,30 @@ namespace
     //      std::cout << "done calc" << std::endl;
   }
 
-  void ProcessSectorData(thread_data *my_data)
+  // reset job settings to their defaults, keeping the capacity of the output vectors
+  void reset_thread_data(thread_data &data)
+  {
+    auto association_vector = std::move(data.association_vector);
+    auto cluster_vector = std::move(data.cluster_vector);
+    auto v_hits = std::move(data.v_hits);
+    auto phivec_ClusHitsVerbose = std::move(data.phivec_ClusHitsVerbose);
+    auto zvec_ClusHitsVerbose = std::move(data.zvec_ClusHitsVerbose);
+
+    data = thread_data();
+
+    association_vector.clear();
+    cluster_vector.clear();
+    v_hits.clear();
+    phivec_ClusHitsVerbose.clear();
+    zvec_ClusHitsVerbose.clear();
+    data.association_vector = std::move(association_vector);
+    data.cluster_vector = std::move(cluster_vector);
+    data.v_hits = std::move(v_hits);
+    data.phivec_ClusHitsVerbose = std::move(phivec_ClusHitsVerbose);
+    data.zvec_ClusHitsVerbose = std::move(zvec_ClusHitsVerbose);
+  }
+
+  void ProcessSectorData(thread_data *my_data, sector_scratch &scratch)
   {
     const auto &pedestal = my_data->pedestal;
     const auto &phibins = my_data->phibins;
@@ -789,10 +908,10 @@ namespace
     const auto &toffset = my_data->toffset;
     const auto &layer = my_data->layer;
     //    int nhits = 0;
-    // for convenience, create a 2D vector to store adc values in and initialize to zero
-    std::vector<std::vector<unsigned short>> adcval(phibins, std::vector<unsigned short>(tbins, 0));
-    std::multimap<unsigned short, ihit> all_hit_map;
-    std::vector<ihit> hit_vect;
+    // 2D vector to store adc values in, all zero on entry
+    scratch.prepare(phibins, tbins);
+    auto &adcval = scratch.adcval;
+    auto &all_hit_map = scratch.seeds;
 
     int tbinmax = tbins;
     int tbinmin = 0;
@@ -872,11 +991,11 @@ namespace
             thisHit.it = tbin;
             thisHit.adc = adc;
             thisHit.edge = 0;
-            all_hit_map.insert(std::make_pair(adc, thisHit));
+            all_hit_map.insert(thisHit);
           }
           if (adc > my_data->edge_threshold)
           {
-            adcval[phibin][tbin] = (unsigned short) adc;
+            scratch.set_adc(phibin, tbin, adc);
           }
         }
       }
@@ -917,9 +1036,9 @@ namespace
                 thisHit.it = pindex;
                 thisHit.adc = val;
                 thisHit.edge = 0;
-                all_hit_map.insert(std::make_pair(val, thisHit));
+                all_hit_map.insert(thisHit);
               }
-              adcval[nphi][pindex++] = val;
+              scratch.set_adc(nphi, pindex++, val);
             }
             else
             {
@@ -936,9 +1055,9 @@ namespace
                   thisHit.it = pindex;
                   thisHit.adc = val;
                   thisHit.edge = 0;
-                  all_hit_map.insert(std::make_pair(val, thisHit));
+                  all_hit_map.insert(thisHit);
                 }
-                adcval[nphi][pindex++] = val;
+                scratch.set_adc(nphi, pindex++, val);
               }
             }
           }
@@ -967,15 +1086,11 @@ namespace
     }
     */
     // std::cout << "done filling " << std::endl;
-    while (all_hit_map.size() > 0)
+    all_hit_map.finalize();
+    auto &ihit_list = scratch.ihit_list;
+    while (!all_hit_map.empty())
     {
-      // std::cout << "all hit map size: " << all_hit_map.size() << std::endl;
-      auto iter = all_hit_map.rbegin();
-      if (iter == all_hit_map.rend())
-      {
-        break;
-      }
-      ihit hiHit = iter->second;
+      ihit hiHit = all_hit_map.top();
       int iphi = hiHit.iphi;
       int it = hiHit.it;
       unsigned short edge = hiHit.edge;
@@ -992,7 +1107,7 @@ namespace
       // put all hits in the all_hit_map (sorted by adc)
       // start with highest adc hit
       //  -> cluster around it and get vector of hits
-      std::vector<ihit> ihit_list;
+      ihit_list.clear();
       int ntouch = 0;
       int nedge = 0;
       get_cluster(iphi, it, *my_data, adcval, ihit_list, ntouch, nedge);
@@ -1073,15 +1188,147 @@ namespace
                 << std::endl;
     }
     */
-    // pthread_exit(nullptr);
+    scratch.reset();
   }
-  void *ProcessSector(void *threadarg)
+}  // namespace
+
+// worker threads are started once and wait for the hitsets of each event.
+// Every worker owns its scratch buffers, results stay in the per hitset
+// thread_data and are merged by the caller in hitset order
+struct TpcClusterizer::WorkerPool
+{
+  explicit WorkerPool(unsigned int nthreads);
+  ~WorkerPool();
+
+  // process the first njobs entries of jobs, returns when all are done
+  void run(size_t njobs);
+
+  std::vector<thread_data> jobs;
+
+ private:
+  struct worker_arg
+  {
+    WorkerPool *pool = nullptr;
+    unsigned int id = 0;
+  };
+
+  static void *worker_main(void *threadarg);
+
+  std::vector<pthread_t> m_threads;
+  std::vector<worker_arg> m_args;
+  // one scratch per worker, the last one is used when running without threads
+  std::vector<sector_scratch> m_scratch;
+
+  pthread_mutex_t m_lock{};
+  pthread_cond_t m_work_cond{};
+  pthread_cond_t m_done_cond{};
+  size_t m_njobs = 0;
+  size_t m_next_job = 0;
+  size_t m_pending = 0;
+  bool m_shutdown = false;
+};
+
+TpcClusterizer::WorkerPool::WorkerPool(unsigned int nthreads)
+  : m_args(nthreads)
+  , m_scratch(nthreads + 1)
+{
+  pthread_mutex_init(&m_lock, nullptr);
+  pthread_cond_init(&m_work_cond, nullptr);
+  pthread_cond_init(&m_done_cond, nullptr);
+
+  m_threads.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
   {
-    auto my_data = static_cast<thread_data *>(threadarg);
-    ProcessSectorData(my_data);
-    pthread_exit(nullptr);
+    m_args[i].pool = this;
+    m_args[i].id = i;
+    pthread_t thread{};
+    int rc = pthread_create(&thread, nullptr, worker_main, &m_args[i]);
+    if (rc)
+    {
+      std::cout << "Error:unable to create thread," << rc << std::endl;
+      continue;
+    }
+    m_threads.push_back(thread);
   }
-}  // namespace
+}
+
+TpcClusterizer::WorkerPool::~WorkerPool()
+{
+  pthread_mutex_lock(&m_lock);
+  m_shutdown = true;
+  pthread_cond_broadcast(&m_work_cond);
+  pthread_mutex_unlock(&m_lock);
+
+  for (const auto &thread : m_threads)
+  {
+    int rc = pthread_join(thread, nullptr);
+    if (rc)
+    {
+      std::cout << "Error:unable to join," << rc << std::endl;
+    }
+  }
+
+  pthread_cond_destroy(&m_done_cond);
+  pthread_cond_destroy(&m_work_cond);
+  pthread_mutex_destroy(&m_lock);
+}
+
+void TpcClusterizer::WorkerPool::run(size_t njobs)
+{
+  // no worker could be started, process everything in the calling thread
+  if (m_threads.empty())
+  {
+    for (size_t i = 0; i < njobs; ++i)
+    {
+      ProcessSectorData(&jobs[i], m_scratch.back());
+    }
+    return;
+  }
+
+  pthread_mutex_lock(&m_lock);
+  m_njobs = njobs;
+  m_next_job = 0;
+  m_pending = njobs;
+  pthread_cond_broadcast(&m_work_cond);
+  while (m_pending > 0)
+  {
+    pthread_cond_wait(&m_done_cond, &m_lock);
+  }
+  m_njobs = 0;
+  pthread_mutex_unlock(&m_lock);
+}
+
+void *TpcClusterizer::WorkerPool::worker_main(void *threadarg)
+{
+  auto arg = static_cast<worker_arg *>(threadarg);
+  WorkerPool *pool = arg->pool;
+  sector_scratch &scratch = pool->m_scratch[arg->id];
+
+  pthread_mutex_lock(&pool->m_lock);
+  while (true)
+  {
+    while (!pool->m_shutdown && pool->m_next_job >= pool->m_njobs)
+    {
+      pthread_cond_wait(&pool->m_work_cond, &pool->m_lock);
+    }
+    if (pool->m_shutdown)
+    {
+      break;
+    }
+    thread_data *my_data = &pool->jobs[pool->m_next_job++];
+    pthread_mutex_unlock(&pool->m_lock);
+
+    ProcessSectorData(my_data, scratch);
+
+    pthread_mutex_lock(&pool->m_lock);
+    if (--pool->m_pending == 0)
+    {
+      pthread_cond_signal(&pool->m_done_cond);
+    }
+  }
+  pthread_mutex_unlock(&pool->m_lock);
+  return nullptr;
+}
 
 TpcClusterizer::TpcClusterizer(const std::string &name)
   : SubsysReco(name)
@@ -1089,6 +1336,8 @@ TpcClusterizer::TpcClusterizer(const std::string &name)
 {
 }
 
+TpcClusterizer::~TpcClusterizer() = default;
+
 bool TpcClusterizer::is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const
 {
   bool reject_it = false;
@@ -1238,6 +1487,18 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
   
   AdcClockPeriod = geom->GetFirstLayerCellGeom()->get_zstep();
 
+  // start the workers once for the whole run
+  unsigned int nthreads = 0;
+  if (!do_sequential)
+  {
+    nthreads = m_nthreads > 0 ? m_nthreads : std::max(1U, std::thread::hardware_concurrency());
+  }
+  m_pool = std::make_unique<WorkerPool>(nthreads);
+  if (Verbosity() > 0)
+  {
+    std::cout << "TpcClusterizer::InitRun - using " << nthreads << " worker threads" << std::endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -1350,28 +1611,13 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
     num_hitsets = std::distance(rawhitsetrange.first, rawhitsetrange.second);
   }
 
-  // create structure to store given thread and associated data
-  struct thread_pair_t
+  // one job per hitset, the job data is kept in the worker pool and reused across events
+  auto &jobs = m_pool->jobs;
+  if (jobs.size() < (size_t) num_hitsets)
   {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
-  threads.reserve(num_hitsets);
-
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    std::cout << std::endl
-              << " mutex init failed" << std::endl;
-    return 1;
+    jobs.resize(num_hitsets);
   }
-//  int count = 0;
+  size_t njobs = 0;
 
   if (!do_read_raw)
   {
@@ -1379,42 +1625,42 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
          hitsetitr != hitsetrange.second;
          ++hitsetitr)
     {
-      // if(count>0)continue;
       TrkrHitSet *hitset = hitsetitr->second;
       unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
       int side = TpcDefs::getSide(hitsetitr->first);
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
+      // reset the next job slot
+      thread_data &data = jobs[njobs++];
+      reset_thread_data(data);
       if (mClusHitsVerbose)
       {
-        thread_pair.data.fillClusHitsVerbose = true;
+        data.fillClusHitsVerbose = true;
       };
 
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = hitset;
-      thread_pair.data.rawhitset = nullptr;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.seed_threshold = seed_threshold;
-      thread_pair.data.edge_threshold = edge_threshold;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.do_singles = do_singles;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
-      thread_pair.data.do_split = do_split;
-      thread_pair.data.FixedWindow = do_fixed_window;
-      thread_pair.data.min_err_squared = min_err_squared;
-      thread_pair.data.min_clus_size = min_clus_size;
-      thread_pair.data.min_adc_sum = min_adc_sum;
+      data.layergeom = layergeom;
+      data.hitset = hitset;
+      data.rawhitset = nullptr;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.seed_threshold = seed_threshold;
+      data.edge_threshold = edge_threshold;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.do_singles = do_singles;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
+      data.do_split = do_split;
+      data.FixedWindow = do_fixed_window;
+      data.min_err_squared = min_err_squared;
+      data.min_clus_size = min_clus_size;
+      data.min_adc_sum = min_adc_sum;
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
       unsigned short NTBins = 0;
@@ -1432,73 +1678,17 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
-
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
+      data.m_tdriftmax = m_tdriftmax;
 
-      thread_pair.data.radius = layergeom->get_radius();
-      thread_pair.data.drift_velocity = m_tGeometry->get_drift_velocity();
-      thread_pair.data.pads_per_sector = 0;
-      thread_pair.data.phistep = 0;
-      int rc;
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
 
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-
-          if (mClusHitsVerbose)
-          {
-            for (auto &hit : data.phivec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addPhiHit(hit.first, hit.second);
-            }
-            for (auto &hit : data.zvec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addZHit(hit.first, hit.second);
-            }
-            mClusHitsVerbose->push_hits(ckey);
-          }
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-//      count++;
+      data.radius = layergeom->get_radius();
+      data.drift_velocity = m_tGeometry->get_drift_velocity();
+      data.pads_per_sector = 0;
+      data.phistep = 0;
     }
   }
   else
@@ -1507,33 +1697,30 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
          hitsetitr != rawhitsetrange.second;
          ++hitsetitr)
     {
-      //	if(count>0)continue;
-      //    const auto hitsetid = hitsetitr->first;
-      //	std::cout << " starting thread # " << count << std::endl;
-
       RawHitSet *hitset = hitsetitr->second;
       unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
       int side = TpcDefs::getSide(hitsetitr->first);
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
-
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = nullptr;
-      thread_pair.data.rawhitset = hitset;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
+      // reset the next job slot
+      thread_data &data = jobs[njobs++];
+      reset_thread_data(data);
+
+      data.layergeom = layergeom;
+      data.hitset = nullptr;
+      data.rawhitset = hitset;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1544,148 +1731,69 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
-
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
-
-      /*
-      PHG4TpcCylinderGeom *testlayergeom = geom_container->GetLayerCellGeom(32);
-      for( float iphi = 1408; iphi < 1408+ 128;iphi+=0.1){
-        double clusiphi = iphi;
-        double clusphi = testlayergeom->get_phi(clusiphi);
-        double radius = layergeom->get_radius();
-        float clusx = radius * cos(clusphi);
-        float clusy = radius * sin(clusphi);
-        float clusz  = -37.524;
-
-        TrkrDefs::hitsetkey tpcHitSetKey = TpcDefs::genHitSetKey( 32,11, 0 );
-        Acts::Vector3 global(clusx, clusy, clusz);
-        TrkrDefs::subsurfkey subsurfkey = 0;
-
-        Surface surface = m_tGeometry->get_tpc_surface_from_coords(
-                                                                   tpcHitSetKey,
-                                                                   global,
-                                                                   subsurfkey);
-        std::cout << " iphi: " << iphi << " clusphi: " << clusphi << " surfkey " << subsurfkey << std::endl;
-        //	std::cout << "surfkey" << subsurfkey << std::endl;
-      }
-      continue;
-      */
-      int rc = 0;
-      //      if(layer==32)
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-      //      else
-      // continue;
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto cluster = data.cluster_vector[index];
+      data.m_tdriftmax = m_tdriftmax;
 
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-//      count++;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
     }
   }
 
-  pthread_attr_destroy(&attr);
-//  count = 0;
-  // wait for completion of all threads
-  if (!do_sequential)
+  // process all hitsets, either on the worker threads or sequentially in this thread
+  m_pool->run(njobs);
+
+  // merge the results in hitset order, so that the output does not depend on the threading
+  for (size_t ijob = 0; ijob < njobs; ++ijob)
   {
-    for (const auto &thread_pair : threads)
-    {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-        std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
+    const auto &data = jobs[ijob];
 
-      // get the hitsetkey from thread data
-      const auto &data(thread_pair.data);
-      const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
+    // get the hitsetkey from thread data
+    const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
-      // copy clusters to map
-      for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy clusters to map
+    for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // get cluster
-        auto cluster = data.cluster_vector[index];
+      // get cluster
+      auto cluster = data.cluster_vector[index];
 
-        // insert in map
-        // std::cout << "X: " << cluster->getLocalX() << "Y: " << cluster->getLocalY() << std::endl;
-        m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      // insert in map
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
 
-        if (mClusHitsVerbose)
+      if (mClusHitsVerbose && data.fillClusHitsVerbose)
+      {
+        for (auto &hit : data.phivec_ClusHitsVerbose[index])
         {
-          for (auto &hit : data.phivec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
-          }
-          for (auto &hit : data.zvec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
-          }
-          mClusHitsVerbose->push_hits(ckey);
+          mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
+        }
+        for (auto &hit : data.zvec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
         }
+        mClusHitsVerbose->push_hits(ckey);
       }
+    }
 
-      // copy hit associations to map
-      for (const auto &[index, hkey] : thread_pair.data.association_vector)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy hit associations to map
+    for (const auto &[index, hkey] : data.association_vector)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // add to association table
-        m_clusterhitassoc->addAssoc(ckey, hkey);
-      }
+      // add to association table
+      m_clusterhitassoc->addAssoc(ckey, hkey);
+    }
 
-      for (auto v_hit : thread_pair.data.v_hits)
+    for (auto v_hit : data.v_hits)
+    {
+      if (_store_hits)
       {
-        if (_store_hits)
-        {
-          m_training->v_hits.emplace_back(*v_hit);
-        }
-        delete v_hit;
+        m_training->v_hits.emplace_back(*v_hit);
       }
+      delete v_hit;
     }
   }
 
@@ -1701,5 +1809,7 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
 
 int TpcClusterizer::End(PHCompositeNode * /*topNode*/)
 {
+  // stop and join the worker threads
+  m_pool.reset();
   return Fun4AllReturnCodes::EVENT_OK;
 }
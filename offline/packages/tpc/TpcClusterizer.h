@@ -6,6 +6,7 @@
 #include <trackbase/TrkrCluster.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -27,7 +28,7 @@ public:
   typedef std::pair<unsigned short, iphiz> ihit;
 
   TpcClusterizer(const std::string &name = "TpcClusterizer");
-  ~TpcClusterizer() override = default;
+  ~TpcClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -39,6 +40,8 @@ public:
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  //! number of worker threads used to process hitsets, 0 means one per hardware core
+  void set_nthreads(unsigned int nthreads) { m_nthreads = nthreads; }
   void set_do_split(bool split) { do_split = split; }
   void set_fixed_window(int fixed) { do_fixed_window = fixed; }
   void set_pedestal(float val) { pedestal = val; }
@@ -73,6 +76,11 @@ public:
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
+  //! persistent worker threads and their scratch buffers, alive from InitRun to End
+  struct WorkerPool;
+  std::unique_ptr<WorkerPool> m_pool;
+  unsigned int m_nthreads = 0;
+
   bool is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const;
   bool record_ClusHitsVerbose{false};
 
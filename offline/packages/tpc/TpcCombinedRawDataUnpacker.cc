@@ -29,8 +29,6 @@
 #include <phool/phool.h>  // for PHWHERE
 
 #include <TFile.h>
-#include <TH1.h>
-#include <TH2.h>
 #include <TNtuple.h>
 #include <TSystem.h>
 
@@ -38,6 +36,7 @@
 #include <cstdint>   // for exit
 #include <cstdlib>   // for exit
 #include <iostream>  // for operator<<, endl, bas...
+#include <limits>
 #include <map>       // for _Rb_tree_iterator
 #include <memory>
 #include <utility>
@@ -167,9 +166,37 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
     m_presampleShift = 0;
   }
 
+  // the geometry can change between runs
+  m_channel_pads.assign(nsectors * nchannels, channel_pad());
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+const TpcCombinedRawDataUnpacker::channel_pad& TpcCombinedRawDataUnpacker::get_channel_pad(int sector, int side, unsigned int key, PHG4TpcCylinderGeomContainer* geom_container)
+{
+  channel_pad* pad = &m_channel_pad;
+  if (sector >= 0 && sector < nsectors && key < nchannels)
+  {
+    pad = &m_channel_pads[sector * nchannels + key];
+    if (pad->valid)
+    {
+      return *pad;
+    }
+  }
+
+  pad->valid = true;
+  pad->layer = m_cdbttree->GetIntValue(key, "layer");
+  // antenna pads will be in 0 layer
+  if (pad->layer <= 0)
+  {
+    return *pad;
+  }
+  double phi = -1 * pow(-1, side) * m_cdbttree->GetDoubleValue(key, "phi") + (sector % 12) * M_PI / 6;
+  PHG4TpcCylinderGeom* layergeom = geom_container->GetLayerCellGeom(pad->layer);
+  pad->phibin = layergeom->get_phibin(phi);
+  return *pad;
+}
+
 int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 {
   if (_ievent < startevt || _ievent > endevt)
@@ -263,8 +290,8 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     }
 
     unsigned int key = 256 * (feeM) + channel;
-    std::string varname = "layer";
-    int layer = m_cdbttree->GetIntValue(key, varname);
+    const channel_pad& pad = get_channel_pad(sector, side, key, geom_container);
+    const int layer = pad.layer;
     // antenna pads will be in 0 layer
     if (layer <= 0)
     {
@@ -275,10 +302,7 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     // uint16_t sampch = tpchit->get_sampachannel();
     //    uint16_t sam = tpchit->get_samples();
     max_time_range = tpchit->get_samples();
-    varname = "phi";  // + std::to_string(key);
-    double phi = -1 * pow(-1, side) * m_cdbttree->GetDoubleValue(key, varname) + (sector % 12) * M_PI / 6;
-    PHG4TpcCylinderGeom* layergeom = geom_container->GetLayerCellGeom(layer);
-    unsigned int phibin = layergeom->get_phibin(phi);
+    const unsigned int phibin = pad.phibin;
 
     hit_set_key = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
     hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
@@ -290,47 +314,37 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     {
       std::cout << "TpcCombinedRawDataUnpacker:: do zero suppression" << std::endl;
     }
-    TH2C* feehist = nullptr;
     hpedestal = 60;
     hpedwidth = m_zs_threshold;
 
-    unsigned int pad_key = create_pad_key(side, layer, phibin);
-
-    std::map<unsigned int, chan_info>::iterator chan_it = chan_map.find(pad_key);
-    if (chan_it != chan_map.end())
+    // remember the first fee seen on each pad for the baseline correction,
+    // hit keys only hold 16 bit pad numbers
+    if (phibin <= std::numeric_limits<uint16_t>::max())
     {
-      (*chan_it).second.ped = hpedestal;
-      (*chan_it).second.width = hpedwidth;
-    }
-    else
-    {
-      chan_info nucinfo;
-      nucinfo.fee = fee;
-      nucinfo.ped = hpedestal;
-      nucinfo.width = hpedwidth;
-      chan_map.insert(std::make_pair(pad_key, nucinfo));
+      const unsigned int padrow = layer * 2 + side;
+      if (padrow >= m_pad_fee.size())
+      {
+        m_pad_fee.resize(padrow + 1);
+      }
+      std::vector<unsigned int>& layer_fees = m_pad_fee[padrow];
+      if (phibin >= layer_fees.size())
+      {
+        layer_fees.resize(phibin + 1, std::numeric_limits<unsigned int>::max());
+      }
+      if (layer_fees[phibin] == std::numeric_limits<unsigned int>::max())
+      {
+        layer_fees[phibin] = fee;
+      }
     }
-    int rx = get_rx(layer);
-    unsigned int fee_key = create_fee_key(side, mc_sectors[sector % 12], rx, fee);
-    // find or insert TH2C;
-    std::map<unsigned int, TH2C*>::iterator fee_map_it;
-
 
-    fee_map_it = feeadc_map.find(fee_key);
-    if (fee_map_it != feeadc_map.end())
+    // adc spectra are only needed for the baseline correction
+    TpcFeeBaseline* feeadc = nullptr;
+    if (m_do_baseline_corr)
     {
-      feehist = (*fee_map_it).second;
+      int rx = get_rx(layer);
+      unsigned int fee_key = create_fee_key(side, mc_sectors[sector % 12], rx, fee);
+      feeadc = &feeadc_map.try_emplace(fee_key, max_time_range + 1).first->second;
     }
-    else
-    {
-      std::string histname = "h" + std::to_string(fee_key);
-      feehist = new TH2C(histname.c_str(), "histname", max_time_range + 1, -0.5, max_time_range + 0.5, 501, -0.5, 1000.5);
-      feeadc_map.insert(std::make_pair(fee_key, feehist));
-      std::vector<int> feeentries(feehist->GetNbinsX(), 0);
-      feeentries_map.insert(std::make_pair(fee_key, feeentries));
-    }
-    auto fee_entries_it = feeentries_map.find(fee_key);
-    std::vector<int>& fee_entries_vec = (*fee_entries_it).second;
 
     float threshold_cut = m_zs_threshold;
 
@@ -345,17 +359,13 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       {
         continue;
       }
-      if (feehist != nullptr)
+      if (feeadc != nullptr)
       {
         if (adc > 0)
         {
           if ((float(adc) - hpedestal) > threshold_cut)
           {
-            feehist->Fill(t, adc - hpedestal);
-            if(t < (int)fee_entries_vec.size())
-            {
-              fee_entries_vec[t]++;
-            }
+            feeadc->fill(t, adc - hpedestal);
           }
         }
       }
@@ -405,89 +415,47 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 
     int nhistfilled = 0;
     int nhisttotal = 0;
-    for (auto& hiter : feeadc_map)
+    for (auto& [fee_key, feeadc] : feeadc_map)
     {
-      if (hiter.second != nullptr)
+      unsigned int side;
+      unsigned int sector;
+      unsigned int rx;
+      unsigned int fee;
+      unpack_fee_key(side, sector, rx, fee, fee_key);
+
+      std::vector<float>& fee_baseline = feebaseline_map[fee_key];
+      fee_baseline.assign(feeadc.ntimebins(), 0);
+      // the last time bin is not corrected
+      for (unsigned int timebin = 0; timebin + 1 < feeadc.ntimebins(); timebin++)
       {
-        unsigned int fee_key = hiter.first;
-        unsigned int side;
-        unsigned int sector;
-        unsigned int rx;
-        unsigned int fee;
-        unpack_fee_key(side, sector, rx, fee, fee_key);
-        TH2C* hist2d = hiter.second;
-        std::map<unsigned int, std::vector<int>>::iterator fee_entries_it = feeentries_map.find(fee_key);
-        if (fee_entries_it == feeentries_map.end())
+        nhisttotal++;
+        float local_ped = 0;
+        float local_width = 0;
+        float entries = feeadc.entries(timebin);
+        if (feeadc.entries(timebin) > 100)
         {
-          continue;
-          //	  fee_entries_vec_it = (*fee_entries_it).second.begin();
+          nhistfilled++;
+          feeadc.baseline(timebin, local_ped, local_width);
         }
-        std::vector<int>::iterator fee_entries_vec_it = (*fee_entries_it).second.begin();
+        fee_baseline[timebin] = local_ped + m_baseline_nsigma * local_width;
 
-        std::vector<float> pedvec(hist2d->GetNbinsX(), 0);
-        feebaseline_map.insert(std::make_pair(hiter.first, pedvec));
-        std::map<unsigned int, std::vector<float>>::iterator fee_blm_it = feebaseline_map.find(hiter.first);
-        (*fee_blm_it).second.resize(hist2d->GetNbinsX(), 0);
-        for (int binx = 1; binx < hist2d->GetNbinsX(); binx++)
+        if (m_writeTree)
         {
-          double timebin = ((TAxis*) hist2d->GetXaxis())->GetBinCenter(binx);
-          std::string histname1d = "h" + std::to_string(hiter.first) + "_" + std::to_string((int) timebin);
-          nhisttotal++;
-          float local_ped = 0;
-          float local_width = 0;
-          float entries = fee_entries_vec_it[timebin];
-          if (fee_entries_vec_it[timebin] > 100)
-          {
-            nhistfilled++;
-
-            TH1D* hist1d = hist2d->ProjectionY(histname1d.c_str(), binx, binx);
-            if (hist1d->GetEntries() != fee_entries_vec_it[timebin])
-            {
-              std::cout << " vec " << fee_entries_vec_it[timebin]
-                        << " hist " << hist1d->GetEntries()
-                        << std::endl;
-            }
-            if (hist1d->GetEntries() > 10)
-            {
-              int maxbin = hist1d->GetMaximumBin();
-              // calc peak position
-              double hadc_sum = 0.0;
-              double hibin_sum = 0.0;
-              double hibin2_sum = 0.0;
-
-              for (int isum = -3; isum <= 3; isum++)
-              {
-                float val = hist1d->GetBinContent(maxbin + isum);
-                float center = hist1d->GetBinCenter(maxbin + isum);
-                hibin_sum += center * val;
-                hibin2_sum += center * center * val;
-                hadc_sum += val;
-              }
-              local_ped = hibin_sum / hadc_sum;
-              local_width = sqrt(hibin2_sum / hadc_sum - (local_ped * local_ped));
-            }
-            delete hist1d;
-          }
-          (*fee_blm_it).second[(int) timebin] = local_ped + m_baseline_nsigma * local_width;
-
-          if (m_writeTree)
-          {
-            float fXh[11];
-            int nh = 0;
+          float fXh[11];
+          int nh = 0;
 
-            fXh[nh++] = _ievent - 1;
-            fXh[nh++] = 0;                        // gtm_bco;
-            fXh[nh++] = 0;                        // packet_id;
-            fXh[nh++] = 0;                        // ep;
-            fXh[nh++] = mc_sectors[sector % 12];  // Sector;
-            fXh[nh++] = side;
-            fXh[nh++] = fee;
-            fXh[nh++] = rx;
-            fXh[nh++] = entries;
-            fXh[nh++] = local_ped;
-            fXh[nh++] = local_width;
-            m_ntup->Fill(fXh);
-          }
+          fXh[nh++] = _ievent - 1;
+          fXh[nh++] = 0;                        // gtm_bco;
+          fXh[nh++] = 0;                        // packet_id;
+          fXh[nh++] = 0;                        // ep;
+          fXh[nh++] = mc_sectors[sector % 12];  // Sector;
+          fXh[nh++] = side;
+          fXh[nh++] = fee;
+          fXh[nh++] = rx;
+          fXh[nh++] = entries;
+          fXh[nh++] = local_ped;
+          fXh[nh++] = local_width;
+          m_ntup->Fill(fXh);
         }
       }
     }
@@ -524,16 +492,12 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
         unsigned short tbin = TpcDefs::getTBin(hitr->first);
         unsigned short adc = (hitr->second->getAdc());
 
-        unsigned int pad_key = create_pad_key(side, layer, phibin);
-
-        float fee = 0;
-        std::map<unsigned int, chan_info>::iterator chan_it = chan_map.find(pad_key);
-        if (chan_it != chan_map.end())
+        unsigned int fee = 0;
+        const unsigned int padrow = layer * 2 + side;
+        if (padrow < m_pad_fee.size() && phibin < m_pad_fee[padrow].size() &&
+            m_pad_fee[padrow][phibin] != std::numeric_limits<unsigned int>::max())
         {
-          chan_info cinfo = (*chan_it).second;
-          fee = cinfo.fee;
-          // hpedestal2 = cinfo.ped;
-          // hpedwidth2 = cinfo.width;
+          fee = m_pad_fee[padrow][phibin];
         }
 
         int rx = get_rx(layer);
@@ -584,18 +548,10 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       }
     }
   }
-  // reset histogramms
+  // reset adc spectra
   for (auto& hiter2 : feeadc_map)
   {
-    if (hiter2.second != nullptr)
-    {
-      hiter2.second->Reset();
-    }
-  }
-  feebaseline_map.clear();
-  for (auto& hiter_entries : feeentries_map)
-  {
-    hiter_entries.second.assign(hiter_entries.second.size(), 0);
+    hiter2.second.reset();
   }
 
   if (Verbosity())
@@ -3,18 +3,18 @@
 #ifndef TPC_COMBINEDRAWDATAUNPACKER_H
 #define TPC_COMBINEDRAWDATAUNPACKER_H
 
+#include "TpcFeeBaseline.h"
+
 #include <fun4all/SubsysReco.h>
 
-#include <limits>
 #include <map>
 #include <string>
 #include <vector>
 
 class PHCompositeNode;
+class PHG4TpcCylinderGeomContainer;
 class CDBTTree;
 class CDBInterface;
-class TH2I;
-class TH2C;
 class TFile;
 class TNtuple;
 
@@ -46,13 +46,6 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
     startevt = a;
     endevt = b;
   }
-  struct chan_info
-  {
-    unsigned int fee = std::numeric_limits<unsigned int>::max();
-    float ped = -1;
-    float width = -1;
-    int entries = 0;
-  };
   unsigned int get_rx(unsigned int layer)
   {
     return (layer - 7) / 16;
@@ -90,6 +83,15 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   }
 
  private:
+  //! layer and phi bin of a FEE channel, layer <= 0 for antenna pads
+  struct channel_pad
+  {
+    int layer = 0;
+    unsigned int phibin = 0;
+    bool valid = false;
+  };
+  const channel_pad &get_channel_pad(int sector, int side, unsigned int key, PHG4TpcCylinderGeomContainer *geom_container);
+
   TNtuple *m_ntup{nullptr};
   TNtuple *m_ntup_hits = nullptr;
   TNtuple *m_ntup_hits_corr = nullptr;
@@ -115,10 +117,13 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   int m_zs_threshold{20};
   std::string m_TpcRawNodeName{"TPCRAWHIT"};
   std::string outfile_name;
-  std::map<unsigned int, chan_info> chan_map;                  // stays in place
-  std::map<unsigned int, TH2C *> feeadc_map;                   // histos reset after each event
-  std::map<unsigned int, std::vector<int>> feeentries_map;     // cleared after each event
-  std::map<unsigned int, std::vector<float>> feebaseline_map;  // cleared after each event
+  static constexpr int nsectors = 24;
+  static constexpr unsigned int nchannels = 26 * 256;          // FEE channel keys per sector
+  std::vector<channel_pad> m_channel_pads;                     // index sector * nchannels + key, cleared in InitRun
+  channel_pad m_channel_pad;                                   // for channels outside of the table
+  std::vector<std::vector<unsigned int>> m_pad_fee;            // fee of [layer * 2 + side][phibin], stays in place
+  std::map<unsigned int, TpcFeeBaseline> feeadc_map;           // adc spectra reset after each event
+  std::map<unsigned int, std::vector<float>> feebaseline_map;  // refilled every event
 };
 
 #endif  // TPC_COMBINEDRAWDATAUNPACKER_H
@@ -0,0 +1,88 @@
+#include "TpcFeeBaseline.h"
+
+#include <algorithm>
+#include <cmath>
+
+TpcFeeBaseline::TpcFeeBaseline(unsigned int ntimebins)
+  : m_counts(static_cast<size_t>(ntimebins) * ncells, 0)
+  , m_entries(ntimebins, 0)
+{
+}
+
+int TpcFeeBaseline::adcbin(double adc)
+{
+  // same as TAxis::FindBin
+  if (adc < adcmin)
+  {
+    return 0;
+  }
+  if (!(adc < adcmax))
+  {
+    return nadcbins + 1;
+  }
+  return 1 + int(nadcbins * (adc - adcmin) / (adcmax - adcmin));
+}
+
+double TpcFeeBaseline::bincenter(int bin)
+{
+  // same as TAxis::GetBinCenter, also outside of the axis range
+  return adcmin + (double(bin) - 0.5) * ((adcmax - adcmin) / nadcbins);
+}
+
+void TpcFeeBaseline::fill(int t, float adc)
+{
+  if (t < 0 || t >= (int) m_entries.size())
+  {
+    return;
+  }
+  if (m_entries[t]++ == 0)
+  {
+    m_filled.push_back(t);
+  }
+  int8_t &count = m_counts[static_cast<size_t>(t) * ncells + adcbin(adc)];
+  if (count < maxcount)
+  {
+    ++count;
+  }
+}
+
+void TpcFeeBaseline::baseline(unsigned int t, float &ped, float &width) const
+{
+  const int8_t *counts = &m_counts[static_cast<size_t>(t) * ncells];
+
+  // first bin with the highest count, under- and overflow excluded
+  int maxbin = 1;
+  for (int bin = 2; bin <= nadcbins; ++bin)
+  {
+    if (counts[bin] > counts[maxbin])
+    {
+      maxbin = bin;
+    }
+  }
+
+  double hadc_sum = 0.0;
+  double hibin_sum = 0.0;
+  double hibin2_sum = 0.0;
+  for (int isum = -3; isum <= 3; isum++)
+  {
+    // bins beyond the axis read the under- or overflow, like TH1::GetBinContent
+    const int bin = maxbin + isum;
+    float val = counts[std::clamp(bin, 0, ncells - 1)];
+    float center = bincenter(bin);
+    hibin_sum += center * val;
+    hibin2_sum += center * center * val;
+    hadc_sum += val;
+  }
+  ped = hibin_sum / hadc_sum;
+  width = std::sqrt(hibin2_sum / hadc_sum - (ped * ped));
+}
+
+void TpcFeeBaseline::reset()
+{
+  for (unsigned int t : m_filled)
+  {
+    std::fill_n(m_counts.begin() + static_cast<size_t>(t) * ncells, ncells, 0);
+    m_entries[t] = 0;
+  }
+  m_filled.clear();
+}
@@ -0,0 +1,59 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef TPC_TPCFEEBASELINE_H
+#define TPC_TPCFEEBASELINE_H
+
+#include <cstdint>
+#include <vector>
+
+/*!
+ * \file TpcFeeBaseline.h
+ * \brief per event ADC spectra of one FEE and their local baselines
+ *
+ * Replaces the TH2C (time bin vs ADC above pedestal) that the unpacker used
+ * to fill per FEE and project for every time bin. The binning and the 8 bit
+ * saturating counters are the ones of that histogram, so the baselines are
+ * the same as from the ProjectionY scan, but nothing is allocated per event
+ * and only the time bins that were filled are cleared again.
+ */
+class TpcFeeBaseline
+{
+ public:
+  //! ADC spectra for time bins 0 to ntimebins-1
+  explicit TpcFeeBaseline(unsigned int ntimebins);
+
+  unsigned int ntimebins() const { return m_entries.size(); }
+
+  //! add an ADC value (above pedestal) in time bin t, t outside the range is ignored
+  void fill(int t, float adc);
+
+  //! number of fills in time bin t
+  int entries(unsigned int t) const { return m_entries[t]; }
+
+  //! peak position and width of the ADC spectrum in time bin t from the 7 bins around its maximum
+  void baseline(unsigned int t, float &ped, float &width) const;
+
+  //! clear the filled time bins
+  void reset();
+
+  //! binning of the ADC axis (501 bins from -0.5 to 1000.5, plus under- and overflow)
+  static constexpr int nadcbins = 501;
+  static constexpr double adcmin = -0.5;
+  static constexpr double adcmax = 1000.5;
+
+ private:
+  static constexpr int ncells = nadcbins + 2;
+
+  //! counters saturate like the ones of a TH2C
+  static constexpr int8_t maxcount = 127;
+
+  static int adcbin(double adc);
+  static double bincenter(int bin);
+
+  //! ncells counters per time bin, cell 0 is underflow and nadcbins+1 overflow
+  std::vector<int8_t> m_counts;
+  std::vector<int> m_entries;
+  std::vector<unsigned int> m_filled;
+};
+
+#endif  // TPC_TPCFEEBASELINE_H
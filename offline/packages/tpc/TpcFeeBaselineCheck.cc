@@ -0,0 +1,157 @@
+// Regression check of TpcFeeBaseline against the ROOT path it replaced in
+// TpcCombinedRawDataUnpacker: a TH2C (time bin vs ADC above pedestal) per
+// FEE, a ProjectionY per time bin and the peak scan around its maximum.
+//
+// usage: tpc_fee_baseline_check [nevents] [nfees]
+//
+// Both are filled with the same synthetic ADC values, including saturated
+// counters, under- and overflows, and reset between events. The entries of
+// all time bins, and the local pedestals and widths of the time bins used by
+// the unpacker, must be bitwise identical. Returns 0 on success, 1 on any difference.
+
+#include "TpcFeeBaseline.h"
+
+#include <TH1.h>
+#include <TH2.h>
+#include <TRandom3.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // local baseline of time bin binx, as computed by the unpacker before TpcFeeBaseline
+  void root_baseline(TH2C* hist2d, int binx, float& local_ped, float& local_width)
+  {
+    std::unique_ptr<TH1D> hist1d(hist2d->ProjectionY("hcheck_projection", binx, binx));
+    local_ped = 0;
+    local_width = 0;
+    if (hist1d->GetEntries() > 10)
+    {
+      int maxbin = hist1d->GetMaximumBin();
+      double hadc_sum = 0.0;
+      double hibin_sum = 0.0;
+      double hibin2_sum = 0.0;
+      for (int isum = -3; isum <= 3; isum++)
+      {
+        float val = hist1d->GetBinContent(maxbin + isum);
+        float center = hist1d->GetBinCenter(maxbin + isum);
+        hibin_sum += center * val;
+        hibin2_sum += center * center * val;
+        hadc_sum += val;
+      }
+      local_ped = hibin_sum / hadc_sum;
+      local_width = std::sqrt(hibin2_sum / hadc_sum - (local_ped * local_ped));
+    }
+  }
+
+  bool same(float a, float b)
+  {
+    return (a == b) || (std::isnan(a) && std::isnan(b));
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const int nevents = (argc > 1) ? std::atoi(argv[1]) : 20;
+  const int nfees = (argc > 2) ? std::atoi(argv[2]) : 40;
+  constexpr int max_time_range = 425;
+
+  TH1::AddDirectory(false);
+  TRandom3 random(4357);
+
+  std::vector<std::unique_ptr<TH2C>> hists;
+  std::vector<TpcFeeBaseline> baselines;
+  for (int ifee = 0; ifee < nfees; ++ifee)
+  {
+    const std::string histname = "hcheck_fee" + std::to_string(ifee);
+    hists.emplace_back(new TH2C(histname.c_str(), "histname", max_time_range + 1, -0.5, max_time_range + 0.5, TpcFeeBaseline::nadcbins, TpcFeeBaseline::adcmin, TpcFeeBaseline::adcmax));
+    baselines.emplace_back(max_time_range + 1);
+  }
+
+  long ncompared = 0;
+  long nused = 0;
+  long ndiff = 0;
+  for (int ievent = 0; ievent < nevents; ++ievent)
+  {
+    for (int ifee = 0; ifee < nfees; ++ifee)
+    {
+      // fills per time bin, counted separately as the unpacker did
+      std::vector<int> fee_entries(max_time_range + 1, 0);
+
+      // a common mode shift per time bin on top of the pedestal subtracted noise,
+      // the busiest time bins saturate the 8 bit counters around the peak
+      const int nwaveforms = random.Integer(600);
+      const int tfirst = random.Integer(max_time_range / 2);
+      const int tlast = tfirst + random.Integer(max_time_range / 2 + 2);
+      for (int iwf = 0; iwf < nwaveforms; ++iwf)
+      {
+        for (int t = tfirst; t < tlast; ++t)
+        {
+          const double shift = 20. * std::sin(0.05 * t + ievent);
+          double adc = random.Gaus(shift, 3.);
+          if (random.Rndm() < 0.02)
+          {
+            // signal, sometimes beyond the axis range
+            adc += random.Exp(300.);
+          }
+          if (random.Rndm() < 0.01)
+          {
+            adc = -random.Exp(5.);
+          }
+          hists[ifee]->Fill(t, static_cast<float>(adc));
+          baselines[ifee].fill(t, static_cast<float>(adc));
+          ++fee_entries[t];
+        }
+      }
+
+      TH2C* hist2d = hists[ifee].get();
+      const TpcFeeBaseline& baseline = baselines[ifee];
+      for (int binx = 1; binx < hist2d->GetNbinsX(); binx++)
+      {
+        const int t = binx - 1;
+        ++ncompared;
+        if (fee_entries[t] != baseline.entries(t))
+        {
+          ++ndiff;
+          std::cout << "event " << ievent << " fee " << ifee << " t " << t
+                    << " entries " << fee_entries[t] << " TpcFeeBaseline " << baseline.entries(t) << std::endl;
+          continue;
+        }
+
+        // only time bins with more than 100 entries are used by the unpacker
+        if (fee_entries[t] <= 100)
+        {
+          continue;
+        }
+        ++nused;
+
+        float root_ped = 0;
+        float root_width = 0;
+        root_baseline(hist2d, binx, root_ped, root_width);
+
+        float ped = 0;
+        float width = 0;
+        baseline.baseline(t, ped, width);
+        if (!same(ped, root_ped) || !same(width, root_width))
+        {
+          ++ndiff;
+          std::cout << "event " << ievent << " fee " << ifee << " t " << t
+                    << " ROOT " << root_ped << " +- " << root_width
+                    << " TpcFeeBaseline " << ped << " +- " << width << std::endl;
+        }
+      }
+
+      hists[ifee]->Reset();
+      baselines[ifee].reset();
+    }
+  }
+
+  std::cout << "compared " << ncompared << " time bins, " << nused << " with a baseline, "
+            << ndiff << " differences" << std::endl;
+  return ndiff ? 1 : 0;
+}
@@ -9,6 +9,7 @@
 #include "TpcClusterZCrossingCorrection.h"
 #include "TpcDistortionCorrection.h"
 
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
 #include <trackbase/TrkrDefs.h>
 
 
@@ -49,6 +50,12 @@ class TpcGlobalPositionWrapper
    */
   Acts::Vector3 getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey&, TrkrCluster*, short int /*crossing*/ ) const;
 
+  //! geometry and distortion corrections used by getGlobalPositionDistortionCorrected, to key the shared position cache
+  TrkrClusterGlobalPositionCache::Configuration cacheConfiguration() const
+  {
+    return {m_tGeometry, true, {{m_dcc_module_edge, m_dcc_static, m_dcc_average, m_dcc_fluctuation}}};
+  }
+
   private:
 
   //! verbosity
@@ -0,0 +1,96 @@
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.cc
+ * @brief Implementation of TrkrClusterGlobalPositionCache
+ */
+#include "TrkrClusterGlobalPositionCache.h"
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+
+#include <numeric>
+#include <stdexcept>
+
+TrkrClusterGlobalPositionCache* TrkrClusterGlobalPositionCache::getOrCreate(PHCompositeNode* topNode)
+{
+  auto cache = findNode::getClass<TrkrClusterGlobalPositionCache>(topNode, NODENAME);
+  if (cache)
+  {
+    return cache;
+  }
+
+  PHNodeIterator iter(topNode);
+  auto dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << "TrkrClusterGlobalPositionCache::getOrCreate - DST Node missing, doing nothing." << std::endl;
+    return nullptr;
+  }
+
+  PHNodeIterator dstiter(dstNode);
+  auto trkrNode = dynamic_cast<PHCompositeNode*>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+  if (!trkrNode)
+  {
+    trkrNode = new PHCompositeNode("TRKR");
+    dstNode->addNode(trkrNode);
+  }
+
+  // transient node, object type PHObject so that it gets reset at the end of each event
+  cache = new TrkrClusterGlobalPositionCache;
+  trkrNode->addNode(new PHDataNode<TrkrClusterGlobalPositionCache>(cache, NODENAME, "PHObject"));
+  return cache;
+}
+
+void TrkrClusterGlobalPositionCache::identify(std::ostream& os) const
+{
+  os << "TrkrClusterGlobalPositionCache - size: " << m_keys.size()
+     << " filled: " << m_filled
+     << " trkrid: " << static_cast<int>(m_trkrid)
+     << " distortion corrected: " << m_configuration.distortionCorrected
+     << std::endl;
+}
+
+void TrkrClusterGlobalPositionCache::Reset()
+{
+  m_keys.clear();
+  m_positions.clear();
+  m_clusters = nullptr;
+  m_filled = false;
+}
+
+const Acts::Vector3& TrkrClusterGlobalPositionCache::at(TrkrDefs::cluskey key) const
+{
+  const auto i = index(key);
+  if (i == m_keys.size())
+  {
+    throw std::out_of_range("TrkrClusterGlobalPositionCache::at - cluster key not found");
+  }
+  return m_positions[i];
+}
+
+void TrkrClusterGlobalPositionCache::sort()
+{
+  // clusters come ordered by hitset and by key inside a hitset, so this is normally a no-op
+  if (std::is_sorted(m_keys.begin(), m_keys.end()))
+  {
+    return;
+  }
+
+  std::vector<std::size_t> order(m_keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b)
+            { return m_keys[a] < m_keys[b]; });
+
+  std::vector<TrkrDefs::cluskey> keys;
+  std::vector<Acts::Vector3> positions;
+  keys.reserve(m_keys.size());
+  positions.reserve(m_positions.size());
+  for (const auto i : order)
+  {
+    keys.push_back(m_keys[i]);
+    positions.push_back(m_positions[i]);
+  }
+  m_keys.swap(keys);
+  m_positions.swap(positions);
+}
@@ -0,0 +1,164 @@
+#ifndef TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+#define TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.h
+ * @brief per event store of cluster global positions, shared between tracking modules
+ */
+
+#include "TrkrClusterContainer.h"
+#include "TrkrDefs.h"
+
+#include <phool/PHObject.h>
+
+#include <Acts/Definitions/Algebra.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class ActsGeometry;
+class PHCompositeNode;
+class TpcDistortionCorrectionContainer;
+
+/**
+ * @brief Flat, sorted array of cluster keys and global positions
+ *
+ * The first module that needs the positions fills the cache, the following modules
+ * only read it. The cache lives on the node tree and is reset at the end of each event.
+ * It records which cluster container, geometry and distortion corrections were used, so that a
+ * module with a different configuration refills it instead of using stale positions.
+ * Positions are for crossing zero, i.e. what the seeders use.
+ *
+ * Once filled, each cluster is identified by its dense index in the arrays, from 0 to size()-1.
+ * Indices follow the key ordering and are only valid for the current event. Modules that look
+ * positions up in inner loops should carry the index rather than the key and use position(i).
+ *
+ * The object is transient and never written to output.
+ */
+class TrkrClusterGlobalPositionCache : public PHObject
+{
+ public:
+  //! dense per event cluster index
+  using index_type = uint32_t;
+
+  //! node name
+  static constexpr const char* NODENAME = "TRKR_CLUSTER_GLOBALPOSITION";
+
+  //! what the positions depend on, besides the clusters. Containers are compared by identity
+  struct Configuration
+  {
+    const ActsGeometry* geometry = nullptr;
+
+    //! true if the TPC crossing and distortion corrections are applied
+    bool distortionCorrected = false;
+
+    //! distortion correction containers: module edge, static, average, fluctuation
+    std::array<const TpcDistortionCorrectionContainer*, 4> corrections = {{nullptr, nullptr, nullptr, nullptr}};
+
+    bool operator==(const Configuration& other) const
+    {
+      return geometry == other.geometry && distortionCorrected == other.distortionCorrected && corrections == other.corrections;
+    }
+  };
+
+  //! find the cache on the node tree, create it under the TRKR node if missing
+  static TrkrClusterGlobalPositionCache* getOrCreate(PHCompositeNode* topNode);
+
+  TrkrClusterGlobalPositionCache() = default;
+
+  ~TrkrClusterGlobalPositionCache() override = default;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  //! clear content, keep allocated memory
+  void Reset() override;
+
+  int isValid() const override { return m_filled; }
+
+  //! true if the cache holds the positions of clusters from this container and tracker, with this configuration
+  bool isFilledFor(const TrkrClusterContainer* clusters, TrkrDefs::TrkrId trkrid, const Configuration& configuration) const
+  {
+    return m_filled && clusters == m_clusters && trkrid == m_trkrid && configuration == m_configuration;
+  }
+
+  /**
+   * @brief fill positions of all clusters of one tracker
+   * @param getPosition callable with signature Acts::Vector3(TrkrDefs::cluskey, TrkrCluster*)
+   */
+  template <class GetPosition>
+  void fill(TrkrClusterContainer* clusters, TrkrDefs::TrkrId trkrid, const Configuration& configuration, GetPosition&& getPosition)
+  {
+    Reset();
+    if (!clusters)
+    {
+      return;
+    }
+    m_keys.reserve(clusters->size());
+    m_positions.reserve(clusters->size());
+    for (const auto& hitsetkey : clusters->getHitSetKeys(trkrid))
+    {
+      auto range = clusters->getClusters(hitsetkey);
+      for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+      {
+        if (!clusIter->second)
+        {
+          continue;
+        }
+        m_keys.push_back(clusIter->first);
+        m_positions.push_back(getPosition(clusIter->first, clusIter->second));
+      }
+    }
+    sort();
+    m_clusters = clusters;
+    m_trkrid = trkrid;
+    m_configuration = configuration;
+    m_filled = true;
+  }
+
+  //! number of stored clusters
+  std::size_t size() const { return m_keys.size(); }
+
+  //! position of key in the arrays, size() if not found
+  std::size_t index(TrkrDefs::cluskey key) const
+  {
+    const auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+    return (iter != m_keys.end() && *iter == key) ? std::size_t(iter - m_keys.begin()) : m_keys.size();
+  }
+
+  //! true if key is stored
+  bool contains(TrkrDefs::cluskey key) const { return index(key) < m_keys.size(); }
+
+  //! global position of a cluster. Throws std::out_of_range if missing, as std::map::at
+  const Acts::Vector3& at(TrkrDefs::cluskey key) const;
+
+  //! cluster key at a given index
+  TrkrDefs::cluskey key(index_type i) const { return m_keys[i]; }
+
+  //! global position at a given index, no bound check
+  const Acts::Vector3& position(index_type i) const { return m_positions[i]; }
+
+  //! sorted cluster keys
+  const std::vector<TrkrDefs::cluskey>& keys() const { return m_keys; }
+
+  //! positions, same ordering as keys()
+  const std::vector<Acts::Vector3>& positions() const { return m_positions; }
+
+ private:
+  //! sort keys and positions by key, if not already sorted
+  void sort();
+
+  std::vector<TrkrDefs::cluskey> m_keys;
+  std::vector<Acts::Vector3> m_positions;
+
+  const TrkrClusterContainer* m_clusters = nullptr;
+  TrkrDefs::TrkrId m_trkrid = TrkrDefs::TrkrId::tpcId;
+  Configuration m_configuration;
+  bool m_filled = false;
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
@@ -0,0 +1,199 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+#include "TrkrHit.h"
+
+#include <algorithm>
+#include <cstdlib>  // for exit
+#include <functional>
+#include <iostream>
+
+void TrkrHitSetv2::Clear(Option_t* /*option*/)
+{
+  // the hitset key is kept, the hitset is reused in the next event
+  clearHits();
+  m_pending.clear();
+
+  // keep the largest pool for the next event
+  if (m_pools.size() > 1)
+  {
+    auto largest = std::max_element(m_pools.begin(), m_pools.end(),
+                                    [](const auto& lhs, const auto& rhs)
+                                    { return lhs.capacity() < rhs.capacity(); });
+    std::swap(*largest, m_pools.front());
+    m_pools.resize(1);
+  }
+  if (!m_pools.empty())
+  {
+    m_pools.front().clear();
+  }
+}
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+  clearHits();
+  m_pending.clear();
+  m_pools.clear();
+}
+
+void TrkrHitSetv2::clearHits()
+{
+  for (auto&& [key, hit] : m_hits)
+  {
+    if (!isPooled(hit))
+    {
+      delete hit;
+    }
+  }
+
+  m_hits.clear();
+}
+
+bool TrkrHitSetv2::isPooled(const TrkrHit* hit) const
+{
+  const std::less<const TrkrHit*> less;
+  for (const auto& pool : m_pools)
+  {
+    if (pool.empty())
+    {
+      continue;
+    }
+    const TrkrHit* first = &pool.front();
+    const TrkrHit* last = &pool.back();
+    if (!less(hit, first) && !less(last, hit))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << m_hits.size()
+      << " pending: " << m_pending.size()
+      << std::endl;
+
+  for (const auto& entry : m_hits)
+  {
+    std::cout << " hitkey " << entry.first << std::endl;
+    (entry.second)->identify(os);
+  }
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  const auto it = m_hits.find(key);
+  if (it != m_hits.end())
+  {
+    // pooled hits are released with the pool
+    if (!isPooled(it->second))
+    {
+      delete it->second;
+    }
+    m_hits.erase(it);
+  }
+  else
+  {
+    identify();
+    std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  const auto ret = m_hits.insert(std::make_pair(key, hit));
+  if (!ret.second)
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  else
+  {
+    return ret.first;
+  }
+}
+
+void TrkrHitSetv2::finalize()
+{
+  if (m_pending.empty())
+  {
+    return;
+  }
+
+  // stable, so that the last appended adc of a key comes last
+  std::stable_sort(m_pending.begin(), m_pending.end(),
+                   [](const auto& lhs, const auto& rhs)
+                   { return lhs.first < rhs.first; });
+
+  // new hits go to a pool with enough spare capacity, so that it never reallocates
+  const size_t needed = m_pending.size();
+  if (m_pools.empty() || m_pools.back().capacity() - m_pools.back().size() < needed)
+  {
+    m_pools.emplace_back();
+    m_pools.back().reserve(needed);
+  }
+  auto& pool = m_pools.back();
+
+  // merge the sorted hits into the map, the hint makes every insertion constant time
+  auto hint = m_hits.begin();
+  for (size_t i = 0; i < m_pending.size(); ++i)
+  {
+    const auto& [key, adc] = m_pending[i];
+    if (i + 1 < m_pending.size() && m_pending[i + 1].first == key)
+    {
+      continue;
+    }
+
+    while (hint != m_hits.end() && hint->first < key)
+    {
+      ++hint;
+    }
+
+    if (hint != m_hits.end() && hint->first == key)
+    {
+      hint->second->setAdc(adc);
+      continue;
+    }
+
+    pool.emplace_back();
+    pool.back().setAdc(adc);
+    hint = m_hits.emplace_hint(hint, key, &pool.back());
+    ++hint;
+  }
+
+  m_pending.clear();
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  TrkrHitSetv2::ConstIterator it = m_hits.find(key);
+
+  if (it != m_hits.end())
+  {
+    return it->second;
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  return std::make_pair(m_hits.cbegin(), m_hits.cend());
+}
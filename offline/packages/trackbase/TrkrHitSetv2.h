@@ -0,0 +1,110 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Container for storing TrkrHit's, with pooled hits and bulk insertion
+ */
+#include "TrkrDefs.h"
+#include "TrkrHitSet.h"
+#include "TrkrHitv2.h"
+
+#include <iostream>
+#include <map>
+#include <utility>  // for pair
+#include <vector>
+
+// forward declaration
+class TrkrHit;
+
+/**
+ * @brief TrkrHitSet with the same hit map as TrkrHitSetv1, filled in bulk
+ *
+ * Hits are kept in the same TrkrHitSet::Map as TrkrHitSetv1, so getHits()
+ * iterators, getHit() and the DST layout are unchanged, and
+ * addHitSpecificKey() keeps its ownership contract.
+ *
+ * Unpackers and digitizers can instead appendHit(key, adc) in any order and
+ * call finalize() once. finalize() sorts the appended hits, merges them into
+ * the map with hinted insertion (no tree search per hit) and constructs the
+ * TrkrHitv2 objects in one contiguous pool instead of one heap allocation
+ * per hit. Clear() keeps the largest pool allocated, so the hitset is reused
+ * without reallocating inside TrkrHitSetContainerv2.
+ */
+class TrkrHitSetv2 : public TrkrHitSet
+{
+ public:
+  TrkrHitSetv2() = default;
+
+  ~TrkrHitSetv2() override
+  {
+    TrkrHitSetv2::Reset();
+  }
+
+  //! used by TrkrHitSetContainerv2 to recycle the hitset, keeps the hit pool allocated
+  void Clear(Option_t* /*option*/ = "") override;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void Reset() override;
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+
+  ConstRange getHits() const override;
+
+  unsigned int size() const override
+  {
+    return m_hits.size();
+  }
+
+  /**
+   * @brief queue a hit for bulk insertion, in any order
+   *
+   * The hit is only visible after finalize(). If the same key is appended
+   * more than once, or is already in the hitset, the last adc wins.
+   */
+  void appendHit(const TrkrDefs::hitkey key, const unsigned int adc)
+  {
+    m_pending.emplace_back(key, adc);
+  }
+
+  //! move all appended hits into the hitset
+  void finalize();
+
+ private:
+  //! true if the hit lives in one of the pools, rather than on the heap
+  bool isPooled(const TrkrHit*) const;
+
+  //! delete heap allocated hits and drop all hits from the map
+  void clearHits();
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// storage for TrkrHit objects
+  Map m_hits;
+
+  /// hits appended since the last finalize()
+  std::vector<std::pair<TrkrDefs::hitkey, unsigned int>> m_pending;  //!
+
+  /// hits created by finalize(). A pool is never grown past its capacity so pointers stay valid
+  std::vector<std::vector<TrkrHitv2>> m_pools;  //!
+
+  ClassDefOverride(TrkrHitSetv2, 1);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
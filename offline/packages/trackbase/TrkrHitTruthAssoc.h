@@ -73,6 +73,15 @@ class TrkrHitTruthAssoc : public PHObject
   {
   }
 
+  /**
+   * @brief Get all associations of a hitset, in one lookup
+   * @param[in] hset TrkrHitSet key
+   */
+  virtual ConstRange getG4HitRange(const TrkrDefs::hitsetkey /*hitsetkey*/) const
+  {
+    return ConstRange();
+  }
+
  protected:
   //! ctor
   TrkrHitTruthAssoc() = default;
@@ -37,6 +37,8 @@ class TrkrHitTruthAssocv1 : public TrkrHitTruthAssoc
 
   void getG4Hits(const TrkrDefs::hitsetkey hitsetkey, const unsigned int hidx, MMap &temp_map) const override;
 
+  ConstRange getG4HitRange(const TrkrDefs::hitsetkey hitsetkey) const override { return m_map.equal_range(hitsetkey); }
+
  private:
   MMap m_map;
 
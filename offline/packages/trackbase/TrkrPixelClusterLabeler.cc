@@ -0,0 +1,132 @@
+/**
+ * @file trackbase/TrkrPixelClusterLabeler.cc
+ * @brief Implementation of TrkrPixelClusterLabeler
+ */
+#include "TrkrPixelClusterLabeler.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+unsigned int TrkrPixelClusterLabeler::find(unsigned int index)
+{
+  // path halving
+  while (m_parent[index] != index)
+  {
+    m_parent[index] = m_parent[m_parent[index]];
+    index = m_parent[index];
+  }
+  return index;
+}
+
+void TrkrPixelClusterLabeler::unite(unsigned int a, unsigned int b)
+{
+  a = find(a);
+  b = find(b);
+  if (a == b)
+  {
+    return;
+  }
+  // keep the lower index as root, so that trees stay shallow for hits filled in (col,row) order
+  if (b < a)
+  {
+    std::swap(a, b);
+  }
+  m_parent[b] = a;
+}
+
+unsigned int TrkrPixelClusterLabeler::label(const Adjacency& adjacency)
+{
+  const unsigned int nhits = m_cells.size();
+
+  m_order.resize(nhits);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  std::sort(m_order.begin(), m_order.end(), [this](unsigned int a, unsigned int b)
+            { return m_cells[a].col < m_cells[b].col || (m_cells[a].col == m_cells[b].col && m_cells[a].row < m_cells[b].row); });
+
+  m_parent.resize(nhits);
+  std::iota(m_parent.begin(), m_parent.end(), 0);
+
+  // sweep over the columns, [prevbegin, prevend) is the previous column in m_order
+  unsigned int prevbegin = 0;
+  unsigned int prevend = 0;
+  unsigned int begin = 0;
+  while (begin < nhits)
+  {
+    const int col = m_cells[m_order[begin]].col;
+    unsigned int end = begin + 1;
+    while (end < nhits && m_cells[m_order[end]].col == col)
+    {
+      ++end;
+    }
+
+    const bool has_prev = prevend > prevbegin && m_cells[m_order[prevbegin]].col == col - 1;
+    unsigned int iprev = prevbegin;
+    for (unsigned int i = begin; i < end; ++i)
+    {
+      const unsigned int index = m_order[i];
+      const int row = m_cells[index].row;
+
+      // same column, rows are sorted so only the previous hit can be a neighbour
+      if (i > begin)
+      {
+        const int prevrow = m_cells[m_order[i - 1]].row;
+        if (prevrow == row || (adjacency.row && prevrow == row - 1))
+        {
+          unite(index, m_order[i - 1]);
+        }
+      }
+
+      // previous column, rows row-1 to row+1
+      if (!has_prev)
+      {
+        continue;
+      }
+      while (iprev < prevend && m_cells[m_order[iprev]].row < row - 1)
+      {
+        ++iprev;
+      }
+      for (unsigned int j = iprev; j < prevend && m_cells[m_order[j]].row <= row + 1; ++j)
+      {
+        const int drow = m_cells[m_order[j]].row - row;
+        if ((drow == 0 && adjacency.col) ||
+            (drow == -1 && adjacency.diagonal) ||
+            (drow == 1 && adjacency.antidiagonal))
+        {
+          unite(index, m_order[j]);
+        }
+      }
+    }
+
+    prevbegin = begin;
+    prevend = end;
+    begin = end;
+  }
+
+  // number the clusters in order of their lowest hit index
+  static constexpr unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+  m_cluster.assign(nhits, unassigned);
+  m_offsets.assign(1, 0);
+  for (unsigned int index = 0; index < nhits; ++index)
+  {
+    const unsigned int root = find(index);
+    if (m_cluster[root] == unassigned)
+    {
+      m_cluster[root] = m_offsets.size() - 1;
+      m_offsets.push_back(0);
+    }
+    m_cluster[index] = m_cluster[root];
+    ++m_offsets[m_cluster[index] + 1];
+  }
+
+  // group hit indices by cluster, keeping the index order
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+  m_hits.resize(nhits);
+  m_order.assign(m_offsets.begin(), m_offsets.end() - 1);
+  for (unsigned int index = 0; index < nhits; ++index)
+  {
+    m_hits[m_order[m_cluster[index]]++] = index;
+  }
+
+  return nClusters();
+}
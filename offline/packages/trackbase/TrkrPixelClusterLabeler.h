@@ -0,0 +1,96 @@
+#ifndef TRACKBASE_TRKRPIXELCLUSTERLABELER_H
+#define TRACKBASE_TRKRPIXELCLUSTERLABELER_H
+
+/**
+ * @file trackbase/TrkrPixelClusterLabeler.h
+ * @brief connected component labelling of the pixels or strips of a single sensor
+ */
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Groups the hits of one sensor into clusters of adjacent (col,row) cells
+ *
+ * Hits are sorted by (col,row) and swept once, each hit is compared to the previous
+ * hit in its column and to the hits of the previous column within one row. This replaces
+ * the pairwise adjacency test on all hit pairs followed by boost::connected_components.
+ *
+ * The result is identical to the boost graph: cluster ids are numbered in order of the
+ * lowest hit index of each cluster and the hits of a cluster are listed in increasing
+ * index order. Hits with the same (col,row) are always in the same cluster.
+ *
+ * The object keeps its buffers between calls, use one labeler per thread.
+ */
+class TrkrPixelClusterLabeler
+{
+ public:
+  //! which neighbours of cell (col,row) are connected to it
+  struct Adjacency
+  {
+    //! (col, row+-1)
+    bool row{true};
+    //! (col+-1, row)
+    bool col{true};
+    //! (col+1, row+1) and (col-1, row-1)
+    bool diagonal{true};
+    //! (col+1, row-1) and (col-1, row+1)
+    bool antidiagonal{true};
+  };
+
+  using ConstIterator = std::vector<unsigned int>::const_iterator;
+  using ConstRange = std::pair<ConstIterator, ConstIterator>;
+
+  //! remove all hits, allocated memory is kept
+  void clear() { m_cells.clear(); }
+
+  void reserve(unsigned int size) { m_cells.reserve(size); }
+
+  //! add a hit, its index is the number of hits added before it
+  void addHit(int col, int row) { m_cells.push_back({col, row}); }
+
+  //! number of hits
+  unsigned int size() const { return m_cells.size(); }
+
+  //! do the clustering, returns the number of clusters
+  unsigned int label(const Adjacency& adjacency);
+
+  //! number of clusters found by the last call to label()
+  unsigned int nClusters() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+  //! cluster id of hit index
+  unsigned int getCluster(unsigned int index) const { return m_cluster[index]; }
+
+  //! hit indices of cluster clusid, in increasing order
+  ConstRange getHits(unsigned int clusid) const
+  {
+    return std::make_pair(m_hits.begin() + m_offsets[clusid], m_hits.begin() + m_offsets[clusid + 1]);
+  }
+
+ private:
+  struct Cell
+  {
+    int col;
+    int row;
+  };
+
+  unsigned int find(unsigned int index);
+  void unite(unsigned int a, unsigned int b);
+
+  std::vector<Cell> m_cells;
+
+  //! hit indices sorted by (col,row)
+  std::vector<unsigned int> m_order;
+
+  //! union find forest, on hit indices
+  std::vector<unsigned int> m_parent;
+
+  //! cluster id per hit index
+  std::vector<unsigned int> m_cluster;
+
+  //! hit indices grouped by cluster, cluster i is [m_offsets[i], m_offsets[i+1])
+  std::vector<unsigned int> m_offsets;
+  std::vector<unsigned int> m_hits;
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include "TrackSeed.h"
 
 #include <trackbase/TrackFitUtils.h>
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
 
 namespace
 {
@@ -49,52 +50,175 @@ namespace
     return {x, y};
   }
 
-}
+  //! position of a cluster, nullptr if missing
+  const Acts::Vector3* find_position(const TrackSeedHelper::position_map_t& positions, TrkrDefs::cluskey key)
+  {
+    const auto iter = positions.find(key);
+    return iter == positions.end() ? nullptr : &iter->second;
+  }
 
-//____________________________________________________________________________________
-float TrackSeedHelper::get_phi(TrackSeed const* seed, const TrackSeedHelper::position_map_t& positions)
-{
-  const auto X0 = seed->get_X0();
-  const auto Y0 = seed->get_Y0();
-  const auto [x, y] = findRoot(seed);
+  //! position of a cluster, nullptr if missing
+  const Acts::Vector3* find_position(const TrkrClusterGlobalPositionCache& positions, TrkrDefs::cluskey key)
+  {
+    const auto index = positions.index(key);
+    return index == positions.size() ? nullptr : &positions.position(static_cast<TrkrClusterGlobalPositionCache::index_type>(index));
+  }
 
-  // This is the angle of the tangent to the circle
-  // The argument is the slope of the tangent (inverse of slope of radial line at tangent)
-  float phi = std::atan2(-1 * (X0 - x), (Y0 - y));
-  Acts::Vector3 pos0 = positions.find(*(seed->begin_cluster_keys()))->second;
-  Acts::Vector3 pos1 = positions.find(*std::next(seed->begin_cluster_keys()))->second;
-
-  // we need to know if the track proceeds clockwise or CCW around the circle
-  double dx0 = pos0(0) - X0;
-  double dy0 = pos0(1) - Y0;
-  double phi0 = std::atan2(dy0, dx0);
-  double dx1 = pos1(0) - X0;
-  double dy1 = pos1(1) - Y0;
-  double phi1 = std::atan2(dy1, dx1);
-  double dphi = phi1 - phi0;
-
-  // need to deal with the switch from -pi to +pi at phi = 180 degrees
-  // final phi - initial phi must be < 180 degrees for it to be a valid track
-  if (dphi > M_PI)
+  template <class PositionStore>
+  float get_phi_impl(TrackSeed const* seed, const PositionStore& positions)
   {
-    dphi -= 2.0 * M_PI;
+    const auto X0 = seed->get_X0();
+    const auto Y0 = seed->get_Y0();
+    const auto [x, y] = findRoot(seed);
+
+    // This is the angle of the tangent to the circle
+    // The argument is the slope of the tangent (inverse of slope of radial line at tangent)
+    float phi = std::atan2(-1 * (X0 - x), (Y0 - y));
+    Acts::Vector3 pos0 = *find_position(positions, *(seed->begin_cluster_keys()));
+    Acts::Vector3 pos1 = *find_position(positions, *std::next(seed->begin_cluster_keys()));
+
+    // we need to know if the track proceeds clockwise or CCW around the circle
+    double dx0 = pos0(0) - X0;
+    double dy0 = pos0(1) - Y0;
+    double phi0 = std::atan2(dy0, dx0);
+    double dx1 = pos1(0) - X0;
+    double dy1 = pos1(1) - Y0;
+    double phi1 = std::atan2(dy1, dx1);
+    double dphi = phi1 - phi0;
+
+    // need to deal with the switch from -pi to +pi at phi = 180 degrees
+    // final phi - initial phi must be < 180 degrees for it to be a valid track
+    if (dphi > M_PI)
+    {
+      dphi -= 2.0 * M_PI;
+    }
+    if (dphi < -M_PI)
+    {
+      dphi += M_PI;
+    }
+
+    // whether we add 180 degrees depends on the angle of the bend
+    if (dphi < 0)
+    {
+      phi += M_PI;
+      if (phi > M_PI)
+      {
+        phi -= 2. * M_PI;
+      }
+    }
+
+    return phi;
   }
-  if (dphi < -M_PI)
+
+  template <class PositionStore>
+  void circleFitByTaubin_impl(TrackSeed* seed, const PositionStore& positions, uint8_t startLayer, uint8_t endLayer)
   {
-    dphi += M_PI;
+    TrackFitUtils::position_vector_t positions_2d;
+    for( auto key_iter = seed->begin_cluster_keys(); key_iter != seed->end_cluster_keys(); ++key_iter )
+    {
+      const auto& key(*key_iter);
+      const auto layer = TrkrDefs::getLayer(key);
+      if (layer < startLayer or layer > endLayer)
+      {
+        continue;
+      }
+
+      const auto pos_ptr = find_position(positions, key);
+
+      /// you supplied the wrong key...
+      if (!pos_ptr)
+      {
+        continue;
+      }
+
+      // add to 2d position list
+      const Acts::Vector3& pos = *pos_ptr;
+      positions_2d.emplace_back(pos.x(), pos.y());
+    }
+
+    // cannot fit if there is less than 3 positions
+    if( positions_2d.size() < 3 ) { return; }
+
+    // do the fit
+    const auto [r, x0, y0] = TrackFitUtils::circle_fit_by_taubin(positions_2d);
+    float qOverR = 1./r;
+
+    /// Set the charge
+    const auto& firstpos = positions_2d.at(0);
+    const auto& secondpos = positions_2d.at(1);
+
+    const auto firstphi = atan2(firstpos.second, firstpos.first);
+    const auto secondphi = atan2(secondpos.second, secondpos.first);
+    auto dphi = secondphi - firstphi;
+    if (dphi > M_PI)
+    {
+      dphi = 2.*M_PI-dphi;
+    }
+
+    if (dphi < -M_PI)
+    {
+      dphi = 2*M_PI + dphi;
+    }
+    if (dphi > 0)
+    {
+      qOverR *= -1;
+    }
+
+    // assign
+    seed->set_X0(x0);
+    seed->set_Y0(y0);
+    seed->set_qOverR(qOverR);
   }
 
-  // whether we add 180 degrees depends on the angle of the bend
-  if (dphi < 0)
+  template <class PositionStore>
+  void lineFit_impl(TrackSeed* seed, const PositionStore& positions, uint8_t startLayer, uint8_t endLayer)
   {
-    phi += M_PI;
-    if (phi > M_PI)
+    TrackFitUtils::position_vector_t positions_2d;
+    for( auto key_iter = seed->begin_cluster_keys(); key_iter != seed->end_cluster_keys(); ++key_iter )
     {
-      phi -= 2. * M_PI;
+      const auto& key(*key_iter);
+      const auto layer = TrkrDefs::getLayer(key);
+      if (layer < startLayer or layer > endLayer)
+      {
+        continue;
+      }
+
+      const auto pos_ptr = find_position(positions, key);
+
+      /// The wrong key was supplied...
+      if (!pos_ptr)
+      {
+        continue;
+      }
+
+      // store (r,z)
+      const Acts::Vector3& pos = *pos_ptr;
+      positions_2d.emplace_back(std::sqrt(square(pos.x()) + square(pos.y())), pos.z());
     }
+
+    // cannot fit if there is less than 2 positions
+    if( positions_2d.size() < 2 ) { return; }
+
+    // do the fit
+    const auto [slope, intercept] = TrackFitUtils::line_fit(positions_2d);
+
+    // assign
+    seed->set_slope(slope);
+    seed->set_Z0(intercept);
   }
 
-  return phi;
+}
+
+//____________________________________________________________________________________
+float TrackSeedHelper::get_phi(TrackSeed const* seed, const TrackSeedHelper::position_map_t& positions)
+{
+  return get_phi_impl(seed, positions);
+}
+
+//____________________________________________________________________________________
+float TrackSeedHelper::get_phi(TrackSeed const* seed, const TrkrClusterGlobalPositionCache& positions)
+{
+  return get_phi_impl(seed, positions);
 }
 
 //____________________________________________________________________________________
@@ -111,61 +235,17 @@ void TrackSeedHelper::circleFitByTaubin(
   uint8_t startLayer,
   uint8_t endLayer)
 {
-  TrackFitUtils::position_vector_t positions_2d;
-  for( auto key_iter = seed->begin_cluster_keys(); key_iter != seed->end_cluster_keys(); ++key_iter )
-  {
-    const auto& key(*key_iter);
-    const auto layer = TrkrDefs::getLayer(key);
-    if (layer < startLayer or layer > endLayer)
-    {
-      continue;
-    }
-
-    const auto iter = positions.find(key);
-
-    /// you supplied the wrong key...
-    if (iter == positions.end())
-    {
-      continue;
-    }
-
-    // add to 2d position list
-    const Acts::Vector3& pos = iter->second;
-    positions_2d.emplace_back(pos.x(), pos.y());
-  }
-
-  // cannot fit if there is less than 3 positions
-  if( positions_2d.size() < 3 ) { return; }
-
-  // do the fit
-  const auto [r, x0, y0] = TrackFitUtils::circle_fit_by_taubin(positions_2d);
-  float qOverR = 1./r;
-
-  /// Set the charge
-  const auto& firstpos = positions_2d.at(0);
-  const auto& secondpos = positions_2d.at(1);
-
-  const auto firstphi = atan2(firstpos.second, firstpos.first);
-  const auto secondphi = atan2(secondpos.second, secondpos.first);
-  auto dphi = secondphi - firstphi;
-  if (dphi > M_PI)
-  {
-    dphi = 2.*M_PI-dphi;
-  }
-
-  if (dphi < -M_PI)
-  {
-    dphi = 2*M_PI + dphi;
-  }
-  if (dphi > 0)
-  {
-    qOverR *= -1;
-  }
+  circleFitByTaubin_impl(seed, positions, startLayer, endLayer);
+}
 
-  // assign
-  seed->set_X0(x0);
-  seed->set_Y0(y0);
-  seed->set_qOverR(qOverR);
+//____________________________________________________________________________________
+void TrackSeedHelper::circleFitByTaubin(
+  TrackSeed* seed,
+  const TrkrClusterGlobalPositionCache& positions,
+  uint8_t startLayer,
+  uint8_t endLayer)
+{
+  circleFitByTaubin_impl(seed, positions, startLayer, endLayer);
 }
 
 //____________________________________________________________________________________
@@ -175,38 +255,17 @@ void TrackSeedHelper::lineFit(
   uint8_t startLayer,
   uint8_t endLayer)
 {
-  TrackFitUtils::position_vector_t positions_2d;
-  for( auto key_iter = seed->begin_cluster_keys(); key_iter != seed->end_cluster_keys(); ++key_iter )
-  {
-    const auto& key(*key_iter);
-    const auto layer = TrkrDefs::getLayer(key);
-    if (layer < startLayer or layer > endLayer)
-    {
-      continue;
-    }
-
-    const auto iter = positions.find(key);
-
-    /// The wrong key was supplied...
-    if (iter == positions.end())
-    {
-      continue;
-    }
-
-    // store (r,z)
-    const Acts::Vector3& pos = iter->second;
-    positions_2d.emplace_back(std::sqrt(square(pos.x()) + square(pos.y())), pos.z());
-  }
-
-  // cannot fit if there is less than 2 positions
-  if( positions_2d.size() < 2 ) { return; }
-
-  // do the fit
-  const auto [slope, intercept] = TrackFitUtils::line_fit(positions_2d);
+  lineFit_impl(seed, positions, startLayer, endLayer);
+}
 
-  // assign
-  seed->set_slope(slope);
-  seed->set_Z0(intercept);
+//____________________________________________________________________________________
+void TrackSeedHelper::lineFit(
+  TrackSeed* seed,
+  const TrkrClusterGlobalPositionCache& positions,
+  uint8_t startLayer,
+  uint8_t endLayer)
+{
+  lineFit_impl(seed, positions, startLayer, endLayer);
 }
 
 //____________________________________________________________________________________
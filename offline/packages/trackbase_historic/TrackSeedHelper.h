@@ -14,6 +14,7 @@
 #include <map>
 
 class TrackSeed;
+class TrkrClusterGlobalPositionCache;
 
 namespace TrackSeedHelper
 {
@@ -32,6 +33,19 @@ namespace TrackSeedHelper
     uint8_t startLayer = 0,
     uint8_t endLayer = 58);
 
+  //! same as above, reading positions from the per event cluster position cache
+  float get_phi(TrackSeed const*, const TrkrClusterGlobalPositionCache&);
+
+  void circleFitByTaubin(
+    TrackSeed*, const TrkrClusterGlobalPositionCache& positions,
+    uint8_t startLayer = 0,
+    uint8_t endLayer = 58);
+
+  void lineFit(
+    TrackSeed*, const TrkrClusterGlobalPositionCache& positions,
+    uint8_t startLayer = 0,
+    uint8_t endLayer = 58);
+
   float get_x(TrackSeed const*);
   float get_y(TrackSeed const*);
   float get_z(TrackSeed const*);
@@ -6,6 +6,7 @@
 #include <trackbase/ClusterErrorPara.h>
 #include <trackbase/TrackFitUtils.h>
 #include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
 #include <trackbase_historic/ActsTransformations.h>
 
 #include <Geant4/G4SystemOfUnits.hh>
@@ -217,7 +218,8 @@ bool ALICEKF::TransportAndRotate(double old_radius, double new_radius, double& p
   return true;
 }
 
-bool ALICEKF::FilterStep(TrkrDefs::cluskey ckey, keylist& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const
+template <class PositionStore>
+bool ALICEKF::FilterStep(TrkrDefs::cluskey ckey, keylist& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionStore& globalPositions) const
 {
   // give up if position vector has NaN for any component
   if (std::isnan(kftrack.GetX()) ||
@@ -445,7 +447,8 @@ bool ALICEKF::FilterStep(TrkrDefs::cluskey ckey, keylist& keys, double& current_
   return true;
 }
 
-TrackSeedAliceSeedMap ALICEKF::ALICEKalmanFilter(const std::vector<keylist>& trackSeedKeyLists, bool use_nhits_limit, const PositionMap& globalPositions, std::vector<float>& trackChi2) const
+template <class PositionStore>
+TrackSeedAliceSeedMap ALICEKF::ALICEKalmanFilter(const std::vector<keylist>& trackSeedKeyLists, bool use_nhits_limit, const PositionStore& globalPositions, std::vector<float>& trackChi2) const
 {
   //  TFile* f = new TFile("/sphenix/u/mjpeters/macros_hybrid/detectors/sPHENIX/pull.root", "RECREATE");
   //  TNtuple* ntp = new TNtuple("pull","pull","cx:cy:cz:xerr:yerr:zerr:tx:ty:tz:layer:xsize:ysize:phisize:phierr:zsize");
@@ -942,6 +945,12 @@ TrackSeedAliceSeedMap ALICEKF::ALICEKalmanFilter(const std::vector<keylist>& tra
   return std::make_pair(seeds_vector, alice_seeds_vector);
 }
 
+// explicit instantiations, for the per seed position maps and for the shared per event cache
+template bool ALICEKF::FilterStep<PositionMap>(TrkrDefs::cluskey, keylist&, double&, GPUTPCTrackParam&, GPUTPCTrackParam::GPUTPCTrackFitParam&, const PositionMap&) const;
+template bool ALICEKF::FilterStep<TrkrClusterGlobalPositionCache>(TrkrDefs::cluskey, keylist&, double&, GPUTPCTrackParam&, GPUTPCTrackParam::GPUTPCTrackFitParam&, const TrkrClusterGlobalPositionCache&) const;
+template TrackSeedAliceSeedMap ALICEKF::ALICEKalmanFilter<PositionMap>(const std::vector<keylist>&, bool, const PositionMap&, std::vector<float>&) const;
+template TrackSeedAliceSeedMap ALICEKF::ALICEKalmanFilter<TrkrClusterGlobalPositionCache>(const std::vector<keylist>&, bool, const TrkrClusterGlobalPositionCache&, std::vector<float>&) const;
+
 bool ALICEKF::covIsPosDef(Eigen::Matrix<double, 6, 6>& cov) const
 {
   // attempt Cholesky decomposition
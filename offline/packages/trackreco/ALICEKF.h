@@ -57,9 +57,14 @@ class ALICEKF
   void setIsobutaneFraction(double frac) { isobutane_frac = frac; };
 
   bool TransportAndRotate(double old_radius, double new_radius, double& phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp) const;
-  bool FilterStep(TrkrDefs::cluskey ckey, std::vector<TrkrDefs::cluskey>& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const;
 
-  TrackSeedAliceSeedMap ALICEKalmanFilter(const std::vector<std::vector<TrkrDefs::cluskey>>& chains, bool use_nhits_limit, const PositionMap& globalPositions, std::vector<float>& trackChi2) const;
+  // globalPositions is either a PositionMap or the per event TrkrClusterGlobalPositionCache,
+  // anything with an at(cluskey) returning the cluster global position. Instantiated in ALICEKF.cc for both
+  template <class PositionStore>
+  bool FilterStep(TrkrDefs::cluskey ckey, std::vector<TrkrDefs::cluskey>& keys, double& current_phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionStore& globalPositions) const;
+
+  template <class PositionStore>
+  TrackSeedAliceSeedMap ALICEKalmanFilter(const std::vector<std::vector<TrkrDefs::cluskey>>& chains, bool use_nhits_limit, const PositionStore& globalPositions, std::vector<float>& trackChi2) const;
   bool covIsPosDef(Eigen::Matrix<double, 6, 6>& cov) const;
   void repairCovariance(Eigen::Matrix<double, 6, 6>& cov) const;
   bool checknan(double val, const std::string& msg, int num) const;
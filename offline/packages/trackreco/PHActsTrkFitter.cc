@@ -54,9 +54,12 @@
 #include <Acts/TrackFitting/GainMatrixSmoother.hpp>
 #include <Acts/TrackFitting/GainMatrixUpdater.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <filesystem>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 namespace
@@ -281,96 +284,158 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
 {
   auto logger = Acts::getDefaultLogger("PHActsTrkFitter", logLevel);
 
+  // seeds, in seed map order
+  std::vector<TrackSeed*> seeds;
+  seeds.reserve(m_seedMap->size());
   for (auto track : *m_seedMap)
   {
-    if (!track)
+    if (track)
     {
-      continue;
+      seeds.push_back(track);
     }
+  }
 
-    unsigned int tpcid = track->get_tpc_seed_index();
-    unsigned int siid = track->get_silicon_seed_index();
+  unsigned int nthreads = m_nthreads > 0 ? m_nthreads : std::max(1U, std::thread::hardware_concurrency());
+  if (nthreads > 1 && !m_use_clustermover)
+  {
+    // source links without the cluster mover modify the shared transient alignment map for each track
+    static bool once = true;
+    if (once)
+    {
+      once = false;
+      std::cout << PHWHERE << " multi-threaded fitting requires the cluster mover, fitting sequentially" << std::endl;
+    }
+    nthreads = 1;
+  }
+  nthreads = std::min<size_t>(nthreads, seeds.size());
 
-    // capture the input crossing value, and set crossing parameters
-    //==============================
-    short silicon_crossing =  SHRT_MAX;
-    auto siseed = m_siliconSeeds->get(siid);
-    if(siseed)
-      {
+  if (nthreads <= 1)
+  {
+    // fit and publish one seed at a time
+    for (auto* track : seeds)
+    {
+      SeedFit fit;
+      fitSeed(track, fit);
+      publishSeedFit(fit);
+    }
+    return;
+  }
+
+  // fit all seeds in parallel. Each fit only reads the shared geometry, clusters and seeds
+  // and writes to its own SeedFit, so results do not depend on the number of threads
+  std::vector<SeedFit> fits(seeds.size());
+  std::atomic<size_t> next(0);
+  auto worker = [&]()
+  {
+    for (size_t i = next++; i < seeds.size(); i = next++)
+    {
+      fitSeed(seeds[i], fits[i]);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  // publish in seed order, identical to the sequential case
+  for (auto& fit : fits)
+  {
+    publishSeedFit(fit);
+  }
+}
+
+void PHActsTrkFitter::fitSeed(TrackSeed* track, SeedFit& fit)
+{
+  fit.seed = track;
+
+  unsigned int tpcid = track->get_tpc_seed_index();
+  unsigned int siid = track->get_silicon_seed_index();
+
+  // capture the input crossing value, and set crossing parameters
+  //==============================
+  short silicon_crossing =  SHRT_MAX;
+  auto siseed = m_siliconSeeds->get(siid);
+  if(siseed)
+    {
 	silicon_crossing = siseed->get_crossing();
-      }
-    short crossing = silicon_crossing;
-    short int crossing_estimate = crossing;
+    }
+  short crossing = silicon_crossing;
+  short int crossing_estimate = crossing;
 
-    if(m_enable_crossing_estimate)
-      {
+  if(m_enable_crossing_estimate)
+    {
 	crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate from matcher
-     }
-    //===============================
+   }
+  //===============================
 
 
-    // must have silicon seed with valid crossing if we are doing a SC calibration fit
-    if (m_fitSiliconMMs)
-      {
+  // must have silicon seed with valid crossing if we are doing a SC calibration fit
+  if (m_fitSiliconMMs)
+    {
 	if( (siid == std::numeric_limits<unsigned int>::max()) || (silicon_crossing == SHRT_MAX))
 	  {
-	    continue;
+	    return;
 	  }
-      }
+    }
 
-    // do not skip TPC only tracks, just set crossing to the nominal zero
-    if(!siseed)
-      {
+  // do not skip TPC only tracks, just set crossing to the nominal zero
+  if(!siseed)
+    {
 	crossing = 0;
-      }
+    }
 
-    if (Verbosity() > 1)
-    {
-      if(siseed)
+  if (Verbosity() > 1)
+  {
+    if(siseed)
 	{
 	  std::cout << "tpc and si id " << tpcid << ", " << siid << " silicon_crossing " << silicon_crossing
 		    << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
 	}
-    }
+  }
 
-    auto tpcseed = m_tpcSeeds->get(tpcid);
+  auto tpcseed = m_tpcSeeds->get(tpcid);
 
-    /// Need to also check that the tpc seed wasn't removed by the ghost finder
-    if (!tpcseed)
-    {
-      std::cout << "no tpc seed" << std::endl;
-      continue;
-    }
+  /// Need to also check that the tpc seed wasn't removed by the ghost finder
+  if (!tpcseed)
+  {
+    std::cout << "no tpc seed" << std::endl;
+    return;
+  }
 
-    if (Verbosity() > 0)
+  if (Verbosity() > 0)
+  {
+    if (siseed)
     {
-      if (siseed)
-      {
-        const auto si_position = TrackSeedHelper::get_xyz(siseed);
-        const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
-        std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
-        std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
-      }
+      const auto si_position = TrackSeedHelper::get_xyz(siseed);
+      const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
+      std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
+      std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
     }
+  }
 
-    PHTimer trackTimer("TrackTimer");
-    trackTimer.stop();
-    trackTimer.restart();
+  PHTimer trackTimer("TrackTimer");
+  trackTimer.stop();
+  trackTimer.restart();
 
-    if (Verbosity() > 1 && siseed)
-    {
-      std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
-        << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
-    }
+  if (Verbosity() > 1 && siseed)
+  {
+    std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
+      << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
+  }
 
-    short int this_crossing = crossing;
-    bool use_estimate = false;
-    short int nvary = 0;
-    std::vector<float> chisq_ndf;
-    std::vector<SvtxTrack_v4> svtx_vec;
+  short int this_crossing = crossing;
+  bool use_estimate = false;
+  short int nvary = 0;
 
-    if(m_pp_mode)
-      {
+  if(m_pp_mode)
+    {
 	if (m_enable_crossing_estimate && crossing == SHRT_MAX)
 	  {
 	    // this only happens if there is a silicon seed but no assigned INTT crossing, and only in pp_mode
@@ -387,92 +452,91 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
 	    // use INTT crossing
 	    crossing_estimate = crossing;
 	  }
-      }
-    else
-      {
+    }
+  else
+    {
 	// non pp mode, we want only crossing zero, veto others
 	if(siseed && silicon_crossing != 0)
 	  {
-	    continue;
+	    return;
 	  }
 	crossing_estimate = crossing;
-      }
+    }
 
-    // Fit this track assuming either:
-    //    crossing = INTT value, if it exists (uses nvary = 0)
-    //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
+  // Fit this track assuming either:
+  //    crossing = INTT value, if it exists (uses nvary = 0)
+  //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
 
-    for (short int ivary = -nvary; ivary <= nvary; ++ivary)
-    {
-      this_crossing = crossing_estimate + ivary;
+  fit.tpcid = tpcid;
+  fit.siid = siid;
+  fit.use_estimate = use_estimate;
+  fit.nvary = nvary;
+  fit.trials.reserve(2 * nvary + 1);
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
-      }
+  for (short int ivary = -nvary; ivary <= nvary; ++ivary)
+  {
+    this_crossing = crossing_estimate + ivary;
 
-      ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    fit.trials.emplace_back();
+    TrialFit& trial = fit.trials.back();
+    trial.ivary = ivary;
+    trial.crossing = this_crossing;
 
-      SourceLinkVec sourceLinks;
+    if (Verbosity() > 1)
+    {
+      std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
+    }
 
-      MakeSourceLinks makeSourceLinks;
-      makeSourceLinks.initialize(_tpccellgeo);
-      makeSourceLinks.setVerbosity(Verbosity());
-      makeSourceLinks.set_pp_mode(m_pp_mode);
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
 
-      // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-      // does nothing if m_transient_id_set is empty
-      makeSourceLinks.resetTransientTransformMap(
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        m_tGeometry);
+    SourceLinkVec sourceLinks;
 
-      // make source links using cluster mover
-      if (m_use_clustermover)
-      {
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-            siseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            this_crossing);
-        }
+    MakeSourceLinks makeSourceLinks;
+    makeSourceLinks.initialize(_tpccellgeo);
+    makeSourceLinks.setVerbosity(Verbosity());
+    makeSourceLinks.set_pp_mode(m_pp_mode);
 
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-          tpcseed,
+    // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+    // does nothing if m_transient_id_set is empty
+    makeSourceLinks.resetTransientTransformMap(
+      m_alignmentTransformationMapTransient,
+      m_transient_id_set,
+      m_tGeometry);
+
+    // make source links using cluster mover
+    if (m_use_clustermover)
+    {
+      if (siseed && !m_ignoreSilicon)
+      {
+        // silicon source links
+        sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+          siseed,
           measurements,
           m_clusterContainer,
           m_tGeometry,
           m_globalPositionWrapper,
           this_crossing);
-
-        // add silicon seeds
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
-      else
-      {
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinks(
-            siseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            m_alignmentTransformationMapTransient,
-            m_transient_id_set,
-            this_crossing);
-        }
 
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
-          tpcseed,
+      // tpc source links
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+        tpcseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        this_crossing);
+
+      // add silicon seeds
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+    }
+    else
+    {
+      if (siseed && !m_ignoreSilicon)
+      {
+        // silicon source links
+        sourceLinks = makeSourceLinks.getSourceLinks(
+          siseed,
           measurements,
           m_clusterContainer,
           m_tGeometry,
@@ -480,277 +544,316 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
           m_alignmentTransformationMapTransient,
           m_transient_id_set,
           this_crossing);
-
-        // insert silicons
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
 
-      // copy transient map for this track into transient geoContext
-      m_transient_geocontext = m_alignmentTransformationMapTransient;
+      // tpc source links
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
+        tpcseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        m_alignmentTransformationMapTransient,
+        m_transient_id_set,
+        this_crossing);
 
-      // position comes from the silicon seed, unless there is no silicon seed
-      Acts::Vector3 position(0, 0, 0);
-      if (siseed)
-      {
-        position = TrackSeedHelper::get_xyz(siseed)*Acts::UnitConstants::cm;
-      }
-      if(!siseed || !is_valid(position) || m_ignoreSilicon)
+      // insert silicons
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+    }
+
+    // copy transient map for this track into transient geoContext
+    Acts::GeometryContext geocontext;
+    geocontext = m_alignmentTransformationMapTransient;
+
+    // position comes from the silicon seed, unless there is no silicon seed
+    Acts::Vector3 position(0, 0, 0);
+    if (siseed)
+    {
+      position = TrackSeedHelper::get_xyz(siseed)*Acts::UnitConstants::cm;
+    }
+    if(!siseed || !is_valid(position) || m_ignoreSilicon)
+    {
+      position = TrackSeedHelper::get_xyz(tpcseed)*Acts::UnitConstants::cm;
+    }
+    if (!is_valid(position))
+    {
+     if(Verbosity() > 4)
       {
-        position = TrackSeedHelper::get_xyz(tpcseed)*Acts::UnitConstants::cm;
+        std::cout << "Invalid position of " << position.transpose() << std::endl;
       }
-      if (!is_valid(position))
+      continue;
+    }
+
+    if (sourceLinks.empty())
+    {
+      continue;
+    }
+
+    /// If using directed navigation, collect surface list to navigate
+    SurfacePtrVec surfaces;
+    if (m_fitSiliconMMs)
+    {
+      sourceLinks = getSurfaceVector(sourceLinks, surfaces);
+
+      // skip if there is no surfaces
+      if (surfaces.empty())
       {
-       if(Verbosity() > 4)
-        {
-          std::cout << "Invalid position of " << position.transpose() << std::endl;
-        }
         continue;
       }
 
-      if (sourceLinks.empty())
+      // make sure micromegas are in the tracks, if required
+      if (m_useMicromegas &&
+          std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
+                       { return m_tGeometry->maps().isMicromegasSurface(surface); }))
       {
         continue;
       }
+    }
+
+    float px = std::numeric_limits<float>::quiet_NaN();
+    float py = std::numeric_limits<float>::quiet_NaN();
+    float pz = std::numeric_limits<float>::quiet_NaN();
+    if (m_ConstField)
+    {
+      float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
+      float phi = tpcseed->get_phi();
+      px = pt * std::cos(phi);
+      py = pt * std::sin(phi);
+      pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
+    }
+    else
+    {
+      px = tpcseed->get_px();
+      py = tpcseed->get_py();
+      pz = tpcseed->get_pz();
+    }
 
-      /// If using directed navigation, collect surface list to navigate
-      SurfacePtrVec surfaces;
-      if (m_fitSiliconMMs)
+    Acts::Vector3 momentum(px, py, pz);
+    if (!is_valid(momentum))
+    {
+      if(Verbosity() > 4)
       {
-        sourceLinks = getSurfaceVector(sourceLinks, surfaces);
+        std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
+      }
+      continue;
+    }
 
-        // skip if there is no surfaces
-        if (surfaces.empty())
-        {
-          continue;
-        }
+    auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
+        position);
 
-        // make sure micromegas are in the tracks, if required
-        if (m_useMicromegas &&
-            std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
-                         { return m_tGeometry->maps().isMicromegasSurface(surface); }))
-        {
-          continue;
-        }
-      }
+    auto actsFourPos = Acts::Vector4(position(0), position(1),
+                                     position(2),
+                                     10 * Acts::UnitConstants::ns);
+    Acts::BoundSquareMatrix cov = setDefaultCovariance();
 
-      float px = std::numeric_limits<float>::quiet_NaN();
-      float py = std::numeric_limits<float>::quiet_NaN();
-      float pz = std::numeric_limits<float>::quiet_NaN();
-      if (m_ConstField)
-      {
-        float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
-        float phi = tpcseed->get_phi();
-        px = pt * std::cos(phi);
-        py = pt * std::sin(phi);
-        pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
-      }
-      else
-      {
-        px = tpcseed->get_px();
-        py = tpcseed->get_py();
-        pz = tpcseed->get_pz();
-      }
+    int charge = tpcseed->get_charge();
 
-      Acts::Vector3 momentum(px, py, pz);
-      if (!is_valid(momentum))
-      {
-        if(Verbosity() > 4)
-        {
-          std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
-        }
-        continue;
-      }
+    /// Reset the track seed with the dummy covariance
+    auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
+                    pSurface,
+                    geocontext,
+                    actsFourPos,
+                    momentum,
+                    charge / momentum.norm(),
+                    cov,
+                    Acts::ParticleHypothesis::pion())
+                    .value();
+
+    if (Verbosity() > 2)
+    {
+      printTrackSeed(seed, geocontext);
+    }
 
-      auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
-          position);
+    /// Set host of propagator options for Acts to do e.g. material integration
+    Acts::PropagatorPlainOptions ppPlainOptions;
 
-      auto actsFourPos = Acts::Vector4(position(0), position(1),
-                                       position(2),
-                                       10 * Acts::UnitConstants::ns);
-      Acts::BoundSquareMatrix cov = setDefaultCovariance();
+    auto calibptr = std::make_unique<Calibrator>();
+    CalibratorAdapter calibrator{*calibptr, measurements};
 
-      int charge = tpcseed->get_charge();
+    auto magcontext = m_tGeometry->geometry().magFieldContext;
+    auto calibcontext = m_tGeometry->geometry().calibContext;
 
-      /// Reset the track seed with the dummy covariance
-      auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
-                      pSurface,
-                      m_transient_geocontext,
-                      actsFourPos,
-                      momentum,
-                      charge / momentum.norm(),
-                      cov,
-                      Acts::ParticleHypothesis::pion())
-                      .value();
+    ActsTrackFittingAlgorithm::GeneralFitterOptions
+        kfOptions{
+            geocontext,
+            magcontext,
+            calibcontext,
+            pSurface.get(),
+            ppPlainOptions};
 
-      if (Verbosity() > 2)
-      {
-        printTrackSeed(seed);
-      }
+    PHTimer fitTimer("FitTimer");
+    fitTimer.stop();
+    fitTimer.restart();
 
-      /// Set host of propagator options for Acts to do e.g. material integration
-      Acts::PropagatorPlainOptions ppPlainOptions;
+    auto trackContainer =
+        std::make_shared<Acts::VectorTrackContainer>();
+    auto trackStateContainer =
+        std::make_shared<Acts::VectorMultiTrajectory>();
+    ActsTrackFittingAlgorithm::TrackContainer
+        tracks(trackContainer, trackStateContainer);
 
-      auto calibptr = std::make_unique<Calibrator>();
-      CalibratorAdapter calibrator{*calibptr, measurements};
+    auto result = fitTrack(sourceLinks, seed, kfOptions,
+                           surfaces, calibrator, tracks);
+    fitTimer.stop();
+    auto fitTime = fitTimer.get_accumulated_time();
 
-      auto magcontext = m_tGeometry->geometry().magFieldContext;
-      auto calibcontext = m_tGeometry->geometry().calibContext;
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+    }
 
-      ActsTrackFittingAlgorithm::GeneralFitterOptions
-          kfOptions{
-              m_transient_geocontext,
-              magcontext,
-              calibcontext,
-              pSurface.get(),
-              ppPlainOptions};
+    /// Check that the track fit result did not return an error
+    /// the SvtxTrack is updated here, publishing it is done in publishSeedFit
+    trial.fitted = true;
+    if (result.ok())
+    {
+      trial.ok = true;
+      trial.track.set_tpc_seed(tpcseed);
+      trial.track.set_crossing(this_crossing);
+      trial.track.set_silicon_seed(siseed);
+      trial.hasTrack = getTrackFitResult(result, &trial.track, tracks, geocontext, trial);
+      trial.trackContainer = trackContainer;
+      trial.trackStateContainer = trackStateContainer;
+      trial.measurements = std::move(measurements);
+    }
+    else
+    {
+      trial.error = result.error();
+    }
+  }    // end ivary loop
 
-      PHTimer fitTimer("FitTimer");
-      fitTimer.stop();
-      fitTimer.restart();
+  trackTimer.stop();
+  auto trackTime = trackTimer.get_accumulated_time();
 
-      auto trackContainer =
-          std::make_shared<Acts::VectorTrackContainer>();
-      auto trackStateContainer =
-          std::make_shared<Acts::VectorMultiTrajectory>();
-      ActsTrackFittingAlgorithm::TrackContainer
-          tracks(trackContainer, trackStateContainer);
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+  }
+}
 
-      auto result = fitTrack(sourceLinks, seed, kfOptions,
-                             surfaces, calibrator, tracks);
-      fitTimer.stop();
-      auto fitTime = fitTimer.get_accumulated_time();
+void PHActsTrkFitter::publishSeedFit(SeedFit& fit)
+{
+  std::vector<float> chisq_ndf;
+  std::vector<SvtxTrack_v4*> svtx_vec;
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
-      }
+  for (auto& trial : fit.trials)
+  {
+    if (!trial.fitted)
+    {
+      continue;
+    }
 
-      /// Check that the track fit result did not return an error
-      if (result.ok())
+    if (trial.ok)
+    {
+      if (fit.use_estimate)  // trial variation case
       {
-        if (use_estimate)  // trial variation case
+        // this is a trial variation of the crossing estimate for this track
+        // Capture the chisq/ndf so we can choose the best one after all trials
+        if (trial.hasTrack)
         {
-          // this is a trial variation of the crossing estimate for this track
-          // Capture the chisq/ndf so we can choose the best one after all trials
-
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
-
-          if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
+          publishTrackFitResult(trial, fit.seed, &trial.track);
+          float chi2ndf = trial.track.get_quality();
+          chisq_ndf.push_back(chi2ndf);
+          svtx_vec.push_back(&trial.track);
+          if (Verbosity() > 1)
           {
-            float chi2ndf = newTrack.get_quality();
-            chisq_ndf.push_back(chi2ndf);
-            svtx_vec.push_back(newTrack);
-            if (Verbosity() > 1)
-            {
-              std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
-            }
+            std::cout << "   tpcid " << fit.tpcid << " siid " << fit.siid << " ivary " << trial.ivary << " this_crossing " << trial.crossing << " chi2ndf " << chi2ndf << std::endl;
           }
+        }
 
-          if (ivary != nvary)
+        if (trial.ivary != fit.nvary)
+        {
+          if (Verbosity() > 3)
           {
-            if(Verbosity() > 3)
-            {
-              std::cout << "Skipping track fit for trial variation" << std::endl;
-            }
-            continue;
+            std::cout << "Skipping track fit for trial variation" << std::endl;
           }
+          continue;
+        }
 
-          // if we are here this is the last crossing iteration, evaluate the results
-          if (Verbosity() > 1)
+        // if we are here this is the last crossing iteration, evaluate the results
+        if (Verbosity() > 1)
+        {
+          std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
+        }
+        if (svtx_vec.empty())
+        {
+          continue;
+        }
+        float best_chisq = 1000.0;
+        short int best_ivary = 0;
+        for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
+        {
+          if (chisq_ndf[i] < best_chisq)
           {
-            std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
+            best_chisq = chisq_ndf[i];
+            best_ivary = i;
           }
-          float best_chisq = 1000.0;
-          short int best_ivary = 0;
-          for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
+          if (Verbosity() > 1)
           {
-            if (chisq_ndf[i] < best_chisq)
-            {
-              best_chisq = chisq_ndf[i];
-              best_ivary = i;
-            }
-            if (Verbosity() > 1)
-            {
-              std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
-            }
+            std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
           }
-          unsigned int trid = m_trackMap->size();
-          svtx_vec[best_ivary].set_id(trid);
-
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
         }
-        else  // case where INTT crossing is known
-        {
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
+        unsigned int trid = m_trackMap->size();
+        svtx_vec[best_ivary]->set_id(trid);
 
-          if (m_fitSiliconMMs)
-          {
-            unsigned int trid = m_directedTrackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for SC calib fit
-          else
-          {
-            unsigned int trid = m_trackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_trackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for normal fit
-        }    // end case where INTT crossing is known
+        m_trackMap->insertWithKey(svtx_vec[best_ivary], trid);
       }
-      else if (!m_fitSiliconMMs)
+      else  // case where INTT crossing is known
       {
-        /// Track fit failed, get rid of the track from the map
-        m_nBadFits++;
-        if (Verbosity() > 1)
+        if (m_fitSiliconMMs)
         {
-          std::cout << "Track fit failed for track " << m_seedMap->find(track)
-                    << " with Acts error message "
-                    << result.error() << ", " << result.error().message()
-                    << std::endl;
-        }
-      }  // end fit failed case
-    }    // end ivary loop
+          unsigned int trid = m_directedTrackMap->size();
+          trial.track.set_id(trid);
 
-    trackTimer.stop();
-    auto trackTime = trackTimer.get_accumulated_time();
+          if (trial.hasTrack)
+          {
+            publishTrackFitResult(trial, fit.seed, &trial.track);
+            m_directedTrackMap->insertWithKey(&trial.track, trid);
+          }
+        }  // end insert track for SC calib fit
+        else
+        {
+          unsigned int trid = m_trackMap->size();
+          trial.track.set_id(trid);
 
-    if (Verbosity() > 1)
-    {
-      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+          if (trial.hasTrack)
+          {
+            publishTrackFitResult(trial, fit.seed, &trial.track);
+            m_trackMap->insertWithKey(&trial.track, trid);
+          }
+        }  // end insert track for normal fit
+      }    // end case where INTT crossing is known
     }
+    else if (!m_fitSiliconMMs)
+    {
+      /// Track fit failed, get rid of the track from the map
+      m_nBadFits++;
+      if (Verbosity() > 1)
+      {
+        std::cout << "Track fit failed for track " << m_seedMap->find(fit.seed)
+                  << " with Acts error message "
+                  << trial.error << ", " << trial.error.message()
+                  << std::endl;
+      }
+    }  // end fit failed case
   }
-
-  return;
 }
 
 bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
-                                        TrackSeed* seed, SvtxTrack* track,
+                                        SvtxTrack* track,
                                         ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                        const ActsTrackFittingAlgorithm::MeasurementContainer& measurements)
+                                        const Acts::GeometryContext& geocontext,
+                                        TrialFit& trial)
 {
   /// Make a trajectory state for storage, which conforms to Acts track fit
   /// analysis tool
-  std::vector<Acts::MultiTrajectoryTraits::IndexType> trackTips;
+  auto& trackTips = trial.trackTips;
   trackTips.reserve(1);
   auto& outtrack = fitOutput.value();
   if (outtrack.hasReferenceSurface())
   {
     trackTips.emplace_back(outtrack.tipIndex());
-    Trajectory::IndexedParameters indexedParams;
+    Trajectory::IndexedParameters& indexedParams = trial.indexedParams;
     indexedParams.emplace(std::pair{outtrack.tipIndex(),
                                     ActsExamples::TrackParameters{outtrack.referenceSurface().getSharedPtr(),
                                                                   outtrack.parameters(), outtrack.covariance(), outtrack.particleHypothesis()}});
@@ -758,7 +861,7 @@ bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
     if (Verbosity() > 2)
     {
       std::cout << "Fitted parameters for track" << std::endl;
-      std::cout << " position : " << outtrack.referenceSurface().localToGlobal(m_transient_geocontext, Acts::Vector2(outtrack.loc0(), outtrack.loc1()), Acts::Vector3(1, 1, 1)).transpose()
+      std::cout << " position : " << outtrack.referenceSurface().localToGlobal(geocontext, Acts::Vector2(outtrack.loc0(), outtrack.loc1()), Acts::Vector3(1, 1, 1)).transpose()
 
                 << std::endl;
       int otcharge = outtrack.qOverP() > 0 ? 1 : -1;
@@ -773,46 +876,50 @@ bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
     PHTimer updateTrackTimer("UpdateTrackTimer");
     updateTrackTimer.stop();
     updateTrackTimer.restart();
-    updateSvtxTrack(trackTips, indexedParams, tracks, track);
-
-    if (m_commissioning)
-    {
-      if (track->get_silicon_seed() && track->get_tpc_seed())
-      {
-        m_alignStates.fillAlignmentStateMap(tracks, trackTips,
-                                            track, measurements);
-      }
-    }
-
+    updateSvtxTrack(trackTips, indexedParams, tracks, track, geocontext);
     updateTrackTimer.stop();
-    auto updateTime = updateTrackTimer.get_accumulated_time();
+    trial.updateTime = updateTrackTimer.get_accumulated_time();
 
-    if (Verbosity() > 1)
-    {
-      std::cout << "PHActsTrkFitter update SvtxTrack time "
-                << updateTime << std::endl;
-    }
+    return true;
+  }
 
-    if (m_timeAnalysis)
-    {
-      h_updateTime->Fill(updateTime);
-    }
+  return false;
+}
 
-    Trajectory trajectory(tracks.trackStateContainer(),
-                          trackTips, indexedParams);
+void PHActsTrkFitter::publishTrackFitResult(TrialFit& trial, TrackSeed* seed, SvtxTrack* track)
+{
+  ActsTrackFittingAlgorithm::TrackContainer tracks(trial.trackContainer, trial.trackStateContainer);
 
-    m_trajectories->insert(std::make_pair(track->get_id(), trajectory));
-    
-    if (m_actsEvaluator)
+  if (m_commissioning)
+  {
+    if (track->get_silicon_seed() && track->get_tpc_seed())
     {
-      m_evaluator->evaluateTrackFit(tracks, trackTips, indexedParams, track,
-                                    seed, measurements);
+      m_alignStates.fillAlignmentStateMap(tracks, trial.trackTips,
+                                          track, trial.measurements);
     }
+  }
 
-    return true;
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter update SvtxTrack time "
+              << trial.updateTime << std::endl;
   }
 
-  return false;
+  if (m_timeAnalysis)
+  {
+    h_updateTime->Fill(trial.updateTime);
+  }
+
+  Trajectory trajectory(tracks.trackStateContainer(),
+                        trial.trackTips, trial.indexedParams);
+
+  m_trajectories->insert(std::make_pair(track->get_id(), trajectory));
+
+  if (m_actsEvaluator)
+  {
+    m_evaluator->evaluateTrackFit(tracks, trial.trackTips, trial.indexedParams, track,
+                                  seed, trial.measurements);
+  }
 }
 
 ActsTrackFittingAlgorithm::TrackFitterResult PHActsTrkFitter::fitTrack(
@@ -939,7 +1046,8 @@ void PHActsTrkFitter::checkSurfaceVec(SurfacePtrVec& surfaces) const
 void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                                       Trajectory::IndexedParameters& paramsMap,
                                       ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                      SvtxTrack* track)
+                                      SvtxTrack* track,
+                                      const Acts::GeometryContext& geocontext)
 {
   const auto& mj = tracks.trackStateContainer();
 
@@ -972,9 +1080,9 @@ void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::I
   const auto& params = paramsMap.find(trackTip)->second;
 
   /// Acts default unit is mm. So convert to cm
-  track->set_x(params.position(m_transient_geocontext)(0) / Acts::UnitConstants::cm);
-  track->set_y(params.position(m_transient_geocontext)(1) / Acts::UnitConstants::cm);
-  track->set_z(params.position(m_transient_geocontext)(2) / Acts::UnitConstants::cm);
+  track->set_x(params.position(geocontext)(0) / Acts::UnitConstants::cm);
+  track->set_y(params.position(geocontext)(1) / Acts::UnitConstants::cm);
+  track->set_z(params.position(geocontext)(2) / Acts::UnitConstants::cm);
 
   track->set_px(params.momentum()(0));
   track->set_py(params.momentum()(1));
@@ -1009,7 +1117,7 @@ void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::I
   if (m_fillSvtxTrackStates)
   {
     rotater.fillSvtxTrackStates(mj, trackTip, track,
-                                m_transient_geocontext);
+                                geocontext);
   }
 
   trackStateTimer.stop();
@@ -1023,6 +1131,7 @@ void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::I
 
   if (m_timeAnalysis)
   {
+    std::lock_guard<std::mutex> lock(m_histMutex);
     h_stateTime->Fill(stateTime);
   }
 
@@ -1081,7 +1190,7 @@ Acts::BoundSquareMatrix PHActsTrkFitter::setDefaultCovariance() const
   return cov;
 }
 
-void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const
+void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed, const Acts::GeometryContext& geocontext) const
 {
   std::cout
       << PHWHERE
@@ -1089,7 +1198,7 @@ void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParam
       << std::endl;
 
   std::cout
-      << "position: " << seed.position(m_transient_geocontext).transpose()
+      << "position: " << seed.position(geocontext).transpose()
       << std::endl
       << "momentum: " << seed.momentum().transpose()
       << std::endl;
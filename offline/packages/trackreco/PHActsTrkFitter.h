@@ -16,6 +16,8 @@
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/ActsTrackFittingAlgorithm.h>
 
+#include <trackbase_historic/SvtxTrack_v4.h>
+
 #include <tpc/TpcGlobalPositionWrapper.h>
 
 #include <Acts/Definitions/Algebra.hpp>
@@ -29,7 +31,10 @@
 #include <TH1.h>
 #include <TH2.h>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <vector>
 
 class alignmentTransformationContainer;
 class ActsGeometry;
@@ -126,6 +131,10 @@ class PHActsTrkFitter : public SubsysReco
   void ignoreLayer(int layer) { m_ignoreLayer.insert(layer); }
   void setTrkrClusterContainerName(std::string &name){ m_clusterContainerName = name; }
 
+  /// number of threads used to fit the seeds. 0 uses all available cores, 1 (default) fits sequentially
+  /// output does not depend on the number of threads
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
   /// Get all the nodes
   int getNodes(PHCompositeNode* topNode);
@@ -133,13 +142,56 @@ class PHActsTrkFitter : public SubsysReco
   /// Create new nodes
   int createNodes(PHCompositeNode* topNode);
 
+  /// fit result for one crossing hypothesis of a seed
+  struct TrialFit
+  {
+    short int ivary = 0;
+    short int crossing = 0;
+
+    /// a fit was attempted
+    bool fitted = false;
+
+    /// the fit succeeded
+    bool ok = false;
+
+    /// the fit has a reference surface, track has been updated
+    bool hasTrack = false;
+
+    std::error_code error;
+    SvtxTrack_v4 track;
+    std::shared_ptr<Acts::VectorTrackContainer> trackContainer;
+    std::shared_ptr<Acts::VectorMultiTrajectory> trackStateContainer;
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    std::vector<Acts::MultiTrajectoryTraits::IndexType> trackTips;
+    Trajectory::IndexedParameters indexedParams;
+    double updateTime = 0;
+  };
+
+  /// all fits of one seed
+  struct SeedFit
+  {
+    TrackSeed* seed = nullptr;
+    unsigned int tpcid = 0;
+    unsigned int siid = 0;
+    bool use_estimate = false;
+    short int nvary = 0;
+    std::vector<TrialFit> trials;
+  };
+
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// fit one seed. Only reads shared state, safe to run concurrently
+  void fitSeed(TrackSeed* track, SeedFit& fit);
+
+  /// store the fit results of one seed in the output maps. Must be called in seed order
+  void publishSeedFit(SeedFit& fit);
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                        Trajectory::IndexedParameters& paramsMap,
                        ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                       SvtxTrack* track);
+                       SvtxTrack* track,
+                       const Acts::GeometryContext& geocontext);
 
   /// Helper function to call either the regular navigation or direct
   /// navigation, depending on m_fitSiliconMMs
@@ -158,13 +210,18 @@ class PHActsTrkFitter : public SubsysReco
                                  SurfacePtrVec& surfaces) const;
   void checkSurfaceVec(SurfacePtrVec& surfaces) const;
 
-  bool getTrackFitResult(FitResult& fitOutput, TrackSeed* seed,
+  /// update track from the fit output, store trajectory information in trial
+  bool getTrackFitResult(FitResult& fitOutput,
                          SvtxTrack* track,
                          ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                         const ActsTrackFittingAlgorithm::MeasurementContainer& measurements);
+                         const Acts::GeometryContext& geocontext,
+                         TrialFit& trial);
+
+  /// fill trajectories, alignment states and evaluator for a fitted track
+  void publishTrackFitResult(TrialFit& trial, TrackSeed* seed, SvtxTrack* track);
 
   Acts::BoundSquareMatrix setDefaultCovariance() const;
-  void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const;
+  void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed, const Acts::GeometryContext& geocontext) const;
 
   /// Event counter
   int m_event = 0;
@@ -179,7 +236,6 @@ class PHActsTrkFitter : public SubsysReco
   alignmentTransformationContainer* m_alignmentTransformationMap = nullptr;  // added for testing purposes
   alignmentTransformationContainer* m_alignmentTransformationMapTransient = nullptr;
   std::set<Acts::GeometryIdentifier> m_transient_id_set;
-  Acts::GeometryContext m_transient_geocontext;
   SvtxTrackMap* m_trackMap = nullptr;
   SvtxTrackMap* m_directedTrackMap = nullptr;
   TrkrClusterContainer* m_clusterContainer = nullptr;
@@ -259,8 +315,12 @@ class PHActsTrkFitter : public SubsysReco
 
   PHG4TpcCylinderGeomContainer* _tpccellgeo = nullptr;
 
+  /// number of fitting threads
+  unsigned int m_nthreads = 1;
+
   /// Variables for doing event time execution analysis
   bool m_timeAnalysis = false;
+  std::mutex m_histMutex;
   TFile* m_timeFile = nullptr;
   TH1* h_eventTime = nullptr;
   TH2* h_fitTime = nullptr;
@@ -210,6 +210,14 @@ int PHCASeeding::InitializeGeometry(PHCompositeNode* topNode)
   // tpc global position wrapper
   m_globalPositionWrapper.loadNodes(topNode);
 
+  // cluster global positions, shared with other modules
+  m_globalPositionCache = TrkrClusterGlobalPositionCache::getOrCreate(topNode);
+  if (!m_globalPositionCache)
+  {
+    std::cout << PHWHERE << "Could not create cluster global position cache, can't proceed" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -242,50 +250,51 @@ void PHCASeeding::QueryTree(const bgi::rtree<PHCASeeding::pointKey, bgi::quadrat
   }
 }
 
-std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::FillGlobalPositions()
+PHCASeeding::keyListPerLayer PHCASeeding::FillGlobalPositions()
 {
   keyListPerLayer ckeys;
-  PositionMap cachedPositions;
-  cachedPositions.reserve(_cluster_map->size());  // avoid resizing mid-execution
 
-  for (const auto& hitsetkey : _cluster_map->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
+  // positions are computed only once per event, by the first module that needs them
+  // the configuration must match what getGlobalPosition uses
+  const auto configuration = _pp_mode ? TrkrClusterGlobalPositionCache::Configuration{m_tGeometry} : m_globalPositionWrapper.cacheConfiguration();
+  if (!m_globalPositionCache->isFilledFor(_cluster_map, TrkrDefs::TrkrId::tpcId, configuration))
   {
-    auto range = _cluster_map->getClusters(hitsetkey);
-    for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
-    {
-      TrkrDefs::cluskey ckey = clusIter->first;
-      TrkrCluster* cluster = clusIter->second;
-      unsigned int layer = TrkrDefs::getLayer(ckey);
+    m_globalPositionCache->fill(_cluster_map, TrkrDefs::TrkrId::tpcId, configuration,
+                                [this](TrkrDefs::cluskey key, TrkrCluster* cluster)
+                                { return getGlobalPosition(key, cluster); });
+  }
+  const PositionMap& cachedPositions = *m_globalPositionCache;
 
-      if(cluster->getZSize()==1&&_reject_zsize1==true){
-	continue;
-      }
-      if (layer < _start_layer || layer >= _end_layer)
+  // clusters are carried around by their index in the cache from here on
+  for (clusindex index = 0; index < cachedPositions.size(); ++index)
+  {
+    TrkrDefs::cluskey ckey = cachedPositions.key(index);
+    unsigned int layer = TrkrDefs::getLayer(ckey);
+
+    if (layer < _start_layer || layer >= _end_layer)
+    {
+      if (Verbosity() > 2)
       {
-        if (Verbosity() > 2)
-        {
-          std::cout << "layer: " << layer << std::endl;
-        }
-        continue;
+        std::cout << "layer: " << layer << std::endl;
       }
-      if (_iteration_map != nullptr && _n_iteration > 0)
+      continue;
+    }
+    if (_reject_zsize1 && _cluster_map->findCluster(ckey)->getZSize() == 1)
+    {
+      continue;
+    }
+    if (_iteration_map != nullptr && _n_iteration > 0)
+    {
+      if (_iteration_map->getIteration(ckey) > 0)
       {
-        if (_iteration_map->getIteration(ckey) > 0)
-        {
-          continue;  // skip hits used in a previous iteration
-        }
+        continue;  // skip hits used in a previous iteration
       }
-
-      // get global position, convert to Acts::Vector3 and store in map
-      const Acts::Vector3 globalpos_d = getGlobalPosition(ckey, cluster);
-      const Acts::Vector3 globalpos = {globalpos_d.x(), globalpos_d.y(), globalpos_d.z()};
-      cachedPositions.insert(std::make_pair(ckey, globalpos));
-
-      ckeys[layer - _FIRST_LAYER_TPC].push_back(ckey);
-      fill_tuple(_tupclus_all, 0, ckey, cachedPositions.at(ckey));
     }
+
+    ckeys[layer - _FIRST_LAYER_TPC].push_back(index);
+    fill_tuple(_tupclus_all, 0, index, cachedPositions.position(index));
   }
-  return std::make_pair(cachedPositions, ckeys);
+  return ckeys;
 }
 
 std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer)
@@ -296,15 +305,15 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
   std::vector<coordKey> coords;
   _rtree.clear();
   /* _rtree.reserve(ckeys.size()); */
-  for (const auto& ckey : ckeys)
+  for (const auto& index : ckeys)
   {
-    const auto& globalpos_d = globalPositions.at(ckey);
+    const auto& globalpos_d = globalPositions.position(index);
     const double clus_phi = get_phi(globalpos_d);
     const double clus_z = globalpos_d.z();
     if (Verbosity() > 5)
     {
-      /* int layer = TrkrDefs::getLayer(ckey); */
-      std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
+      /* int layer = TrkrDefs::getLayer(globalPositions.key(index)); */
+      std::cout << "Found cluster " << globalPositions.key(index) << " in layer " << layer << std::endl;
     }
     std::vector<pointKey> testduplicate;
     QueryTree(_rtree, clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001, testduplicate);
@@ -313,9 +322,9 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
       ++n_dupli;
       continue;
     }
-    coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
+    coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, index});
     t_fill->restart();
-    _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
+    _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), index));
     t_fill->stop();
   }
   if (Verbosity() > 5)
@@ -353,9 +362,8 @@ int PHCASeeding::Process(PHCompositeNode* /*topNode*/)
   t_seed->restart();
   t_makebilinks->restart();
 
-  PositionMap globalPositions;
-  keyListPerLayer ckeys;
-  std::tie(globalPositions, ckeys) = FillGlobalPositions();
+  const keyListPerLayer ckeys = FillGlobalPositions();
+  const PositionMap& globalPositions = *m_globalPositionCache;
 
   t_seed->stop();
   if (Verbosity() > 0)
@@ -419,7 +427,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   // a time -- the prior padplane row and the next padplain row
   std::array<std::vector<coordKey>, 3> coord_arr;
   std::array<std::unordered_set<keyLink>, 2> previous_downlinks_arr;
-  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
+  std::array<std::unordered_set<clusindex>, 2> bottom_of_bilink_arr;
 
   // iterate from outer to inner layers
   const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
@@ -468,7 +476,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
     for (const auto& StartCluster : coord)
     {
       double StartPhi = StartCluster.first[0];
-      const auto& globalpos = globalPositions.at(StartCluster.second);
+      const auto& globalpos = globalPositions.position(StartCluster.second);
       double StartX = globalpos(0);
       double StartY = globalpos(1);
       double StartZ = globalpos(2);
@@ -514,7 +522,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       std::transform(ClustersBelow.begin(), ClustersBelow.end(), delta_below.begin(),
                      [&](pointKey BelowCandidate)
                      {
-          const auto& belowpos = globalPositions.at(BelowCandidate.second);
+          const auto& belowpos = globalPositions.position(BelowCandidate.second);
           return std::array<double,3>{belowpos(0)-StartX,
           belowpos(1)-StartY,
           belowpos(2)-StartZ}; });
@@ -522,7 +530,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       std::transform(ClustersAbove.begin(), ClustersAbove.end(), delta_above.begin(),
                      [&](pointKey AboveCandidate)
                      {
-          const auto& abovepos = globalPositions.at(AboveCandidate.second);
+          const auto& abovepos = globalPositions.position(AboveCandidate.second);
           return std::array<double,3>{abovepos(0)-StartX,
           abovepos(1)-StartY,
           abovepos(2)-StartZ}; });
@@ -533,7 +541,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       // find the three clusters closest to a straight line
       // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
       // double minSumLengths = 1e9;
-      std::unordered_set<TrkrDefs::cluskey> bestAboveClusters;
+      std::unordered_set<clusindex> bestAboveClusters;
       for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
       {
         for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
@@ -559,9 +567,9 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
             bestAboveClusters.insert(ClustersAbove[iAbove].second);
 
             // fill the tuples for plotting
-            fill_tuple(_tupclus_links, 0, StartCluster.second, globalPositions.at(StartCluster.second));
-            fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.at(ClustersBelow[iBelow].second));
-            fill_tuple(_tupclus_links, 1, ClustersAbove[iAbove].second, globalPositions.at(ClustersAbove[iAbove].second));
+            fill_tuple(_tupclus_links, 0, StartCluster.second, globalPositions.position(StartCluster.second));
+            fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.position(ClustersBelow[iBelow].second));
+            fill_tuple(_tupclus_links, 1, ClustersAbove[iAbove].second, globalPositions.position(ClustersAbove[iAbove].second));
           }
         }
       }
@@ -583,8 +591,8 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
           const auto& key_top = uplink.first;
           const auto& key_bot = uplink.second;
           curr_bottom_of_bilink.insert(key_bot);
-          fill_tuple(_tupclus_bilinks, 0, key_top, globalPositions.at(key_top));
-          fill_tuple(_tupclus_bilinks, 1, key_bot, globalPositions.at(key_bot));
+          fill_tuple(_tupclus_bilinks, 0, key_top, globalPositions.position(key_top));
+          fill_tuple(_tupclus_bilinks, 1, key_bot, globalPositions.position(key_bot));
 
           if (last_bottom_of_bilink.find(key_top) == last_bottom_of_bilink.end())
           {
@@ -621,13 +629,13 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   return std::make_pair(startLinks, bodyLinks);
 }
 
-double PHCASeeding::getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PHCASeeding::PositionMap& globalPositions) const
+double PHCASeeding::getMengerCurvature(clusindex a, clusindex b, clusindex c, const PHCASeeding::PositionMap& globalPositions) const
 {
   // Menger curvature = 1/R for circumcircle of triangle formed by most recent three clusters
   // We use here 1/R = 2*sin(breaking angle)/(hypotenuse of triangle)
-  auto& a_pos = globalPositions.at(a);
-  auto& b_pos = globalPositions.at(b);
-  auto& c_pos = globalPositions.at(c);
+  auto& a_pos = globalPositions.position(a);
+  auto& b_pos = globalPositions.position(b);
+  auto& c_pos = globalPositions.position(c);
   double hypot_length = sqrt(square<double>(c_pos.x() - a_pos.x()) + square<double>(c_pos.y() - a_pos.y()) + square<double>(c_pos.z() - a_pos.z()));
   double break_angle = breaking_angle(
       a_pos.x() - b_pos.x(),
@@ -645,8 +653,8 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
   keyLists seeds;
   for (auto& startLink : trackSeedPairs)
   {
-    TrkrDefs::cluskey trackHead = startLink.second;
-    unsigned int trackHead_layer = TrkrDefs::getLayer(trackHead) - _FIRST_LAYER_TPC;
+    clusindex trackHead = startLink.second;
+    unsigned int trackHead_layer = TrkrDefs::getLayer(globalPositions.key(trackHead)) - _FIRST_LAYER_TPC;
     // the following call with get iterators to all bilinks which match the head
     for (const auto& matchlink : bilinks[trackHead_layer])
     {
@@ -663,9 +671,9 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
       trackSeedTriplet.push_back(matchlink.second);
       seeds.push_back(trackSeedTriplet);
 
-      fill_tuple(_tupclus_seeds, 0, startLink.first, globalPositions.at(startLink.first));
-      fill_tuple(_tupclus_seeds, 1, startLink.second, globalPositions.at(startLink.second));
-      fill_tuple(_tupclus_seeds, 2, matchlink.second, globalPositions.at(matchlink.second));
+      fill_tuple(_tupclus_seeds, 0, startLink.first, globalPositions.position(startLink.first));
+      fill_tuple(_tupclus_seeds, 1, startLink.second, globalPositions.position(startLink.second));
+      fill_tuple(_tupclus_seeds, 2, matchlink.second, globalPositions.position(matchlink.second));
     }
   }
 
@@ -716,7 +724,7 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
       while (!done_growing)
       {
         // Get all bilinks which fit to the head of the chain
-        unsigned int iL = TrkrDefs::getLayer(head_keys[0]) - _FIRST_LAYER_TPC;
+        unsigned int iL = TrkrDefs::getLayer(globalPositions.key(head_keys[0])) - _FIRST_LAYER_TPC;
         keySet link_matches{};
         for (const auto& head_key : head_keys)
         {
@@ -742,7 +750,7 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
             first_link = false;
             for (int i = 1; i < 4; ++i)
             {
-              const auto& pos = globalPositions.at(seed.rbegin()[i - 1]);
+              const auto& pos = globalPositions.position(seed.rbegin()[i - 1]);
               const auto x = pos.x();
               const auto y = pos.y();
               int index = (iL + i) % 4;
@@ -753,7 +761,7 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
           }
 
           // get the data for the new link
-          const auto& pos = globalPositions.at(link);
+          const auto& pos = globalPositions.position(link);
           const auto x = pos.x();
           const auto y = pos.y();
           const auto z = pos.z();
@@ -843,7 +851,7 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
             float avg_z = 0;
             for (const auto& link : passing_links)
             {
-              const auto& pos = globalPositions.at(link);
+              const auto& pos = globalPositions.position(link);
               avg_x += pos.x();
               avg_y += pos.y();
               avg_z += pos.z();
@@ -905,9 +913,9 @@ std::vector<TrackSeed_v2> PHCASeeding::RemoveBadClusters(const std::vector<PHCAS
     }
 
     TrackFitUtils::position_vector_t xy_pts;
-    for (const auto& cluskey : chain)
+    for (const auto& index : chain)
     {
-      const auto& global = globalPositions.at(cluskey);
+      const auto& global = globalPositions.position(index);
       xy_pts.emplace_back(global.x(), global.y());
     }
 
@@ -925,9 +933,9 @@ std::vector<TrackSeed_v2> PHCASeeding::RemoveBadClusters(const std::vector<PHCAS
 
     // assign clusters to seed
     TrackSeed_v2 trackseed;
-    for (const auto& key : chain)
+    for (const auto& index : chain)
     {
-      trackseed.insert_cluster_key(key);
+      trackseed.insert_cluster_key(globalPositions.key(index));
     }
     clean_chains.push_back(trackseed);
     if (Verbosity() > 2)
@@ -1107,7 +1115,7 @@ void PHCASeeding::fill_split_chains(const PHCASeeding::keyList& seed, const PHCA
       r1 = r0;
       phi1 = phi0;
     }
-    auto link_pos = pos.at(link);
+    auto link_pos = pos.position(link);
     has_0 = true;
     x0 = link_pos.x();
     y0 = link_pos.y();
@@ -1117,13 +1125,13 @@ void PHCASeeding::fill_split_chains(const PHCASeeding::keyList& seed, const PHCA
 
     if (!has_1)
     {
-      _tup_chainbody->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(link), x0, y0, z0, -1000., -1000., index, nlinks);
+      _tup_chainbody->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(pos.key(link)), x0, y0, z0, -1000., -1000., index, nlinks);
       continue;
     }
     float dzdr = (z0 - z1) / (r0 - r1);
     if (!has_2)
     {
-      _tup_chainbody->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(link), x0, y0, z0, dzdr, -1000., index, nlinks);
+      _tup_chainbody->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(pos.key(link)), x0, y0, z0, dzdr, -1000., index, nlinks);
       continue;
     }
     float dphi01 = std::fmod(phi1 - phi0, M_PI);
@@ -1132,7 +1140,7 @@ void PHCASeeding::fill_split_chains(const PHCASeeding::keyList& seed, const PHCA
     float dr_12 = r2 - r1;
     dphidr01 = dphi01 / dr_01 / dr_01;
     float d2phidr2 = dphidr01 - dphi12 / dr_12 / dr_12;
-    _tup_chainbody->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(link), x0, y0, z0, dzdr, d2phidr2, index, nlinks);
+    _tup_chainbody->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(pos.key(link)), x0, y0, z0, dzdr, d2phidr2, index, nlinks);
   }
 
   // now fill a chain of the possible added seeds
@@ -1142,7 +1150,7 @@ void PHCASeeding::fill_split_chains(const PHCASeeding::keyList& seed, const PHCA
   for (const auto& link : add_links)
   {
     index += 1;
-    auto link_pos = pos.at(link);
+    auto link_pos = pos.position(link);
     float xt = link_pos.x();
     float yt = link_pos.y();
     float zt = link_pos.z();
@@ -1154,7 +1162,7 @@ void PHCASeeding::fill_split_chains(const PHCASeeding::keyList& seed, const PHCA
     float dphit0 = std::fmod(phit - phi0, M_PI);
 
     float d2phidr2 = dphit0 / dr_t0 / dr_t0 - dphidr01;
-    _tup_chainfork->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(link), xt, yt, zt, dzdr, d2phidr2, index, nlinks);
+    _tup_chainfork->Fill(_tupout_count, n_tupchains, TrkrDefs::getLayer(pos.key(link)), xt, yt, zt, dzdr, d2phidr2, index, nlinks);
   }
 }
 
@@ -1181,16 +1189,16 @@ void PHCASeeding::write_tuples()
   _f_clustering_process->Close();
 }
 
-void PHCASeeding::fill_tuple(TNtuple* tup, float val, TrkrDefs::cluskey key, const Acts::Vector3& pos) const
+void PHCASeeding::fill_tuple(TNtuple* tup, float val, clusindex index, const Acts::Vector3& pos) const
 {
-  tup->Fill(_tupout_count, TrkrDefs::getLayer(key), val, pos[0], pos[1], pos[2]);
+  tup->Fill(_tupout_count, TrkrDefs::getLayer(m_globalPositionCache->key(index)), val, pos[0], pos[1], pos[2]);
 }
 
 void PHCASeeding::fill_tuple_with_seed(TNtuple* tup, const PHCASeeding::keyList& seed, const PHCASeeding::PositionMap& pos) const
 {
   for (unsigned int i = 0; i < seed.size(); ++i)
   {
-    fill_tuple(tup, (float) i, seed[i], pos.at(seed[i]));
+    fill_tuple(tup, (float) i, seed[i], pos.position(seed[i]));
   }
 }
 
@@ -1204,7 +1212,7 @@ void PHCASeeding::process_tupout_count()
 void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
 {
   double StartPhi = StartCluster.first[0];
-  const auto& P0 = globalPositions.at(StartCluster.second);
+  const auto& P0 = globalPositions.position(StartCluster.second);
   double StartZ = P0(2);
   // Fill TNTuple _tupwin_link
   std::vector<pointKey> ClustersBelow;
@@ -1217,34 +1225,34 @@ void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadrati
 
   for (const auto& pkey : ClustersBelow)
   {
-    const auto P1 = globalPositions.at(pkey.second);
+    const auto P1 = globalPositions.position(pkey.second);
     double dphi = bg::get<0>(pkey.first) - StartPhi;
     double dZ = P1(2) - StartZ;
-    _tupwin_link->Fill(_tupout_count, TrkrDefs::getLayer(StartCluster.second), P0(0), P0(1), P0(2), TrkrDefs::getLayer(pkey.second), P1(0), P1(1), P1(2), dphi, dZ);
+    _tupwin_link->Fill(_tupout_count, TrkrDefs::getLayer(globalPositions.key(StartCluster.second)), P0(0), P0(1), P0(2), TrkrDefs::getLayer(globalPositions.key(pkey.second)), P1(0), P1(1), P1(2), dphi, dZ);
   }
 }
 
-void PHCASeeding::FillTupWinCosAngle(const TrkrDefs::cluskey A, const TrkrDefs::cluskey B, const TrkrDefs::cluskey C, const PHCASeeding::PositionMap& globalPositions, double cos_angle_sq, bool isneg) const
+void PHCASeeding::FillTupWinCosAngle(const clusindex A, const clusindex B, const clusindex C, const PHCASeeding::PositionMap& globalPositions, double cos_angle_sq, bool isneg) const
 {
   // A is top cluster, B the middle, C the bottom
   // a,b,c are the positions
 
-  auto a = globalPositions.at(A);
-  auto b = globalPositions.at(B);
-  auto c = globalPositions.at(C);
+  auto a = globalPositions.position(A);
+  auto b = globalPositions.position(B);
+  auto c = globalPositions.position(C);
 
   _tupwin_cos_angle->Fill(_tupout_count,
-                          TrkrDefs::getLayer(A), a[0], a[1], a[2],
-                          TrkrDefs::getLayer(B), b[0], b[1], b[2],
-                          TrkrDefs::getLayer(C), c[0], c[1], c[2],
+                          TrkrDefs::getLayer(globalPositions.key(A)), a[0], a[1], a[2],
+                          TrkrDefs::getLayer(globalPositions.key(B)), b[0], b[1], b[2],
+                          TrkrDefs::getLayer(globalPositions.key(C)), c[0], c[1], c[2],
                           (isneg ? -1 : 1) * sqrt(cos_angle_sq));
 }
 
 void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& seed, const PHCASeeding::keyLink& link, const PHCASeeding::PositionMap& globalPositions) const
 {
-  TrkrDefs::cluskey trackHead = seed.back();
-  auto& head_pos = globalPositions.at(trackHead);
-  auto& prev_pos = globalPositions.at(seed.rbegin()[1]);
+  clusindex trackHead = seed.back();
+  auto& head_pos = globalPositions.position(trackHead);
+  auto& prev_pos = globalPositions.position(seed.rbegin()[1]);
   float x1 = head_pos.x();
   float y1 = head_pos.y();
   float z1 = head_pos.z();
@@ -1253,7 +1261,7 @@ void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& seed, const PHC
   float z2 = prev_pos.z();
   float dr_12 = sqrt(x1 * x1 + y1 * y1) - sqrt(x2 * x2 + y2 * y2);
   /* TrkrDefs::cluskey testCluster = link.second; */
-  auto& test_pos = globalPositions.at(link.second);
+  auto& test_pos = globalPositions.position(link.second);
   float xt = test_pos.x();
   float yt = test_pos.y();
   float zt = test_pos.z();
@@ -1262,7 +1270,7 @@ void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& seed, const PHC
   float dzdr_t1 = (zt - z1) / dr_t1;
   // if (fabs(dzdr_12 - dzdr_t1) > _clusadd_delta_dzdr_window)) // then fail this link
 
-  auto& third_pos = globalPositions.at(seed.rbegin()[2]);
+  auto& third_pos = globalPositions.position(seed.rbegin()[2]);
   float x3 = third_pos.x();
   float y3 = third_pos.y();
   float z3 = third_pos.z();
@@ -1276,21 +1284,21 @@ void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& seed, const PHC
   float dphit1 = std::fmod(atan2(yt, xt) - atan2(y1, x1), M_PI);
   float d2phidr2_t12 = dphit1 / (dr_t1 * dr_t1) - dphi12 / (dr_12 * dr_12);
   _tupwin_seed23->Fill(_tupout_count,
-                       (TrkrDefs::getLayer(seed.rbegin()[1])), x2, y2, z2,
-                       (TrkrDefs::getLayer(seed.rbegin()[2])), x3, y3, z3);
+                       (TrkrDefs::getLayer(globalPositions.key(seed.rbegin()[1]))), x2, y2, z2,
+                       (TrkrDefs::getLayer(globalPositions.key(seed.rbegin()[2]))), x3, y3, z3);
   _tupwin_seedL1->Fill(_tupout_count,
-                       (TrkrDefs::getLayer(link.second)), xt, yt, zt,
-                       (TrkrDefs::getLayer(seed.back())), x1, y1, z1,
+                       (TrkrDefs::getLayer(globalPositions.key(link.second))), xt, yt, zt,
+                       (TrkrDefs::getLayer(globalPositions.key(seed.back()))), x1, y1, z1,
                        dzdr_12, dzdr_t1, fabs(dzdr_12 - dzdr_t1),
                        d2phidr2_123, d2phidr2_t12, fabs(d2phidr2_123 - d2phidr2_t12));
 }
 #else
 void PHCASeeding::write_tuples(){};
-void PHCASeeding::fill_tuple(TNtuple* /**/, float /**/, TrkrDefs::cluskey /**/, const Acts::Vector3& /**/) const {};
+void PHCASeeding::fill_tuple(TNtuple* /**/, float /**/, clusindex /**/, const Acts::Vector3& /**/) const {};
 void PHCASeeding::fill_tuple_with_seed(TNtuple* /**/, const PHCASeeding::keyList& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::process_tupout_count(){};
 void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& /**/, const PHCASeeding::coordKey& /**/, const PHCASeeding::PositionMap& /**/) const {};
-void PHCASeeding::FillTupWinCosAngle(const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const PHCASeeding::PositionMap& /**/, double /**/, bool /**/) const {};
+void PHCASeeding::FillTupWinCosAngle(const clusindex /**/, const clusindex /**/, const clusindex /**/, const PHCASeeding::PositionMap& /**/, double /**/, bool /**/) const {};
 void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& /**/, const PHCASeeding::keyLink& /**/, const PHCASeeding::PositionMap& /**/) const {};
 #endif  // defined _PHCASEEDING_CLUSTERLOG_TUPOUT_
 
@@ -18,6 +18,7 @@
 
 #include <tpc/TpcGlobalPositionWrapper.h>
 
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
 #include <trackbase/TrkrDefs.h>  // for cluskey
 
 #include <phool/PHTimer.h>  // for PHTimer
@@ -66,19 +67,23 @@ class PHCASeeding : public PHTrackSeeding
 
   using point = bg::model::point<float, 2, bg::cs::cartesian>;
   using box = bg::model::box<point>;
-  using pointKey = std::pair<point, TrkrDefs::cluskey>;                 // phi and z in the key
-  using coordKey = std::pair<std::array<float, 2>, TrkrDefs::cluskey>;  // just use phi and Z, no longer needs the layer
+  //! clusters are identified by their index in the position cache, the cluster key is only needed for the layer and the output seeds
+  using clusindex = TrkrClusterGlobalPositionCache::index_type;
 
-  using keyList = std::vector<TrkrDefs::cluskey>;
+  using pointKey = std::pair<point, clusindex>;                 // phi and z in the key
+  using coordKey = std::pair<std::array<float, 2>, clusindex>;  // just use phi and Z, no longer needs the layer
+
+  using keyList = std::vector<clusindex>;
   using keyLists = std::vector<keyList>;
   using keyListPerLayer = std::array<keyList, _NLAYERS_TPC>;
-  using keySet = std::set<TrkrDefs::cluskey>;
+  using keySet = std::set<clusindex>;
 
-  using keyLink = std::pair<TrkrDefs::cluskey, TrkrDefs::cluskey>;
+  using keyLink = std::pair<clusindex, clusindex>;
   using keyLinks = std::vector<keyLink>;
   using keyLinkPerLayer = std::array<std::vector<keyLink>, _NLAYERS_TPC>;
 
-  using PositionMap = std::unordered_map<TrkrDefs::cluskey, Acts::Vector3>;
+  //! cluster positions, shared with other modules via the node tree
+  using PositionMap = TrkrClusterGlobalPositionCache;
 
   std::array<float, 55> dZ_per_layer{};
   std::array<float, 55> dphi_per_layer{};
@@ -181,11 +186,11 @@ class PHCASeeding : public PHTrackSeeding
                                        // It would be equally valid in a TMap or map<string,float>
   // functions used to fill tuples -- only defined if _PHCASEEDING_CLUSTERLOG_TUPOUT_ is defined in preprocessor
   void write_tuples();
-  void fill_tuple(TNtuple*, float, TrkrDefs::cluskey, const Acts::Vector3&) const;
+  void fill_tuple(TNtuple*, float, clusindex, const Acts::Vector3&) const;
   void fill_tuple_with_seed(TNtuple*, const keyList&, const PositionMap&) const;
   void process_tupout_count();
   void FillTupWinLink(bgi::rtree<pointKey, bgi::quadratic<16>>&, const coordKey&, const PositionMap&) const;
-  void FillTupWinCosAngle(const TrkrDefs::cluskey, const TrkrDefs::cluskey, const TrkrDefs::cluskey, const PositionMap&, double cos_angle, bool isneg) const;
+  void FillTupWinCosAngle(const clusindex, const clusindex, const clusindex, const PositionMap&, double cos_angle, bool isneg) const;
   void FillTupWinGrowSeed(const keyList& seed, const keyLink& link, const PositionMap& globalPositions) const;
   void fill_split_chains(const keyList& chain, const keyList& keylinks, const PositionMap& globalPositions, int& nchains) const;
   /* void fill_tuple_with_seed(TN */
@@ -195,16 +200,16 @@ class PHCASeeding : public PHTrackSeeding
   class CompKeyToBilink
   {
    public:
-    bool operator()(const keyLink& p, const TrkrDefs::cluskey& val) const
+    bool operator()(const keyLink& p, const clusindex& val) const
     {
       return p.first < val;
     }
-    bool operator()(const TrkrDefs::cluskey& val, const keyLink& p) const
+    bool operator()(const clusindex& val, const keyLink& p) const
     {
       return val < p.first;
     }
   };
-  std::pair<std::vector<keyLink>::iterator, std::vector<keyLink>::iterator> FindBilinks(const TrkrDefs::cluskey& key);
+  std::pair<std::vector<keyLink>::iterator, std::vector<keyLink>::iterator> FindBilinks(const clusindex& key);
 
   /// tpc distortion correction utility class
   TpcDistortionCorrection m_distortionCorrection;
@@ -215,7 +220,7 @@ class PHCASeeding : public PHTrackSeeding
    * incorporates TPC distortion correction, if present
    */
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey, TrkrCluster*) const;
-  std::pair<PositionMap, keyListPerLayer> FillGlobalPositions();
+  keyListPerLayer FillGlobalPositions();
   std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys);
   PHCASeeding::keyLists FollowBiLinks(const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions) const;
   std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
@@ -223,7 +228,7 @@ class PHCASeeding : public PHTrackSeeding
 
   void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>>& rtree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
   std::vector<TrackSeed_v2> RemoveBadClusters(const std::vector<keyList>& seeds, const PositionMap& globalPositions) const;
-  double getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PositionMap& globalPositions) const;
+  double getMengerCurvature(clusindex a, clusindex b, clusindex c, const PositionMap& globalPositions) const;
 
   void publishSeeds(const std::vector<TrackSeed_v2>& seeds) const;
 
@@ -267,6 +272,9 @@ class PHCASeeding : public PHTrackSeeding
   /// global position wrapper
   TpcGlobalPositionWrapper m_globalPositionWrapper;
 
+  /// per event cluster global positions
+  TrkrClusterGlobalPositionCache* m_globalPositionCache{nullptr};
+
   std::unique_ptr<ALICEKF> fitter;
 
   std::unique_ptr<PHTimer> t_seed;
@@ -31,9 +31,11 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
+#include <algorithm>
 #include <climits>   // for UINT_MAX
 #include <cmath>     // for fabs, sqrt
 #include <iostream>  // for operator<<, basic_ostream
+#include <limits>
 #include <memory>
 #include <set>      // for _Rb_tree_const_iterator
 #include <utility>  // for pair
@@ -189,6 +191,124 @@ bool PHSiliconTpcTrackMatching::WindowMatcher::in_window
   }
 }
 
+void PHSiliconTpcTrackMatching::WindowMatcher::delta_range
+(const bool posQ, const double tpc_pt, double& lo, double& hi)
+{
+  // mirrors in_window
+  if (use_legacy) {
+    double mag = 1.;
+    if (tpc_pt>0.15) {
+      mag = 1.+5./tpc_pt;
+    }
+    hi = mag * leg_search_win;
+    lo = -hi;
+    return;
+  }
+  if (posQ) {
+    double pt = (tpc_pt<min_pt_posQ) ? min_pt_posQ : tpc_pt;
+    hi = fn_exp(posHi, posHi_b0, pt);
+    lo = fabs_max_posQ ? -hi : fn_exp(posLo, posLo_b0, pt);
+  } else {
+    double pt = (tpc_pt<min_pt_negQ) ? min_pt_negQ : tpc_pt;
+    hi = fn_exp(negHi, negHi_b0, pt);
+    lo = fabs_max_negQ ? -hi : fn_exp(negLo, negLo_b0, pt);
+  }
+}
+
+//____________________________________________________________________________..
+int PHSiliconTpcTrackMatching::SiliconSeedGrid::bin(double x, double min, double width, int nbins) const
+{
+  // clamp before converting, x may be far outside of the grid
+  const double b = std::floor((x - min) / width);
+  if (b < 0)
+  {
+    return 0;
+  }
+  if (b > nbins - 1)
+  {
+    return nbins - 1;
+  }
+  return (int) b;
+}
+
+//____________________________________________________________________________..
+void PHSiliconTpcTrackMatching::SiliconSeedGrid::fill(const std::vector<SiliconSeedParams> &params)
+{
+  // seeds with undefined eta or phi never pass the windows, keep them off the grid
+  auto on_grid = [](const SiliconSeedParams &p)
+  { return p.ok && std::isfinite(p.eta) && std::isfinite(p.phi); };
+
+  unsigned int nok = 0;
+  eta_min = phi_min = std::numeric_limits<double>::max();
+  eta_max = phi_max = std::numeric_limits<double>::lowest();
+  for (const auto &p : params)
+  {
+    if (!on_grid(p))
+    {
+      continue;
+    }
+    ++nok;
+    eta_min = std::min(eta_min, p.eta);
+    eta_max = std::max(eta_max, p.eta);
+    phi_min = std::min(phi_min, p.phi);
+    phi_max = std::max(phi_max, p.phi);
+  }
+
+  // about two seeds per cell
+  n_eta = n_phi = std::clamp((int) std::sqrt(nok / 2.), 1, 256);
+  eta_width = (eta_max > eta_min) ? (eta_max - eta_min) / n_eta : 1.;
+  phi_width = (phi_max > phi_min) ? (phi_max - phi_min) / n_phi : 1.;
+
+  // counting sort of the seed ids into the cells, keeps ids ordered within a cell
+  const auto ncells = (unsigned int) (n_eta * n_phi);
+  m_offsets.assign(ncells + 1, 0);
+  std::vector<unsigned int> cell(params.size(), ncells);
+  for (unsigned int id = 0; id < params.size(); ++id)
+  {
+    if (!on_grid(params[id]))
+    {
+      continue;
+    }
+    cell[id] = bin(params[id].eta, eta_min, eta_width, n_eta) * n_phi + bin(params[id].phi, phi_min, phi_width, n_phi);
+    ++m_offsets[cell[id] + 1];
+  }
+  for (unsigned int i = 0; i < ncells; ++i)
+  {
+    m_offsets[i + 1] += m_offsets[i];
+  }
+  m_ids.resize(nok);
+  std::vector<unsigned int> next(m_offsets.begin(), m_offsets.end() - 1);
+  for (unsigned int id = 0; id < params.size(); ++id)
+  {
+    if (cell[id] < ncells)
+    {
+      m_ids[next[cell[id]]++] = id;
+    }
+  }
+}
+
+//____________________________________________________________________________..
+void PHSiliconTpcTrackMatching::SiliconSeedGrid::candidates(
+    double eta_lo, double eta_hi, double phi_lo, double phi_hi, std::vector<unsigned int> &ids) const
+{
+  if (m_ids.empty() || eta_hi < eta_min || eta_lo > eta_max || phi_hi < phi_min || phi_lo > phi_max)
+  {
+    return;
+  }
+  const int ieta_lo = bin(eta_lo, eta_min, eta_width, n_eta);
+  const int ieta_hi = bin(eta_hi, eta_min, eta_width, n_eta);
+  const int iphi_lo = bin(phi_lo, phi_min, phi_width, n_phi);
+  const int iphi_hi = bin(phi_hi, phi_min, phi_width, n_phi);
+  for (int ieta = ieta_lo; ieta <= ieta_hi; ++ieta)
+  {
+    for (int iphi = iphi_lo; iphi <= iphi_hi; ++iphi)
+    {
+      const int icell = ieta * n_phi + iphi;
+      ids.insert(ids.end(), m_ids.begin() + m_offsets[icell], m_ids.begin() + m_offsets[icell + 1]);
+    }
+  }
+}
+
 //____________________________________________________________________________..
 int PHSiliconTpcTrackMatching::process_event(PHCompositeNode * /*unused*/)
 {
@@ -458,11 +578,56 @@ int PHSiliconTpcTrackMatching::GetNodes(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHSiliconTpcTrackMatching::fillSiliconSeedParams()
+{
+  m_si_params.assign(_track_map_silicon->size(), SiliconSeedParams());
+  for (unsigned int siid = 0; siid < _track_map_silicon->size(); ++siid)
+  {
+    TrackSeed *tracklet_si = _track_map_silicon->get(siid);
+    if (!tracklet_si)
+    {
+      continue;
+    }
+
+    auto &si = m_si_params[siid];
+    if (_zero_field)
+    {
+      auto cluster_list = getTrackletClusterList(tracklet_si);
+
+      Acts::Vector3 mom;
+      std::tie(si.ok, si.phi, si.eta, si.pt, si.pos, mom) =
+          TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
+      si.px = mom.x();
+      si.py = mom.y();
+      si.pz = mom.z();
+      si.q = -100;
+    }
+    else
+    {
+      si.ok = true;
+      si.eta = tracklet_si->get_eta();
+      si.phi = tracklet_si->get_phi();
+
+      si.pos = TrackSeedHelper::get_xyz(tracklet_si);
+      si.px = tracklet_si->get_px();
+      si.py = tracklet_si->get_py();
+      si.pz = tracklet_si->get_pz();
+      si.q = tracklet_si->get_charge();
+    }
+    si.crossing = tracklet_si->get_crossing();
+  }
+
+  m_si_grid.fill(m_si_params);
+}
+
 void PHSiliconTpcTrackMatching::findEtaPhiMatches(
     std::set<unsigned int> &tpc_matched_set,
     std::set<unsigned int> &tpc_unmatched_set,
     std::multimap<unsigned int, unsigned int> &tpc_matches)
 {
+  // silicon seed parameters and grid are shared by all TPC seeds
+  fillSiliconSeedParams();
+
   // loop over the TPC track seeds
   for (unsigned int phtrk_iter = 0;
        phtrk_iter < _track_map->size();
@@ -558,58 +723,63 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
 
     bool matched = false;
 
-    // Now search the silicon track list for a match in eta and phi
-    for (unsigned int phtrk_iter_si = 0;
-         phtrk_iter_si < _track_map_silicon->size();
-         ++phtrk_iter_si)
+    // Collect the silicon seeds in the grid cells allowed by the eta and phi windows,
+    // the wrapped phi ranges cover the case where |tpc_phi-si_phi|>PI.
+    // All seeds are tested when the window test tree is filled
+    m_si_candidates.clear();
+    double deta_lo = 0, deta_hi = 0, dphi_lo = 0, dphi_hi = 0;
+    window_deta.delta_range(is_posQ, tpc_pt, deta_lo, deta_hi);
+    window_dphi.delta_range(is_posQ, tpc_pt, dphi_lo, dphi_hi);
+    const double eta_lo = tpc_eta - deta_hi;
+    const double eta_hi = tpc_eta - deta_lo;
+    const double phi_lo = tpc_phi - dphi_hi;
+    const double phi_hi = tpc_phi - dphi_lo;
+    if (_test_windows || !std::isfinite(eta_lo) || !std::isfinite(eta_hi) || !std::isfinite(phi_lo) || !std::isfinite(phi_hi))
     {
-      _tracklet_si = _track_map_silicon->get(phtrk_iter_si);
-      if (!_tracklet_si)
+      for (unsigned int siid = 0; siid < m_si_params.size(); ++siid)
       {
+        m_si_candidates.push_back(siid);
+      }
+    }
+    else
+    {
+      // margin against rounding of tpc_X-si_X at the edges of the windows
+      const double margin = 1e-6;
+      for (const double shift : {0., -2 * M_PI, 2 * M_PI})
+      {
+        m_si_grid.candidates(eta_lo - margin, eta_hi + margin, phi_lo + shift - margin, phi_hi + shift + margin, m_si_candidates);
+      }
+      // same order as a loop over all silicon seeds
+      std::sort(m_si_candidates.begin(), m_si_candidates.end());
+      m_si_candidates.erase(std::unique(m_si_candidates.begin(), m_si_candidates.end()), m_si_candidates.end());
+    }
 
+    // Now search the silicon track list for a match in eta and phi
+    for (const unsigned int siid : m_si_candidates)
+    {
+      const auto &si = m_si_params[siid];
+      if (!si.ok)
+      {
         continue;
       }
+      _tracklet_si = _track_map_silicon->get(siid);
       bool eta_match = false;
 
-    double si_phi, si_eta, si_pt;
-    float si_px, si_py, si_pz;
-    int si_q;
-    Acts::Vector3 si_pos;
-    if (_zero_field) {
-      auto cluster_list = getTrackletClusterList(_tracklet_si);
-
-      Acts::Vector3  mom;
-      bool ok_track;
+      const double si_phi = si.phi;
+      const double si_eta = si.eta;
+      const Acts::Vector3 &si_pos = si.pos;
+      const int si_q = si.q;
+      const int si_crossing = si.crossing;
 
-      std::tie(ok_track, si_phi, si_eta, si_pt, si_pos, mom) = 
-        TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
-      if (!ok_track) { continue; }
-      si_px = mom.x();
-      si_py = mom.y();
-      si_pz = mom.z();
-      si_q = -100;
-    } else {
-      si_eta = _tracklet_si->get_eta();
-      si_phi = _tracklet_si->get_phi();
-
-      si_pos = TrackSeedHelper::get_xyz(_tracklet_si);
-      si_px = _tracklet_si->get_px();
-      si_py = _tracklet_si->get_py();
-      si_pz = _tracklet_si->get_pz();
-	    si_q = _tracklet_si->get_charge();
-    }
-	  int si_crossing = _tracklet_si->get_crossing();
-    unsigned int siid = phtrk_iter_si;
-
-  if(_test_windows)
-  {
-    float data[] = {
-      (float) m_event, (float) si_crossing,
-      (float) si_q, (float) si_phi, (float) si_eta, (float) si_pos.x(), (float) si_pos.y(), (float) si_pos.z(), (float) si_px, (float) si_py, (float) si_pz,
-      (float) tpc_q, (float) tpc_phi, (float) tpc_eta, (float) tpc_pos.x(), (float) tpc_pos.y(), (float) tpc_pos.z(), (float) tpc_px, (float) tpc_py, (float) tpc_pz,
-      (float) tpcid, (float) siid};
-    _tree->Fill(data);
-  }
+      if (_test_windows)
+      {
+        float data[] = {
+            (float) m_event, (float) si_crossing,
+            (float) si_q, (float) si_phi, (float) si_eta, (float) si_pos.x(), (float) si_pos.y(), (float) si_pos.z(), si.px, si.py, si.pz,
+            (float) tpc_q, (float) tpc_phi, (float) tpc_eta, (float) tpc_pos.x(), (float) tpc_pos.y(), (float) tpc_pos.z(), (float) tpc_px, (float) tpc_py, (float) tpc_pz,
+            (float) tpcid, (float) siid};
+        _tree->Fill(data);
+      }
 
       if (window_deta.in_window(is_posQ, tpc_pt, tpc_eta, si_eta))
       {
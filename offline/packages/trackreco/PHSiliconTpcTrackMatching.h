@@ -9,6 +9,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class TrackSeedContainer;
@@ -100,6 +101,9 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
     void init_bools(const std::string& which_window="", const bool print=false);
 
     bool in_window(bool posQ, const double tpc_pt, const double tpc_X, const double si_X);
+
+    // bounds lo < tpc_X-si_X < hi that include every delta accepted by in_window
+    void delta_range(bool posQ, const double tpc_pt, double& lo, double& hi);
     
     // initialize to fn_lo < deltaX < fn_hi for +Q, and fn_lo < deltaX < fn_hi for -Q
 
@@ -179,6 +183,52 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   short int findCrossingGeometrically(unsigned int tpc_id, unsigned int si_id);
   double getBunchCrossing(unsigned int trid, double z_mismatch);
 
+  // silicon seed parameters used in the matching, computed once per event
+  struct SiliconSeedParams
+  {
+    bool ok = false;
+    double phi = 0;
+    double eta = 0;
+    double pt = 0;
+    float px = 0;
+    float py = 0;
+    float pz = 0;
+    int q = 0;
+    int crossing = 0;
+    Acts::Vector3 pos = Acts::Vector3::Zero();
+  };
+
+  // silicon seeds bucketed in eta and phi, so that each TPC seed only
+  // tests the seeds in the cells allowed by its deta and dphi windows
+  struct SiliconSeedGrid
+  {
+    void fill(const std::vector<SiliconSeedParams> &params);
+
+    // append the ids of seeds in cells overlapping [eta_lo,eta_hi] x [phi_lo,phi_hi]
+    void candidates(double eta_lo, double eta_hi, double phi_lo, double phi_hi, std::vector<unsigned int> &ids) const;
+
+    int bin(double x, double min, double width, int nbins) const;
+
+    int n_eta = 1;
+    int n_phi = 1;
+    double eta_min = 0;
+    double eta_max = 0;
+    double eta_width = 1;
+    double phi_min = 0;
+    double phi_max = 0;
+    double phi_width = 1;
+
+    // seed ids of cell i are in m_ids[m_offsets[i]..m_offsets[i+1]), in increasing order
+    std::vector<unsigned int> m_offsets;
+    std::vector<unsigned int> m_ids;
+  };
+
+  void fillSiliconSeedParams();
+
+  std::vector<SiliconSeedParams> m_si_params;
+  SiliconSeedGrid m_si_grid;
+  std::vector<unsigned int> m_si_candidates;
+
   TFile *_file = nullptr;
   TNtuple *_tree = nullptr;
 
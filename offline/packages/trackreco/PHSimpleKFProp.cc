@@ -28,6 +28,7 @@
 #include <trackbase/TrackFitUtils.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
 #include <trackbase/TrkrClusterIterationMapv1.h>
 #include <trackbase/TrkrDefs.h>
 
@@ -174,6 +175,14 @@ int PHSimpleKFProp::get_nodes(PHCompositeNode* topNode)
   // tpc global position wrapper
   m_globalPositionWrapper.loadNodes(topNode);
 
+  // cluster global positions, shared with other modules
+  m_globalPositionCache = TrkrClusterGlobalPositionCache::getOrCreate(topNode);
+  if (!m_globalPositionCache)
+  {
+    std::cerr << PHWHERE << " ERROR: Can't create cluster global position cache" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
   // clusters
   if (_use_truth_clusters)
   {
@@ -235,7 +244,8 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
   {
     std::cout << "starting Process" << std::endl;
   }
-  const PositionMap globalPositions = PrepareKDTrees();
+  PrepareKDTrees();
+  const TrkrClusterGlobalPositionCache& globalPositions = *m_globalPositionCache;
   if (Verbosity())
   {
     std::cout << "prepared KD trees" << std::endl;
@@ -275,12 +285,6 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       std::vector<std::vector<TrkrDefs::cluskey>> keylist_A(1);
       std::copy(track->begin_cluster_keys(), track->end_cluster_keys(), std::back_inserter(keylist_A[0]));
 
-      // copy seed clusters position into local map
-      std::map<TrkrDefs::cluskey, Acts::Vector3> trackClusPositions;
-      std::transform(track->begin_cluster_keys(), track->end_cluster_keys(), std::inserter(trackClusPositions, trackClusPositions.end()),
-        [globalPositions](const auto& key)
-        { return std::make_pair(key, globalPositions.at(key)); });
-
       /// Can't circle fit a seed with less than 3 clusters, skip it
       if (keylist_A[0].size() < 3)
       {
@@ -294,7 +298,7 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       timer.restart();
 
       auto seedpair = fitter->ALICEKalmanFilter(keylist_A, false,
-                                                trackClusPositions, trackChi2);
+                                                globalPositions, trackChi2);
 
       timer.stop();
       if (Verbosity() > 3)
@@ -305,9 +309,9 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       timer.restart();
 
       /// circle fit back to update track parameters
-      TrackSeedHelper::circleFitByTaubin(track, trackClusPositions, 7, 55);
-      TrackSeedHelper::lineFit(track, trackClusPositions, 7, 55);
-      track->set_phi(TrackSeedHelper::get_phi(track, trackClusPositions));
+      TrackSeedHelper::circleFitByTaubin(track, globalPositions, 7, 55);
+      TrackSeedHelper::lineFit(track, globalPositions, 7, 55);
+      track->set_phi(TrackSeedHelper::get_phi(track, globalPositions));
       timer.stop();
       if (Verbosity() > 3)
       {
@@ -353,16 +357,10 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
 
       auto pretrack = prepair.first.at(0);
 
-      // copy seed clusters position into local map
-      std::map<TrkrDefs::cluskey, Acts::Vector3> pretrackClusPositions;
-      std::transform(pretrack.begin_cluster_keys(), pretrack.end_cluster_keys(), std::inserter(pretrackClusPositions, pretrackClusPositions.end()),
-        [globalPositions](const auto& key)
-        { return std::make_pair(key, globalPositions.at(key)); });
-
       // fit seed
-      TrackSeedHelper::circleFitByTaubin(&pretrack,pretrackClusPositions, 7, 55);
-      TrackSeedHelper::lineFit(&pretrack, pretrackClusPositions, 7, 55);
-      pretrack.set_phi(TrackSeedHelper::get_phi(&pretrack, pretrackClusPositions));
+      TrackSeedHelper::circleFitByTaubin(&pretrack, globalPositions, 7, 55);
+      TrackSeedHelper::lineFit(&pretrack, globalPositions, 7, 55);
+      pretrack.set_phi(TrackSeedHelper::get_phi(&pretrack, globalPositions));
 
       prepair.second.at(0).SetDzDs(-prepair.second.at(0).GetDzDs());
       auto finalchain = PropagateTrack(&pretrack, kl.at(0), PropagationDirection::Outward, prepair.second.at(0), globalPositions);
@@ -443,29 +441,33 @@ Acts::Vector3 PHSimpleKFProp::getGlobalPosition(TrkrDefs::cluskey key, TrkrClust
     m_globalPositionWrapper.getGlobalPositionDistortionCorrected( key, cluster, 0 );
 }
 
-PositionMap PHSimpleKFProp::PrepareKDTrees()
+void PHSimpleKFProp::PrepareKDTrees()
 {
-  PositionMap globalPositions;
   //***** convert clusters to kdhits, and divide by layer
   std::vector<std::vector<std::vector<double>>> kdhits;
   kdhits.resize(58);
   if (!_cluster_map)
   {
     std::cout << "WARNING: (tracking.PHTpcTrackerUtil.convert_clusters_to_hits) cluster map is not provided" << std::endl;
-    return globalPositions;
+    return;
   }
 
-  for (const auto& hitsetkey : _cluster_map->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
+  // positions are computed only once per event, by the first module that needs them
+  // the configuration must match what getGlobalPosition uses
+  const auto configuration = _pp_mode ? TrkrClusterGlobalPositionCache::Configuration{m_tgeometry} : m_globalPositionWrapper.cacheConfiguration();
+  if (!m_globalPositionCache->isFilledFor(_cluster_map, TrkrDefs::TrkrId::tpcId, configuration))
   {
-    auto range = _cluster_map->getClusters(hitsetkey);
-    for (TrkrClusterContainer::ConstIterator it = range.first; it != range.second; ++it)
+    m_globalPositionCache->fill(_cluster_map, TrkrDefs::TrkrId::tpcId, configuration,
+                                [this](TrkrDefs::cluskey key, TrkrCluster* cluster)
+                                { return getGlobalPosition(key, cluster); });
+  }
+
+  {
+    const auto& cluskeys = m_globalPositionCache->keys();
+    const auto& positions = m_globalPositionCache->positions();
+    for (TrkrClusterGlobalPositionCache::index_type i = 0; i < cluskeys.size(); ++i)
     {
-      TrkrDefs::cluskey cluskey = it->first;
-      TrkrCluster* cluster = it->second;
-      if (!cluster)
-      {
-        continue;
-      }
+      const TrkrDefs::cluskey cluskey = cluskeys[i];
 
       // skip hits used in a previous iteration
       if (_n_iteration && _iteration_map && _iteration_map->getIteration(cluskey) > 0)
@@ -473,21 +475,16 @@ PositionMap PHSimpleKFProp::PrepareKDTrees()
         continue;
       }
 
-      const auto globalpos = getGlobalPosition(cluskey, cluster);
-      globalPositions.insert(std::make_pair(cluskey, globalpos));
+      const auto& globalpos = positions[i];
 
       int layer = TrkrDefs::getLayer(cluskey);
       std::vector<double> kdhit(4);
       kdhit[0] = globalpos.x();
       kdhit[1] = globalpos.y();
       kdhit[2] = globalpos.z();
-      uint64_t key = cluskey;
-      std::memcpy(&kdhit[3], &key, sizeof(key));
 
-      //      HINT: way to get original uint64_t value from double:
-      //
-      //      LOG_DEBUG("tracking.PHTpcTrackerUtil.convert_clusters_to_hits")
-      //        << "orig: " << cluster->getClusKey() << ", readback: " << (*((int64_t*)&kdhit[3]));
+      // index in the position cache, from which both key and position are read back
+      kdhit[3] = i;
 
       kdhits[layer].push_back(kdhit);
     }
@@ -513,8 +510,6 @@ PositionMap PHSimpleKFProp::PrepareKDTrees()
     _kdtrees[l] = std::make_shared<nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<double, KDPointCloud<double>>, KDPointCloud<double>, 3>>(3, *(_ptclouds[l]), nanoflann::KDTreeSingleIndexAdaptorParams(10));
     _kdtrees[l]->buildIndex();
   }
-
-  return globalPositions;
 }
 
 bool PHSimpleKFProp::TransportAndRotate(double old_radius, double new_radius, double& phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp) const
@@ -625,7 +620,7 @@ bool PHSimpleKFProp::TransportAndRotate(double old_radius, double new_radius, do
   return true;
 }
 
-bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const
+bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const TrkrClusterGlobalPositionCache& globalPositions) const
 {
   // give up if position vector is NaN (propagation failed)
   if (std::isnan(kftrack.GetX()) ||
@@ -911,9 +906,10 @@ bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_
     return true;
   }
   const std::vector<double>& point = _ptclouds[next_layer]->pts[index_out[0]];
-  TrkrDefs::cluskey closest_ckey = (*((int64_t*) &point[3]));
+  const auto closest_index = static_cast<TrkrClusterGlobalPositionCache::index_type>(point[3]);
+  TrkrDefs::cluskey closest_ckey = globalPositions.key(closest_index);
   TrkrCluster* clusterCandidate = _cluster_map->findCluster(closest_ckey);
-  auto candidate_globalpos = globalPositions.at(closest_ckey);
+  const auto& candidate_globalpos = globalPositions.position(closest_index);
   const double cand_x = candidate_globalpos(0);
   const double cand_y = candidate_globalpos(1);
   const double cand_z = candidate_globalpos(2);
@@ -994,7 +990,7 @@ bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_
   return true;
 }
 
-std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const
+std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const TrkrClusterGlobalPositionCache& globalPositions) const
 {
   // extract cluster list
 
@@ -1009,7 +1005,7 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
   return PropagateTrack(track, ckeys, direction, aliceSeed, globalPositions);
 }
 
-std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const
+std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const TrkrClusterGlobalPositionCache& globalPositions) const
 {
   if (direction == PropagationDirection::Inward)
   {
@@ -1297,7 +1293,7 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
   return propagated_track;
 }
 
-std::vector<keylist> PHSimpleKFProp::RemoveBadClusters(const std::vector<keylist>& chains, const PositionMap& /* globalPositions */) const
+std::vector<keylist> PHSimpleKFProp::RemoveBadClusters(const std::vector<keylist>& chains, const TrkrClusterGlobalPositionCache& /* globalPositions */) const
 {
   if (Verbosity())
   {
@@ -1353,7 +1349,7 @@ std::vector<keylist> PHSimpleKFProp::RemoveBadClusters(const std::vector<keylist
   return clean_chains;
 }
 
-void PHSimpleKFProp::rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, const PositionMap& positions, std::vector<float>& trackChi2, PHTimer& timer)
+void PHSimpleKFProp::rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, const TrkrClusterGlobalPositionCache& positions, std::vector<float>& trackChi2, PHTimer& timer)
 {
   // testing with presets for rejection
   PHGhostRejection rejector(Verbosity(), seeds);
@@ -1379,13 +1375,9 @@ void PHSimpleKFProp::rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, con
     /// The ALICEKF gives a better charge determination at high pT
     const int q = seed.get_charge();
 
-    PositionMap local;
-    std::transform(seed.begin_cluster_keys(), seed.end_cluster_keys(), std::inserter(local, local.end()),
-                   [positions](const auto& key)
-                   { return std::make_pair(key, positions.at(key)); });
-    TrackSeedHelper::circleFitByTaubin(&seed,local, 7, 55);
-    TrackSeedHelper::lineFit(&seed,local, 7, 55);
-    seed.set_phi(TrackSeedHelper::get_phi(&seed,local));
+    TrackSeedHelper::circleFitByTaubin(&seed, positions, 7, 55);
+    TrackSeedHelper::lineFit(&seed, positions, 7, 55);
+    seed.set_phi(TrackSeedHelper::get_phi(&seed, positions));
     seed.set_qOverR(fabs(seed.get_qOverR()) * q);
   }
 
@@ -33,13 +33,12 @@ class ActsGeometry;
 class PHCompositeNode;
 class PHField;
 class TrkrClusterContainer;
+class TrkrClusterGlobalPositionCache;
 class TrkrClusterIterationMapv1;
 class SvtxTrackMap;
 class TrackSeedContainer;
 class TrackSeed;
 
-using PositionMap = std::map<TrkrDefs::cluskey, Acts::Vector3>;
-
 class PHSimpleKFProp : public SubsysReco
 {
  public:
@@ -124,6 +123,9 @@ class PHSimpleKFProp : public SubsysReco
   /// global position wrapper
   TpcGlobalPositionWrapper m_globalPositionWrapper;
 
+  /// per event cluster global positions, shared with other modules
+  TrkrClusterGlobalPositionCache* m_globalPositionCache = nullptr;
+
   /// get global position for a given cluster
   /**
    * uses ActsTransformation to convert cluster local position into global coordinates
@@ -131,17 +133,18 @@ class PHSimpleKFProp : public SubsysReco
    */
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey, TrkrCluster*) const;
 
-  PositionMap PrepareKDTrees();
+  //! fill the position cache if needed and build the per layer kd trees, which store the cache index of each cluster
+  void PrepareKDTrees();
 
   bool TransportAndRotate(double old_layer, double new_layer, double& phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp) const;
 
-  bool PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const;
+  bool PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const TrkrClusterGlobalPositionCache& globalPositions) const;
 
   // TrackSeed objects store clusters in order of increasing cluster key (std::set<TrkrDefs::cluskey>),
   // which means we have to have a way to directly pass a list of clusters in order to extend looping tracks
-  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const;
-  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const;
-  std::vector<std::vector<TrkrDefs::cluskey>> RemoveBadClusters(const std::vector<std::vector<TrkrDefs::cluskey>>& seeds, const PositionMap& globalPositions) const;
+  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const TrkrClusterGlobalPositionCache& globalPositions) const;
+  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const TrkrClusterGlobalPositionCache& globalPositions) const;
+  std::vector<std::vector<TrkrDefs::cluskey>> RemoveBadClusters(const std::vector<std::vector<TrkrDefs::cluskey>>& seeds, const TrkrClusterGlobalPositionCache& globalPositions) const;
   template <typename T>
   struct KDPointCloud
   {
@@ -177,7 +180,7 @@ class PHSimpleKFProp : public SubsysReco
   std::vector<std::shared_ptr<nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<double, KDPointCloud<double>>, KDPointCloud<double>, 3>>> _kdtrees;
   std::unique_ptr<ALICEKF> fitter;
   double get_Bz(double x, double y, double z) const;
-  void rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, const PositionMap& positions, std::vector<float>& trackChi2, PHTimer& timer);
+  void rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, const TrkrClusterGlobalPositionCache& positions, std::vector<float>& trackChi2, PHTimer& timer);
   void publishSeeds(const std::vector<TrackSeed_v2>&);
 
   int _max_propagation_steps = 200;
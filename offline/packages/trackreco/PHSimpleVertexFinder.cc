@@ -34,6 +34,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <vector>
 
@@ -465,19 +466,20 @@ int PHSimpleVertexFinder::GetNodes(PHCompositeNode *topNode)
 
 void PHSimpleVertexFinder::checkDCAs(SvtxTrackMap *track_map)
 {
-  // Loop over tracks and check for close DCA match with all other tracks
-  for (auto tr1_it = track_map->begin(); tr1_it != track_map->end(); ++tr1_it)
+  // select the tracks passing the quality and MVTX requirements once
+  std::vector<SvtxTrack *> tracks;
+  std::vector<Eigen::Vector3d> points;
+  std::vector<Eigen::Vector3d> directions;
+  for (const auto &[id, track] : *track_map)
   {
-    auto id1 = tr1_it->first;
-    auto tr1 = tr1_it->second;
-    if (tr1->get_quality() > _qual_cut)
+    if (track->get_quality() > _qual_cut)
     {
       continue;
     }
     if (_require_mvtx)
     {
       unsigned int nmvtx = 0;
-      TrackSeed *siliconseed = tr1->get_silicon_seed();
+      TrackSeed *siliconseed = track->get_silicon_seed();
       if (!siliconseed)
       {
         continue;
@@ -500,58 +502,113 @@ void PHSimpleVertexFinder::checkDCAs(SvtxTrackMap *track_map)
       }
       if (Verbosity() > 3)
       {
-        std::cout << " tr1 id " << id1 << " has nmvtx at least " << nmvtx << std::endl;
+        std::cout << " track id " << id << " has nmvtx at least " << nmvtx << std::endl;
       }
     }
 
-    // look for close DCA matches with all other such tracks
-    for (auto tr2_it = std::next(tr1_it); tr2_it != track_map->end(); ++tr2_it)
+    tracks.push_back(track);
+    points.emplace_back(track->get_x(), track->get_y(), track->get_z());
+    directions.emplace_back(track->get_px() / track->get_p(), track->get_py() / track->get_p(), track->get_pz() / track->get_p());
+  }
+
+  // look for close DCA matches among the pairs that can meet near the beam line,
+  // in the same order as a loop over all pairs
+  for (const auto &[i1, i2] : findCandidatePairs(points, directions))
+  {
+    if (Verbosity() > 3)
     {
-      auto id2 = tr2_it->first;
-      auto tr2 = tr2_it->second;
-      if (tr2->get_quality() > _qual_cut)
-      {
-        continue;
-      }
-      if (_require_mvtx)
-      {
-        unsigned int nmvtx = 0;
-        TrackSeed *siliconseed = tr2->get_silicon_seed();
-        if (!siliconseed)
-        {
-          continue;
-        }
+      std::cout << "Check DCA for tracks " << tracks[i1]->get_id() << " and  " << tracks[i2]->get_id() << std::endl;
+    }
 
-        for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
-        {
-          if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-          {
-            nmvtx++;
-          }
-          if (nmvtx >= _nmvtx_required)
-          {
-            break;
-          }
-        }
-        if (nmvtx < _nmvtx_required)
-        {
-          continue;
-        }
-        if (Verbosity() > 3)
-        {
-          std::cout << " tr2 id " << id2 << " has nmvtx at least " << nmvtx << std::endl;
-        }
-      }
+    findDcaTwoTracks(tracks[i1], tracks[i2]);
+  }
+}
 
-      // find DCA of these two tracks
-      if (Verbosity() > 3)
+bool PHSimpleVertexFinder::zRangeNearBeamLine(const Eigen::Vector3d &a, const Eigen::Vector3d &b,
+                                              double &zmin, double &zmax) const
+{
+  // range of the line parameter c for which a + c*b is inside the transverse box
+  // |x|,|y| < _beamline_xy_cut + _active_dcacut. The first PCA of an accepted pair
+  // is inside |x|,|y| < _beamline_xy_cut, and the second is within the dca of it
+  const double halfwidth = _beamline_xy_cut + _active_dcacut;
+  double cmin = -std::numeric_limits<double>::infinity();
+  double cmax = std::numeric_limits<double>::infinity();
+  for (int i = 0; i < 2; ++i)
+  {
+    if (!std::isfinite(a(i)) || !std::isfinite(b(i)))
+    {
+      return false;
+    }
+    if (b(i) == 0)
+    {
+      if (std::fabs(a(i)) > halfwidth)
       {
-        std::cout << "Check DCA for tracks " << id1 << " and  " << id2 << std::endl;
+        return false;
       }
+      continue;
+    }
+    const double c1 = (-halfwidth - a(i)) / b(i);
+    const double c2 = (halfwidth - a(i)) / b(i);
+    cmin = std::max(cmin, std::min(c1, c2));
+    cmax = std::min(cmax, std::max(c1, c2));
+  }
+  if (cmin > cmax || !std::isfinite(a.z()) || !std::isfinite(b.z()))
+  {
+    return false;
+  }
 
-      findDcaTwoTracks(tr1, tr2);
+  if (b.z() == 0)
+  {
+    zmin = zmax = a.z();
+  }
+  else
+  {
+    zmin = std::min(a.z() + cmin * b.z(), a.z() + cmax * b.z());
+    zmax = std::max(a.z() + cmin * b.z(), a.z() + cmax * b.z());
+  }
+  return true;
+}
+
+std::vector<std::pair<unsigned int, unsigned int>> PHSimpleVertexFinder::findCandidatePairs(
+    const std::vector<Eigen::Vector3d> &points, const std::vector<Eigen::Vector3d> &directions) const
+{
+  // Two lines can only pass the DCA and beam line cuts if their z ranges near the
+  // beam line are within the DCA cut of each other. Sort the ranges in zmin and
+  // sweep, so that only overlapping ranges are paired.
+  // Phi is not used: tracks from a common vertex can have any phi
+  struct ZRange
+  {
+    double zmin = 0;
+    double zmax = 0;
+    unsigned int index = 0;
+  };
+  std::vector<ZRange> ranges;
+  ranges.reserve(points.size());
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    ZRange range;
+    range.index = i;
+    if (zRangeNearBeamLine(points[i], directions[i], range.zmin, range.zmax))
+    {
+      ranges.push_back(range);
     }
   }
+  std::sort(ranges.begin(), ranges.end(), [](const ZRange &lhs, const ZRange &rhs)
+            { return lhs.zmin < rhs.zmin; });
+
+  // margin against rounding in the PCA calculation
+  const double zwindow = _active_dcacut + 1e-6;
+  std::vector<std::pair<unsigned int, unsigned int>> pairs;
+  for (auto it1 = ranges.begin(); it1 != ranges.end(); ++it1)
+  {
+    for (auto it2 = std::next(it1); it2 != ranges.end() && it2->zmin <= it1->zmax + zwindow; ++it2)
+    {
+      pairs.emplace_back(std::min(it1->index, it2->index), std::max(it1->index, it2->index));
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
 }
 
 void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map)
@@ -654,46 +711,53 @@ void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map)
     cumulative_fitpars_vec.push_back(fitpars);
   }
 
-  for(unsigned int i1 = 0; i1 < cumulative_trackid_vec.size(); ++i1)
+  // straight lines for the tracks with a successful fit
+  //  For straight line: fitpars[4] = { xyslope, y0, xzslope, z0 }
+  std::vector<unsigned int> fitted;
+  std::vector<Eigen::Vector3d> points;
+  std::vector<Eigen::Vector3d> directions;
+  for (unsigned int i = 0; i < cumulative_trackid_vec.size(); ++i)
+  {
+    if (cumulative_fitpars_vec[i].size() == 0)
     {
-      if(cumulative_fitpars_vec[i1].size() == 0) { continue; }
+      continue;
+    }
+    fitted.push_back(i);
+    points.emplace_back(0.0, cumulative_fitpars_vec[i][1], cumulative_fitpars_vec[i][3]);
+    directions.emplace_back(1.0, cumulative_fitpars_vec[i][0], cumulative_fitpars_vec[i][2]);
+  }
 
-      for(unsigned int i2 = i1; i2 < cumulative_trackid_vec.size(); ++i2)
+  for (const auto &[j1, j2] : findCandidatePairs(points, directions))
+    {
+      // point on the track at x = 0, direction vector made from dy/dx = xyslope and dz/dx = xzslope
+      const Eigen::Vector3d &a1 = points[j1];
+      const Eigen::Vector3d &a2 = points[j2];
+      const Eigen::Vector3d &b1 = directions[j1];
+      const Eigen::Vector3d &b2 = directions[j2];
+
+      Eigen::Vector3d PCA1(0, 0, 0);
+      Eigen::Vector3d PCA2(0, 0, 0);
+      double dca = dcaTwoLines(a1, b1, a2, b2, PCA1, PCA2);
+
+      // check dca cut is satisfied, and that PCA is close to beam line
+      if (fabs(dca) < _active_dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
 	{
-	  if(cumulative_fitpars_vec[i2].size() == 0) { continue; }
-
-	  //  For straight line: fitpars[4] = { xyslope, y0, xzslope, z0 }
-	  Eigen::Vector3d a1(0.0, cumulative_fitpars_vec[i1][1],cumulative_fitpars_vec[i1][3]);      // point on track 1 at x = 0
-	  Eigen::Vector3d a2(0.0, cumulative_fitpars_vec[i2][1],cumulative_fitpars_vec[i2][3]);      // point on track 2 at x = 0
-	  // direction vectors made from dy/dx = xyslope and dz/dx = xzslope
-	  Eigen::Vector3d b1(1.0, cumulative_fitpars_vec[i1][0],cumulative_fitpars_vec[i1][2]);      // direction vector of track 1
-	  Eigen::Vector3d b2(1.0, cumulative_fitpars_vec[i2][0],cumulative_fitpars_vec[i2][2]);      // direction vector of track 2
-	  	  
-	  Eigen::Vector3d PCA1(0, 0, 0);
-	  Eigen::Vector3d PCA2(0, 0, 0);
-	  double dca = dcaTwoLines(a1, b1, a2, b2, PCA1, PCA2);
-
-
-	  // check dca cut is satisfied, and that PCA is close to beam line
-	  if (fabs(dca) < _active_dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
+	  int id1 = cumulative_trackid_vec[fitted[j1]];
+	  int id2 = cumulative_trackid_vec[fitted[j2]];
+
+	  if (Verbosity() > 3)
 	    {
-	      int id1 = cumulative_trackid_vec[i1];
-	      int id2 = cumulative_trackid_vec[i2];
-
-	      if (Verbosity() > 3)
-		{
-		  std::cout << " good match for tracks " << id1 << " and " << id2 << std::endl;
-		  std::cout << "    a1.x " << a1.x() << " a1.y " << a1.y() << " a1.z " << a1.z() << std::endl;
-		  std::cout << "    a2.x  " << a2.x() << " a2.y " << a2.y() << " a2.z " << a2.z() << std::endl;
-		  std::cout << "    PCA1.x() " << PCA1.x() << " PCA1.y " << PCA1.y() << " PCA1.z " << PCA1.z() << std::endl;
-		  std::cout << "    PCA2.x() " << PCA2.x() << " PCA2.y " << PCA2.y() << " PCA2.z " << PCA2.z() << std::endl;
-		  std::cout << "    dca " << dca << std::endl;
-		}
-	      
-	      // capture the results for successful matches
-	      _track_pair_map.insert(std::make_pair(id1, std::make_pair(id2, dca)));
-	      _track_pair_pca_map.insert(std::make_pair(id1, std::make_pair(id2, std::make_pair(PCA1, PCA2))));
-	    }	  	  
+	      std::cout << " good match for tracks " << id1 << " and " << id2 << std::endl;
+	      std::cout << "    a1.x " << a1.x() << " a1.y " << a1.y() << " a1.z " << a1.z() << std::endl;
+	      std::cout << "    a2.x  " << a2.x() << " a2.y " << a2.y() << " a2.z " << a2.z() << std::endl;
+	      std::cout << "    PCA1.x() " << PCA1.x() << " PCA1.y " << PCA1.y() << " PCA1.z " << PCA1.z() << std::endl;
+	      std::cout << "    PCA2.x() " << PCA2.x() << " PCA2.y " << PCA2.y() << " PCA2.z " << PCA2.z() << std::endl;
+	      std::cout << "    dca " << dca << std::endl;
+	    }
+
+	  // capture the results for successful matches
+	  _track_pair_map.insert(std::make_pair(id1, std::make_pair(id2, dca)));
+	  _track_pair_pca_map.insert(std::make_pair(id1, std::make_pair(id2, std::make_pair(PCA1, PCA2))));
 	}
     }
 
@@ -17,6 +17,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -68,6 +69,11 @@ class PHSimpleVertexFinder : public SubsysReco
   double dcaTwoLines(const Eigen::Vector3d &p1, const Eigen::Vector3d &v1,
                      const Eigen::Vector3d &p2, const Eigen::Vector3d &v2,
                      Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2);
+  //! pairs of lines (indices i < j, sorted) that can meet the DCA and beam line cuts
+  std::vector<std::pair<unsigned int, unsigned int>> findCandidatePairs(const std::vector<Eigen::Vector3d> &points,
+                                                                       const std::vector<Eigen::Vector3d> &directions) const;
+  //! z range of the line a + c*b close enough to the beam line to be part of a pair
+  bool zRangeNearBeamLine(const Eigen::Vector3d &a, const Eigen::Vector3d &b, double &zmin, double &zmax) const;
   std::vector<std::set<unsigned int>> findConnectedTracks();
   void removeOutlierTrackPairs();
   double getMedian(std::vector<double> &v);
@@ -23,12 +23,14 @@
 
 #include <TVector3.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
 #include <iostream>  // for operator<<, basic_ostream
 #include <map>
 #include <set>
+#include <vector>
 
 SvtxClusterEval::SvtxClusterEval(PHCompositeNode* topNode)
   : _hiteval(topNode)
@@ -49,18 +51,13 @@ SvtxClusterEval::~SvtxClusterEval()
 
 void SvtxClusterEval::next_event(PHCompositeNode* topNode)
 {
-  _cache_all_truth_hits.clear();
   _cache_all_truth_clusters.clear();
   _cache_max_truth_hit_by_energy.clear();
   _cache_max_truth_cluster_by_energy.clear();
-  _cache_all_truth_particles.clear();
   _cache_max_truth_particle_by_energy.clear();
   _cache_max_truth_particle_by_cluster_energy.clear();
-  _cache_all_clusters_from_particle.clear();
-  _cache_all_clusters_from_g4hit.clear();
   _cache_best_cluster_from_g4hit.clear();
-  _cache_get_energy_contribution_g4particle.clear();
-  _cache_get_energy_contribution_g4hit.clear();
+  _truth_links.clear();
   _cache_best_cluster_from_gtrackid_layer.clear();
   _clusters_per_layer.clear();
   //  _g4hits_per_layer.clear();
@@ -345,12 +342,13 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
 
   if (_do_cache)
   {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>>::iterator iter =
-        _cache_all_truth_hits.find(cluster_key);
-    if (iter != _cache_all_truth_hits.end())
+    std::set<PHG4Hit*> truth_hits;
+    auto range = truth_links().find_key(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      truth_hits.insert(iter->g4hit);
     }
+    return truth_hits;
   }
 
   std::set<PHG4Hit*> truth_hits;
@@ -403,11 +401,6 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     }  // end loop over g4hits associated with hitsetkey and hitkey
   }    // end loop over hits associated with cluskey
 
-  if (_do_cache)
-  {
-    _cache_all_truth_hits.insert(std::make_pair(cluster_key, truth_hits));
-  }
-
   return truth_hits;
 }
 
@@ -787,12 +780,22 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
 
   if (_do_cache)
   {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>>::iterator iter =
-        _cache_all_truth_particles.find(cluster_key);
-    if (iter != _cache_all_truth_particles.end())
+    std::set<PHG4Particle*> truth_particles;
+    auto range = truth_links().find_key(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      if (_strict)
+      {
+        assert(iter->particle);
+      }
+      else if (!iter->particle)
+      {
+        ++_errors;
+        continue;
+      }
+      truth_particles.insert(iter->particle);
     }
+    return truth_particles;
   }
 
   std::set<PHG4Particle*> truth_particles;
@@ -817,11 +820,6 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
     truth_particles.insert(particle);
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_particles.insert(std::make_pair(cluster_key, truth_particles));
-  }
-
   return truth_particles;
 }
 
@@ -936,23 +934,13 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Particle* tru
     ++_errors;
     return std::set<TrkrDefs::cluskey>();
   }
-  // check if cache is filled, if not fill it.
-  //   if(_cache_all_clusters_from_particle.count(truthparticle)==0){
-  if (_cache_all_clusters_from_particle.empty())
-  {
-    FillRecoClusterFromG4HitCache();
-  }
 
-  if (_do_cache)
+  std::set<TrkrDefs::cluskey> clusters;
+  auto range = truth_links().find_trkid(truthparticle->get_track_id());
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>>::iterator iter =
-        _cache_all_clusters_from_particle.find(truthparticle);
-    if (iter != _cache_all_clusters_from_particle.end())
-    {
-      return iter->second;
-    }
+    clusters.insert(clusters.end(), iter->key);
   }
-  std::set<TrkrDefs::cluskey> clusters;
   return clusters;
 }
 
@@ -962,44 +950,80 @@ void SvtxClusterEval::FillRecoClusterFromG4HitCache()
   Mytimer->stop();
   Mytimer->restart();
 
-  std::multimap<PHG4Particle*, TrkrDefs::cluskey> temp_clusters_from_particles;
-  // loop over all the clusters
-  for (const auto& hitsetkey : _clustermap->getHitSetKeys())
+  // one pass over all clusters, their hits and the g4hits of these hits
+  _truth_links.clear();
+  if (_cluster_hit_map && _hit_truth_map)
   {
-    auto range = _clustermap->getClusters(hitsetkey);
-    for (auto iter = range.first; iter != range.second; ++iter)
+    // (hitkey, g4hitkey) pairs of the current hitset, sorted by hitkey
+    std::vector<std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>> hit_g4hits;
+    for (const auto& hitsetkey : _clustermap->getHitSetKeys())
     {
-      TrkrDefs::cluskey cluster_key = iter->first;
+      PHG4HitContainer* g4hits = nullptr;
+      switch (TrkrDefs::getTrkrId(hitsetkey))
+      {
+      case TrkrDefs::tpcId:
+        g4hits = _g4hits_tpc;
+        break;
+      case TrkrDefs::inttId:
+        g4hits = _g4hits_intt;
+        break;
+      case TrkrDefs::mvtxId:
+        g4hits = _g4hits_mvtx;
+        break;
+      case TrkrDefs::micromegasId:
+        g4hits = _g4hits_mms;
+        break;
+      default:
+        break;
+      }
+      if (!g4hits)
+      {
+        continue;
+      }
 
-      // loop over all truth particles connected to this cluster
-      std::set<PHG4Particle*> particles = all_truth_particles(cluster_key);
-      for (auto candidate : particles)
+      hit_g4hits.clear();
+      const auto g4range = _hit_truth_map->getG4HitRange(hitsetkey);
+      for (auto htiter = g4range.first; htiter != g4range.second; ++htiter)
       {
-        temp_clusters_from_particles.insert(std::make_pair(candidate, cluster_key));
+        hit_g4hits.push_back(htiter->second);
+      }
+      std::sort(hit_g4hits.begin(), hit_g4hits.end());
+
+      auto range = _clustermap->getClusters(hitsetkey);
+      for (auto iter = range.first; iter != range.second; ++iter)
+      {
+        TrkrDefs::cluskey cluster_key = iter->first;
+        const auto hitrange = _cluster_hit_map->getHits(cluster_key);
+        for (auto clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
+        {
+          TrkrDefs::hitkey hitkey = clushititer->second;
+          auto g4iter = std::lower_bound(hit_g4hits.begin(), hit_g4hits.end(), std::make_pair(hitkey, PHG4HitDefs::keytype(0)));
+          for (; g4iter != hit_g4hits.end() && g4iter->first == hitkey; ++g4iter)
+          {
+            PHG4Hit* g4hit = g4hits->findHit(g4iter->second);
+            if (g4hit)
+            {
+              _truth_links.add(cluster_key, g4hit, _truthinfo->GetParticle(g4hit->get_trkid()));
+            }
+          }
+        }
       }
     }
   }
-  // Loop over particles and fill cache
-  PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second; ++iter)
-  {
-    PHG4Particle* g4particle = iter->second;
-    std::set<TrkrDefs::cluskey> clusters;
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
-    {
-      TrkrDefs::cluskey cluster_key = cfp_iter->second;
-      clusters.insert(cluster_key);
-    }
-    _cache_all_clusters_from_particle.insert(std::make_pair(g4particle, clusters));
-  }
+  _truth_links.sort();
 
   Mytimer->stop();
 }
 
+const SvtxTruthLinks<TrkrDefs::cluskey>& SvtxClusterEval::truth_links()
+{
+  if (!_truth_links.filled())
+  {
+    FillRecoClusterFromG4HitCache();
+  }
+  return _truth_links;
+}
+
 std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit)
 {
   if (!has_node_pointers())
@@ -1018,107 +1042,16 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit
     return std::set<TrkrDefs::cluskey>();
   }
 
-  // one time, fill cache of g4hit/cluster pairs
-  if (_cache_all_clusters_from_g4hit.size() == 0)
-  {
-    // make a map of truthhit, cluster_key inside this loop
-    std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey> truth_cluster_map;
-    std::set<PHG4HitDefs::keytype> all_g4hits_set;
-    std::map<PHG4HitDefs::keytype, PHG4Hit*> all_g4hits_map;
-
-    // get all reco clusters
-    if (_verbosity > 1)
-    {
-      std::cout << "all_clusters_from_g4hit: list all reco clusters " << std::endl;
-    }
-
-    for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-    {
-      auto range = _clustermap->getClusters(hitsetkey);
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        TrkrDefs::cluskey cluster_key = iter->first;
-        int layer = TrkrDefs::getLayer(cluster_key);
-        TrkrCluster* clus = iter->second;
-        if (_verbosity > 1)
-        {
-          std::cout << " layer " << layer << " cluster_key " << cluster_key << " adc " << clus->getAdc()
-                    << " localx " << clus->getLocalX()
-                    << " localy " << clus->getLocalY()
-                    << std::endl;
-          std::cout << "  associated hits:";
-          std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-              hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-          for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-                   clushititer = hitrange.first;
-               clushititer != hitrange.second; ++clushititer)
-          {
-            TrkrDefs::hitkey hitkey = clushititer->second;
-            std::cout << " " << hitkey;
-          }
-          std::cout << std::endl;
-        }
-
-        // the returned truth hits were obtained from TrkrAssoc maps
-        std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-        for (auto candidate : hits)
-        {
-          PHG4HitDefs::keytype g4hit_key = candidate->get_hit_id();
-
-          if (_verbosity > 5)
-          {
-            int gtrackID = candidate->get_trkid();
-            std::cout << "   adding cluster with cluster_key " << cluster_key << " g4hit with g4hit_key " << g4hit_key
-                      << " gtrackID " << gtrackID
-                      << std::endl;
-          }
-
-          all_g4hits_set.insert(g4hit_key);
-          all_g4hits_map.insert(std::make_pair(g4hit_key, candidate));
-
-          truth_cluster_map.insert(std::make_pair(g4hit_key, cluster_key));
-        }
-      }
-    }
-
-    // now fill the cache
-    // loop over all entries in all_g4hits
-    for (unsigned long long g4hit_key : all_g4hits_set)
-    {
-      if (_verbosity > 5)
-      {
-        std::cout << " associations for g4hit_key " << g4hit_key << std::endl;
-      }
-
-      std::map<PHG4HitDefs::keytype, PHG4Hit*>::iterator it = all_g4hits_map.find(g4hit_key);
-      PHG4Hit* g4hit = it->second;
-
-      std::set<TrkrDefs::cluskey> assoc_clusters;
-
-      std::pair<std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator,
-                std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator>
-          ret = truth_cluster_map.equal_range(g4hit_key);
-      for (std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator jter = ret.first; jter != ret.second; ++jter)
-      {
-        assoc_clusters.insert(jter->second);
-
-        if (_verbosity > 5)
-        {
-          std::cout << "             g4hit_key " << g4hit_key << " associated with cluster_key " << jter->second << std::endl;
-        }
-      }
-      // done with this g4hit
-      _cache_all_clusters_from_g4hit.insert(std::make_pair(g4hit, assoc_clusters));
-    }
-  }
-
   // get the clusters
   std::set<TrkrDefs::cluskey> clusters;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>>::iterator iter =
-      _cache_all_clusters_from_g4hit.find(truthhit);
-  if (iter != _cache_all_clusters_from_g4hit.end())
+  auto range = truth_links().find_g4hit(truthhit);
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    return iter->second;
+    clusters.insert(clusters.end(), iter->key);
+  }
+  if (!clusters.empty())
+  {
+    return clusters;
   }
 
   if (_clusters_per_layer.size() == 0)
@@ -1277,17 +1210,21 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return NAN;
   }
 
+  float energy = 0.0;
+
   if (_do_cache)
   {
-    std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4particle.find(std::make_pair(cluster_key, particle));
-    if (iter != _cache_get_energy_contribution_g4particle.end())
+    auto range = truth_links().find_key(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      if (iter->trkid == particle->get_track_id())
+      {
+        energy += iter->edep;
+      }
     }
+    return energy;
   }
 
-  float energy = 0.0;
   std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
   for (auto hit : hits)
   {
@@ -1297,11 +1234,6 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4particle.insert(std::make_pair(std::make_pair(cluster_key, particle), energy));
-  }
-
   return energy;
 }
 
@@ -1324,17 +1256,24 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return NAN;
   }
 
-  if ((_do_cache) &&
-      (_cache_get_energy_contribution_g4hit.find(std::make_pair(cluster_key, g4hit)) !=
-       _cache_get_energy_contribution_g4hit.end()))
-  {
-    return _cache_get_energy_contribution_g4hit[std::make_pair(cluster_key, g4hit)];
-  }
-
   // this is a fairly simple existance check right now, but might be more
   // complex in the future, so this is here mostly as future-proofing.
 
   float energy = 0.0;
+
+  if (_do_cache)
+  {
+    auto range = truth_links().find_key(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->g4hit->get_hit_id() == g4hit->get_hit_id())
+      {
+        energy += iter->edep;
+      }
+    }
+    return energy;
+  }
+
   std::set<PHG4Hit*> g4hits = all_truth_hits(cluster_key);
   for (auto candidate : g4hits)
   {
@@ -1345,11 +1284,6 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     energy += candidate->get_edep();
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4hit.insert(std::make_pair(std::make_pair(cluster_key, g4hit), energy));
-  }
-
   return energy;
 }
 
@@ -47,11 +47,8 @@ void SvtxHitEval::next_event(PHCompositeNode* topNode)
   _cache_max_truth_hit_by_energy.clear();
   _cache_all_truth_particles.clear();
   _cache_max_truth_particle_by_energy.clear();
-  _cache_all_hits_from_particle.clear();
-  _cache_all_hits_from_g4hit.clear();
   _cache_best_hit_from_g4hit.clear();
-  _cache_get_energy_contribution_g4particle.clear();
-  _cache_get_energy_contribution_g4hit.clear();
+  _truth_links.clear();
 
   _trutheval.next_event(topNode);
 
@@ -128,12 +125,13 @@ std::set<PHG4Hit*> SvtxHitEval::all_truth_hits(TrkrDefs::hitkey hit_key)
 
   if (_do_cache)
   {
-    std::map<TrkrDefs::hitkey, std::set<PHG4Hit*> >::iterator iter =
-        _cache_all_truth_hits.find(hit_key);
-    if (iter != _cache_all_truth_hits.end())
+    std::set<PHG4Hit*> truth_hits;
+    auto range = truth_links().find_key(hit_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      truth_hits.insert(iter->g4hit);
     }
+    return truth_hits;
   }
 
   std::set<PHG4Hit*> truth_hits;
@@ -227,11 +225,6 @@ std::set<PHG4Hit*> SvtxHitEval::all_truth_hits(TrkrDefs::hitkey hit_key)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_hits.insert(std::make_pair(hit_key, truth_hits));
-  }
-
   return truth_hits;
 }
 
@@ -468,12 +461,22 @@ std::set<PHG4Particle*> SvtxHitEval::all_truth_particles(TrkrDefs::hitkey hit_ke
 
   if (_do_cache)
   {
-    std::map<TrkrDefs::hitkey, std::set<PHG4Particle*> >::iterator iter =
-        _cache_all_truth_particles.find(hit_key);
-    if (iter != _cache_all_truth_particles.end())
+    std::set<PHG4Particle*> truth_particles;
+    auto range = truth_links().find_key(hit_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      if (_strict)
+      {
+        assert(iter->particle);
+      }
+      else if (!iter->particle)
+      {
+        ++_errors;
+        continue;
+      }
+      truth_particles.insert(iter->particle);
     }
+    return truth_particles;
   }
 
   std::set<PHG4Particle*> truth_particles;
@@ -501,11 +504,6 @@ std::set<PHG4Particle*> SvtxHitEval::all_truth_particles(TrkrDefs::hitkey hit_ke
     truth_particles.insert(particle);
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_particles.insert(std::make_pair(hit_key, truth_particles));
-  }
-
   return truth_particles;
 }
 
@@ -724,12 +722,13 @@ std::set<TrkrDefs::hitkey> SvtxHitEval::all_hits_from(PHG4Particle* g4particle)
 
   if (_do_cache)
   {
-    std::map<PHG4Particle*, std::set<TrkrDefs::hitkey> >::iterator iter =
-        _cache_all_hits_from_particle.find(g4particle);
-    if (iter != _cache_all_hits_from_particle.end())
+    std::set<TrkrDefs::hitkey> hits;
+    auto range = truth_links().find_trkid(g4particle->get_track_id());
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      hits.insert(hits.end(), iter->key);
     }
+    return hits;
   }
 
   std::set<TrkrDefs::hitkey> hits;
@@ -758,11 +757,6 @@ std::set<TrkrDefs::hitkey> SvtxHitEval::all_hits_from(PHG4Particle* g4particle)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_all_hits_from_particle.insert(std::make_pair(g4particle, hits));
-  }
-
   return hits;
 }
 
@@ -792,20 +786,23 @@ std::set<TrkrDefs::hitkey> SvtxHitEval::all_hits_from(PHG4Hit* g4hit)
     return std::set<TrkrDefs::hitkey>();
   }
 
+  std::set<TrkrDefs::hitkey> hits;
+
+  unsigned int hit_layer = g4hit->get_layer();
+
   if (_do_cache)
   {
-    std::map<PHG4Hit*, std::set<TrkrDefs::hitkey> >::iterator iter =
-        _cache_all_hits_from_g4hit.find(g4hit);
-    if (iter != _cache_all_hits_from_g4hit.end())
+    auto range = truth_links().find_g4hit(g4hit);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      if (TrkrDefs::getLayer(iter->key) == hit_layer)
+      {
+        hits.insert(hits.end(), iter->key);
+      }
     }
+    return hits;
   }
 
-  std::set<TrkrDefs::hitkey> hits;
-
-  unsigned int hit_layer = g4hit->get_layer();
-
   // loop over all the hits
   TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets();
   for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first;
@@ -834,11 +831,6 @@ std::set<TrkrDefs::hitkey> SvtxHitEval::all_hits_from(PHG4Hit* g4hit)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_all_hits_from_g4hit.insert(std::make_pair(g4hit, hits));
-  }
-
   return hits;
 }
 
@@ -927,17 +919,21 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Particl
     return NAN;
   }
 
+  float energy = 0.0;
+
   if (_do_cache)
   {
-    std::map<std::pair<TrkrDefs::hitkey, PHG4Particle*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4particle.find(std::make_pair(hit_key, particle));
-    if (iter != _cache_get_energy_contribution_g4particle.end())
+    auto range = truth_links().find_key(hit_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      if (iter->trkid == particle->get_track_id())
+      {
+        energy += iter->edep;
+      }
     }
+    return energy;
   }
 
-  float energy = 0.0;
   std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key);
   for (auto g4hit : g4hits)
   {
@@ -947,11 +943,6 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Particl
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4particle.insert(std::make_pair(std::make_pair(hit_key, particle), energy));
-  }
-
   return energy;
 }
 
@@ -982,20 +973,24 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Hit* g4
     return NAN;
   }
 
+  // this is a fairly simple existance check right now, but might be more
+  // complex in the future, so this is here mostly as future-proofing.
+
+  float energy = 0.0;
+
   if (_do_cache)
   {
-    std::map<std::pair<TrkrDefs::hitkey, PHG4Hit*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4hit.find(std::make_pair(hit_key, g4hit));
-    if (iter != _cache_get_energy_contribution_g4hit.end())
+    auto range = truth_links().find_key(hit_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      if (iter->g4hit->get_hit_id() == g4hit->get_hit_id())
+      {
+        energy += iter->edep;
+      }
     }
+    return energy;
   }
 
-  // this is a fairly simple existance check right now, but might be more
-  // complex in the future, so this is here mostly as future-proofing.
-
-  float energy = 0.0;
   std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key);
   for (auto candidate : g4hits)
   {
@@ -1006,12 +1001,70 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Hit* g4
     energy += candidate->get_edep();
   }
 
-  if (_do_cache)
+  return energy;
+}
+
+const SvtxTruthLinks<TrkrDefs::hitkey>& SvtxHitEval::truth_links()
+{
+  if (!_truth_links.filled())
   {
-    _cache_get_energy_contribution_g4hit.insert(std::make_pair(std::make_pair(hit_key, g4hit), energy));
+    fill_truth_links();
   }
+  return _truth_links;
+}
 
-  return energy;
+void SvtxHitEval::fill_truth_links()
+{
+  // one pass over all hits and their g4hits, with the same semantics as the uncached
+  // all_truth_hits(): a hitkey collects the g4hits of all hitsets containing it
+  _truth_links.clear();
+  if (_hit_truth_map)
+  {
+    TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets();
+    for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first; iter != all_hitsets.second; ++iter)
+    {
+      TrkrDefs::hitsetkey hitset_key = iter->first;
+      TrkrHitSet* hitset = iter->second;
+      PHG4HitContainer* g4hits = nullptr;
+      switch (TrkrDefs::getTrkrId(hitset_key))
+      {
+      case TrkrDefs::tpcId:
+        g4hits = _g4hits_tpc;
+        break;
+      case TrkrDefs::inttId:
+        g4hits = _g4hits_intt;
+        break;
+      case TrkrDefs::mvtxId:
+        g4hits = _g4hits_mvtx;
+        break;
+      case TrkrDefs::micromegasId:
+        g4hits = _g4hits_mms;
+        break;
+      default:
+        break;
+      }
+      if (!g4hits)
+      {
+        continue;
+      }
+
+      const auto range = _hit_truth_map->getG4HitRange(hitset_key);
+      for (auto htiter = range.first; htiter != range.second; ++htiter)
+      {
+        TrkrDefs::hitkey hit_key = htiter->second.first;
+        if (!hitset->getHit(hit_key))
+        {
+          continue;
+        }
+        PHG4Hit* g4hit = g4hits->findHit(htiter->second.second);
+        if (g4hit)
+        {
+          _truth_links.add(hit_key, g4hit, _truthinfo->GetParticle(g4hit->get_trkid()));
+        }
+      }
+    }
+  }
+  _truth_links.sort();
 }
 
 void SvtxHitEval::get_node_pointers(PHCompositeNode* topNode)
@@ -2,6 +2,7 @@
 #define G4EVAL_SVTXHITEVAL_H
 
 #include "SvtxTruthEval.h"
+#include "SvtxTruthLinks.h"
 
 #include <trackbase/TrkrDefs.h>
 
@@ -79,6 +80,10 @@ class SvtxHitEval
   void get_node_pointers(PHCompositeNode* topNode);
   bool has_node_pointers();
 
+  //! hit - g4hit - particle table of this event, filled on first use
+  const SvtxTruthLinks<TrkrDefs::hitkey>& truth_links();
+  void fill_truth_links();
+
   SvtxTruthEval _trutheval;
   TrkrHitSetContainer* _hitmap = nullptr;
   TrkrClusterContainer* _clustermap{};
@@ -100,11 +105,8 @@ class SvtxHitEval
   std::map<TrkrDefs::hitkey, PHG4Hit*> _cache_max_truth_hit_by_energy;
   std::map<TrkrDefs::hitkey, std::set<PHG4Particle*> > _cache_all_truth_particles;
   std::map<TrkrDefs::hitkey, PHG4Particle*> _cache_max_truth_particle_by_energy;
-  std::map<PHG4Particle*, std::set<TrkrDefs::hitkey> > _cache_all_hits_from_particle;
-  std::map<PHG4Hit*, std::set<TrkrDefs::hitkey> > _cache_all_hits_from_g4hit;
   std::map<PHG4Hit*, TrkrDefs::hitkey> _cache_best_hit_from_g4hit;
-  std::map<std::pair<TrkrDefs::hitkey, PHG4Particle*>, float> _cache_get_energy_contribution_g4particle;
-  std::map<std::pair<TrkrDefs::hitkey, PHG4Hit*>, float> _cache_get_energy_contribution_g4hit;
+  SvtxTruthLinks<TrkrDefs::hitkey> _truth_links;
 };
 
 #endif  // G4EVAL_SVTXHITEVAL_H
@@ -17,10 +17,13 @@
 
 #include <phool/getClass.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
+#include <functional>  // for less
 #include <iostream>
 #include <set>
+#include <vector>
 
 SvtxTrackEval::SvtxTrackEval(PHCompositeNode* topNode)
   : _clustereval(topNode)
@@ -44,14 +47,15 @@ void SvtxTrackEval::next_event(PHCompositeNode* topNode)
   _cache_all_truth_hits.clear();
   _cache_all_truth_particles.clear();
   _cache_max_truth_particle_by_nclusters.clear();
-  _cache_all_tracks_from_particle.clear();
   _cache_best_track_from_particle.clear();
-  _cache_all_tracks_from_g4hit.clear();
   _cache_all_tracks_from_cluster.clear();
   _cache_best_track_from_cluster.clear();
   _cache_get_nclusters_contribution.clear();
   _cache_get_nclusters_contribution_by_layer.clear();
   _cache_get_nwrongclusters_contribution.clear();
+  _track_links.clear();
+  _track_links_by_trkid.clear();
+  _track_links_filled = false;
   _clustereval.next_event(topNode);
 
   get_node_pointers(topNode);
@@ -308,12 +312,7 @@ std::set<SvtxTrack*> SvtxTrackEval::all_tracks_from(PHG4Particle* truthparticle)
 
   if (_do_cache)
   {
-    std::map<PHG4Particle*, std::set<SvtxTrack*> >::iterator iter =
-        _cache_all_tracks_from_particle.find(truthparticle);
-    if (iter != _cache_all_tracks_from_particle.end())
-    {
-      return iter->second;
-    }
+    return tracks_from_trkid(truthparticle->get_track_id());
   }
 
   std::set<SvtxTrack*> tracks;
@@ -348,11 +347,6 @@ std::set<SvtxTrack*> SvtxTrackEval::all_tracks_from(PHG4Particle* truthparticle)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_all_tracks_from_particle.insert(std::make_pair(truthparticle, tracks));
-  }
-
   return tracks;
 }
 
@@ -376,12 +370,7 @@ std::set<SvtxTrack*> SvtxTrackEval::all_tracks_from(PHG4Hit* truthhit)
 
   if (_do_cache)
   {
-    std::map<PHG4Hit*, std::set<SvtxTrack*> >::iterator iter =
-        _cache_all_tracks_from_g4hit.find(truthhit);
-    if (iter != _cache_all_tracks_from_g4hit.end())
-    {
-      return iter->second;
-    }
+    return tracks_from_trkid(truthhit->get_trkid());
   }
 
   std::set<SvtxTrack*> tracks;
@@ -417,11 +406,6 @@ std::set<SvtxTrack*> SvtxTrackEval::all_tracks_from(PHG4Hit* truthhit)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_all_tracks_from_g4hit.insert(std::make_pair(truthhit, tracks));
-  }
-
   return tracks;
 }
 
@@ -678,6 +662,11 @@ unsigned int SvtxTrackEval::get_nclusters_contribution(SvtxTrack* track, PHG4Par
     return 0;
   }
 
+  if (_do_cache)
+  {
+    return nclusters_from_trkid(track, particle->get_track_id());
+  }
+
   calc_cluster_contribution(track, particle);
 
   std::map<std::pair<SvtxTrack*, PHG4Particle*>, unsigned int>::iterator iter =
@@ -708,6 +697,12 @@ unsigned int SvtxTrackEval::get_nwrongclusters_contribution(SvtxTrack* track, PH
     return 0;
   }
 
+  if (_do_cache)
+  {
+    // clusters without a g4hit of this particle
+    return get_track_ckeys(track).size() - nclusters_from_trkid(track, particle->get_track_id());
+  }
+
   calc_cluster_contribution(track, particle);
 
   std::map<std::pair<SvtxTrack*, PHG4Particle*>, unsigned int>::iterator iter =
@@ -948,6 +943,75 @@ std::pair<unsigned int, unsigned int> SvtxTrackEval::get_layer_range_contributio
   return std::make_pair(nmatches,nwrong);
 }
 
+void SvtxTrackEval::fill_track_links()
+{
+  // one pass over all tracks, counting the clusters with g4hits of each particle
+  _track_links.clear();
+  std::vector<int> trkids;
+  for (auto& iter : *_trackmap)
+  {
+    SvtxTrack* track = iter.second;
+    trkids.clear();
+    for (const auto& cluster_key : get_track_ckeys(track))
+    {
+      // a cluster counts once per particle
+      const auto first = trkids.size();
+      for (auto g4hit : _clustereval.all_truth_hits(cluster_key))
+      {
+        trkids.push_back(g4hit->get_trkid());
+      }
+      std::sort(trkids.begin() + first, trkids.end());
+      trkids.erase(std::unique(trkids.begin() + first, trkids.end()), trkids.end());
+    }
+    std::sort(trkids.begin(), trkids.end());
+    for (auto first = trkids.begin(); first != trkids.end();)
+    {
+      auto last = std::upper_bound(first, trkids.end(), *first);
+      PHG4Particle* particle = _truthinfo ? _truthinfo->GetParticle(*first) : nullptr;
+      _track_links.push_back({track, particle, *first, static_cast<unsigned int>(last - first)});
+      first = last;
+    }
+  }
+  // tracks are visited in map order, which is not the pointer order
+  std::sort(_track_links.begin(), _track_links.end(), [](const TrackLink& lhs, const TrackLink& rhs)
+            { return std::less<SvtxTrack*>()(lhs.track, rhs.track) || (lhs.track == rhs.track && lhs.trkid < rhs.trkid); });
+  _track_links_by_trkid = _track_links;
+  std::stable_sort(_track_links_by_trkid.begin(), _track_links_by_trkid.end(), [](const TrackLink& lhs, const TrackLink& rhs)
+                   { return lhs.trkid < rhs.trkid; });
+  _track_links_filled = true;
+}
+
+std::set<SvtxTrack*> SvtxTrackEval::tracks_from_trkid(int trkid)
+{
+  if (!_track_links_filled)
+  {
+    fill_track_links();
+  }
+  std::set<SvtxTrack*> tracks;
+  auto iter = std::partition_point(_track_links_by_trkid.begin(), _track_links_by_trkid.end(), [trkid](const TrackLink& link)
+                                   { return link.trkid < trkid; });
+  for (; iter != _track_links_by_trkid.end() && iter->trkid == trkid; ++iter)
+  {
+    tracks.insert(iter->track);
+  }
+  return tracks;
+}
+
+unsigned int SvtxTrackEval::nclusters_from_trkid(SvtxTrack* track, int trkid)
+{
+  if (!_track_links_filled)
+  {
+    fill_track_links();
+  }
+  auto iter = std::partition_point(_track_links.begin(), _track_links.end(), [track, trkid](const TrackLink& link)
+                                   { return std::less<SvtxTrack*>()(link.track, track) || (link.track == track && link.trkid < trkid); });
+  if (iter != _track_links.end() && iter->track == track && iter->trkid == trkid)
+  {
+    return iter->nclusters;
+  }
+  return 0;
+}
+
 void SvtxTrackEval::get_node_pointers(PHCompositeNode* topNode)
 {
   // need things off of the DST...
@@ -9,6 +9,7 @@
 #include <set>
 #include <string>  // for string
 #include <utility>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -82,6 +83,19 @@ class SvtxTrackEval
 
   std::vector<TrkrDefs::cluskey> get_track_ckeys(SvtxTrack* track);
 
+  //! track - particle table of this event, filled on first use
+  void fill_track_links();
+  std::set<SvtxTrack*> tracks_from_trkid(int trkid);
+  unsigned int nclusters_from_trkid(SvtxTrack* track, int trkid);
+
+  struct TrackLink
+  {
+    SvtxTrack* track;
+    PHG4Particle* particle;  // nullptr if the g4hit track id is not in the truth container
+    int trkid;
+    unsigned int nclusters;  // clusters of the track with a g4hit of this particle
+  };
+
   SvtxClusterEval _clustereval;
   SvtxTrackMap* _trackmap = nullptr;
   PHG4TruthInfoContainer* _truthinfo = nullptr;
@@ -97,14 +111,16 @@ class SvtxTrackEval
   std::map<SvtxTrack*, std::set<PHG4Hit*> > _cache_all_truth_hits;
   std::map<SvtxTrack*, std::set<PHG4Particle*> > _cache_all_truth_particles;
   std::map<SvtxTrack*, PHG4Particle*> _cache_max_truth_particle_by_nclusters;
-  std::map<PHG4Particle*, std::set<SvtxTrack*> > _cache_all_tracks_from_particle;
   std::map<PHG4Particle*, SvtxTrack*> _cache_best_track_from_particle;
-  std::map<PHG4Hit*, std::set<SvtxTrack*> > _cache_all_tracks_from_g4hit;
   std::map<TrkrDefs::cluskey, std::set<SvtxTrack*> > _cache_all_tracks_from_cluster;
   std::map<TrkrDefs::cluskey, SvtxTrack*> _cache_best_track_from_cluster;
   std::map<std::pair<SvtxTrack*, PHG4Particle*>, unsigned int> _cache_get_nclusters_contribution;
   std::map<std::pair<SvtxTrack*, PHG4Particle*>, unsigned int> _cache_get_nclusters_contribution_by_layer;
   std::map<std::pair<SvtxTrack*, PHG4Particle*>, unsigned int> _cache_get_nwrongclusters_contribution;
+  //! sorted by track and by particle track id
+  std::vector<TrackLink> _track_links;
+  std::vector<TrackLink> _track_links_by_trkid;
+  bool _track_links_filled = false;
   std::string m_TrackNodeName = "SvtxTrackMap";
 };
 
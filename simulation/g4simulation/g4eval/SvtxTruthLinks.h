@@ -0,0 +1,110 @@
+#ifndef G4EVAL_SVTXTRUTHLINKS_H
+#define G4EVAL_SVTXTRUTHLINKS_H
+
+#include <g4main/PHG4Hit.h>
+
+#include <algorithm>
+#include <functional>  // for less
+#include <utility>
+#include <vector>
+
+class PHG4Particle;
+
+// Flat truth association table for one kind of reco object (TrkrHit or
+// TrkrCluster key). The evaluators fill it once per event with one entry per
+// (key, g4hit) pair and sort it into three orders, so that queries in either
+// direction are binary searches on contiguous memory instead of a walk through
+// the association containers per query.
+
+template <class Key>
+class SvtxTruthLinks
+{
+ public:
+  struct Link
+  {
+    Key key;
+    PHG4Hit* g4hit;
+    PHG4Particle* particle;  // nullptr if the g4hit track id is not in the truth container
+    int trkid;
+    float edep;
+  };
+
+  using ConstIterator = typename std::vector<Link>::const_iterator;
+  using ConstRange = std::pair<ConstIterator, ConstIterator>;
+
+  void clear()
+  {
+    m_by_key.clear();
+    m_by_g4hit.clear();
+    m_by_trkid.clear();
+    m_filled = false;
+  }
+
+  //! true once sort() was called since the last clear()
+  bool filled() const { return m_filled; }
+
+  void add(Key key, PHG4Hit* g4hit, PHG4Particle* particle)
+  {
+    m_by_key.push_back({key, g4hit, particle, g4hit->get_trkid(), g4hit->get_edep()});
+  }
+
+  //! remove duplicate (key, g4hit) pairs and build the lookup orders, call after the last add()
+  void sort()
+  {
+    std::sort(m_by_key.begin(), m_by_key.end(), [](const Link& lhs, const Link& rhs)
+              { return lhs.key < rhs.key || (lhs.key == rhs.key && std::less<PHG4Hit*>()(lhs.g4hit, rhs.g4hit)); });
+    m_by_key.erase(std::unique(m_by_key.begin(), m_by_key.end(), [](const Link& lhs, const Link& rhs)
+                               { return lhs.key == rhs.key && lhs.g4hit == rhs.g4hit; }),
+                   m_by_key.end());
+
+    // stable sorts keep the key order within a g4hit or a particle
+    m_by_g4hit = m_by_key;
+    std::stable_sort(m_by_g4hit.begin(), m_by_g4hit.end(), [](const Link& lhs, const Link& rhs)
+                     { return std::less<PHG4Hit*>()(lhs.g4hit, rhs.g4hit); });
+    m_by_trkid = m_by_key;
+    std::stable_sort(m_by_trkid.begin(), m_by_trkid.end(), [](const Link& lhs, const Link& rhs)
+                     { return lhs.trkid < rhs.trkid; });
+    m_filled = true;
+  }
+
+  //! g4hits of a reco object, ordered by g4hit
+  ConstRange find_key(Key key) const
+  {
+    return equal_range(m_by_key, key, [](const Link& link)
+                       { return link.key; });
+  }
+
+  //! reco objects a g4hit contributed to, ordered by key
+  ConstRange find_g4hit(PHG4Hit* g4hit) const
+  {
+    return equal_range(m_by_g4hit, g4hit, [](const Link& link)
+                       { return link.g4hit; });
+  }
+
+  //! g4hits of a particle and the reco objects they contributed to, ordered by key
+  ConstRange find_trkid(int trkid) const
+  {
+    return equal_range(m_by_trkid, trkid, [](const Link& link)
+                       { return link.trkid; });
+  }
+
+  unsigned int size() const { return m_by_key.size(); }
+
+ private:
+  template <class T, class Proj>
+  static ConstRange equal_range(const std::vector<Link>& links, const T& value, Proj proj)
+  {
+    auto lower = std::partition_point(links.begin(), links.end(), [&](const Link& link)
+                                      { return std::less<T>()(proj(link), value); });
+    auto upper = std::partition_point(lower, links.end(), [&](const Link& link)
+                                      { return !std::less<T>()(value, proj(link)); });
+    return std::make_pair(lower, upper);
+  }
+
+  std::vector<Link> m_by_key;
+  std::vector<Link> m_by_g4hit;
+  std::vector<Link> m_by_trkid;
+  bool m_filled = false;
+};
+
+#endif  // G4EVAL_SVTXTRUTHLINKS_H
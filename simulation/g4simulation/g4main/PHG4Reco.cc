@@ -163,6 +163,11 @@ int PHG4Reco::Init(PHCompositeNode *topNode)
     uimanager->SetCoutDestination(m_UISession);
   }
 
+  // Geant4 runs sequentially. A G4MTRunManager/G4TaskRunManager mode is not supported:
+  // the subsystem stepping, tracking and event actions keep per track state and write
+  // directly into the hit and truth containers on the node tree, and Fun4All hands
+  // PHG4Reco one event at a time. It would need per worker copies of all subsystem
+  // actions and hit containers, and an event loop that merges worker results in order.
   m_RunManager = new G4RunManager();
 
   DefineMaterials();
@@ -36,6 +36,8 @@
 #include <TProfile.h>
 #include <TSystem.h>
 #include <TTree.h>
+
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -46,6 +48,30 @@ double CaloWaveformSim::template_function(double *x, double *par)
   return v1;
 }
 
+void CaloWaveformSim::tabulate_template()
+{
+  // TProfile::Interpolate is linear between bin centers and constant outside of them,
+  // a grid through the bin centers reproduces it
+  const int nbins = h_template->GetNbinsX();
+  const double first = h_template->GetBinCenter(1);
+  const double last = h_template->GetBinCenter(nbins);
+  const int npoints = std::max(1, nbins - 1) * std::max(1, m_template_oversampling) + 1;
+  m_template_x0 = first;
+  m_template_step = (last > first) ? (last - first) / (npoints - 1) : 1.;
+  m_template.resize(npoints);
+  for (int i = 0; i < npoints; i++)
+  {
+    m_template[i] = h_template->Interpolate(first + i * m_template_step);
+  }
+  // peak of the unshifted template inside the readout window
+  TF1 f_fit(
+      "f_fit", [this](double *x, double *par)
+      { return this->template_function(x, par); },
+      0, m_nsamples, 3);
+  f_fit.SetParameters(1., 0., 0.);
+  m_template_peak = f_fit.GetMaximumX();
+}
+
 CaloWaveformSim::CaloWaveformSim(const std::string &name)
   : SubsysReco(name)
 {
@@ -75,6 +101,7 @@ int CaloWaveformSim::InitRun(PHCompositeNode *topNode)
   assert(ft);
   assert(ft->IsOpen());
   h_template = (TProfile *) ft->Get("hpwaveform");
+  tabulate_template();
   
   // get the decalibration from the CDB
   PHNodeIterator nodeIter(topNode);
@@ -199,11 +226,8 @@ int CaloWaveformSim::InitRun(PHCompositeNode *topNode)
       exit(1);
     }
   }
-  m_waveforms.resize(m_nchannels);
-  for (auto &waveform : m_waveforms)
-  {
-    waveform.resize(m_nsamples);
-  }
+  m_waveforms.resize(m_nchannels * m_nsamples);
+  m_waveform_pedestal.resize(m_nsamples);
 
   CreateNodeTree(topNode);
   return Fun4AllReturnCodes::EVENT_OK;
@@ -244,23 +268,14 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
   }
 
   // initialize the waveform
-  for (auto &waveform : m_waveforms)
-  {
-    for (auto &sample : waveform)
-    {
-      sample = 0.;
-    }
-  }
-  // waveform TH1
-  TF1 *f_fit = new TF1(
-      "f_fit", [this](double *x, double *par)
-      { return this->template_function(x, par); },
-      0, m_nsamples, 3);
-  f_fit->SetParameter(0, 1.0);
+  std::fill(m_waveforms.begin(), m_waveforms.end(), 0.);
+
   float shift_of_shift = m_timeshiftwidth * gsl_rng_uniform(m_RandomGenerator);
 
-  float _shiftval = m_peakpos + shift_of_shift - f_fit->GetMaximumX();
-  f_fit->SetParameters(1, _shiftval, 0);
+  float _shiftval = m_peakpos + shift_of_shift - m_template_peak;
+
+  const double inv_step = 1. / m_template_step;
+  const double umax = m_template.size() - 1;
 
   // get G4Hits
   std::string nodename = "G4HIT_" + m_detector;
@@ -310,10 +325,28 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     edepMap[hit->get_hit_id()] += hitEdep;
     showerMap[showerID] += hitEdep;
 
-    f_fit->SetParameters(ADC, _shiftval + t0, 0.);
+    // position of sample 0 in the template table, every sample moves it by 1/m_template_step
+    const double shift = _shiftval + t0;
+    const double u0 = (-shift - m_template_x0) * inv_step;
+    float *waveform = &m_waveforms[tower_index * m_nsamples];
     for (int i = 0; i < m_nsamples; i++)
     {
-      m_waveforms.at(tower_index).at(i) += f_fit->Eval(i);
+      const double u = u0 + i * inv_step;
+      double value;
+      if (u <= 0)
+      {
+        value = m_template.front();
+      }
+      else if (u >= umax)
+      {
+        value = m_template.back();
+      }
+      else
+      {
+        const unsigned int j = u;
+        value = m_template[j] + (u - j) * (m_template[j + 1] - m_template[j]);
+      }
+      waveform[i] += ADC * value;
     }
   }
 
@@ -332,55 +365,47 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
       }
     }
 
+    // pedestal and noise, once per tower
     for (int i = 0; i < m_nchannels; i++)
     {
-      std::vector<float> m_waveform_pedestal;
-      m_waveform_pedestal.resize(m_nsamples);
-      if(m_noiseType == NoiseType::NOISE_TREE)
+      float *waveform = &m_waveforms[i * m_nsamples];
+      if (m_noiseType == NoiseType::NOISE_TREE)
       {
         TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
         float pedestal_mean = 0;
-        for(int j = 0; j < m_nsamples; j++)
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveform_pedestal.at(j) = (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
-          pedestal_mean += m_waveform_pedestal.at(j);
+          m_waveform_pedestal[j] = (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
+          pedestal_mean += m_waveform_pedestal[j];
         }
         pedestal_mean /= m_nsamples;
-        for(int j = 0; j < m_nsamples; j++)
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveform_pedestal.at(j)  = (m_waveform_pedestal.at(j) - pedestal_mean) * m_pedestal_scale + pedestal_mean;
+          waveform[j] += (m_waveform_pedestal[j] - pedestal_mean) * m_pedestal_scale + pedestal_mean;
         }
       }
-      for (int j = 0; j < m_nsamples; j++)
+      else if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
       {
-        if (m_noiseType == NoiseType::NOISE_TREE)
+        for (int j = 0; j < m_nsamples; j++)
         {
-          //TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
-          //m_waveforms.at(i).at(j) += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
-          m_waveforms.at(i).at(j) += m_waveform_pedestal.at(j);
+          waveform[j] += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
         }
-        if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
-        {
-          m_waveforms.at(i).at(j) += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
-        }
-        if (m_noiseType == NoiseType::NOISE_NONE)
+      }
+      else if (m_noiseType == NoiseType::NOISE_NONE)
+      {
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveforms.at(i).at(j) += m_fixpedestal;
+          waveform[j] += m_fixpedestal;
         }
+      }
+      TowerInfo *tower = m_CaloWaveformContainer->get_tower_at_channel(i);
+      for (int j = 0; j < m_nsamples; j++)
+      {
         // saturate at 2^14 - 1
-        if(m_waveforms.at(i).at(j) > 16383)
-        {
-          m_waveforms.at(i).at(j) = 16383;
-        }
-        if(m_waveforms.at(i).at(j) < 0)
-	      {
-	        m_waveforms.at(i).at(j) = 0;
-	      }
-        
-        m_CaloWaveformContainer->get_tower_at_channel(i)->set_waveform_value(j, m_waveforms.at(i).at(j));
+        waveform[j] = std::clamp(waveform[j], 0.F, 16383.F);
+        tower->set_waveform_value(j, waveform[j]);
       }
     }
-    delete f_fit;
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
@@ -142,6 +142,12 @@ class CaloWaveformSim : public SubsysReco
     m_pedestal_scale = _pedestal_scale;
     return;
   }
+  //! number of table points per template bin, the template is linear between bin centers
+  void set_template_oversampling(int _oversampling)
+  {
+    m_template_oversampling = _oversampling;
+    return;
+  }
   // for CEMC light yield correction
   LightCollectionModel &get_light_collection_model() { return light_collection_model; }
 
@@ -158,7 +164,16 @@ class CaloWaveformSim : public SubsysReco
   TowerInfoContainer *m_CaloWaveformContainer{nullptr};
   TowerInfoContainer *m_PedestalContainer{nullptr};
 
-  std::vector<std::vector<float>> m_waveforms = {{}};
+  //! channels x samples, waveform of channel i starts at i * m_nsamples
+  std::vector<float> m_waveforms;
+  std::vector<float> m_waveform_pedestal;
+
+  //! pulse template tabulated at InitRun on a uniform grid
+  std::vector<double> m_template;
+  double m_template_x0{0.};
+  double m_template_step{1.};
+  double m_template_peak{0.};
+  int m_template_oversampling{4};
   int m_runNumber{0};
   int m_nsamples{31};
   int m_nchannels{24576};
@@ -181,6 +196,7 @@ class CaloWaveformSim : public SubsysReco
   unsigned int (*encode_tower)(const unsigned int etabin, const unsigned int phibin){TowerInfoDefs::encode_emcal};
   unsigned int (*decode_tower)(const unsigned int tower_key){TowerInfoDefs::decode_emcal};
   double template_function(double *x, double *par);
+  void tabulate_template();
   void CreateNodeTree(PHCompositeNode *topNode);
 
   LightCollectionModel light_collection_model;